@@ -12,11 +12,13 @@ struct GLProgramAttribute
     enum Index
     {
         Position = 0,
+        ObjectTransform = 4, // mat4, occupying the locations 4 to 7
         TexCoord = 8,
         Tangent = 9,
         Bitangent = 10,
         Normal = 11,
         Colour = 12,
+        WorldToObject = 13, // mat3x4, the first three rows of the inverse object transform, locations 13 to 15
     };
 };
 
@@ -183,6 +183,10 @@ public:
 
 	virtual const Plane3& getPlane3() const = 0;
 
+	// Replaces the plane of this face, keeping its material and texture projection.
+	// The owning brush needs to re-evaluate its B-Rep afterwards.
+	virtual void setPlane(const Plane3& plane) = 0;
+
 	/**
 	 * The matrix used to project world coordinates to U/V space, after the winding vertices
      * have been transformed to this face's axis base system.
@@ -348,6 +348,14 @@ public:
      */
     virtual void reloadDefs() = 0;
 
+    /**
+     * Like reloadDefs(), but only re-parses the files that have been added or
+     * modified since they have been parsed, plus the files declaring entityDefs
+     * and modelDefs which inherit from the re-parsed ones.
+     * Returns false if no file has changed.
+     */
+    virtual bool reloadChangedDefs() = 0;
+
     /**
      * greebo: Finds the model def with the given name. Might return NULL if not found.
      */
@@ -40,8 +40,9 @@ public:
 
     enum class Type
     {
-        Vertex, // vertex buffer
-        Index   // index buffer
+        Vertex,         // vertex buffer
+        Index,          // index buffer
+        DrawIndirect,   // draw command buffer sourced by the glDraw*Indirect calls
     };
 
     using Ptr = std::shared_ptr<IBufferObject>;
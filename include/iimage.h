@@ -111,6 +111,18 @@ public:
      */
     virtual ImagePtr imageFromVFS(const std::string& vfsPath) const = 0;
 
+    /**
+     * \brief
+     * Load a low-resolution version of an image from a VFS path, fitting into
+     * maxSize x maxSize pixels. The file lookup is the same as in imageFromVFS().
+     *
+     * Loaders read only a small mipmap or decode at reduced resolution where the
+     * format allows it, and the result is kept in a persistent thumbnail cache.
+     * Textures bound from the returned image report the dimensions of the
+     * full-resolution source image.
+     */
+    virtual ImagePtr previewImageFromVFS(const std::string& vfsPath, std::size_t maxSize) const = 0;
+
     /**
      * \brief
      * Load an image from a filesystem path.
@@ -2,6 +2,11 @@
 
 #include <set>
 #include <string>
+#include <vector>
+#include <cstdint>
+#include <iterator>
+#include <algorithm>
+#include <initializer_list>
 #include <functional>
 #include "imodule.h"
 #include <sigc++/signal.h>
@@ -12,8 +17,281 @@ namespace scene
 class INode;
 typedef std::shared_ptr<INode> INodePtr;
 
-// A list of named layers
-typedef std::set<int> LayerList;
+/**
+ * The set of layer IDs a node is a member of.
+ *
+ * Every node in the scene carries one of these, so it is designed to avoid
+ * any heap allocation in the common case: IDs 0..63 are stored in an inline
+ * bitmask, any other ID ends up in a small sorted overflow vector.
+ * The interface mimics the subset of std::set<int> used throughout the codebase,
+ * iteration yields the IDs in ascending order.
+ */
+class LayerList
+{
+private:
+	static constexpr int NumInlineBits = 64;
+
+	// Membership bits of the layers 0..63
+	std::uint64_t _bits;
+
+	// Sorted IDs outside the inline range
+	std::vector<int> _overflow;
+
+public:
+	class const_iterator
+	{
+	private:
+		const LayerList* _list;
+
+		// Points into the overflow vector as long as _bit is negative
+		std::size_t _overflowIndex;
+
+		// The inline bit this iterator is pointing at, -1 if pointing into the overflow
+		int _bit;
+
+		friend class LayerList;
+
+		const_iterator(const LayerList* list, std::size_t overflowIndex, int bit) :
+			_list(list),
+			_overflowIndex(overflowIndex),
+			_bit(bit)
+		{}
+
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = int;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const int*;
+		using reference = int;
+
+		const_iterator() :
+			const_iterator(nullptr, 0, -1)
+		{}
+
+		int operator*() const
+		{
+			return _bit >= 0 ? _bit : _list->_overflow[_overflowIndex];
+		}
+
+		const_iterator& operator++()
+		{
+			if (_bit >= 0)
+			{
+				// Continue with the next bit, or with the non-negative overflow IDs
+				_bit = _list->findNextBit(_bit + 1);
+				return *this;
+			}
+
+			bool wasNegative = _list->_overflow[_overflowIndex] < 0;
+			++_overflowIndex;
+
+			// The negative IDs are sorted before the inline range
+			if (wasNegative && (_overflowIndex == _list->_overflow.size() || _list->_overflow[_overflowIndex] >= 0))
+			{
+				_bit = _list->findNextBit(0);
+			}
+
+			return *this;
+		}
+
+		const_iterator operator++(int)
+		{
+			auto previous = *this;
+			++*this;
+			return previous;
+		}
+
+		bool operator==(const const_iterator& other) const
+		{
+			return _overflowIndex == other._overflowIndex && _bit == other._bit;
+		}
+
+		bool operator!=(const const_iterator& other) const
+		{
+			return !operator==(other);
+		}
+	};
+
+	using iterator = const_iterator;
+	using value_type = int;
+	using size_type = std::size_t;
+
+	LayerList() :
+		_bits(0)
+	{}
+
+	LayerList(std::initializer_list<int> ids) :
+		LayerList()
+	{
+		for (auto id : ids)
+		{
+			insert(id);
+		}
+	}
+
+	const_iterator begin() const
+	{
+		if (!_overflow.empty() && _overflow.front() < 0)
+		{
+			return const_iterator(this, 0, -1);
+		}
+
+		return const_iterator(this, 0, findNextBit(0));
+	}
+
+	const_iterator end() const
+	{
+		return const_iterator(this, _overflow.size(), -1);
+	}
+
+	bool empty() const
+	{
+		return _bits == 0 && _overflow.empty();
+	}
+
+	size_type size() const
+	{
+		size_type count = _overflow.size();
+
+		for (auto bits = _bits; bits != 0; bits &= bits - 1)
+		{
+			++count;
+		}
+
+		return count;
+	}
+
+	void clear()
+	{
+		_bits = 0;
+		_overflow.clear();
+	}
+
+	std::pair<const_iterator, bool> insert(int id)
+	{
+		if (isInline(id))
+		{
+			bool inserted = (_bits & getMask(id)) == 0;
+			_bits |= getMask(id);
+			return std::make_pair(const_iterator(this, getNumNegativeIds(), id), inserted);
+		}
+
+		auto pos = std::lower_bound(_overflow.begin(), _overflow.end(), id);
+		bool inserted = pos == _overflow.end() || *pos != id;
+
+		if (inserted)
+		{
+			pos = _overflow.insert(pos, id);
+		}
+
+		return std::make_pair(const_iterator(this, pos - _overflow.begin(), -1), inserted);
+	}
+
+	template<typename InputIterator>
+	void insert(InputIterator first, InputIterator last)
+	{
+		for (; first != last; ++first)
+		{
+			insert(*first);
+		}
+	}
+
+	// Removes the given ID, returns the number of removed elements (0 or 1)
+	size_type erase(int id)
+	{
+		if (isInline(id))
+		{
+			bool found = (_bits & getMask(id)) != 0;
+			_bits &= ~getMask(id);
+			return found ? 1 : 0;
+		}
+
+		auto pos = std::lower_bound(_overflow.begin(), _overflow.end(), id);
+
+		if (pos == _overflow.end() || *pos != id)
+		{
+			return 0;
+		}
+
+		_overflow.erase(pos);
+		return 1;
+	}
+
+	size_type count(int id) const
+	{
+		if (isInline(id))
+		{
+			return (_bits & getMask(id)) != 0 ? 1 : 0;
+		}
+
+		return std::binary_search(_overflow.begin(), _overflow.end(), id) ? 1 : 0;
+	}
+
+	const_iterator find(int id) const
+	{
+		if (count(id) == 0)
+		{
+			return end();
+		}
+
+		if (isInline(id))
+		{
+			return const_iterator(this, getNumNegativeIds(), id);
+		}
+
+		return const_iterator(this, std::lower_bound(_overflow.begin(), _overflow.end(), id) - _overflow.begin(), -1);
+	}
+
+	// Returns the number of bytes allocated on the heap for large IDs
+	std::size_t getHeapMemoryUsage() const
+	{
+		return _overflow.capacity() * sizeof(int);
+	}
+
+	bool operator==(const LayerList& other) const
+	{
+		return _bits == other._bits && _overflow == other._overflow;
+	}
+
+	bool operator!=(const LayerList& other) const
+	{
+		return !operator==(other);
+	}
+
+private:
+	static bool isInline(int id)
+	{
+		return id >= 0 && id < NumInlineBits;
+	}
+
+	static std::uint64_t getMask(int id)
+	{
+		return std::uint64_t(1) << id;
+	}
+
+	// Returns the lowest set bit at or above the given one, or -1 if there is none
+	int findNextBit(int bit) const
+	{
+		if (bit >= NumInlineBits) return -1;
+
+		auto remaining = _bits >> bit;
+
+		if (remaining == 0) return -1;
+
+		while ((remaining & 1) == 0)
+		{
+			remaining >>= 1;
+			++bit;
+		}
+
+		return bit;
+	}
+
+	std::size_t getNumNegativeIds() const
+	{
+		return std::lower_bound(_overflow.begin(), _overflow.end(), 0) - _overflow.begin();
+	}
+};
 
 /**
  * greebo: Interface of a Layered object.
@@ -174,6 +452,26 @@ public:
 	 */
 	virtual bool updateNodeVisibility(const scene::INodePtr& node) = 0;
 
+	/**
+	 * Assigns all the given nodes to the given set of layers, overwriting
+	 * any previous assignments (see Layered::assignToLayers).
+	 * The visibility of the affected nodes is updated in one go afterwards,
+	 * which is much cheaper than assigning and updating them one by one.
+	 * Note: The layers list must not be empty, otherwise the call will be ignored.
+	 */
+	virtual void assignNodesToLayers(const std::vector<INodePtr>& nodes, const LayerList& layers) = 0;
+
+	/**
+	 * The layer manager keeps track of the members of each layer, such that
+	 * showing, hiding or selecting a layer only needs to visit these nodes.
+	 * Nodes call registerNode() when they are inserted into the scene, and
+	 * unregisterNode() when they are removed from it. A node changing its layer
+	 * assignment while being in the scene unregisters itself before and registers
+	 * itself again after the change.
+	 */
+	virtual void registerNode(INode& node) = 0;
+	virtual void unregisterNode(INode& node) = 0;
+
 	/**
 	 * greebo: Sets the selection status of the entire layer.
 	 *
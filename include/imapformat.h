@@ -81,6 +81,11 @@ typedef std::shared_ptr<PrimitiveParser> PrimitiveParserPtr;
  * errors during write (e.g. a visited node is not exportable) a
  * IMapWriter::FailureException will be thrown. The calling code
  * is designed to catch this exception.
+ *
+ * Writers able to serialise entities independently of each other can
+ * return a separate writer instance per entity from createEntityWriter().
+ * The map exporter is then writing the entities on worker threads, into
+ * memory buffers which are concatenated in the order of traversal.
  */
 class IMapWriter 
 {
@@ -121,6 +126,21 @@ public:
 	// Patch export methods
 	virtual void beginWritePatch(const IPatchNodePtr& patch, std::ostream& stream) = 0;
 	virtual void endWritePatch(const IPatchNodePtr& patch, std::ostream& stream) = 0;
+
+	/**
+	 * Returns a new writer to serialise the entity with the given (zero-based)
+	 * number and its primitives, producing the same output as this writer would.
+	 * The returned instance is used on a worker thread and must not share any
+	 * mutable state with this writer. It receives the beginWriteEntity/endWriteEntity
+	 * and primitive calls of that single entity, the map calls are still going
+	 * through this instance.
+	 *
+	 * Writers returning an empty pointer (the default) are invoked sequentially.
+	 */
+	virtual std::shared_ptr<IMapWriter> createEntityWriter(std::size_t entityNumber)
+	{
+		return std::shared_ptr<IMapWriter>();
+	}
 };
 typedef std::shared_ptr<IMapWriter> IMapWriterPtr;
 
@@ -3,6 +3,7 @@
 #include "imodule.h"
 #include "imodel.h"
 #include "inode.h"
+#include <set>
 #include <sigc++/signal.h>
 
 namespace model 
@@ -14,6 +15,20 @@ class IModelCache :
 	public RegisterableModule
 {
 public:
+	// Usage figures of the cache, sizes are estimated in bytes
+	struct Statistics
+	{
+		std::size_t numModels = 0;
+		std::size_t totalSize = 0;
+
+		// Size the cache is trimmed to, 0 if unlimited
+		std::size_t memoryBudget = 0;
+
+		std::size_t numHits = 0;
+		std::size_t numMisses = 0;
+		std::size_t numEvictions = 0;
+	};
+
 	/**
 	 * greebo: This method returns the readily fabricated scene::Node
 	 * containing the suitable model node. The modelPath is analysed
@@ -29,10 +44,25 @@ public:
 	 * so calling this with the same path twice will return the same
 	 * IModelPtr to save memory.
 	 *
+	 * Once the cached models exceed the configured memory budget, the least
+	 * recently used ones are dropped again, as long as nothing else (like the
+	 * model nodes created from them) is holding a reference to them.
+	 *
 	 * This method is primarily used by the ModelLoaders to acquire their model data.
 	 */
 	virtual IModelPtr getModel(const std::string& modelPath) = 0;
 
+	/**
+	 * Loads the models referenced by the given "model" spawnarg values into the
+	 * cache, parsing several files concurrently. Values referring to modelDefs are
+	 * resolved to their mesh. Models already in the cache, particles and paths
+	 * without a suitable importer are skipped, as are models that fail to load,
+	 * these are reported by the next getModelNode() call as usual.
+	 *
+	 * Subsequent getModelNode() calls for these values are cache hits.
+	 */
+	virtual void preloadModels(const std::set<std::string>& modelPaths) = 0;
+
     // Loads a model from the static resources in DarkRadiant's runtime data/resources folder
     virtual scene::INodePtr getModelNodeForStaticResource(const std::string& resourcePath) = 0;
 
@@ -48,6 +78,9 @@ public:
 	// Clears the modelcache
 	virtual void clear() = 0;
 
+	// Returns the current usage figures, hit and miss counts refer to getModel()
+	virtual Statistics getStatistics() const = 0;
+
 	/// Signal emitted after models are reloaded
 	virtual sigc::signal<void> signal_modelsReloaded() = 0;
 };
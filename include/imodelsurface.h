@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstdint>
+#include <vector>
+
 // Math/Vertex classes
 #include "render/MeshVertex.h"
 
@@ -65,6 +68,13 @@ public:
 
 	// Const access to the index array connecting the vertices.
 	virtual const std::vector<unsigned int>& getIndexArray() const = 0;
+
+	// Surfaces returning the same non-zero key have identical vertex and index
+	// arrays, their renderables can share the same geometry in the renderer.
+	virtual std::uint64_t getGeometryKey() const
+	{
+		return 0;
+	}
 };
 
 } // namespace
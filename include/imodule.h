@@ -31,7 +31,7 @@
  * As long as no external module/plugin files are removed this number is safe to stay 
  * as it is. Keep this number compatible to std::size_t, i.e. unsigned.
  */
-#define MODULE_COMPATIBILITY_LEVEL 20211014
+#define MODULE_COMPATIBILITY_LEVEL 20261019
 
 // A function taking an error title and an error message string, invoked in debug builds
 // for things like ASSERT_MESSAGE and ERROR_MESSAGE
@@ -191,6 +191,23 @@ public:
         // Empty default implementation
     }
 
+    /**
+     * Returns true if this module's initialiseModule() method may be invoked
+     * on a worker thread, concurrently to other modules whose dependencies
+     * have already been initialised.
+     *
+     * Modules opting in must only access their declared dependencies during
+     * initialisation, and must not touch the UI or any other facility that
+     * is not thread-safe (like preference pages or sigc++ signals). Modules
+     * creating thread-affine resources (like an OpenAL context) must stay on
+     * the main thread. Registering commands and VFS observers is fine.
+     * The default is to initialise the module on the main thread.
+     */
+    virtual bool supportsParallelInitialisation() const
+    {
+        return false;
+    }
+
     // Internally queried by the ModuleRegistry. To protect against leftover
     // binaries containing outdated moudles from being loaded and registered
     // the compatibility level is compared with the one in the ModuleRegistry.
@@ -315,6 +332,12 @@ public:
 	*/
 	virtual sigc::signal<void>& signal_modulesUnloading() = 0;
 
+	/**
+	 * Lock to be held when connecting to the registry's signals from code
+	 * that might run on a worker thread during parallel module initialisation.
+	 */
+	virtual std::mutex& getSignalLock() = 0;
+
 	// The compatibility level this Registry instance was compiled against.
 	// Old module registrations will be rejected by the registry anyway,
 	// on top of that they can actively query this number from the registry
@@ -418,6 +441,9 @@ namespace module
 
             _instancePtr = dynamic_cast<ModuleType*>(registry.getModule(_moduleName).get());
 
+            // Module references might be acquired during parallel module initialisation
+            std::lock_guard<std::mutex> lock(registry.getSignalLock());
+
             registry.signal_allModulesUninitialised().connect([this]
             {
                 _instancePtr = nullptr;
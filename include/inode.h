@@ -115,6 +115,17 @@ public:
 	// Returns the type of this node
 	virtual Type getNodeType() const = 0;
 
+	/**
+	 * Returns an estimate of the memory in bytes occupied by this node,
+	 * including the data it owns on the heap, but excluding its child nodes.
+	 * Used for memory statistics only, the default implementation returns 0
+	 * for node types not reporting their usage.
+	 */
+	virtual std::size_t getMemoryUsage() const
+	{
+		return 0;
+	}
+
 	/**
 	 * Set the scenegraph this node is belonging to. This is usually
 	 * set by the scenegraph itself during insertion.
@@ -234,6 +245,20 @@ public:
 	virtual IRenderEntity* getRenderEntity() const = 0;
 	virtual void setRenderEntity(IRenderEntity* entity) = 0;
 
+	/**
+	 * Returns true if this node needs to run its onPreRender() preparations
+	 * in the next front-end pass. The flag is raised when the transform, bounds,
+	 * visibility, selection status or render entity of the node changes.
+	 * Nodes not tracking their render state report a dirty state in every frame.
+	 */
+	virtual bool isRenderStateDirty() const = 0;
+
+	// Flags the render state of this node as outdated, see isRenderStateDirty()
+	virtual void queueRenderStateUpdate() = 0;
+
+	// Called by the front-end renderer right before invoking onPreRender()
+	virtual void clearRenderStateDirty() = 0;
+
 	// Call this if the node gets changed in any way or gets inserted somewhere.
 	virtual void boundsChanged() = 0;
 	// Call this on transform change
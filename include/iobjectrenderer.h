@@ -5,6 +5,8 @@
 #include "igl.h"
 #include "igeometrystore.h"
 
+class Matrix4;
+
 namespace render
 {
 
@@ -43,6 +45,21 @@ public:
     // Draws the geometry with a custom set of indices
     virtual void submitGeometryWithCustomIndices(IGeometryStore::Slot slot, GLenum primitiveMode,
         const std::vector<unsigned int>& indices) = 0;
+
+    // Draws all given slots (triangle primitives) sharing the same object transform in a single draw call
+    virtual void submitObjects(const std::vector<IGeometryStore::Slot>& slots, const Matrix4& objectTransform) = 0;
+
+    // Draws the given slots (triangle primitives), each of them using the object transform at the same
+    // position in the objectTransforms vector, passed to the GLSL programs through the ObjectTransform
+    // vertex attribute. Every slot is drawn numInstances times (e.g. once per shadow map cube face).
+    virtual void submitOrientedObjects(const std::vector<IGeometryStore::Slot>& slots,
+        const std::vector<Matrix4>& objectTransforms, int numInstances) = 0;
+
+    // The number of glDraw* calls issued since the last call to resetDrawCallCount()
+    virtual std::size_t getDrawCallCount() const = 0;
+
+    // Resets the draw call counter, to be called at the start of a frame
+    virtual void resetDrawCallCount() = 0;
 };
 
 }
@@ -9,6 +9,7 @@ const char* const MODULE_RADIANT_CORE("RadiantCore");
 
 namespace applog { class ILogWriter;  }
 namespace language { class ILanguageManager; } // see "i18n.h"
+namespace profiling { class ITraceCollector; } // see "itracecollector.h"
 
 namespace radiant
 {
@@ -52,6 +53,12 @@ public:
      */
     virtual language::ILanguageManager& getLanguageManager() = 0;
 
+    /**
+     * Get a reference to the performance trace collector,
+     * see also the GlobalTraceCollector() accessor.
+     */
+    virtual profiling::ITraceCollector& getTraceCollector() = 0;
+
     /**
      * Loads and initialises all modules, starting up the 
      * application. Might throw a StartupFailure exception
@@ -114,6 +114,14 @@ public:
 
 	// Returns the associated spacepartition
 	virtual ISpacePartitionSystemPtr getSpacePartition() = 0;
+
+	/**
+	 * Returns a counter which is incremented each time a node is linked to or
+	 * unlinked from the space partition, including re-links due to bounds changes.
+	 * Pending bounds changes are evaluated first. Clients caching the result of
+	 * a foreachNodeInVolume() traversal can use this to detect stale data.
+	 */
+	virtual std::size_t getSpacePartitionChangeCount() = 0;
 };
 typedef std::shared_ptr<Graph> GraphPtr;
 typedef std::weak_ptr<Graph> GraphWeakPtr;
@@ -187,6 +187,16 @@ public:
     /// Return the editor image texture for this shader.
     virtual TexturePtr getEditorImage() = 0;
 
+    // Maximum width and height of the image returned by getEditorImagePreview()
+    static constexpr std::size_t EDITOR_IMAGE_PREVIEW_SIZE = 256;
+
+    /**
+     * Return a low-resolution version of the editor image, used by texture
+     * thumbnails and previews. The texture reports the dimensions of the
+     * full-resolution editor image, but avoids decoding it.
+     */
+    virtual TexturePtr getEditorImagePreview() = 0;
+
     /// Return true if the editor image is no tex for this shader.
     virtual bool isEditorImageNoTex() = 0;
 
@@ -489,6 +499,14 @@ public:
   virtual void unrealise() = 0;
   virtual void refresh() = 0;
 
+    /**
+     * Re-parses the material files that have been added or modified since they
+     * have been loaded, and drops the declarations of the removed files. Only the
+     * materials declared in these files are updated, the existing Material objects
+     * stay valid. Returns false if no material file has changed.
+     */
+    virtual bool refreshChangedFiles() = 0;
+
 	/** Determine whether the shader system is realised. This may be used
 	 * by components which need to ensure the shaders are realised before
 	 * they start trying to display them.
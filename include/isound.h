@@ -85,6 +85,19 @@ public:
 };
 typedef std::shared_ptr<ISoundShader> ISoundShaderPtr;
 
+// Properties of a sound file, as read from its headers
+struct SoundFileMetadata
+{
+    // Length in seconds
+    float duration = 0;
+
+    // Number of channels (1 = mono, 2 = stereo)
+    unsigned int channels = 0;
+
+    // Samples per second
+    unsigned int sampleRate = 0;
+};
+
 const char* const MODULE_SOUNDMANAGER("SoundManager");
 
 /// Sound manager interface.
@@ -125,6 +138,13 @@ public:
     // Will throw a std::out_of_range exception if the path cannot be resolved
     virtual float getSoundFileDuration(const std::string& vfsPath) = 0;
 
+    // Returns duration, channel count and sample rate of the given sound file.
+    // Only the file headers are parsed, and the results are kept in a persistent
+    // index which is invalidated when the file (or its PK4) changes on disk.
+    // This method can be called from any thread.
+    // Will throw a std::out_of_range exception if the path cannot be resolved
+    virtual SoundFileMetadata getSoundFileMetadata(const std::string& vfsPath) = 0;
+
     // Reloads all sound shader definitions from the VFS
     virtual void reloadSounds() = 0;
 
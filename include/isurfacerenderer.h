@@ -31,6 +31,14 @@ public:
 
     // Returns the indices to render the triangle primitives
     virtual const std::vector<unsigned int>& getIndices() = 0;
+
+    // Surfaces returning the same non-zero key have identical vertices and indices
+    // (like the instances of a cached model), a renderer stores their data only once.
+    // The key is re-evaluated when the renderer is asked to update the surface.
+    virtual std::uint64_t getGeometryKey()
+    {
+        return 0;
+    }
 };
 
 /**
@@ -58,12 +66,14 @@ public:
     virtual void removeSurface(Slot slot) = 0;
 
     // Schedules an update of the vertex data contained in the surface.
+    // This also re-evaluates the surface's geometry key.
     virtual void updateSurface(Slot slot) = 0;
 
     // Submits the surface of a single slot to GL
     virtual void renderSurface(Slot slot) = 0;
 
-    // Get the key to access the vertex data of this surface within the renderer's backend geometry store
+    // Get the key to access the vertex data of this surface within the renderer's backend geometry store.
+    // Surfaces sharing their geometry share the same location, it changes when a surface's geometry key changes.
     virtual IGeometryStore::Slot getSurfaceStorageLocation(ISurfaceRenderer::Slot slot) = 0;
 };
 
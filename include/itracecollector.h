@@ -0,0 +1,58 @@
+#pragma once
+
+#include <chrono>
+#include <ostream>
+#include "iradiant.h"
+
+namespace profiling
+{
+
+/**
+ * Low-overhead collector of performance trace events, hosted by the core module.
+ *
+ * While tracing is enabled, timed zones and counter values are recorded into
+ * per-thread ring buffers (the oldest events are overwritten when a buffer is full).
+ * The recorded events can be exported in the Chrome trace event format, which can
+ * be loaded into chrome://tracing or ui.perfetto.dev.
+ *
+ * Use the helpers in debugging/ScopedTraceZone.h to record events, they take care
+ * of checking isEnabled() such that disabled tracing costs next to nothing.
+ */
+class ITraceCollector
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    virtual ~ITraceCollector() {}
+
+    // Returns true if events are currently being recorded
+    virtual bool isEnabled() const = 0;
+
+    // Starts or stops recording events. Already recorded events are kept.
+    virtual void setEnabled(bool enabled) = 0;
+
+    // Discards all recorded events
+    virtual void clear() = 0;
+
+    /**
+     * Records a timed zone on the calling thread. The category and name strings
+     * are not copied and need to be string literals. The optional detail string
+     * is copied (and truncated if it is very long).
+     */
+    virtual void recordZone(const char* category, const char* name, const char* detail,
+        Clock::time_point start, Clock::time_point end) = 0;
+
+    // Records the value of the named counter at the current time.
+    // The name is not copied and needs to be a string literal.
+    virtual void recordCounter(const char* name, double value) = 0;
+
+    // Writes all recorded events of all threads to the given stream (in JSON format)
+    virtual void exportChromeTrace(std::ostream& stream) = 0;
+};
+
+}
+
+inline profiling::ITraceCollector& GlobalTraceCollector()
+{
+    return GlobalRadiantCore().getTraceCollector();
+}
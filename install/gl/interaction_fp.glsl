@@ -7,14 +7,10 @@ uniform sampler2D	u_attenuationmap_xy;
 uniform sampler2D	u_attenuationmap_z;
 uniform sampler2D	u_ShadowMap;
 
-uniform vec3    u_LocalViewOrigin;
-uniform vec3    u_WorldUpLocal; // world 0,0,1 direction in local space
-uniform vec3    u_LocalLightOrigin; // Light origin in local space
 uniform vec3    u_LightColour;  // the RGB colour as defined on the light entity
 uniform float   u_LightScale;
 uniform vec4    u_ColourModulation;
 uniform vec4    u_ColourAddition;
-uniform mat4    u_ObjectTransform;     // object to world
 
 // Defines the region within the shadow map atlas containing the depth information of the current light
 uniform vec4        u_ShadowMapRect; // x,y,w,h
@@ -28,12 +24,15 @@ varying vec2 var_TexDiffuse;
 varying vec2 var_TexBump;
 varying vec2 var_TexSpecular;
 
-varying vec3 var_vertex; // in world space
 varying vec4 var_tex_atten_xy_z;
 varying mat3 var_mat_os2ts;
 varying vec4 var_Colour; // colour to be multiplied on the final fragment
 varying vec3 var_WorldLightDirection; // direction the light is coming from in world space
 varying vec3 var_LocalViewerDirection; // viewer direction in local space
+varying vec3 var_LocalViewOffset; // local view origin minus the world space vertex
+varying vec3 var_LocalLightOffset; // local light origin minus the world space vertex
+varying vec3 var_LocalWorldLightDirection; // world light direction rotated by the inverse object transform
+varying vec3 var_WorldUpLocal; // world 0,0,1 direction in local space
 
 // Function ported from TDM tdm_shadowmaps.glsl, determining the cube map face for the given direction
 vec3 CubeMapDirectionToUv(vec3 v, out int faceIdx)
@@ -119,10 +118,10 @@ void main()
         vec4 lightParms = vec4(.7, 1.8, 10.0, 30.0);
 
         // compute view direction in tangent space
-        vec3 localV = normalize(var_mat_os2ts * (u_LocalViewOrigin - var_vertex));
+        vec3 localV = normalize(var_mat_os2ts * var_LocalViewOffset);
     
         // compute light direction in tangent space
-        vec3 localL = normalize(var_mat_os2ts * (u_LocalLightOrigin - var_vertex));
+        vec3 localL = normalize(var_mat_os2ts * var_LocalLightOffset);
     
         vec3 RawN = normalize(bumpTexel.xyz);
         vec3 N = var_mat_os2ts * RawN;
@@ -159,9 +158,8 @@ void main()
             float maxAbsL = max(absL.x, max(absL.y, absL.z));
             float centerFragZ = maxAbsL;
 
-            vec3 normal = mat3(u_ObjectTransform) * N;
-
-            float lightFallAngle = -dot(normal, L);
+            // Same as rotating the normal into world space and comparing it to L
+            float lightFallAngle = -dot(N, var_LocalWorldLightDirection) / length(var_WorldLightDirection);
             float errorMargin = 5.0 * maxAbsL / ( shadowMapResolution * max(lightFallAngle, 0.1) );
 
             float centerBlockerZ = getDepthValueForVector(u_ShadowMap, u_ShadowMapRect, L);
@@ -179,13 +177,13 @@ void main()
         vec3 N = normalize(var_mat_os2ts * localNormal);
         
         vec3 light1 = vec3(.5); // directionless half
-        light1 += max(dot(N, u_WorldUpLocal) * (1. - specular) * .5, 0);
+        light1 += max(dot(N, var_WorldUpLocal) * (1. - specular) * .5, 0);
         
         // Calculate specularity
         vec3 nViewDir = normalize(var_LocalViewerDirection);
         vec3 reflect = - (nViewDir - 2 * N * dot(N, nViewDir));
 
-        float spec = max(dot(reflect, u_WorldUpLocal), 0);
+        float spec = max(dot(reflect, var_WorldUpLocal), 0);
         float specPow = clamp((spec * spec), 0.0, 1.1);
         light1 += vec3(spec * specPow * specPow) * specular * 1.0;
         
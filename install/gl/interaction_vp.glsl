@@ -6,13 +6,14 @@ in vec4 attr_Tangent;   // bound to attribute 9 in source
 in vec4 attr_Bitangent; // bound to attribute 10 in source
 in vec4 attr_Normal;    // bound to attribute 11 in source
 in vec4 attr_Colour;    // bound to attribute 12 in source
+in mat4 attr_ObjectTransform; // bound to attributes 4-7 in source, object to world
+in mat3x4 attr_WorldToObject; // bound to attributes 13-15 in source, the rows of the inverse object transform
 
 uniform vec4 u_ColourModulation;    // vertex colour weight
 uniform vec4 u_ColourAddition;      // constant additive vertex colour value
 uniform mat4 u_ModelViewProjection; // combined modelview and projection matrix
-uniform mat4 u_ObjectTransform;     // object to world
 uniform vec3 u_WorldLightOrigin;    // light origin in world space
-uniform vec3 u_LocalViewOrigin;     // view origin in local space
+uniform vec3 u_WorldViewOrigin;     // view origin in world space
 
 // Texture Matrices (the two top rows of each)
 uniform vec4 u_DiffuseTextureMatrix[2];
@@ -27,16 +28,24 @@ varying vec2 var_TexDiffuse;
 varying vec2 var_TexBump;
 varying vec2 var_TexSpecular;
 
-varying vec3 var_vertex;
 varying vec4 var_tex_atten_xy_z;
 varying mat3 var_mat_os2ts;
 varying vec4 var_Colour; // colour to be multiplied on the final fragment
 varying vec3 var_WorldLightDirection; // direction the light is coming from in world space
 varying vec3 var_LocalViewerDirection; // viewer direction in local space
+varying vec3 var_LocalViewOffset; // local view origin minus the world space vertex
+varying vec3 var_LocalLightOffset; // local light origin minus the world space vertex
+varying vec3 var_LocalWorldLightDirection; // world light direction rotated by the inverse object transform
+varying vec3 var_WorldUpLocal; // world 0,0,1 direction in local space
 
 void main()
 {
-    vec4 worldVertex = u_ObjectTransform * attr_Position;
+    vec4 worldVertex = attr_ObjectTransform * attr_Position;
+
+    // The inverse object transform is calculated per object on the CPU, each column
+    // of attr_WorldToObject holds a row, so it is applied from the right
+    vec3 localViewOrigin = vec4(u_WorldViewOrigin, 1) * attr_WorldToObject;
+    vec3 localLightOrigin = vec4(u_WorldLightOrigin, 1) * attr_WorldToObject;
 
 	// transform vertex position into homogenous clip-space
 	gl_Position = u_ModelViewProjection * worldVertex;
@@ -44,8 +53,15 @@ void main()
     // The position of the vertex in light space (used in shadow mapping)
     var_WorldLightDirection = worldVertex.xyz - u_WorldLightOrigin;
 
-	// assign position in world space
-	var_vertex = worldVertex.xyz;
+    // Used to get the normal's angle to the light direction (the transpose rotates the direction into object space)
+    var_LocalWorldLightDirection = transpose(mat3(attr_ObjectTransform)) * var_WorldLightDirection;
+
+    // These are linear in the vertex position, so interpolating them doesn't change the result
+    var_LocalViewOffset = localViewOrigin - worldVertex.xyz;
+    var_LocalLightOffset = localLightOrigin - worldVertex.xyz;
+
+    // Calculate world up (0,0,1) in object space, this is needed for ambient lights
+    var_WorldUpLocal = vec3(attr_WorldToObject[0].z, attr_WorldToObject[1].z, attr_WorldToObject[2].z);
 
     // Apply the texture matrix to get the texture coords for this vertex
     var_TexDiffuse.x = dot(u_DiffuseTextureMatrix[0], attr_TexCoord);
@@ -68,7 +84,7 @@ void main()
     );
 
     // Calculate the viewer direction in local space (attr_Position is already in local space)
-    var_LocalViewerDirection = u_LocalViewOrigin - attr_Position.xyz;
+    var_LocalViewerDirection = localViewOrigin - attr_Position.xyz;
 
     // Vertex colour factor
     var_Colour = (attr_Colour * u_ColourModulation + u_ColourAddition);
@@ -2,9 +2,9 @@
 
 in vec4 attr_Position; // bound to attribute 0 in source, in object space
 in vec4 attr_TexCoord; // bound to attribute 8 in source
+in mat4 attr_ObjectTransform; // bound to attributes 4-7 in source, object transform (object2world)
 
 uniform vec3 u_LightOrigin;     // light origin in world coords
-uniform mat4 u_ObjectTransform; // object transform (object2world)
 
 // The two top-rows of the diffuse stage texture transformation matrix
 uniform vec4 u_DiffuseTextureMatrix[2];
@@ -55,7 +55,7 @@ void main()
 {
     // Transform the model vertex to world space, then subtract the light origin
     // to move the vertex into light space (with the light residing at 0,0,0)
-    vec4 lightSpacePos = u_ObjectTransform * attr_Position;
+    vec4 lightSpacePos = attr_ObjectTransform * attr_Position;
     lightSpacePos.xyz -= u_LightOrigin;
 
     // Render the vertex 6 times, once for each cubemap face (gl_InstanceID = [0..5])
@@ -2,9 +2,9 @@
 
 in vec4 attr_Position; // bound to attribute 0 in source, in object space
 in vec4 attr_TexCoord; // bound to attribute 8 in source
+in mat4 attr_ObjectTransform; // bound to attributes 4-7 in source, object transform (object2world)
 
 uniform mat4 u_ModelViewProjection; // combined modelview and projection matrix
-uniform mat4 u_ObjectTransform; // object transform (object2world)
 
 // The two top-rows of the diffuse stage texture transformation matrix
 uniform vec4 u_DiffuseTextureMatrix[2];
@@ -16,7 +16,7 @@ void main()
 {
     // Apply the supplied object transform to the incoming vertex
     // transform vertex position into homogenous clip-space
-    gl_Position = u_ModelViewProjection * u_ObjectTransform * attr_Position;
+    gl_Position = u_ModelViewProjection * attr_ObjectTransform * attr_Position;
 
     // Apply the stage texture transform to the incoming tex coord, component wise
     var_TexDiffuse.x = dot(u_DiffuseTextureMatrix[0], attr_TexCoord);
@@ -30,3 +30,20 @@ GlobalSceneGraph.root().traverse(walker)
 
 print('')
 
+
+# Test bulk geometry access, the returned GeometryBuffers support the buffer protocol
+# and can be wrapped by numpy.asarray() without copying
+for brush in GlobalSceneGraph.findBrushes(GlobalSceneGraph.root()):
+	planes = brush.getBrush().getFacePlanes()
+	vertices = memoryview(brush.getBrush().getWindingVertices())
+	print('Brush with ' + str(planes.getShape()[0]) + ' faces and ' + str(vertices.shape[0]) + ' winding vertices')
+
+	# Setting the planes updates the faces in place, face objects stay valid
+	face = brush.getBrush().getFace(0)
+	shader = face.getShader()
+	brush.getBrush().setFacePlanes(planes)
+	print('First face still has shader ' + face.getShader() + ' (was ' + shader + ')')
+
+entities = GlobalSceneGraph.findEntities(GlobalSceneGraph.root())
+origins = memoryview(GlobalSceneGraph.getEntityOrigins(entities))
+print('Found ' + str(len(entities)) + ' entities, origins: ' + str(origins.tolist()))
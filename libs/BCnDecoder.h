@@ -0,0 +1,650 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <future>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "igl.h"
+#include "iimage.h"
+#include "RGBAImage.h"
+
+/**
+ * CPU decompression of block-compressed (BCn) texture data into 8-bit RGBA pixels.
+ *
+ * Covers BC1-BC3 (DXT1/3/5 incl. the RXGB variant of DOOM 3), BC4 and BC5 (RGTC)
+ * as well as BC7 (BPTC). The block routines are written as plain loops over fixed
+ * size arrays, leaving the vectorisation to the compiler. Larger images are split
+ * into bands of block rows which are decoded in parallel.
+ */
+namespace image
+{
+
+enum class BlockFormat
+{
+    BC1,        // DXT1, 1-bit alpha
+    BC2,        // DXT3, explicit 4-bit alpha
+    BC3,        // DXT5, interpolated alpha
+    BC3_RXGB,   // DXT5 with the red channel swizzled into alpha (DOOM 3 normal maps)
+    BC4,        // RGTC1, single channel, decoded to greyscale
+    BC5,        // RGTC2, two channel normal map, Z is reconstructed into blue
+    BC7,        // BPTC
+};
+
+// Number of bytes occupied by one 4x4 block of the given format
+inline std::size_t getBlockSize(BlockFormat format)
+{
+    return format == BlockFormat::BC1 || format == BlockFormat::BC4 ? 8 : 16;
+}
+
+// Number of bytes occupied by an image of the given dimensions
+inline std::size_t getCompressedSize(BlockFormat format, std::size_t width, std::size_t height)
+{
+    return ((width + 3) / 4) * ((height + 3) / 4) * getBlockSize(format);
+}
+
+// Returns the block format corresponding to the given compressed GL format, if supported
+inline std::optional<BlockFormat> getBlockFormat(GLenum glFormat)
+{
+    switch (glFormat)
+    {
+    case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+    case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+        return BlockFormat::BC1;
+    case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:
+        return BlockFormat::BC2;
+    case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+        return BlockFormat::BC3;
+    case GL_COMPRESSED_RED_RGTC1:
+        return BlockFormat::BC4;
+    case GL_COMPRESSED_RG_RGTC2:
+        return BlockFormat::BC5;
+    case GL_COMPRESSED_RGBA_BPTC_UNORM:
+        return BlockFormat::BC7;
+    default:
+        return std::nullopt;
+    }
+}
+
+namespace bcn
+{
+
+// One decoded 4x4 block, 16 RGBA pixels in row-major order
+using PixelBlock = uint8_t[16][4];
+
+inline uint16_t readUInt16(const uint8_t* src)
+{
+    return static_cast<uint16_t>(src[0] | (src[1] << 8));
+}
+
+inline uint64_t readUInt64(const uint8_t* src, std::size_t numBytes)
+{
+    uint64_t value = 0;
+
+    for (std::size_t i = numBytes; i-- > 0;)
+    {
+        value = (value << 8) | src[i];
+    }
+
+    return value;
+}
+
+inline void expand565(uint16_t colour, uint8_t* rgba)
+{
+    auto r = (colour >> 11) & 0x1f;
+    auto g = (colour >> 5) & 0x3f;
+    auto b = colour & 0x1f;
+
+    rgba[0] = static_cast<uint8_t>((r << 3) | (r >> 2));
+    rgba[1] = static_cast<uint8_t>((g << 2) | (g >> 4));
+    rgba[2] = static_cast<uint8_t>((b << 3) | (b >> 2));
+    rgba[3] = 255;
+}
+
+// Decodes the 8 byte colour part of a BC1-BC3 block. The three-colour mode with
+// transparent black is only available to BC1, the other formats always interpolate.
+inline void decodeColourBlock(const uint8_t* src, PixelBlock& out, bool allowPunchThrough)
+{
+    auto c0 = readUInt16(src);
+    auto c1 = readUInt16(src + 2);
+
+    uint8_t palette[4][4];
+    expand565(c0, palette[0]);
+    expand565(c1, palette[1]);
+
+    if (c0 > c1 || !allowPunchThrough)
+    {
+        for (int c = 0; c < 3; ++c)
+        {
+            palette[2][c] = static_cast<uint8_t>((2 * palette[0][c] + palette[1][c]) / 3);
+            palette[3][c] = static_cast<uint8_t>((palette[0][c] + 2 * palette[1][c]) / 3);
+        }
+
+        palette[2][3] = palette[3][3] = 255;
+    }
+    else
+    {
+        for (int c = 0; c < 3; ++c)
+        {
+            palette[2][c] = static_cast<uint8_t>((palette[0][c] + palette[1][c]) / 2);
+            palette[3][c] = 0;
+        }
+
+        palette[2][3] = 255;
+        palette[3][3] = 0;
+    }
+
+    auto indices = static_cast<uint32_t>(readUInt64(src + 4, 4));
+
+    for (int i = 0; i < 16; ++i)
+    {
+        std::memcpy(out[i], palette[(indices >> (2 * i)) & 3], 4);
+    }
+}
+
+// Decodes the 8 byte interpolated single-channel block used by BC3 alpha, BC4 and BC5,
+// writing the 16 values into the given channel of the output block
+inline void decodeInterpolatedBlock(const uint8_t* src, PixelBlock& out, int channel)
+{
+    unsigned v0 = src[0];
+    unsigned v1 = src[1];
+
+    uint8_t values[8] = { static_cast<uint8_t>(v0), static_cast<uint8_t>(v1) };
+
+    if (v0 > v1)
+    {
+        for (unsigned i = 1; i < 7; ++i)
+        {
+            values[i + 1] = static_cast<uint8_t>(((7 - i) * v0 + i * v1) / 7);
+        }
+    }
+    else
+    {
+        for (unsigned i = 1; i < 5; ++i)
+        {
+            values[i + 1] = static_cast<uint8_t>(((5 - i) * v0 + i * v1) / 5);
+        }
+
+        values[6] = 0;
+        values[7] = 255;
+    }
+
+    auto indices = readUInt64(src + 2, 6);
+
+    for (int i = 0; i < 16; ++i)
+    {
+        out[i][channel] = values[(indices >> (3 * i)) & 7];
+    }
+}
+
+// Decodes the explicit 4-bit alpha values of a BC2 block
+inline void decodeExplicitAlphaBlock(const uint8_t* src, PixelBlock& out)
+{
+    auto alpha = readUInt64(src, 8);
+
+    for (int i = 0; i < 16; ++i)
+    {
+        out[i][3] = static_cast<uint8_t>(((alpha >> (4 * i)) & 0xf) * 17);
+    }
+}
+
+inline void decodeBC1(const uint8_t* src, PixelBlock& out)
+{
+    decodeColourBlock(src, out, true);
+}
+
+inline void decodeBC2(const uint8_t* src, PixelBlock& out)
+{
+    decodeColourBlock(src + 8, out, false);
+    decodeExplicitAlphaBlock(src, out);
+}
+
+inline void decodeBC3(const uint8_t* src, PixelBlock& out)
+{
+    decodeColourBlock(src + 8, out, false);
+    decodeInterpolatedBlock(src, out, 3);
+}
+
+inline void decodeBC3RXGB(const uint8_t* src, PixelBlock& out)
+{
+    decodeBC3(src, out);
+
+    for (int i = 0; i < 16; ++i)
+    {
+        out[i][0] = out[i][3];
+        out[i][3] = 255;
+    }
+}
+
+inline void decodeBC4(const uint8_t* src, PixelBlock& out)
+{
+    decodeInterpolatedBlock(src, out, 0);
+
+    for (int i = 0; i < 16; ++i)
+    {
+        out[i][1] = out[i][2] = out[i][0];
+        out[i][3] = 255;
+    }
+}
+
+inline void decodeBC5(const uint8_t* src, PixelBlock& out)
+{
+    decodeInterpolatedBlock(src, out, 0);
+    decodeInterpolatedBlock(src + 8, out, 1);
+
+    // Reconstruct the Z component of the unit-length normal
+    for (int i = 0; i < 16; ++i)
+    {
+        auto x = out[i][0] / 127.5f - 1.0f;
+        auto y = out[i][1] / 127.5f - 1.0f;
+        auto z = std::sqrt(std::max(0.0f, 1.0f - x * x - y * y));
+
+        out[i][2] = static_cast<uint8_t>((z + 1.0f) * 127.5f + 0.5f);
+        out[i][3] = 255;
+    }
+}
+
+// BC7 partition tables, one bit (2 subsets) or two bits (3 subsets) per pixel
+constexpr uint16_t BC7Partitions2[64] =
+{
+    0xcccc, 0x8888, 0xeeee, 0xecc8, 0xc880, 0xfeec, 0xfec8, 0xec80,
+    0xc800, 0xffec, 0xfe80, 0xe800, 0xffe8, 0xff00, 0xfff0, 0xf000,
+    0xf710, 0x008e, 0x7100, 0x08ce, 0x008c, 0x7310, 0x3100, 0x8cce,
+    0x088c, 0x3110, 0x6666, 0x366c, 0x17e8, 0x0ff0, 0x718e, 0x399c,
+    0xaaaa, 0xf0f0, 0x5a5a, 0x33cc, 0x3c3c, 0x55aa, 0x9696, 0xa55a,
+    0x73ce, 0x13c8, 0x324c, 0x3bdc, 0x6996, 0xc33c, 0x9966, 0x0660,
+    0x0272, 0x04e4, 0x4e40, 0x2720, 0xc936, 0x936c, 0x39c6, 0x639c,
+    0x9336, 0x9cc6, 0x817e, 0xe718, 0xccf0, 0x0fcc, 0x7744, 0xee22,
+};
+
+constexpr uint32_t BC7Partitions3[64] =
+{
+    0xaa685050, 0x6a5a5040, 0x5a5a4200, 0x5450a0a8, 0xa5a50000, 0xa0a05050, 0x5555a0a0, 0x5a5a5050,
+    0xaa550000, 0xaa555500, 0xaaaa5500, 0x90909090, 0x94949494, 0xa4a4a4a4, 0xa9a59450, 0x2a0a4250,
+    0xa5945040, 0x0a425054, 0xa5a5a500, 0x55a0a0a0, 0xa8a85454, 0x6a6a4040, 0xa4a45000, 0x1a1a0500,
+    0x0050a4a4, 0xaaa59090, 0x14696914, 0x69691400, 0xa08585a0, 0xaa821414, 0x50a4a450, 0x6a5a0200,
+    0xa9a58000, 0x5090a0a8, 0xa8a09050, 0x24242424, 0x00aa5500, 0x24924924, 0x24499224, 0x50a50a50,
+    0x500aa550, 0xaaaa4444, 0x66660000, 0xa5a0a5a0, 0x50a050a0, 0x69286928, 0x44aaaa44, 0x66666600,
+    0xaa444444, 0x54a854a8, 0x95809580, 0x96969600, 0xa85454a8, 0x80959580, 0xaa141414, 0x96960000,
+    0xaaaa1414, 0xa05050a0, 0xa0a5a5a0, 0x96000000, 0x40804080, 0xa9a8a9a8, 0xaaaaaa44, 0x2a4a5254,
+};
+
+// Anchor pixel of the second subset in two-subset partitions
+constexpr uint8_t BC7Anchors2[64] =
+{
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+    15,  2,  8,  2,  2,  8,  8, 15,  2,  8,  2,  2,  8,  8,  2,  2,
+    15, 15,  6,  8,  2,  8, 15, 15,  2,  8,  2,  2,  2, 15, 15,  6,
+     6,  2,  6,  8, 15, 15,  2,  2, 15, 15, 15, 15, 15,  2,  2, 15,
+};
+
+// Anchor pixels of the second and third subset in three-subset partitions
+constexpr uint8_t BC7Anchors3[2][64] =
+{
+    {
+         3,  3, 15, 15,  8,  3, 15, 15,  8,  8,  6,  6,  6,  5,  3,  3,
+         3,  3,  8, 15,  3,  3,  6, 10,  5,  8,  8,  6,  8,  5, 15, 15,
+         8, 15,  3,  5,  6, 10,  8, 15, 15,  3, 15,  5, 15, 15, 15, 15,
+         3, 15,  5,  5,  5,  8,  5, 10,  5, 10,  8, 13, 15, 12,  3,  3,
+    },
+    {
+        15,  8,  8,  3, 15, 15,  3,  8, 15, 15, 15, 15, 15, 15, 15,  8,
+        15,  8, 15,  3, 15,  8, 15,  8,  3, 15,  6, 10, 15, 15, 10,  8,
+        15,  3, 15, 10, 10,  8,  9, 10,  6, 15,  8, 15,  3,  6,  6,  8,
+        15,  3, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  3, 15, 15,  8,
+    },
+};
+
+// Interpolation weights for 2, 3 and 4 bit indices
+constexpr uint8_t BC7Weights2[4] = { 0, 21, 43, 64 };
+constexpr uint8_t BC7Weights3[8] = { 0, 9, 18, 27, 37, 46, 55, 64 };
+constexpr uint8_t BC7Weights4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+struct BC7Mode
+{
+    uint8_t numSubsets;
+    uint8_t partitionBits;
+    uint8_t rotationBits;
+    uint8_t indexSelectionBits;
+    uint8_t colourBits;
+    uint8_t alphaBits;
+    uint8_t endpointPBits;  // one p-bit per endpoint
+    uint8_t sharedPBits;    // one p-bit per subset
+    uint8_t indexBits;
+    uint8_t secondaryIndexBits;
+};
+
+constexpr BC7Mode BC7Modes[8] =
+{
+    { 3, 4, 0, 0, 4, 0, 1, 0, 3, 0 },
+    { 2, 6, 0, 0, 6, 0, 0, 1, 3, 0 },
+    { 3, 6, 0, 0, 5, 0, 0, 0, 2, 0 },
+    { 2, 6, 0, 0, 7, 0, 1, 0, 2, 0 },
+    { 1, 0, 2, 1, 5, 6, 0, 0, 2, 3 },
+    { 1, 0, 2, 0, 7, 8, 0, 0, 2, 2 },
+    { 1, 0, 0, 0, 7, 7, 1, 0, 4, 0 },
+    { 2, 6, 0, 0, 5, 5, 1, 0, 2, 0 },
+};
+
+// Reads bit fields from a 128 bit block, starting at the least significant bit
+class BitReader
+{
+private:
+    uint64_t _low;
+    uint64_t _high;
+    unsigned _position = 0;
+
+public:
+    BitReader(const uint8_t* src) :
+        _low(readUInt64(src, 8)),
+        _high(readUInt64(src + 8, 8))
+    {}
+
+    unsigned read(unsigned numBits)
+    {
+        if (numBits == 0) return 0;
+
+        uint64_t value;
+
+        if (_position >= 64)
+        {
+            value = _high >> (_position - 64);
+        }
+        else if (_position + numBits <= 64)
+        {
+            value = _low >> _position;
+        }
+        else
+        {
+            value = (_low >> _position) | (_high << (64 - _position));
+        }
+
+        _position += numBits;
+        return static_cast<unsigned>(value & ((uint64_t(1) << numBits) - 1));
+    }
+};
+
+inline uint8_t getBC7Weight(unsigned numBits, unsigned index)
+{
+    return numBits == 2 ? BC7Weights2[index] : numBits == 3 ? BC7Weights3[index] : BC7Weights4[index];
+}
+
+inline uint8_t interpolateBC7(unsigned e0, unsigned e1, unsigned weight)
+{
+    return static_cast<uint8_t>(((64 - weight) * e0 + weight * e1 + 32) >> 6);
+}
+
+inline void decodeBC7(const uint8_t* src, PixelBlock& out)
+{
+    BitReader bits(src);
+
+    // The mode is encoded as the position of the lowest set bit
+    unsigned modeIndex = 0;
+    while (modeIndex < 8 && bits.read(1) == 0) ++modeIndex;
+
+    if (modeIndex == 8)
+    {
+        // Reserved mode, decodes to transparent black
+        std::memset(out, 0, sizeof(PixelBlock));
+        return;
+    }
+
+    const auto& mode = BC7Modes[modeIndex];
+
+    auto partition = bits.read(mode.partitionBits);
+    auto rotation = bits.read(mode.rotationBits);
+    auto indexSelection = bits.read(mode.indexSelectionBits);
+
+    // Endpoints are stored channel by channel
+    unsigned numEndpoints = mode.numSubsets * 2u;
+    unsigned endpoints[6][4] = {};
+
+    for (int c = 0; c < 3; ++c)
+    {
+        for (unsigned e = 0; e < numEndpoints; ++e)
+        {
+            endpoints[e][c] = bits.read(mode.colourBits);
+        }
+    }
+
+    for (unsigned e = 0; e < numEndpoints && mode.alphaBits > 0; ++e)
+    {
+        endpoints[e][3] = bits.read(mode.alphaBits);
+    }
+
+    unsigned colourBits = mode.colourBits;
+    unsigned alphaBits = mode.alphaBits;
+
+    if (mode.endpointPBits || mode.sharedPBits)
+    {
+        unsigned pBits[6];
+
+        if (mode.endpointPBits)
+        {
+            for (unsigned e = 0; e < numEndpoints; ++e) pBits[e] = bits.read(1);
+        }
+        else
+        {
+            for (unsigned s = 0; s < mode.numSubsets; ++s) pBits[s * 2] = pBits[s * 2 + 1] = bits.read(1);
+        }
+
+        for (unsigned e = 0; e < numEndpoints; ++e)
+        {
+            for (int c = 0; c < 4; ++c)
+            {
+                endpoints[e][c] = (endpoints[e][c] << 1) | pBits[e];
+            }
+        }
+
+        ++colourBits;
+        if (alphaBits > 0) ++alphaBits;
+    }
+
+    // Expand the endpoints to 8 bits by replicating the most significant bits
+    for (unsigned e = 0; e < numEndpoints; ++e)
+    {
+        for (int c = 0; c < 3; ++c)
+        {
+            endpoints[e][c] = (endpoints[e][c] << (8 - colourBits)) | (endpoints[e][c] >> (2 * colourBits - 8));
+        }
+
+        endpoints[e][3] = alphaBits > 0 ?
+            (endpoints[e][3] << (8 - alphaBits)) | (endpoints[e][3] >> (2 * alphaBits - 8)) : 255;
+    }
+
+    unsigned subsets[16];
+    unsigned anchors[3] = { 0, 0, 0 };
+
+    for (int i = 0; i < 16; ++i)
+    {
+        subsets[i] = mode.numSubsets == 1 ? 0 :
+            mode.numSubsets == 2 ? (BC7Partitions2[partition] >> i) & 1 :
+            (BC7Partitions3[partition] >> (2 * i)) & 3;
+    }
+
+    if (mode.numSubsets == 2)
+    {
+        anchors[1] = BC7Anchors2[partition];
+    }
+    else if (mode.numSubsets == 3)
+    {
+        anchors[1] = BC7Anchors3[0][partition];
+        anchors[2] = BC7Anchors3[1][partition];
+    }
+
+    // The most significant bit of each anchor index is implicitly zero
+    unsigned indices[16];
+    unsigned secondaryIndices[16] = {};
+
+    for (unsigned i = 0; i < 16; ++i)
+    {
+        indices[i] = bits.read(mode.indexBits - (anchors[subsets[i]] == i ? 1 : 0));
+    }
+
+    for (unsigned i = 0; i < 16 && mode.secondaryIndexBits > 0; ++i)
+    {
+        secondaryIndices[i] = bits.read(mode.secondaryIndexBits - (i == 0 ? 1 : 0));
+    }
+
+    for (int i = 0; i < 16; ++i)
+    {
+        const auto& e0 = endpoints[subsets[i] * 2];
+        const auto& e1 = endpoints[subsets[i] * 2 + 1];
+
+        auto colourWeight = getBC7Weight(mode.indexBits, indices[i]);
+        auto alphaWeight = colourWeight;
+
+        if (mode.secondaryIndexBits > 0)
+        {
+            auto secondaryWeight = getBC7Weight(mode.secondaryIndexBits, secondaryIndices[i]);
+
+            if (indexSelection == 0)
+            {
+                alphaWeight = secondaryWeight;
+            }
+            else
+            {
+                alphaWeight = colourWeight;
+                colourWeight = secondaryWeight;
+            }
+        }
+
+        for (int c = 0; c < 3; ++c)
+        {
+            out[i][c] = interpolateBC7(e0[c], e1[c], colourWeight);
+        }
+
+        out[i][3] = interpolateBC7(e0[3], e1[3], alphaWeight);
+
+        if (rotation > 0)
+        {
+            std::swap(out[i][3], out[i][rotation - 1]);
+        }
+    }
+}
+
+using BlockDecodeFunction = void(*)(const uint8_t*, PixelBlock&);
+
+inline BlockDecodeFunction getBlockDecodeFunction(BlockFormat format)
+{
+    switch (format)
+    {
+    case BlockFormat::BC1: return decodeBC1;
+    case BlockFormat::BC2: return decodeBC2;
+    case BlockFormat::BC3: return decodeBC3;
+    case BlockFormat::BC3_RXGB: return decodeBC3RXGB;
+    case BlockFormat::BC4: return decodeBC4;
+    case BlockFormat::BC5: return decodeBC5;
+    case BlockFormat::BC7: return decodeBC7;
+    }
+
+    return nullptr;
+}
+
+// Decodes the block rows [firstRow, lastRow) of the image, clipping the blocks at the image borders
+inline void decodeBlockRows(BlockDecodeFunction decodeBlock, std::size_t blockSize, const uint8_t* blocks,
+    std::size_t width, std::size_t height, uint8_t* rgba, std::size_t firstRow, std::size_t lastRow)
+{
+    auto blocksPerRow = (width + 3) / 4;
+
+    for (auto blockY = firstRow; blockY < lastRow; ++blockY)
+    {
+        auto numRows = std::min<std::size_t>(4, height - blockY * 4);
+        const auto* src = blocks + blockY * blocksPerRow * blockSize;
+
+        for (std::size_t blockX = 0; blockX < blocksPerRow; ++blockX, src += blockSize)
+        {
+            PixelBlock pixels;
+            decodeBlock(src, pixels);
+
+            auto numColumns = std::min<std::size_t>(4, width - blockX * 4);
+
+            for (std::size_t row = 0; row < numRows; ++row)
+            {
+                std::memcpy(rgba + ((blockY * 4 + row) * width + blockX * 4) * 4, pixels[row * 4], numColumns * 4);
+            }
+        }
+    }
+}
+
+// Images with fewer blocks than this are decoded on the calling thread
+constexpr std::size_t MinBlocksPerTask = 4096;
+
+} // namespace bcn
+
+/**
+ * Decodes width x height pixels of the given block-compressed data into the
+ * RGBA target buffer, which needs to provide width * height * 4 bytes.
+ * The block data needs to be getCompressedSize(format, width, height) bytes long.
+ */
+inline void decodeBlocks(BlockFormat format, const uint8_t* blocks, std::size_t width, std::size_t height, uint8_t* rgba)
+{
+    auto decodeBlock = bcn::getBlockDecodeFunction(format);
+    auto blockSize = getBlockSize(format);
+
+    auto numBlockRows = (height + 3) / 4;
+    auto numBlocks = numBlockRows * ((width + 3) / 4);
+
+    auto numTasks = std::min<std::size_t>(std::max(std::thread::hardware_concurrency(), 1u),
+        std::min(numBlockRows, numBlocks / bcn::MinBlocksPerTask));
+
+    if (numTasks <= 1)
+    {
+        bcn::decodeBlockRows(decodeBlock, blockSize, blocks, width, height, rgba, 0, numBlockRows);
+        return;
+    }
+
+    // Split the image into bands of block rows, the last band is decoded on this thread
+    auto rowsPerTask = (numBlockRows + numTasks - 1) / numTasks;
+    std::vector<std::future<void>> tasks;
+
+    for (std::size_t firstRow = 0; firstRow + rowsPerTask < numBlockRows; firstRow += rowsPerTask)
+    {
+        tasks.emplace_back(std::async(std::launch::async, [=]()
+        {
+            bcn::decodeBlockRows(decodeBlock, blockSize, blocks, width, height, rgba, firstRow, firstRow + rowsPerTask);
+        }));
+    }
+
+    bcn::decodeBlockRows(decodeBlock, blockSize, blocks, width, height, rgba, tasks.size() * rowsPerTask, numBlockRows);
+
+    for (auto& task : tasks)
+    {
+        task.get();
+    }
+}
+
+/**
+ * Decompresses the given mipmap level of a precompressed image into a new RGBA image.
+ * Returns an empty pointer if the image is not compressed using one of the supported formats.
+ * The mipmap levels are expected to be stored consecutively, starting at getPixels().
+ */
+inline std::shared_ptr<RGBAImage> decompressImage(const Image& image, std::size_t level = 0)
+{
+    if (!image.isPrecompressed() || level >= image.getLevels()) return {};
+
+    auto format = getBlockFormat(image.getGLFormat());
+
+    if (!format) return {};
+
+    std::size_t offset = 0;
+
+    for (std::size_t i = 0; i < level; ++i)
+    {
+        offset += getCompressedSize(*format, image.getWidth(i), image.getHeight(i));
+    }
+
+    auto width = image.getWidth(level);
+    auto height = image.getHeight(level);
+
+    auto result = std::make_shared<RGBAImage>(width, height);
+    decodeBlocks(*format, image.getPixels() + offset, width, height, result->getPixels());
+
+    return result;
+}
+
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <string>
+#include "itracecollector.h"
+
+namespace profiling
+{
+
+/**
+ * Records the lifetime of this object as timed zone in the performance trace.
+ * Does nothing (apart from a single check) if tracing is disabled at the time
+ * of construction.
+ *
+ * Category and name need to be string literals, the optional detail string
+ * (e.g. a file or module name) is only copied when tracing is enabled.
+ */
+class ScopedTraceZone
+{
+private:
+    ITraceCollector* _collector;
+    const char* _category;
+    const char* _name;
+    std::string _detail;
+    ITraceCollector::Clock::time_point _start;
+
+public:
+    ScopedTraceZone(const char* category, const char* name) :
+        _collector(nullptr),
+        _category(category),
+        _name(name)
+    {
+        auto& collector = GlobalTraceCollector();
+
+        if (collector.isEnabled())
+        {
+            _collector = &collector;
+            _start = ITraceCollector::Clock::now();
+        }
+    }
+
+    ScopedTraceZone(const char* category, const char* name, const std::string& detail) :
+        ScopedTraceZone(category, name)
+    {
+        if (_collector)
+        {
+            _detail = detail;
+        }
+    }
+
+    ScopedTraceZone(const ScopedTraceZone& other) = delete;
+    ScopedTraceZone& operator=(const ScopedTraceZone& other) = delete;
+
+    ~ScopedTraceZone()
+    {
+        if (_collector)
+        {
+            _collector->recordZone(_category, _name, _detail.empty() ? nullptr : _detail.c_str(),
+                _start, ITraceCollector::Clock::now());
+        }
+    }
+};
+
+// Records the current value of the named counter, if tracing is enabled
+inline void recordTraceCounter(const char* name, double value)
+{
+    auto& collector = GlobalTraceCollector();
+
+    if (collector.isEnabled())
+    {
+        collector.recordCounter(name, value);
+    }
+}
+
+}
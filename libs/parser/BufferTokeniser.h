@@ -0,0 +1,216 @@
+#pragma once
+
+#include "DefTokeniser.h"
+
+#include <charconv>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace parser
+{
+
+/**
+ * Lightweight DefTokeniser working on an in-memory character buffer.
+ *
+ * Splits tokens on whitespace and returns the characters "{}()" as tokens
+ * of their own, C and C++ style comments are skipped and quoted content is
+ * returned without the quotes, matching the behaviour of the BasicDefTokeniser
+ * for the common case.
+ *
+ * On top of the regular DefTokeniser interface, this class offers a numeric
+ * fast path: nextNumber<T>() converts the next token directly from the buffer
+ * without constructing any intermediate std::string, which makes it suitable
+ * for large files that are mostly made of numbers (like AAS files).
+ *
+ * The buffer is not owned by the tokeniser and must outlive it.
+ */
+class BufferTokeniser :
+    public DefTokeniser
+{
+private:
+    const char* _pos;
+    const char* _end;
+
+public:
+    BufferTokeniser(const char* buffer, std::size_t length) :
+        _pos(buffer),
+        _end(buffer + length)
+    {
+        skipWhitespaceAndComments();
+    }
+
+    BufferTokeniser(std::string_view buffer) :
+        BufferTokeniser(buffer.data(), buffer.size())
+    {}
+
+    bool hasMoreTokens() const override
+    {
+        return _pos < _end;
+    }
+
+    std::string nextToken() override
+    {
+        auto token = nextTokenView();
+        return std::string(token.data(), token.size());
+    }
+
+    std::string peek() const override
+    {
+        BufferTokeniser copy(*this);
+        return copy.nextToken();
+    }
+
+    // Compares the next token to the given value without allocating
+    void assertNextToken(const std::string& val) override
+    {
+        auto token = nextTokenView();
+
+        if (token != val)
+        {
+            throw ParseException("BufferTokeniser: Assertion failed: Required \""
+                + val + "\", found \"" + std::string(token) + "\"");
+        }
+    }
+
+    void skipTokens(unsigned int n) override
+    {
+        for (unsigned int i = 0; i < n; i++)
+        {
+            nextTokenView();
+        }
+    }
+
+    /**
+     * Returns the next token as view into the underlying buffer.
+     * The view stays valid as long as the buffer is alive.
+     */
+    std::string_view nextTokenView()
+    {
+        if (!hasMoreTokens())
+        {
+            throw ParseException("BufferTokeniser: no more tokens");
+        }
+
+        std::string_view token;
+
+        if (isKeptDelim(*_pos))
+        {
+            token = std::string_view(_pos++, 1);
+        }
+        else if (*_pos == '"')
+        {
+            auto start = ++_pos;
+
+            while (_pos < _end && *_pos != '"') ++_pos;
+
+            token = std::string_view(start, _pos - start);
+
+            if (_pos < _end) ++_pos; // skip the closing quote
+        }
+        else
+        {
+            auto start = _pos;
+
+            while (_pos < _end && !isWhitespace(*_pos) && !isKeptDelim(*_pos)) ++_pos;
+
+            token = std::string_view(start, _pos - start);
+        }
+
+        skipWhitespaceAndComments();
+
+        return token;
+    }
+
+    /**
+     * Parses the next token as number of the given type (integral or
+     * floating point), directly from the buffer. Throws a ParseException
+     * if the token is not a valid number.
+     */
+    template<typename T>
+    T nextNumber()
+    {
+        auto token = nextTokenView();
+
+        T value;
+        auto first = token.data();
+
+        // std::from_chars doesn't accept a leading plus sign
+        if (!token.empty() && *first == '+') ++first;
+
+        auto [ptr, ec] = std::from_chars(first, token.data() + token.size(), value);
+
+        if (ec != std::errc() || ptr != token.data() + token.size())
+        {
+            throw ParseException("BufferTokeniser: Cannot convert \"" + std::string(token) + "\" to a number");
+        }
+
+        return value;
+    }
+
+    /**
+     * Skips all tokens up to and including the next closing brace,
+     * taking nested blocks into account. The opening brace is expected
+     * to have been consumed already.
+     */
+    void skipBlock()
+    {
+        std::size_t depth = 1;
+
+        while (hasMoreTokens())
+        {
+            auto token = nextTokenView();
+
+            if (token == "{")
+            {
+                ++depth;
+            }
+            else if (token == "}" && --depth == 0)
+            {
+                return;
+            }
+        }
+
+        throw ParseException("BufferTokeniser: missing closing brace");
+    }
+
+private:
+    static bool isWhitespace(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\0';
+    }
+
+    static bool isKeptDelim(char c)
+    {
+        return c == '{' || c == '}' || c == '(' || c == ')';
+    }
+
+    void skipWhitespaceAndComments()
+    {
+        while (_pos < _end)
+        {
+            if (isWhitespace(*_pos))
+            {
+                ++_pos;
+            }
+            else if (*_pos == '/' && _pos + 1 < _end && _pos[1] == '/')
+            {
+                while (_pos < _end && *_pos != '\n') ++_pos;
+            }
+            else if (*_pos == '/' && _pos + 1 < _end && _pos[1] == '*')
+            {
+                _pos += 2;
+
+                while (_pos + 1 < _end && !(_pos[0] == '*' && _pos[1] == '/')) ++_pos;
+
+                _pos = _pos + 1 < _end ? _pos + 2 : _end;
+            }
+            else
+            {
+                break;
+            }
+        }
+    }
+};
+
+}
@@ -0,0 +1,279 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "itextstream.h"
+#include "DefBlockTokeniser.h"
+#include "os/fs.h"
+
+namespace parser
+{
+
+/**
+ * Persistent binary cache of the blocks found in declaration files, such that
+ * the files don't need to be read and tokenised again as long as they're
+ * unchanged. Each record is keyed by the file's VFS path and remembers the
+ * stamp (path on disk, modification time and size of the file or the PK4
+ * containing it) it has been created from, a record with a different stamp
+ * is treated as missing.
+ *
+ * The cache file is loaded in one go on first access. save() only keeps the
+ * records that have been looked up or inserted since the cache was loaded
+ * (or last saved), records of files that are gone are dropped this way.
+ *
+ * Not thread-safe, each cache is meant to be used by a single decl parser.
+ */
+class DeclBlockCache
+{
+public:
+    using Blocks = std::vector<BlockTokeniser::Block>;
+
+    struct Record
+    {
+        std::string stamp;
+
+        // The mod the file has been found in
+        std::string modName;
+
+        Blocks blocks;
+
+        // True if this record has been used since the cache was loaded or saved
+        bool used = false;
+    };
+
+private:
+    // Changing the version discards all existing cache files
+    static constexpr uint32_t Version = 1;
+    static constexpr const char* const Magic = "DRDeclBlocks";
+
+    std::string _filename;
+
+    // Records by VFS path
+    std::map<std::string, Record> _records;
+
+    bool _loaded;
+    bool _modified;
+
+public:
+    DeclBlockCache(const std::string& filename) :
+        _filename(filename),
+        _loaded(false),
+        _modified(false)
+    {}
+
+    // Returns the record of the given file, if it has been created from a file with the same stamp
+    const Record* find(const std::string& path, const std::string& stamp)
+    {
+        ensureLoaded();
+
+        auto found = _records.find(path);
+
+        if (found == _records.end() || stamp.empty() || found->second.stamp != stamp)
+        {
+            return nullptr;
+        }
+
+        found->second.used = true;
+        return &found->second;
+    }
+
+    void insert(const std::string& path, const std::string& stamp, const std::string& modName, Blocks blocks)
+    {
+        if (stamp.empty()) return;
+
+        ensureLoaded();
+
+        _records[path] = Record{ stamp, modName, std::move(blocks), true };
+        _modified = true;
+    }
+
+    // Drops the records that haven't been used since the cache was loaded or saved,
+    // and writes the remaining ones to disk if anything changed
+    void save()
+    {
+        if (_filename.empty()) return;
+
+        ensureLoaded();
+
+        for (auto i = _records.begin(); i != _records.end();)
+        {
+            if (!i->second.used)
+            {
+                i = _records.erase(i);
+                _modified = true;
+                continue;
+            }
+
+            i->second.used = false;
+            ++i;
+        }
+
+        if (!_modified) return;
+
+        std::error_code ec;
+        fs::create_directories(fs::path(_filename).parent_path(), ec);
+
+        // Write to a temporary file first, a partially written cache is worse than none
+        auto temporaryFilename = _filename + ".tmp";
+
+        {
+            std::ofstream stream(temporaryFilename, std::ios::binary);
+
+            if (!stream)
+            {
+                rWarning() << "Cannot write decl cache to " << temporaryFilename << std::endl;
+                return;
+            }
+
+            stream.write(Magic, std::strlen(Magic));
+            writeInt(stream, Version);
+            writeInt(stream, static_cast<uint32_t>(_records.size()));
+
+            for (const auto& [path, record] : _records)
+            {
+                writeString(stream, path);
+                writeString(stream, record.stamp);
+                writeString(stream, record.modName);
+                writeInt(stream, static_cast<uint32_t>(record.blocks.size()));
+
+                for (const auto& block : record.blocks)
+                {
+                    writeString(stream, block.name);
+                    writeString(stream, block.contents);
+                }
+            }
+
+            if (!stream)
+            {
+                rWarning() << "Failed to write decl cache to " << temporaryFilename << std::endl;
+                stream.close();
+                fs::remove(temporaryFilename, ec);
+                return;
+            }
+        }
+
+        fs::rename(temporaryFilename, _filename, ec);
+
+        if (ec)
+        {
+            rWarning() << "Cannot replace decl cache " << _filename << ": " << ec.message() << std::endl;
+            fs::remove(temporaryFilename, ec);
+            return;
+        }
+
+        _modified = false;
+    }
+
+private:
+    void ensureLoaded()
+    {
+        if (_loaded || _filename.empty()) return;
+
+        _loaded = true;
+
+        std::ifstream stream(_filename, std::ios::binary);
+
+        if (!stream) return;
+
+        // Read the whole file at once, the records are decoded from memory
+        std::string buffer((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+
+        const char* cur = buffer.data();
+        const char* end = cur + buffer.size();
+
+        auto magicLength = std::strlen(Magic);
+        uint32_t version = 0;
+        uint32_t numRecords = 0;
+
+        if (static_cast<std::size_t>(end - cur) < magicLength || std::memcmp(cur, Magic, magicLength) != 0)
+        {
+            return;
+        }
+
+        cur += magicLength;
+
+        if (!readInt(cur, end, version) || version != Version || !readInt(cur, end, numRecords))
+        {
+            return;
+        }
+
+        std::map<std::string, Record> records;
+
+        for (uint32_t i = 0; i < numRecords; ++i)
+        {
+            std::string path;
+            Record record;
+            uint32_t numBlocks = 0;
+
+            if (!readString(cur, end, path) || !readString(cur, end, record.stamp) ||
+                !readString(cur, end, record.modName) || !readInt(cur, end, numBlocks) ||
+                numBlocks > static_cast<std::size_t>(end - cur) / 8) // two lengths per block
+            {
+                rWarning() << "Discarding corrupt decl cache " << _filename << std::endl;
+                return;
+            }
+
+            record.blocks.resize(numBlocks);
+
+            for (auto& block : record.blocks)
+            {
+                if (!readString(cur, end, block.name) || !readString(cur, end, block.contents))
+                {
+                    rWarning() << "Discarding corrupt decl cache " << _filename << std::endl;
+                    return;
+                }
+            }
+
+            records.emplace(std::move(path), std::move(record));
+        }
+
+        _records = std::move(records);
+    }
+
+    static void writeInt(std::ostream& stream, uint32_t value)
+    {
+        // Little endian, independent of the platform
+        char bytes[4] =
+        {
+            static_cast<char>(value & 0xff), static_cast<char>((value >> 8) & 0xff),
+            static_cast<char>((value >> 16) & 0xff), static_cast<char>((value >> 24) & 0xff)
+        };
+
+        stream.write(bytes, 4);
+    }
+
+    static void writeString(std::ostream& stream, const std::string& value)
+    {
+        writeInt(stream, static_cast<uint32_t>(value.size()));
+        stream.write(value.data(), value.size());
+    }
+
+    static bool readInt(const char*& cur, const char* end, uint32_t& value)
+    {
+        if (end - cur < 4) return false;
+
+        auto bytes = reinterpret_cast<const unsigned char*>(cur);
+        value = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+
+        cur += 4;
+        return true;
+    }
+
+    static bool readString(const char*& cur, const char* end, std::string& value)
+    {
+        uint32_t length = 0;
+
+        if (!readInt(cur, end, length) || static_cast<std::size_t>(end - cur) < length) return false;
+
+        value.assign(cur, length);
+        cur += length;
+        return true;
+    }
+};
+
+}
@@ -1,11 +1,22 @@
 #pragma once
 
+#include <map>
+#include <memory>
+#include <set>
+#include <fmt/format.h>
+#include "imodule.h"
 #include "ifilesystem.h"
 #include "itextstream.h"
 #include "idecltypes.h"
 #include "ThreadedDefLoader.h"
 #include "debugging/ScopedDebugTimer.h"
+#include "debugging/ScopedTraceZone.h"
 #include "parser/ParseException.h"
+#include "parser/DefBlockTokeniser.h"
+#include "parser/DeclBlockCache.h"
+#include "os/fs.h"
+#include "os/path.h"
+#include "string/case_conv.h"
 
 namespace parser
 {
@@ -13,6 +24,13 @@ namespace parser
 /**
  * Threaded declaration parser, visiting all files associated to the given
  * decl type, processing the files in the correct order.
+ *
+ * The modification stamps of the processed files are recorded, such that
+ * subclasses can find and re-parse the files that changed since the last run.
+ *
+ * Subclasses either process each file stream in parse(), or each of the
+ * file's blocks in parseBlock(). The latter can enable the DeclBlockCache,
+ * which restores the blocks of unchanged files without tokenising them again.
  */
 template <typename ReturnType>
 class ThreadedDeclParser :
@@ -24,17 +42,50 @@ private:
     std::string _extension;
     std::size_t _depth;
 
+    // Modification stamps of the files processed so far, by full VFS path
+    std::map<std::string, std::string> _fileStamps;
+
+    bool _useBlockCache;
+    std::unique_ptr<DeclBlockCache> _blockCache;
+
+    // Number of decl blocks handed to parseBlock() during the current run
+    std::size_t _numParsedBlocks;
+
 protected:
+    // The files that have been added, modified or removed since they were last processed
+    struct FileChanges
+    {
+        // Added or modified files, sorted by name
+        std::vector<vfs::FileInfo> changedFiles;
+
+        // Full VFS paths of the files that are gone
+        std::set<std::string> removedFiles;
+
+        bool empty() const
+        {
+            return changedFiles.empty() && removedFiles.empty();
+        }
+    };
+
     // Construct a parser traversing all files matching the given extension in the given VFS path
-    // Subclasses need to implement the parse(std::istream) overload for this scenario
+    // Subclasses need to implement either the parse(std::istream) overload or parseBlock()
     ThreadedDeclParser(decl::Type declType, const std::string& baseDir, const std::string& extension, std::size_t depth = 1) :
         util::ThreadedDefLoader<ReturnType>(std::bind(&ThreadedDeclParser::doParse, this)),
         _baseDir(baseDir),
         _extension(extension),
         _depth(depth),
-        _declType(declType)
+        _declType(declType),
+        _useBlockCache(false),
+        _numParsedBlocks(0)
     {}
 
+    // To be called by subclasses implementing parseBlock(), the blocks of each file are stored
+    // in the cache folder then, and restored from there as long as the file doesn't change
+    void useBlockCache()
+    {
+        _useBlockCache = true;
+    }
+
 public:
     virtual ~ThreadedDeclParser()
     {}
@@ -59,37 +110,124 @@ protected:
         return onFinishParsing();
     }
 
-    // Parse all decls found in the given stream, to be implemented by subclasses
-    virtual void parse(std::istream& stream, const vfs::FileInfo& fileInfo, const std::string& modDir) = 0;
+    // Parse all decls found in the given stream, passes each block to parseBlock() by default
+    virtual void parse(std::istream& stream, const vfs::FileInfo& fileInfo, const std::string& modDir)
+    {
+        BasicDefBlockTokeniser<std::istream> tokeniser(stream);
+
+        while (tokeniser.hasMoreBlocks())
+        {
+            parseBlock(tokeniser.nextBlock(), fileInfo, modDir);
+            ++_numParsedBlocks;
+        }
+    }
+
+    // Parse the decl contained in the given block
+    virtual void parseBlock(const BlockTokeniser::Block& block, const vfs::FileInfo& fileInfo, const std::string& modDir)
+    {}
 
     void processFiles()
     {
         ScopedDebugTimer timer("[DeclParser] Parsed " + decl::getTypeName(_declType) + " declarations");
+        profiling::ScopedTraceZone zone("decl", "ThreadedDeclParser::processFiles", decl::getTypeName(_declType));
+
+        _fileStamps.clear();
+
+        processFiles(collectFiles());
+
+        if (_blockCache)
+        {
+            _blockCache->save();
+        }
+    }
+
+    // Compares the files in the VFS against the ones processed so far
+    FileChanges findChangedFiles()
+    {
+        FileChanges changes;
+
+        std::set<std::string> existingFiles;
+
+        for (const auto& fileInfo : collectFiles())
+        {
+            auto fullPath = fileInfo.fullPath();
+            auto stamp = _fileStamps.find(fullPath);
+
+            if (stamp == _fileStamps.end() || stamp->second != GetStamp(fileInfo))
+            {
+                changes.changedFiles.push_back(fileInfo);
+            }
+
+            existingFiles.insert(fullPath);
+        }
+
+        for (const auto& [fullPath, stamp] : _fileStamps)
+        {
+            if (existingFiles.count(fullPath) == 0)
+            {
+                changes.removedFiles.insert(fullPath);
+            }
+        }
+
+        return changes;
+    }
+
+    // Re-parses the changed files (in the given order) and forgets about the removed ones
+    void processChangedFiles(const FileChanges& changes)
+    {
+        for (const auto& fullPath : changes.removedFiles)
+        {
+            _fileStamps.erase(fullPath);
+        }
+
+        processFiles(changes.changedFiles);
+    }
 
-        // Accumulate all the files and sort them before calling the protected parse() method
-        std::vector<vfs::FileInfo> _incomingFiles;
-        _incomingFiles.reserve(200);
+    // Returns all files associated to the decl type, sorted by name
+    std::vector<vfs::FileInfo> collectFiles()
+    {
+        std::vector<vfs::FileInfo> files;
+        files.reserve(200);
 
         GlobalFileSystem().forEachFile(_baseDir, _extension, [&](const vfs::FileInfo& info)
         {
-            _incomingFiles.push_back(info);
+            files.push_back(info);
         }, _depth);
 
         // Sort the files by name
-        std::sort(_incomingFiles.begin(), _incomingFiles.end(), [](const vfs::FileInfo& a, const vfs::FileInfo& b)
+        std::sort(files.begin(), files.end(), [](const vfs::FileInfo& a, const vfs::FileInfo& b)
         {
             return a.name < b.name;
         });
 
+        return files;
+    }
+
+private:
+    void processFiles(const std::vector<vfs::FileInfo>& files)
+    {
+        _numParsedBlocks = 0;
+
         // Dispatch the sorted list to the protected parse() method
-        for (const auto& fileInfo : _incomingFiles)
+        for (const auto& fileInfo : files)
         {
-            auto file = GlobalFileSystem().openTextFile(fileInfo.fullPath());
+            auto stamp = GetStamp(fileInfo);
+            _fileStamps[fileInfo.fullPath()] = stamp;
 
-            if (!file) continue;
+            profiling::ScopedTraceZone fileZone("decl", "ThreadedDeclParser::parse", fileInfo.name);
 
             try
             {
+                if (_useBlockCache)
+                {
+                    processBlocks(fileInfo, stamp);
+                    continue;
+                }
+
+                auto file = GlobalFileSystem().openTextFile(fileInfo.fullPath());
+
+                if (!file) continue;
+
                 // Parse entity defs from the file
                 std::istream stream(&file->getInputStream());
                 parse(stream, fileInfo, file->getModName());
@@ -100,6 +238,72 @@ protected:
                     << " (" << e.what() << ")" << std::endl;
             }
         }
+
+        profiling::recordTraceCounter("decl.parsedFiles", static_cast<double>(files.size()));
+        profiling::recordTraceCounter("decl.parsedBlocks", static_cast<double>(_numParsedBlocks));
+    }
+
+    void processBlocks(const vfs::FileInfo& fileInfo, const std::string& stamp)
+    {
+        if (!_blockCache)
+        {
+            auto cachePath = module::GlobalModuleRegistry().getApplicationContext().getCacheDataPath();
+
+            // Without a cache folder, the blocks are only kept in memory
+            _blockCache = std::make_unique<DeclBlockCache>(cachePath.empty() ? std::string() :
+                os::standardPathWithSlash(cachePath) + "decls/" + string::to_lower_copy(decl::getTypeName(_declType)) + ".bin");
+        }
+
+        auto fullPath = fileInfo.fullPath();
+
+        if (auto record = _blockCache->find(fullPath, stamp); record != nullptr)
+        {
+            for (const auto& block : record->blocks)
+            {
+                parseBlock(block, fileInfo, record->modName);
+            }
+
+            _numParsedBlocks += record->blocks.size();
+
+            return;
+        }
+
+        auto file = GlobalFileSystem().openTextFile(fullPath);
+
+        if (!file) return;
+
+        std::istream stream(&file->getInputStream());
+        BasicDefBlockTokeniser<std::istream> tokeniser(stream);
+        DeclBlockCache::Blocks blocks;
+
+        while (tokeniser.hasMoreBlocks())
+        {
+            blocks.emplace_back(tokeniser.nextBlock());
+            parseBlock(blocks.back(), fileInfo, file->getModName());
+        }
+
+        _numParsedBlocks += blocks.size();
+
+        // Files failing to parse are not stored, such that the errors show up again
+        _blockCache->insert(fullPath, stamp, file->getModName(), std::move(blocks));
+    }
+
+    // Files in PK4s are stamped using the archive's modification time
+    static std::string GetStamp(const vfs::FileInfo& fileInfo)
+    {
+        auto sourcePath = fileInfo.getIsPhysicalFile() ?
+            os::standardPathWithSlash(fileInfo.getArchivePath()) + fileInfo.fullPath() :
+            fileInfo.getArchivePath();
+
+        std::error_code ec;
+        auto modificationTime = fs::last_write_time(sourcePath, ec);
+
+        if (ec)
+        {
+            return {};
+        }
+
+        return fmt::format("{0}|{1}|{2}", sourcePath, modificationTime.time_since_epoch().count(), fileInfo.getSize());
     }
 };
 
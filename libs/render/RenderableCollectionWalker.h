@@ -2,12 +2,84 @@
 
 #include "iselection.h"
 #include "iscenegraph.h"
+#include "irender.h"
+#include "ivolumetest.h"
 #include <functional>
+#include <vector>
+#include "math/Matrix4.h"
 #include "render/RenderableCollectorBase.h"
 
 namespace render
 {
 
+/**
+ * \brief
+ * Retained result of the frustum culling pass of a single view.
+ *
+ * The nodes intersecting the view volume are collected once and re-used in
+ * subsequent frames, until either the view matrices or the space partition
+ * of the scene are changed. Hidden nodes are kept in the list and skipped
+ * during iteration, such that visibility changes don't invalidate the cache.
+ */
+class CulledNodeCache
+{
+private:
+    std::vector<scene::INodeWeakPtr> _nodes;
+
+    Matrix4 _viewProjection;
+    Matrix4 _viewport;
+    std::size_t _changeCount;
+    bool _valid;
+
+public:
+    CulledNodeCache() :
+        _changeCount(0),
+        _valid(false)
+    {}
+
+    // Discards the cached nodes, the next frame will traverse the scene again
+    void clear()
+    {
+        _nodes.clear();
+        _valid = false;
+    }
+
+    // Invokes the functor on each visible node intersecting the given volume
+    void foreachVisibleNode(const VolumeTest& volume, const std::function<void(const scene::INodePtr&)>& functor)
+    {
+        auto& sceneGraph = GlobalSceneGraph();
+        auto changeCount = sceneGraph.getSpacePartitionChangeCount();
+
+        if (!_valid || _changeCount != changeCount ||
+            _viewProjection != volume.GetViewProjection() || _viewport != volume.GetViewport())
+        {
+            _nodes.clear();
+
+            sceneGraph.foreachNodeInVolume(volume, [&](const scene::INodePtr& node)
+            {
+                _nodes.emplace_back(node);
+                return true;
+            });
+
+            // The traversal might have flushed some pending changes
+            _changeCount = sceneGraph.getSpacePartitionChangeCount();
+            _viewProjection = volume.GetViewProjection();
+            _viewport = volume.GetViewport();
+            _valid = true;
+        }
+
+        for (const auto& weakNode : _nodes)
+        {
+            auto node = weakNode.lock();
+
+            if (node && node->visible())
+            {
+                functor(node);
+            }
+        }
+    }
+};
+
 /**
  * \brief
  * Scenegraph walker class that finds all renderable objects and adds them to a
@@ -30,6 +102,28 @@ public:
             return true;
         });
 
+        CollectRenderSystemRenderables(volume);
+    }
+
+    /**
+     * \brief
+     * Same as above, but re-uses the culled node list of the previous frame
+     * if neither the view nor the scene partition changed in between.
+     */
+    static void CollectRenderablesInScene(RenderableCollectorBase& collector, const VolumeTest& volume,
+        CulledNodeCache& cache)
+    {
+        cache.foreachVisibleNode(volume, [&](const scene::INodePtr& node)
+        {
+            collector.processNode(node, volume);
+        });
+
+        CollectRenderSystemRenderables(volume);
+    }
+
+private:
+    static void CollectRenderSystemRenderables(const VolumeTest& volume)
+    {
         // Prepare any renderables that have been directly attached to the RenderSystem
 		// without belonging to an actual scene object
 		GlobalRenderSystem().forEachRenderable([&](Renderable& renderable)
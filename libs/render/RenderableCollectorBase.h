@@ -48,7 +48,14 @@ public:
 
     virtual void processNode(const scene::INodePtr& node, const VolumeTest& volume)
     {
-        node->onPreRender(volume);
+        // Renderables are retained by the backend, only nodes
+        // which changed since the last frame need to be prepared
+        if (node->isRenderStateDirty())
+        {
+            // Clear the flag first, changes during onPreRender must not get lost
+            node->clearRenderStateDirty();
+            node->onPreRender(volume);
+        }
 
         // greebo: Highlighting propagates to child nodes
         scene::INodePtr parent = node->getParent();
@@ -30,13 +30,16 @@ private:
     // The render entity the adapter is attached to
     IRenderEntity* _renderEntity;
 
-    // When attached to an entity, this is the backend storage handle
-    IGeometryStore::Slot _storageLocation;
+    // When attached to an entity, this is the shader holding the backend storage
+    // used by the entity. The storage handle itself is looked up on demand, since
+    // it changes when the surface starts or stops sharing its geometry.
+    ShaderPtr _storageShader;
+    ISurfaceRenderer::Slot _storageShaderSlot;
 
 protected:
     RenderableSurface() :
         _renderEntity(nullptr),
-        _storageLocation(std::numeric_limits<IGeometryStore::Slot>::max())
+        _storageShaderSlot(ISurfaceRenderer::InvalidSlot)
     {}
 
 public:
@@ -107,7 +110,8 @@ public:
 
         _renderEntity = entity;
         _renderEntity->addRenderable(shared_from_this(), shader.get());
-        _storageLocation = shader->getSurfaceStorageLocation(_shaders[shader]);
+        _storageShader = shader;
+        _storageShaderSlot = _shaders[shader];
     }
 
     // Renders the surface stored in our single slot
@@ -126,8 +130,8 @@ public:
 
     IGeometryStore::Slot getStorageLocation() override
     {
-        assert(_storageLocation != std::numeric_limits<IGeometryStore::Slot>::max());
-        return _storageLocation;
+        assert(_storageShader);
+        return _storageShader->getSurfaceStorageLocation(_storageShaderSlot);
     }
 
 private:
@@ -139,7 +143,8 @@ private:
             _renderEntity = nullptr;
         }
 
-        _storageLocation = std::numeric_limits<IGeometryStore::Slot>::max();
+        _storageShader.reset();
+        _storageShaderSlot = ISurfaceRenderer::InvalidSlot;
     }
 
     void detachFromShader(const ShaderMapping::iterator& iter)
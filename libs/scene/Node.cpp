@@ -1,6 +1,7 @@
 #include "Node.h"
 
 #include "itransformnode.h"
+#include "ilayer.h"
 #include "iscenegraph.h"
 #include "debugging/debugging.h"
 #include "InstanceWalkers.h"
@@ -9,20 +10,30 @@
 namespace scene
 {
 
+namespace
+{
+	// Shared by all nodes without a local to world transform
+	const Matrix4& getIdentityTransform()
+	{
+		static const Matrix4 _identity = Matrix4::getIdentity();
+		return _identity;
+	}
+}
+
 Node::Node() :
 	_state(eVisible),
-	_isRoot(false),
 	_id(getNewId()), // Get new auto-incremented ID
 	_children(*this),
+	_isRoot(false),
 	_boundsChanged(true),
 	_boundsMutex(false),
 	_childBoundsChanged(true),
 	_childBoundsMutex(false),
 	_transformChanged(true),
 	_transformMutex(false),
-	_local2world(Matrix4::getIdentity()),
 	_instantiated(false),
 	_forceVisible(false),
+	_renderStateDirty(true),
     _renderEntity(nullptr)
 {
 	// Each node is part of layer 0 by default
@@ -32,16 +43,19 @@ Node::Node() :
 Node::Node(const Node& other) :
 	std::enable_shared_from_this<Node>(other),
 	_state(other._state),
-	_isRoot(other._isRoot),
 	_id(getNewId()),	// ID is incremented on copy
 	_children(*this),
+	_local2world(other._local2world ? std::make_unique<Matrix4>(*other._local2world) : nullptr),
+	_isRoot(other._isRoot),
 	_boundsChanged(true),
 	_boundsMutex(false),
 	_childBoundsChanged(true),
 	_childBoundsMutex(false),
-	_local2world(other._local2world),
+	_transformChanged(true),
+	_transformMutex(false),
 	_instantiated(false),
 	_forceVisible(false),
+	_renderStateDirty(true),
 	_layers(other._layers),
     _renderEntity(other._renderEntity)
 {}
@@ -51,6 +65,21 @@ scene::INodePtr Node::getSelf()
 	return shared_from_this();
 }
 
+std::size_t Node::getMemoryUsage() const
+{
+	return sizeof(Node) + getNodeHeapMemoryUsage();
+}
+
+std::size_t Node::getNodeHeapMemoryUsage() const
+{
+	std::size_t usage = _local2world ? sizeof(Matrix4) : 0;
+
+	// Every child occupies a list element holding its shared pointer
+	usage += _children.size() * (sizeof(INodePtr) + 2 * sizeof(void*));
+
+	return usage + _layers.getHeapMemoryUsage();
+}
+
 void Node::resetIds() {
 	_maxNodeId = 0;
 }
@@ -83,6 +112,7 @@ void Node::enable(unsigned int state)
     // After setting a flag, this node may have changed to invisible
     if (wasVisible && _state != eVisible)
     {
+        _renderStateDirty = true;
         onVisibilityChanged(false);
     }
 }
@@ -96,6 +126,7 @@ void Node::disable(unsigned int state)
     // After clearing a flag, this node can only switch from invisible to visible
     if (!wasVisible && visible())
     {
+        _renderStateDirty = true;
         onVisibilityChanged(true);
     }
 }
@@ -124,28 +155,36 @@ bool Node::excluded() const
 
 void Node::addToLayer(int layerId)
 {
+	if (_layers.count(layerId) > 0) return;
+
+	unregisterFromLayerManager();
 	_layers.insert(layerId);
+	registerWithLayerManager();
 }
 
 void Node::moveToLayer(int layerId)
 {
+	unregisterFromLayerManager();
 	_layers.clear();
 	_layers.insert(layerId);
+	registerWithLayerManager();
 }
 
 void Node::removeFromLayer(int layerId)
 {
 	// Look up the layer ID and remove it from the list
-	LayerList::iterator found = _layers.find(layerId);
+	if (_layers.count(layerId) == 0) return;
 
-	if (found != _layers.end()) {
-		_layers.erase(found);
+	unregisterFromLayerManager();
 
-		// greebo: Make sure that every node is at least member of layer 0
-		if (_layers.empty()) {
-			_layers.insert(0);
-		}
+	_layers.erase(layerId);
+
+	// greebo: Make sure that every node is at least member of layer 0
+	if (_layers.empty()) {
+		_layers.insert(0);
 	}
+
+	registerWithLayerManager();
 }
 
 const LayerList& Node::getLayers() const
@@ -155,12 +194,38 @@ const LayerList& Node::getLayers() const
 
 void Node::assignToLayers(const LayerList& newLayers)
 {
-	if (!newLayers.empty())
+	if (!newLayers.empty() && newLayers != _layers)
     {
+		unregisterFromLayerManager();
         _layers = newLayers;
+		registerWithLayerManager();
     }
 }
 
+void Node::registerWithLayerManager()
+{
+	if (!_instantiated) return;
+
+	auto rootNode = getRootNode();
+
+	if (rootNode)
+	{
+		rootNode->getLayerManager().registerNode(*this);
+	}
+}
+
+void Node::unregisterFromLayerManager()
+{
+	if (!_instantiated) return;
+
+	auto rootNode = getRootNode();
+
+	if (rootNode)
+	{
+		rootNode->getLayerManager().unregisterNode(*this);
+	}
+}
+
 void Node::addChildNode(const INodePtr& node)
 {
 	// Add the node to the TraversableNodeSet, this triggers an
@@ -292,6 +357,9 @@ void Node::onChildRemoved(const INodePtr& child)
 void Node::onInsertIntoScene(IMapRootNode& root)
 {
 	_instantiated = true;
+	_renderStateDirty = true;
+
+	root.getLayerManager().registerNode(*this);
 
     // The node was 100% not visible before, check if it is now
     if (visible())
@@ -306,6 +374,8 @@ void Node::onRemoveFromScene(IMapRootNode& root)
 {
     disconnectUndoSystem(root.getUndoSystem());
 
+	root.getLayerManager().unregisterNode(*this);
+
     bool wasVisible = visible();
 
 	_instantiated = false;
@@ -313,6 +383,7 @@ void Node::onRemoveFromScene(IMapRootNode& root)
     // The node is 100% not visible after removing from the scene
     if (wasVisible)
     {
+        _renderStateDirty = true;
         onVisibilityChanged(false);
     }
 }
@@ -426,6 +497,7 @@ void Node::evaluateChildBounds() const {
 void Node::boundsChanged() {
 	_boundsChanged = true;
 	_childBoundsChanged = true;
+	_renderStateDirty = true;
 
 	INodePtr parent = _parent.lock();
 	if (parent != NULL) {
@@ -447,7 +519,7 @@ void Node::boundsChanged() {
 
 const Matrix4& Node::localToWorld() const {
 	evaluateTransform();
-	return _local2world;
+	return _local2world ? *_local2world : getIdentityTransform();
 }
 
 void Node::evaluateTransform() const {
@@ -460,12 +532,23 @@ void Node::evaluateTransform() const {
 			parent->boundsChanged();
 		}
 
-		_local2world = (parent != NULL) ? parent->localToWorld() : Matrix4::getIdentity();
+		Matrix4 local2world = (parent != NULL) ? parent->localToWorld() : Matrix4::getIdentity();
 
 		const ITransformNode* transformNode = dynamic_cast<const ITransformNode*>(this);
 
 		if (transformNode != NULL) {
-			_local2world.multiplyBy(transformNode->localToParent());
+			local2world.multiplyBy(transformNode->localToParent());
+		}
+
+		// Only allocate storage once the transform deviates from identity,
+		// once allocated it is kept to not invalidate any references
+		if (_local2world)
+		{
+			*_local2world = local2world;
+		}
+		else if (local2world != getIdentityTransform())
+		{
+			_local2world = std::make_unique<Matrix4>(local2world);
 		}
 
 		_transformMutex = false;
@@ -479,6 +562,7 @@ void Node::transformChangedLocal()
 	_transformMutex = false;
 	_boundsChanged = true;
 	_childBoundsChanged = true;
+	_renderStateDirty = true;
 }
 
 void Node::transformChanged()
@@ -504,6 +588,7 @@ RenderSystemPtr Node::getRenderSystem() const
 void Node::setRenderSystem(const RenderSystemPtr& renderSystem)
 {
 	_renderSystem = renderSystem;
+	_renderStateDirty = true;
 
 	if (_children.empty()) return;
 
@@ -521,6 +606,7 @@ void Node::setForcedVisibility(bool forceVisible, bool includeChildren)
 
     if (wasVisible ^ isVisible)
     {
+        _renderStateDirty = true;
         onVisibilityChanged(isVisible);
     }
 
@@ -31,7 +31,6 @@ public:
 
 private:
 	unsigned int _state;
-	bool _isRoot;
 	unsigned long _id;
 
 	// Auto-incrementing ID (contains the largest ID in use)
@@ -44,21 +43,29 @@ private:
 
 	mutable AABB _bounds;
 	mutable AABB _childBounds;
-	mutable bool _boundsChanged;
-	mutable bool _boundsMutex;
-	mutable bool _childBoundsChanged;
-	mutable bool _childBoundsMutex;
-	mutable bool _transformChanged;
-	mutable bool _transformMutex;
 
-	mutable Matrix4 _local2world;
+	// The local to world transform is only allocated if it differs from identity,
+	// which is not the case for the vast majority of nodes in a map
+	mutable std::unique_ptr<Matrix4> _local2world;
+
+	// The flags are packed into a single word to keep the node small
+	bool _isRoot : 1;
+	mutable bool _boundsChanged : 1;
+	mutable bool _boundsMutex : 1;
+	mutable bool _childBoundsChanged : 1;
+	mutable bool _childBoundsMutex : 1;
+	mutable bool _transformChanged : 1;
+	mutable bool _transformMutex : 1;
 
 	// Is true when the node is part of the scenegraph
-	bool _instantiated;
+	bool _instantiated : 1;
 
 	// A special flag capable of overriding the ordinary state flags
 	// We use this to force the rendering of hidden but selected nodes
-	bool _forceVisible;
+	bool _forceVisible : 1;
+
+	// Set when the renderables of this node need to be refreshed by onPreRender()
+	bool _renderStateDirty : 1;
 
 	// The list of layers this object is associated to
 	LayerList _layers;
@@ -85,6 +92,9 @@ public:
     // Default name for generic nodes
     std::string name() const override { return "node"; }
 
+	// Subclasses with significant members should override this
+	std::size_t getMemoryUsage() const override;
+
 	void setSceneGraph(const GraphPtr& sceneGraph) override;
 
 	bool isRoot() const override;
@@ -188,6 +198,24 @@ public:
 	void setRenderEntity(IRenderEntity* entity) override
 	{
 		_renderEntity = entity;
+		_renderStateDirty = true;
+	}
+
+	// Nodes are prepared for rendering in every frame by default,
+	// subclasses tracking all changes to their renderables can override this
+	bool isRenderStateDirty() const override
+	{
+		return true;
+	}
+
+	void queueRenderStateUpdate() override
+	{
+		_renderStateDirty = true;
+	}
+
+	void clearRenderStateDirty() override
+	{
+		_renderStateDirty = false;
 	}
 
 	// Base renderable implementation
@@ -201,6 +229,13 @@ protected:
 	// Method for subclasses to check whether this node is forcedly visible
 	bool isForcedVisible() const;
 
+	// Returns true if a render state update has been queued for this node,
+	// for use in subclasses overriding isRenderStateDirty()
+	bool renderStateUpdateQueued() const
+	{
+		return _renderStateDirty;
+	}
+
     // Overridable method to get notified on visibility changes of this node
     virtual void onVisibilityChanged(bool isVisibleNow)
     {}
@@ -208,6 +243,10 @@ protected:
 	// Fills in the ancestors and self (in this order) into the given targetPath.
 	void getPathRecursively(scene::Path& targetPath);
 
+	// Returns the number of bytes this Node base class allocated on the heap,
+	// for subclasses to include in their getMemoryUsage() implementation
+	std::size_t getNodeHeapMemoryUsage() const;
+
 	TraversableNodeSet& getTraversable();
 
 	// Clears the TraversableNodeSet
@@ -217,6 +256,11 @@ private:
     void connectUndoSystem(IUndoSystem& undoSystem);
     void disconnectUndoSystem(IUndoSystem& undoSystem);
 
+	// Keep the per-layer member index of the scene's layer manager
+	// in sync, these are no-ops while this node is not in the scene
+	void registerWithLayerManager();
+	void unregisterFromLayerManager();
+
 	void evaluateBounds() const;
 	void evaluateChildBounds() const;
 	void evaluateTransform() const;
@@ -215,6 +215,9 @@ void SelectableNode::onSelectionStatusChange(bool changeGroupStatus)
 	// Update the flag to render selected nodes regardless of their hidden status 
 	setForcedVisibility(selected, true);
 
+	// Selected nodes may render additional visual aids
+	queueRenderStateUpdate();
+
 	GlobalSelectionSystem().onSelectedChanged(Node::getSelf(), *this);
 
 	// Check if this node is member of a group
@@ -171,6 +171,11 @@ bool TraversableNodeSet::empty() const
 	return _children.empty();
 }
 
+std::size_t TraversableNodeSet::size() const
+{
+	return _children.size();
+}
+
 void TraversableNodeSet::connectUndoSystem(IUndoSystem& undoSystem)
 {
 	_undoStateSaver = undoSystem.getStateSaver(*this);
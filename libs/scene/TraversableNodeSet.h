@@ -82,6 +82,9 @@ public:
 	 */
 	bool empty() const;
 
+	// Returns the number of contained nodes
+	std::size_t size() const;
+
 	void connectUndoSystem(IUndoSystem& undoSystem);
     void disconnectUndoSystem(IUndoSystem& undoSystem);
 
@@ -3,6 +3,7 @@
 #include "idatastream.h"
 #include <algorithm>
 #include <cstdio>
+#include <cstdint>
 
 namespace stream
 {
@@ -83,18 +84,24 @@ public:
 ///
 /// - Maintains an input stream.
 /// - Provides input starting at an offset in the file for a limited range.
+/// - Seek positions are relative to the start of the range.
 class SubFileInputStream : 
-	public InputStream
+	public SeekableInputStream
 {
+public:
+	typedef FileInputStream::position_type position_type;
+
 private:
 	FileInputStream& _istream;
+	position_type _offset;
+	size_type _size;
 	size_type _remaining;
 
 public:
-	typedef FileInputStream::position_type position_type;
-
 	SubFileInputStream(FileInputStream& istream, position_type offset, size_type size) : 
 		_istream(istream), 
+		_offset(offset),
+		_size(size),
 		_remaining(size)
 	{
 		_istream.seek(offset);
@@ -106,6 +113,28 @@ public:
 		_remaining -= result;
 		return result;
 	}
+
+	size_type seek(size_type position) override
+	{
+		// Clamp the position to the end of the range
+		position = std::min(position, _size);
+		_remaining = _size - position;
+
+		return _istream.seek(_offset + position);
+	}
+
+	size_type seek(offset_type offset, seekdir direction) override
+	{
+		auto base = direction == beg ? 0 : direction == cur ? tell() : _size;
+		auto position = static_cast<std::int64_t>(base) + offset;
+
+		return seek(static_cast<size_type>(std::max<std::int64_t>(position, 0)));
+	}
+
+	size_type tell() const override
+	{
+		return _size - _remaining;
+	}
 };
 
 }
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace util
+{
+
+/**
+ * Helpers to estimate the heap memory occupied by standard containers,
+ * used by the scene nodes to report their memory footprint.
+ * These are estimates, allocator overhead is not taken into account.
+ */
+
+template<typename T, typename Allocator>
+inline std::size_t getHeapMemoryUsage(const std::vector<T, Allocator>& vector)
+{
+    return vector.capacity() * sizeof(T);
+}
+
+inline std::size_t getHeapMemoryUsage(const std::string& string)
+{
+    // Short strings are stored inline, without heap allocation
+    return string.capacity() > std::string().capacity() ? string.capacity() + 1 : 0;
+}
+
+}
@@ -0,0 +1,119 @@
+#include "LazyVFSTreePopulator.h"
+
+#include <cstring>
+#include "string/string.h"
+
+namespace wxutil
+{
+
+bool LazyVFSTreePopulator::NameLess::operator()(const std::string& a, const std::string& b) const
+{
+    auto result = string::icmp(a.c_str(), b.c_str());
+
+    return result != 0 ? result < 0 : std::strcmp(a.c_str(), b.c_str()) < 0;
+}
+
+LazyVFSTreePopulator::LazyVFSTreePopulator(const TreeModel::Ptr& store, const wxDataViewItem& toplevel) :
+    _store(store),
+    _topLevel(toplevel),
+    _root(std::make_shared<Folder>()),
+    _lastFolder(nullptr)
+{}
+
+void LazyVFSTreePopulator::setTopLevelItem(const wxDataViewItem& topLevel)
+{
+    _topLevel = topLevel;
+}
+
+void LazyVFSTreePopulator::addPath(const std::string& path)
+{
+    auto slashPos = path.rfind('/');
+
+    if (slashPos == std::string::npos)
+    {
+        _root->files.insert(path);
+        return;
+    }
+
+    auto& folder = findOrInsertFolder(path.substr(0, slashPos));
+    folder.files.insert(path.substr(slashPos + 1));
+}
+
+bool LazyVFSTreePopulator::empty() const
+{
+    return _root->folders.empty() && _root->files.empty();
+}
+
+LazyVFSTreePopulator::Folder& LazyVFSTreePopulator::findOrInsertFolder(const std::string& path)
+{
+    if (_lastFolder != nullptr && path == _lastFolderPath)
+    {
+        return *_lastFolder;
+    }
+
+    auto* folder = _root.get();
+    std::size_t start = 0;
+
+    while (true)
+    {
+        auto slashPos = path.find('/', start);
+        auto name = path.substr(start, slashPos != std::string::npos ? slashPos - start : std::string::npos);
+
+        auto& child = folder->folders[name];
+
+        if (!child)
+        {
+            child = std::make_shared<Folder>();
+        }
+
+        folder = child.get();
+
+        if (slashPos == std::string::npos) break;
+
+        start = slashPos + 1;
+    }
+
+    _lastFolderPath = path;
+    _lastFolder = folder;
+
+    return *folder;
+}
+
+void LazyVFSTreePopulator::populate(const ColumnPopulationCallback& callback)
+{
+    InsertChildren(*_store, _topLevel, std::string(), *_root,
+        std::make_shared<ColumnPopulationCallback>(callback));
+
+    // The folders are owned by the model's population functions now
+    _root = std::make_shared<Folder>();
+    _lastFolderPath.clear();
+    _lastFolder = nullptr;
+}
+
+void LazyVFSTreePopulator::InsertChildren(TreeModel& model, const wxDataViewItem& parent, const std::string& parentPath,
+    const Folder& folder, const std::shared_ptr<ColumnPopulationCallback>& callback)
+{
+    for (const auto& [name, childFolder] : folder.folders)
+    {
+        auto path = parentPath.empty() ? name : parentPath + "/" + name;
+
+        auto row = model.AddItem(parent);
+        (*callback)(model, row, path, name, true);
+
+        model.SetChildPopulationFunction(row.getItem(),
+            [childFolder = childFolder, path, callback](TreeModel& model, const wxDataViewItem& item)
+        {
+            InsertChildren(model, item, path, *childFolder, callback);
+        });
+    }
+
+    for (const auto& name : folder.files)
+    {
+        auto path = parentPath.empty() ? name : parentPath + "/" + name;
+
+        auto row = model.AddItem(parent);
+        (*callback)(model, row, path, name, false);
+    }
+}
+
+} // namespace
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include "TreeModel.h"
+
+namespace wxutil
+{
+
+/**
+ * Variant of the VFSTreePopulator for large trees. The paths passed to addPath()
+ * are collected in a lightweight folder structure, and populate() only creates
+ * the TreeModel rows of the top-level entries. The rows of every folder are
+ * created when its children are first requested, e.g. when the folder is
+ * expanded in the view (see TreeModel::SetChildPopulationFunction).
+ *
+ * The children of each folder are kept sorted while the paths are added:
+ * folders first, then files, each case-insensitively by name. Models populated
+ * this way don't need to be sorted afterwards.
+ *
+ * Paths are split at each slash. A path that is added explicitly and is also
+ * the parent folder of another path shows up as both a file and a folder.
+ */
+class LazyVFSTreePopulator
+{
+public:
+    // Fills in the column values of a newly created row. This is invoked from
+    // populate() for top-level entries and later on for all other rows, possibly on
+    // a different thread, so any data referenced by the callback has to stay valid
+    // for the lifetime of the model. Don't call SendItemAdded() on the row.
+    typedef std::function<void(TreeModel& model,
+                               TreeModel::Row& row,
+                               const std::string& path,
+                               const std::string& leafName,
+                               bool isFolder)> ColumnPopulationCallback;
+
+private:
+    // Orders names case-insensitively, names only differing in case are kept apart
+    struct NameLess
+    {
+        bool operator()(const std::string& a, const std::string& b) const;
+    };
+
+    struct Folder;
+    using FolderPtr = std::shared_ptr<Folder>;
+
+    struct Folder
+    {
+        std::map<std::string, FolderPtr, NameLess> folders;
+        std::set<std::string, NameLess> files;
+    };
+
+    TreeModel::Ptr _store;
+
+    // Toplevel item to add the entries to
+    wxDataViewItem _topLevel;
+
+    FolderPtr _root;
+
+    // The folder the last path has been added to, subsequent paths usually share it
+    std::string _lastFolderPath;
+    Folder* _lastFolder;
+
+public:
+    LazyVFSTreePopulator(const TreeModel::Ptr& store, const wxDataViewItem& toplevel = wxDataViewItem());
+
+    // wxDataViewItem pointing to the toplevel node, under which all paths should be added.
+    // Default is empty to indicate that paths should be added under the tree root.
+    void setTopLevelItem(const wxDataViewItem& topLevel);
+
+    // Add a single VFS path to the folder structure (no rows are created yet)
+    void addPath(const std::string& path);
+
+    // Returns true if no paths have been added yet
+    bool empty() const;
+
+    // Creates the rows of the top-level entries, all other rows are created on demand.
+    // The collected paths are handed over to the model, this populator is empty afterwards.
+    void populate(const ColumnPopulationCallback& callback);
+
+private:
+    Folder& findOrInsertFolder(const std::string& path);
+
+    static void InsertChildren(TreeModel& model, const wxDataViewItem& parent, const std::string& parentPath,
+        const Folder& folder, const std::shared_ptr<ColumnPopulationCallback>& callback);
+};
+
+} // namespace
@@ -1,4 +1,5 @@
 #include "TreeModel.h"
+#include "TreeModelSearchIndex.h"
 
 #include <algorithm>
 #include <functional>
@@ -6,6 +7,28 @@
 namespace wxutil
 {
 
+namespace
+{
+	// Returns the text of String and IconText values, as compared by the string search
+	wxString getSearchableText(const wxVariant& value, TreeModel::Column::Type type)
+	{
+		if (value.IsNull())
+		{
+			return wxString();
+		}
+
+		if (type == TreeModel::Column::IconText)
+		{
+			wxDataViewIconText iconText;
+			iconText << value;
+
+			return iconText.GetText();
+		}
+
+		return type == TreeModel::Column::String ? value.GetString() : wxString();
+	}
+}
+
 wxString TreeModel::Column::getWxType() const
 {
 	static std::vector<wxString> types(NumTypes);
@@ -42,6 +65,12 @@ public:
 	typedef std::vector<NodePtr> Children;
 	Children children;
 
+	// Position of this node in the parent's children list
+	std::size_t childIndex;
+
+	// Creates the children of this node when they're first needed
+	ChildPopulationFunction populateChildren;
+
 	typedef std::vector<wxDataViewItemAttr> Attributes;
 	Attributes attributes;
 
@@ -51,7 +80,8 @@ public:
 	// Public constructor, does not accept NULL pointers
 	Node(Node* parent_) :
 		parent(parent_),
-		item(reinterpret_cast<wxDataViewItem::Type>(this))
+		item(reinterpret_cast<wxDataViewItem::Type>(this)),
+		childIndex(0)
 	{
 		// Use CreateRoot() instead of passing NULL
 		assert(parent_ != nullptr);
@@ -61,7 +91,8 @@ private:
 	// Private constructor creates a root node, has a wxDataViewItem ID == NULL
 	Node() :
 		parent(nullptr),
-		item(nullptr)
+		item(nullptr),
+		childIndex(0)
 	{}
 
 public:
@@ -77,13 +108,63 @@ public:
 		{
 			if (i->get() == child)
 			{
-				children.erase(i);
+				i = children.erase(i);
+				updateChildIndices(i - children.begin());
 				return true;
 			}
 		}
 
 		return false;
 	}
+
+	// Re-assigns the child index of all children starting at the given position
+	void updateChildIndices(std::size_t start = 0)
+	{
+		for (auto i = start; i < children.size(); ++i)
+		{
+			children[i]->childIndex = i;
+		}
+	}
+
+	// Returns the number of ancestors of this node, including the root node
+	std::size_t getDepth() const
+	{
+		std::size_t depth = 0;
+
+		for (auto node = parent; node != nullptr; node = node->parent)
+		{
+			++depth;
+		}
+
+		return depth;
+	}
+
+	// Returns true if node a is visited before node b, in the order of
+	// ForeachNode (forward) or ForeachNodeReverse
+	static bool IsVisitedBefore(const Node* a, const Node* b, bool forward)
+	{
+		auto depthA = a->getDepth();
+		auto depthB = b->getDepth();
+
+		// Move up to the ancestors at the same depth
+		for (auto depth = depthA; depth > depthB; --depth) a = a->parent;
+		for (auto depth = depthB; depth > depthA; --depth) b = b->parent;
+
+		// Parents are visited before their children in both directions
+		if (a == b)
+		{
+			return depthA < depthB;
+		}
+
+		// Compare the positions of the ancestors below the common parent
+		while (a->parent != b->parent)
+		{
+			a = a->parent;
+			b = b->parent;
+		}
+
+		return forward ? a->childIndex < b->childIndex : a->childIndex > b->childIndex;
+	}
 };
 
 // -------------------------------------------------------------------------------
@@ -158,6 +239,7 @@ void TreeModel::PopulationProgressEvent::SetMessage(const wxString& message)
 TreeModel::TreeModel(const ColumnRecord& columns, bool isListModel) :
 	_columns(columns),
 	_rootNode(Node::createRoot()),
+	_searchIndex(std::make_shared<SearchIndex>()),
 	_defaultStringSortColumn(-1),
 	_hasDefaultCompare(false),
 	_isListModel(isListModel)
@@ -166,6 +248,7 @@ TreeModel::TreeModel(const ColumnRecord& columns, bool isListModel) :
 TreeModel::TreeModel(const TreeModel& existingModel) :
 	_columns(existingModel._columns),
 	_rootNode(existingModel._rootNode),
+	_searchIndex(existingModel._searchIndex),
 	_defaultStringSortColumn(existingModel._defaultStringSortColumn),
 	_hasDefaultCompare(existingModel._hasDefaultCompare),
 	_isListModel(existingModel._isListModel)
@@ -196,6 +279,7 @@ TreeModel::Row TreeModel::AddItem(const wxDataViewItem& parent)
 
 	NodePtr node(new Node(parentNode));
 
+	node->childIndex = parentNode->children.size();
 	parentNode->children.push_back(node);
 
 	return Row(node->item, *this);
@@ -210,6 +294,8 @@ bool TreeModel::RemoveItem(const wxDataViewItem& item)
 
 		if (parent == NULL) return false; // cannot remove the root node
 
+		RemoveFromSearchIndex(*node);
+
 		if (parent->remove(node))
 		{
 			ItemDeleted(parent->item, item);
@@ -220,6 +306,24 @@ bool TreeModel::RemoveItem(const wxDataViewItem& item)
 	return false;
 }
 
+void TreeModel::SetChildPopulationFunction(const wxDataViewItem& item, const ChildPopulationFunction& populate)
+{
+	Node* node = !item.IsOk() ? _rootNode.get() : static_cast<Node*>(item.GetID());
+
+	node->populateChildren = populate;
+}
+
+void TreeModel::EnsureChildrenPopulated(Node& node)
+{
+	if (!node.populateChildren) return;
+
+	// Clear the function before invoking it, it might query the children itself
+	auto populate = std::move(node.populateChildren);
+	node.populateChildren = ChildPopulationFunction();
+
+	populate(*this, node.item);
+}
+
 int TreeModel::RemoveItems(const std::function<bool (const TreeModel::Row&)>& predicate)
 {
 	return RemoveItemsRecursively(GetRoot(), predicate);
@@ -232,6 +336,8 @@ int TreeModel::RemoveItemsRecursively(const wxDataViewItem& parent, const std::f
 	int deleteCount = 0;
 	wxDataViewItemArray itemsToDelete;
 
+	EnsureChildrenPopulated(*parentNode);
+
 	for (Node::Children::const_iterator i = parentNode->children.begin();
 			i != parentNode->children.end(); ++i)
 	{
@@ -253,6 +359,7 @@ int TreeModel::RemoveItemsRecursively(const wxDataViewItem& parent, const std::f
 		std::for_each(itemsToDelete.begin(), itemsToDelete.end(), [&] (const wxDataViewItem& item)
 		{
 			Node* nodeToDelete = static_cast<Node*>(item.GetID());
+			RemoveFromSearchIndex(*nodeToDelete);
 			parentNode->remove(nodeToDelete);
 			deleteCount++;
 		});
@@ -292,6 +399,8 @@ void TreeModel::Clear()
 	// Now it should be safe to free all the nodes
 	_rootNode->values.clear();
 	_rootNode->children.clear();
+	_rootNode->populateChildren = ChildPopulationFunction();
+	_searchIndex->clear();
 	
 	Cleared();
 }
@@ -308,6 +417,8 @@ void TreeModel::SetHasDefaultCompare(bool hasDefaultCompare)
 
 void TreeModel::ForeachNode(const TreeModel::VisitFunction& visitFunction)
 {
+	EnsureChildrenPopulated(*_rootNode);
+
 	// Skip the root node and traverse its immediate children recursively
 	std::for_each(_rootNode->children.begin(), _rootNode->children.end(), [&] (const NodePtr& node)
 	{
@@ -320,6 +431,8 @@ void TreeModel::ForeachNodeRecursive(const TreeModel::NodePtr& node, const TreeM
 	wxutil::TreeModel::Row row(node->item, *this);
 	visitFunction(row);
 
+	EnsureChildrenPopulated(*node);
+
 	// Enter the recursion
 	std::for_each(node->children.begin(), node->children.end(), [&] (const NodePtr& child)
 	{
@@ -329,6 +442,8 @@ void TreeModel::ForeachNodeRecursive(const TreeModel::NodePtr& node, const TreeM
 
 void TreeModel::ForeachNodeReverse(const TreeModel::VisitFunction& visitFunction)
 {
+	EnsureChildrenPopulated(*_rootNode);
+
 	// Skip the root node and traverse its immediate children recursively
 	for (Node::Children::const_reverse_iterator i = _rootNode->children.rbegin(); i != _rootNode->children.rend(); ++i)
 	{
@@ -341,6 +456,8 @@ void TreeModel::ForeachNodeRecursiveReverse(const TreeModel::NodePtr& node, cons
 	wxutil::TreeModel::Row row(node->item, *this);
 	visitFunction(row);
 
+	EnsureChildrenPopulated(*node);
+
 	// Enter the recursion
 	for (Node::Children::const_reverse_iterator i = node->children.rbegin(); i != node->children.rend(); ++i)
 	{
@@ -421,12 +538,16 @@ void TreeModel::SortModelFoldersFirst(const Column& stringColumn, const Column&
 
 void TreeModel::SortModelRecursive(const TreeModel::NodePtr& node, const TreeModel::SortFunction& sortFunction)
 {
+	EnsureChildrenPopulated(*node);
+
 	// Use std::sort algorithm and small lambda to only pass wxDataViewItems to the client sort function
 	std::sort(node->children.begin(), node->children.end(), [&] (const NodePtr& a, const NodePtr& b)->bool
 	{
 		return sortFunction(a->item, b->item);
 	});
 
+	node->updateChildIndices();
+
 	// Enter recursion
 	std::for_each(node->children.begin(), node->children.end(), [&] (const NodePtr& child)
 	{
@@ -484,7 +605,7 @@ wxDataViewItem TreeModel::FindInteger(long needle, const Column& column, const w
 	});
 }
 
-wxDataViewItem TreeModel::FindRecursive(const TreeModel::Node& node, const std::function<bool (const TreeModel::Node&)>& predicate)
+wxDataViewItem TreeModel::FindRecursive(TreeModel::Node& node, const std::function<bool (const TreeModel::Node&)>& predicate)
 {
 	// Test the node itself
 	if (predicate(node))
@@ -492,6 +613,8 @@ wxDataViewItem TreeModel::FindRecursive(const TreeModel::Node& node, const std::
 		return node.item;
 	}
 
+	EnsureChildrenPopulated(node);
+
 	// Then test all children, aborting on first success
 	for (const auto& child : node.children)
 	{
@@ -507,7 +630,7 @@ wxDataViewItem TreeModel::FindRecursive(const TreeModel::Node& node, const std::
 	return wxDataViewItem();
 }
 
-wxDataViewItem TreeModel::FindRecursiveUsingRows(const TreeModel::Node& node, const std::function<bool (TreeModel::Row&)>& predicate)
+wxDataViewItem TreeModel::FindRecursiveUsingRows(TreeModel::Node& node, const std::function<bool (TreeModel::Row&)>& predicate)
 {
 	if (node.item.IsOk())
 	{
@@ -520,6 +643,8 @@ wxDataViewItem TreeModel::FindRecursiveUsingRows(const TreeModel::Node& node, co
 		}
 	}
 
+	EnsureChildrenPopulated(node);
+
 	// Then test all children, aborting on first success
 	for (const auto& child : node.children)
 	{
@@ -596,6 +721,11 @@ bool TreeModel::SetValue(const wxVariant& variant,
 	
 	owningNode->values[col] = variant;
 
+	if (item.IsOk() && !_searchIndex->empty() && col < _columns.size())
+	{
+		_searchIndex->setValue(static_cast<int>(col), owningNode, getSearchableText(variant, _columns[col].type));
+	}
+
 	return true;
 }
 
@@ -672,7 +802,7 @@ bool TreeModel::IsContainer(const wxDataViewItem& item) const
 	// Regular implementation: return true if this node has child nodes
 	Node* owningNode = static_cast<Node*>(item.GetID());
 
-	return owningNode != NULL && !owningNode->children.empty();
+	return owningNode != NULL && (!owningNode->children.empty() || owningNode->populateChildren);
 #endif
 }
 
@@ -681,6 +811,10 @@ unsigned int TreeModel::GetChildren(const wxDataViewItem& item, wxDataViewItemAr
 	// Requests for invalid items are asking for our root children, actually
 	Node* owningNode = !item.IsOk() ? _rootNode.get() : static_cast<Node*>(item.GetID());
 
+	// wxWidgets declares this method const, but this is where the view
+	// asks for the rows of an expanded item, which are created on demand
+	const_cast<TreeModel*>(this)->EnsureChildrenPopulated(*owningNode);
+
 	for (Node::Children::const_iterator iter = owningNode->children.begin(); iter != owningNode->children.end(); ++iter)
 	{
 		children.Add((*iter)->item);
@@ -958,6 +1092,11 @@ public:
 wxDataViewItem TreeModel::FindNextString(const wxString& needle,
 	const std::vector<TreeModel::Column>& columns, const wxDataViewItem& previousMatch)
 {
+	if (PrepareSearchIndex(needle, columns, previousMatch))
+	{
+		return FindStringUsingIndex(needle, columns, previousMatch, true);
+	}
+
 	SearchFunctor functor(needle, columns, previousMatch);
 
 	ForeachNode([&] (Row& row)
@@ -972,6 +1111,11 @@ wxDataViewItem TreeModel::FindNextString(const wxString& needle,
 wxDataViewItem TreeModel::FindPrevString(const wxString& needle,
 	const std::vector<TreeModel::Column>& columns, const wxDataViewItem& previousMatch)
 {
+	if (PrepareSearchIndex(needle, columns, previousMatch))
+	{
+		return FindStringUsingIndex(needle, columns, previousMatch, false);
+	}
+
 	SearchFunctor functor(needle, columns, previousMatch);
 
 	ForeachNodeReverse([&] (Row& row)
@@ -982,6 +1126,118 @@ wxDataViewItem TreeModel::FindPrevString(const wxString& needle,
 	return functor.getMatch();
 }
 
+bool TreeModel::IsSearchable(const wxDataViewItem& item) const
+{
+	return true;
+}
+
+bool TreeModel::PrepareSearchIndex(const wxString& needle, const std::vector<Column>& columns,
+	const wxDataViewItem& previousMatch)
+{
+	// Needles shorter than a trigram would match most of the entries, walk the tree instead
+	if (needle.length() < SearchIndex::NgramLength || columns.empty())
+	{
+		return false;
+	}
+
+	for (const auto& column : columns)
+	{
+		// Only text columns are indexed
+		if (column.type != Column::String && column.type != Column::IconText)
+		{
+			return false;
+		}
+	}
+
+	for (const auto& column : columns)
+	{
+		auto colIndex = column.getColumnIndex();
+
+		if (_searchIndex->hasColumn(colIndex)) continue;
+
+		_searchIndex->addColumn(colIndex);
+
+		std::function<void(const NodePtr&)> addRecursively = [&](const NodePtr& node)
+		{
+			if (static_cast<int>(node->values.size()) > colIndex)
+			{
+				_searchIndex->setValue(colIndex, node.get(), getSearchableText(node->values[colIndex], column.type));
+			}
+
+			EnsureChildrenPopulated(*node);
+
+			for (const auto& child : node->children)
+			{
+				addRecursively(child);
+			}
+		};
+
+		EnsureChildrenPopulated(*_rootNode);
+
+		for (const auto& child : _rootNode->children)
+		{
+			addRecursively(child);
+		}
+	}
+
+	// A reference item unknown to the index might not be part of this model (anymore),
+	// leave it to the tree walk which never dereferences it
+	return !previousMatch.IsOk() ||
+		_searchIndex->containsNode(static_cast<Node*>(previousMatch.GetID()), columns);
+}
+
+wxDataViewItem TreeModel::FindStringUsingIndex(const wxString& needle, const std::vector<Column>& columns,
+	const wxDataViewItem& previousMatch, bool forward)
+{
+	const Node* previousNode = nullptr;
+
+	if (previousMatch.IsOk())
+	{
+		// The tree walk never gets past a reference item that is not searchable
+		if (!IsSearchable(previousMatch))
+		{
+			return wxDataViewItem();
+		}
+
+		previousNode = static_cast<Node*>(previousMatch.GetID());
+	}
+
+	auto lowerNeedle = SearchIndex::ToLowerUtf8(needle);
+
+	// Pick the matching node which the tree walk would have encountered first
+	Node* match = nullptr;
+
+	for (const auto& column : columns)
+	{
+		_searchIndex->foreachMatch(column.getColumnIndex(), lowerNeedle, [&](Node* node)
+		{
+			if (node == match ||
+				(previousNode != nullptr && !Node::IsVisitedBefore(previousNode, node, forward)) ||
+				(match != nullptr && !Node::IsVisitedBefore(node, match, forward)) ||
+				!IsSearchable(node->item))
+			{
+				return;
+			}
+
+			match = node;
+		});
+	}
+
+	return match != nullptr ? match->item : wxDataViewItem();
+}
+
+void TreeModel::RemoveFromSearchIndex(const Node& node)
+{
+	if (_searchIndex->empty()) return;
+
+	_searchIndex->removeNode(&node);
+
+	for (const auto& child : node.children)
+	{
+		RemoveFromSearchIndex(*child);
+	}
+}
+
 bool TreeModel::IsEnabled(const wxDataViewItem& item, unsigned int col) const
 {
 	Node* owningNode = item.IsOk() ? static_cast<Node*>(item.GetID()) : _rootNode.get();
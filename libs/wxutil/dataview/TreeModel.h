@@ -333,6 +333,9 @@ public:
 	// Sort function - should return true if a < b, false otherwise
 	typedef std::function<bool (const wxDataViewItem&, const wxDataViewItem&)> SortFunction;
 
+	// Function adding the child items of the given parent item on demand, see SetChildPopulationFunction()
+	typedef std::function<void(TreeModel& model, const wxDataViewItem& parent)> ChildPopulationFunction;
+
 	// Event to be emitted by threaded treemodel populators. Worker threads should use events
 	// to communicate with the main GUI thread.
 	class PopulationFinishedEvent : 
@@ -379,12 +382,17 @@ protected:
 	typedef std::shared_ptr<Node> NodePtr;
 
 	class SearchFunctor;
+	class SearchIndex;
 
 private:
 	const ColumnRecord& _columns;
 
 	NodePtr _rootNode;
 
+	// Lowercase text index used by FindNextString/FindPrevString,
+	// shared with all models referencing the same root node
+	std::shared_ptr<SearchIndex> _searchIndex;
+
 	int _defaultStringSortColumn;
 
 	bool _hasDefaultCompare;
@@ -413,6 +421,12 @@ public:
 	// Removes the item, returns TRUE on success
 	virtual bool RemoveItem(const wxDataViewItem& item);
 
+	// Defers the creation of the given item's children until they are first requested,
+	// i.e. when the item is expanded in a view, or the model is traversed or searched.
+	// The function is invoked once, it should add the child rows without sending
+	// ItemAdded events. Sorting the model populates all pending items first.
+	virtual void SetChildPopulationFunction(const wxDataViewItem& item, const ChildPopulationFunction& populate);
+
 	// Remove all items matching the predicate, returns the number of deleted items
 	virtual int RemoveItems(const std::function<bool (const Row&)>& predicate);
 
@@ -525,6 +539,10 @@ protected:
 	void ForeachNodeRecursiveReverse(const TreeModel::NodePtr& node, const TreeModel::VisitFunction& visitFunction);
 	void SortModelRecursive(const TreeModel::NodePtr& node, const TreeModel::SortFunction& sortFunction);
 
+	// Invokes the pending child population function of the given node, if there is any.
+	// This adds rows to the model, so it's only available to non-const methods.
+	void EnsureChildrenPopulated(Node& node);
+
 	// Sort functor for the SortModelFoldersFirst() method, uses the stringCompare method to compare the actual text values
     // Pass CompareStringVariants or CompareIconTextVariants as stringCompare.
 	bool CompareFoldersFirst(const wxDataViewItem& a, const wxDataViewItem& b, 
@@ -536,9 +554,23 @@ protected:
     static int CompareStringVariants(const wxVariant& a, const wxVariant& b);
     static int CompareIconTextVariants(const wxVariant& a, const wxVariant& b);
 
-	wxDataViewItem FindRecursive(const TreeModel::Node& node, const std::function<bool (const TreeModel::Node&)>& predicate);
-	wxDataViewItem FindRecursiveUsingRows(const TreeModel::Node& node, const std::function<bool (TreeModel::Row&)>& predicate);
+	wxDataViewItem FindRecursive(TreeModel::Node& node, const std::function<bool (const TreeModel::Node&)>& predicate);
+	wxDataViewItem FindRecursiveUsingRows(TreeModel::Node& node, const std::function<bool (TreeModel::Row&)>& predicate);
 	int RemoveItemsRecursively(const wxDataViewItem& parent, const std::function<bool (const Row&)>& predicate);
+
+	// Returns true if the given item should be considered by FindNextString/FindPrevString.
+	// Subclasses hiding some of the items should exclude them here, the default returns true.
+	virtual bool IsSearchable(const wxDataViewItem& item) const;
+
+private:
+	// Indexes the given columns if necessary, returns false if the search cannot be answered by the index
+	bool PrepareSearchIndex(const wxString& needle, const std::vector<Column>& columns, const wxDataViewItem& previousMatch);
+
+	wxDataViewItem FindStringUsingIndex(const wxString& needle, const std::vector<Column>& columns,
+		const wxDataViewItem& previousMatch, bool forward);
+
+	// Removes the given node and all its children from the search index
+	void RemoveFromSearchIndex(const Node& node);
 };
 
 // wx event macros
@@ -134,6 +134,11 @@ void TreeModelFilter::ForeachNode(const VisitFunction& visitFunction)
 	});
 }
 
+bool TreeModelFilter::IsSearchable(const wxDataViewItem& item) const
+{
+	return ItemIsVisible(item);
+}
+
 wxDataViewItem TreeModelFilter::FindString(const std::string& needle, int column)
 {
 	return FindRecursiveUsingRows(*getRootNode(), [&] (Row& row)->bool
@@ -87,6 +87,10 @@ public:
     virtual bool IsContainer(const wxDataViewItem& item) const;
 
 	virtual unsigned int GetChildren(const wxDataViewItem& item, wxDataViewItemArray& children) const;
+
+protected:
+	// Filtered items are excluded from FindNextString/FindPrevString
+	virtual bool IsSearchable(const wxDataViewItem& item) const override;
 };
 
 } // namespace
@@ -0,0 +1,238 @@
+#pragma once
+
+#include "TreeModel.h"
+
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace wxutil
+{
+
+/**
+ * Trigram index over the lowercase text values of a TreeModel's searchable
+ * columns, used by FindNextString() and FindPrevString() to avoid walking
+ * and lowercasing the entire tree on every keystroke.
+ *
+ * Columns are added to the index on the first search, from then on
+ * the TreeModel keeps the index up to date when values are assigned or
+ * nodes are removed. The index is shared with any TreeModelFilter
+ * referencing the same nodes.
+ */
+class TreeModel::SearchIndex
+{
+private:
+    struct Entry
+    {
+        // The node this text belongs to, nullptr if the entry has been invalidated
+        Node* node;
+
+        // Lowercase UTF-8 representation of the column value
+        std::string text;
+    };
+
+    struct ColumnIndex
+    {
+        // Entries are never moved, postings refer to them by position
+        std::vector<Entry> entries;
+        std::unordered_map<const Node*, std::size_t> entryByNode;
+
+        // Entry positions by trigram, in ascending order
+        std::unordered_map<uint32_t, std::vector<std::size_t>> trigrams;
+
+        std::size_t numInvalidEntries = 0;
+    };
+
+    // Indexed columns by column index
+    std::unordered_map<int, ColumnIndex> _columns;
+
+public:
+    // Length of the substrings the texts are indexed by, shorter needles can't be looked up
+    static constexpr std::size_t NgramLength = 3;
+
+    bool empty() const
+    {
+        return _columns.empty();
+    }
+
+    bool hasColumn(int column) const
+    {
+        return _columns.count(column) > 0;
+    }
+
+    // Starts indexing the given column, values need to be assigned using setValue()
+    void addColumn(int column)
+    {
+        _columns.emplace(column, ColumnIndex());
+    }
+
+    // Returns true if the node has a value in any of the given columns
+    bool containsNode(const Node* node, const std::vector<Column>& columns) const
+    {
+        for (const auto& column : columns)
+        {
+            auto found = _columns.find(column.getColumnIndex());
+
+            if (found != _columns.end() && found->second.entryByNode.count(node) > 0)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // Updates the text of the given node, does nothing if the column is not indexed
+    void setValue(int column, Node* node, const wxString& value)
+    {
+        auto found = _columns.find(column);
+
+        if (found == _columns.end()) return;
+
+        auto& index = found->second;
+
+        invalidateEntry(index, node);
+
+        auto position = index.entries.size();
+        index.entries.push_back(Entry{ node, ToLowerUtf8(value) });
+        index.entryByNode[node] = position;
+
+        ForeachTrigram(index.entries.back().text, [&](uint32_t trigram)
+        {
+            auto& postings = index.trigrams[trigram];
+
+            // Repeated trigrams of the same text are stored once
+            if (postings.empty() || postings.back() != position)
+            {
+                postings.push_back(position);
+            }
+        });
+    }
+
+    // Removes the node from all columns
+    void removeNode(const Node* node)
+    {
+        for (auto& [_, index] : _columns)
+        {
+            invalidateEntry(index, node);
+        }
+    }
+
+    void clear()
+    {
+        _columns.clear();
+    }
+
+    // Invokes the visitor for each node whose value in the given column contains
+    // the given lowercase needle. Nodes are visited in no particular order.
+    // The needle must be at least NgramLength bytes long.
+    void foreachMatch(int column, const std::string& needle, const std::function<void(Node*)>& visitor) const
+    {
+        assert(needle.length() >= NgramLength);
+
+        auto found = _columns.find(column);
+
+        if (found == _columns.end()) return;
+
+        const auto& index = found->second;
+
+        // Every match contains all trigrams of the needle, verify the entries of the rarest one
+        const std::vector<std::size_t>* candidates = nullptr;
+        bool hasMissingTrigram = false;
+
+        ForeachTrigram(needle, [&](uint32_t trigram)
+        {
+            auto postings = index.trigrams.find(trigram);
+
+            if (postings == index.trigrams.end())
+            {
+                hasMissingTrigram = true;
+            }
+            else if (candidates == nullptr || postings->second.size() < candidates->size())
+            {
+                candidates = &postings->second;
+            }
+        });
+
+        if (hasMissingTrigram || candidates == nullptr) return;
+
+        for (auto position : *candidates)
+        {
+            const auto& entry = index.entries[position];
+
+            if (entry.node != nullptr && entry.text.find(needle) != std::string::npos)
+            {
+                visitor(entry.node);
+            }
+        }
+    }
+
+    // Lowercases the given string the same way the row-based search does
+    static std::string ToLowerUtf8(const wxString& value)
+    {
+        auto lower = value.Lower();
+        auto utf8 = lower.ToUTF8();
+
+        return std::string(utf8.data(), utf8.length());
+    }
+
+private:
+    void invalidateEntry(ColumnIndex& index, const Node* node)
+    {
+        auto existing = index.entryByNode.find(node);
+
+        if (existing == index.entryByNode.end()) return;
+
+        index.entries[existing->second].node = nullptr;
+        index.entries[existing->second].text.clear();
+        index.entryByNode.erase(existing);
+
+        if (++index.numInvalidEntries > 1024 && index.numInvalidEntries > index.entries.size() / 2)
+        {
+            compact(index);
+        }
+    }
+
+    // Rebuilds the column index from its valid entries
+    void compact(ColumnIndex& index)
+    {
+        ColumnIndex compacted;
+        compacted.entries.reserve(index.entries.size() - index.numInvalidEntries);
+
+        for (auto& entry : index.entries)
+        {
+            if (entry.node == nullptr) continue;
+
+            auto position = compacted.entries.size();
+            compacted.entryByNode[entry.node] = position;
+            compacted.entries.push_back(std::move(entry));
+
+            ForeachTrigram(compacted.entries.back().text, [&](uint32_t trigram)
+            {
+                auto& postings = compacted.trigrams[trigram];
+
+                if (postings.empty() || postings.back() != position)
+                {
+                    postings.push_back(position);
+                }
+            });
+        }
+
+        index = std::move(compacted);
+    }
+
+    static void ForeachTrigram(const std::string& text, const std::function<void(uint32_t)>& visitor)
+    {
+        for (std::size_t i = 0; i + NgramLength <= text.length(); ++i)
+        {
+            visitor(static_cast<uint32_t>(static_cast<uint8_t>(text[i])) << 16 |
+                static_cast<uint32_t>(static_cast<uint8_t>(text[i + 1])) << 8 |
+                static_cast<uint32_t>(static_cast<uint8_t>(text[i + 2])));
+        }
+    }
+};
+
+}
@@ -2,6 +2,7 @@
 
 #include "../SceneNodeBuffer.h"
 #include <pybind11/stl_bind.h>
+#include <pybind11/stl.h>
 
 PYBIND11_MAKE_OPAQUE(IWinding);
 
@@ -76,6 +77,55 @@ IWinding& ScriptFace::getWinding()
 	return _face->getWinding();
 }
 
+ScriptGeometryBuffer ScriptFace::getWindingVertices()
+{
+	const auto& winding = getWinding();
+
+	ScriptGeometryBuffer buffer({ static_cast<py::ssize_t>(winding.size()), 3 });
+	auto* data = buffer.data();
+
+	for (const auto& vertex : winding)
+	{
+		*data++ = vertex.vertex.x();
+		*data++ = vertex.vertex.y();
+		*data++ = vertex.vertex.z();
+	}
+
+	return buffer;
+}
+
+ScriptGeometryBuffer ScriptFace::getWindingTexcoords()
+{
+	const auto& winding = getWinding();
+
+	ScriptGeometryBuffer buffer({ static_cast<py::ssize_t>(winding.size()), 2 });
+	auto* data = buffer.data();
+
+	for (const auto& vertex : winding)
+	{
+		*data++ = vertex.texcoord.x();
+		*data++ = vertex.texcoord.y();
+	}
+
+	return buffer;
+}
+
+ScriptGeometryBuffer ScriptFace::getPlane()
+{
+	ScriptGeometryBuffer buffer({ 4 });
+	if (_face == NULL) return buffer;
+
+	const auto& plane = _face->getPlane3();
+	auto* data = buffer.data();
+
+	data[0] = plane.normal().x();
+	data[1] = plane.normal().y();
+	data[2] = plane.normal().z();
+	data[3] = plane.dist();
+
+	return buffer;
+}
+
 std::string ScriptFace::_emptyShader;
 IWinding ScriptFace::_emptyWinding;
 
@@ -174,6 +224,97 @@ void ScriptBrushNode::undoSave()
 	brushNode->getIBrush().undoSave();
 }
 
+ScriptGeometryBuffer ScriptBrushNode::getFacePlanes()
+{
+	IBrushNodePtr brushNode = std::dynamic_pointer_cast<IBrushNode>(_node.lock());
+	if (brushNode == NULL) return ScriptGeometryBuffer({ 0, 4 });
+
+	const auto& brush = brushNode->getIBrush();
+
+	ScriptGeometryBuffer buffer({ static_cast<py::ssize_t>(brush.getNumFaces()), 4 });
+	auto* data = buffer.data();
+
+	for (std::size_t i = 0; i < brush.getNumFaces(); ++i)
+	{
+		const auto& plane = brush.getFace(i).getPlane3();
+
+		*data++ = plane.normal().x();
+		*data++ = plane.normal().y();
+		*data++ = plane.normal().z();
+		*data++ = plane.dist();
+	}
+
+	return buffer;
+}
+
+void ScriptBrushNode::setFacePlanes(const py::buffer& planes)
+{
+	IBrushNodePtr brushNode = std::dynamic_pointer_cast<IBrushNode>(_node.lock());
+	if (brushNode == NULL) return;
+
+	auto& brush = brushNode->getIBrush();
+
+	// A plane count differing from the number of faces is rejected with a ValueError
+	auto values = readGeometryBuffer(planes, { static_cast<py::ssize_t>(brush.getNumFaces()), 4 });
+
+	// Update the faces in place, such that face objects held by scripts stay valid
+	// and every face keeps its material and texture projection
+	for (std::size_t i = 0; i < brush.getNumFaces(); ++i)
+	{
+		const auto* row = values.data() + i * 4;
+		brush.getFace(i).setPlane(Plane3(row[0], row[1], row[2], row[3]));
+	}
+
+	brush.evaluateBRep();
+}
+
+ScriptGeometryBuffer ScriptBrushNode::getWindingVertices()
+{
+	IBrushNodePtr brushNode = std::dynamic_pointer_cast<IBrushNode>(_node.lock());
+	if (brushNode == NULL) return ScriptGeometryBuffer({ 0, 3 });
+
+	const auto& brush = brushNode->getIBrush();
+	std::size_t numVertices = 0;
+
+	for (std::size_t i = 0; i < brush.getNumFaces(); ++i)
+	{
+		numVertices += brush.getFace(i).getWinding().size();
+	}
+
+	ScriptGeometryBuffer buffer({ static_cast<py::ssize_t>(numVertices), 3 });
+	auto* data = buffer.data();
+
+	for (std::size_t i = 0; i < brush.getNumFaces(); ++i)
+	{
+		for (const auto& vertex : brush.getFace(i).getWinding())
+		{
+			*data++ = vertex.vertex.x();
+			*data++ = vertex.vertex.y();
+			*data++ = vertex.vertex.z();
+		}
+	}
+
+	return buffer;
+}
+
+std::vector<std::size_t> ScriptBrushNode::getWindingVertexCounts()
+{
+	IBrushNodePtr brushNode = std::dynamic_pointer_cast<IBrushNode>(_node.lock());
+	if (brushNode == NULL) return std::vector<std::size_t>();
+
+	const auto& brush = brushNode->getIBrush();
+
+	std::vector<std::size_t> counts;
+	counts.reserve(brush.getNumFaces());
+
+	for (std::size_t i = 0; i < brush.getNumFaces(); ++i)
+	{
+		counts.push_back(brush.getFace(i).getWinding().size());
+	}
+
+	return counts;
+}
+
 // Checks if the given SceneNode structure is a BrushNode
 bool ScriptBrushNode::isBrush(const ScriptSceneNode& node) 
 {
@@ -232,6 +373,9 @@ void BrushInterface::registerInterface(py::module& scope, py::dict& globals)
 	face.def("flipTexture", &ScriptFace::flipTexture);
 	face.def("normaliseTexture", &ScriptFace::normaliseTexture);
 	face.def("getWinding", &ScriptFace::getWinding, py::return_value_policy::reference);
+	face.def("getWindingVertices", &ScriptFace::getWindingVertices);
+	face.def("getWindingTexcoords", &ScriptFace::getWindingTexcoords);
+	face.def("getPlane", &ScriptFace::getPlane);
 
 	// Define a BrushNode interface
 	py::class_<ScriptBrushNode, ScriptSceneNode> brush(scope, "BrushNode");
@@ -247,6 +391,10 @@ void BrushInterface::registerInterface(py::module& scope, py::dict& globals)
 	brush.def("getFace", &ScriptBrushNode::getFace);
 	brush.def("getDetailFlag", &ScriptBrushNode::getDetailFlag);
 	brush.def("setDetailFlag", &ScriptBrushNode::setDetailFlag);
+	brush.def("getFacePlanes", &ScriptBrushNode::getFacePlanes);
+	brush.def("setFacePlanes", &ScriptBrushNode::setFacePlanes);
+	brush.def("getWindingVertices", &ScriptBrushNode::getWindingVertices);
+	brush.def("getWindingVertexCounts", &ScriptBrushNode::getWindingVertexCounts);
 
 	// Define the BrushCreator interface
 	py::class_<BrushInterface> brushCreator(scope, "BrushCreator");
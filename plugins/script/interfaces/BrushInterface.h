@@ -5,6 +5,7 @@
 #include "ibrush.h"
 
 #include "SceneGraphInterface.h"
+#include "GeometryBuffer.h"
 
 namespace script 
 {
@@ -40,6 +41,15 @@ public:
 	void normaliseTexture();
 
 	IWinding& getWinding();
+
+	// Returns the winding vertex positions as Nx3 array
+	ScriptGeometryBuffer getWindingVertices();
+
+	// Returns the winding texture coordinates as Nx2 array
+	ScriptGeometryBuffer getWindingTexcoords();
+
+	// Returns the face plane as (a, b, c, d) array
+	ScriptGeometryBuffer getPlane();
 };
 
 class ScriptBrushNode :
@@ -87,6 +97,19 @@ public:
 	// Call this before manipulating the brush to make your action undo-able.
 	void undoSave();
 
+	// Returns the planes of all faces as Fx4 array, one (a, b, c, d) row per face
+	ScriptGeometryBuffer getFacePlanes();
+
+	// Replaces the face planes with the rows of the given Fx4 buffer, F must match
+	// the number of faces. Shaders and texture projections of the faces are preserved.
+	void setFacePlanes(const py::buffer& planes);
+
+	// Returns the winding vertices of all faces as one Nx3 array,
+	// getWindingVertexCounts() returns the number of vertices contributed by each face
+	ScriptGeometryBuffer getWindingVertices();
+
+	std::vector<std::size_t> getWindingVertexCounts();
+
 	// Checks if the given SceneNode structure is a BrushNode
 	static bool isBrush(const ScriptSceneNode& node);
 
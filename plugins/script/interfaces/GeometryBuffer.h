@@ -0,0 +1,153 @@
+#pragma once
+
+#include <vector>
+#include <functional>
+#include <stdexcept>
+#include <pybind11/pybind11.h>
+
+namespace py = pybind11;
+
+namespace script
+{
+
+/**
+ * Contiguous n-dimensional array of doubles, handed out to Python by the bulk
+ * geometry accessors. Implements the buffer protocol, so scripts can wrap it
+ * with numpy.asarray() or memoryview() without copying the contents.
+ */
+class ScriptGeometryBuffer
+{
+private:
+    std::vector<py::ssize_t> _shape;
+    std::vector<double> _data;
+
+public:
+    ScriptGeometryBuffer(std::vector<py::ssize_t> shape) :
+        _shape(std::move(shape))
+    {
+        py::ssize_t size = 1;
+
+        for (auto dim : _shape)
+        {
+            size *= dim;
+        }
+
+        _data.resize(static_cast<std::size_t>(size));
+    }
+
+    double* data()
+    {
+        return _data.data();
+    }
+
+    const std::vector<py::ssize_t>& getShape() const
+    {
+        return _shape;
+    }
+
+    std::size_t size() const
+    {
+        return _data.size();
+    }
+
+    py::buffer_info getBufferInfo()
+    {
+        // Row-major strides
+        std::vector<py::ssize_t> strides(_shape.size());
+        py::ssize_t stride = sizeof(double);
+
+        for (auto i = _shape.size(); i-- > 0;)
+        {
+            strides[i] = stride;
+            stride *= _shape[i];
+        }
+
+        return py::buffer_info(_data.data(), sizeof(double), py::format_descriptor<double>::format(),
+            static_cast<py::ssize_t>(_shape.size()), _shape, strides);
+    }
+
+    // Registers the GeometryBuffer type in the given scope
+    static void Register(py::module& scope)
+    {
+        py::class_<ScriptGeometryBuffer> buffer(scope, "GeometryBuffer", py::buffer_protocol());
+        buffer.def_buffer(&ScriptGeometryBuffer::getBufferInfo);
+        buffer.def("getShape", [](const ScriptGeometryBuffer& self)
+        {
+            py::tuple shape(self.getShape().size());
+
+            for (std::size_t i = 0; i < self.getShape().size(); ++i)
+            {
+                shape[i] = self.getShape()[i];
+            }
+
+            return shape;
+        });
+        buffer.def("__len__", [](const ScriptGeometryBuffer& self) { return self.getShape().empty() ? 0 : self.getShape().front(); });
+    }
+};
+
+/**
+ * Reads an arbitrary (possibly non-contiguous) buffer of floats or doubles passed in
+ * from Python, e.g. a numpy array, a memoryview or a GeometryBuffer.
+ * The buffer needs to have the given number of dimensions, a negative size in
+ * the expected shape accepts any extent in that dimension.
+ * The values are copied into a flat, row-major vector.
+ * Throws std::invalid_argument (ValueError in Python) if the buffer doesn't match.
+ */
+inline std::vector<double> readGeometryBuffer(const py::buffer& buffer, const std::vector<py::ssize_t>& expectedShape,
+    std::vector<py::ssize_t>* actualShape = nullptr)
+{
+    auto info = buffer.request();
+
+    bool isDouble = info.format == py::format_descriptor<double>::format();
+    bool isFloat = info.format == py::format_descriptor<float>::format();
+
+    if (!isDouble && !isFloat)
+    {
+        throw std::invalid_argument("Expected a buffer of float or double values, got format " + info.format);
+    }
+
+    if (info.ndim != static_cast<py::ssize_t>(expectedShape.size()))
+    {
+        throw std::invalid_argument("Expected a buffer with " + std::to_string(expectedShape.size()) +
+            " dimensions, got " + std::to_string(info.ndim));
+    }
+
+    for (std::size_t i = 0; i < expectedShape.size(); ++i)
+    {
+        if (expectedShape[i] >= 0 && info.shape[i] != expectedShape[i])
+        {
+            throw std::invalid_argument("Buffer dimension " + std::to_string(i) + " has size " +
+                std::to_string(info.shape[i]) + ", expected " + std::to_string(expectedShape[i]));
+        }
+    }
+
+    if (actualShape != nullptr)
+    {
+        *actualShape = info.shape;
+    }
+
+    std::vector<double> result;
+    result.reserve(static_cast<std::size_t>(info.size));
+
+    // Walk the buffer in row-major order respecting the strides
+    std::function<void(py::ssize_t, const char*)> readDimension = [&](py::ssize_t dim, const char* ptr)
+    {
+        if (dim == info.ndim)
+        {
+            result.push_back(isDouble ? *reinterpret_cast<const double*>(ptr) : *reinterpret_cast<const float*>(ptr));
+            return;
+        }
+
+        for (py::ssize_t i = 0; i < info.shape[dim]; ++i)
+        {
+            readDimension(dim + 1, ptr + i * info.strides[dim]);
+        }
+    };
+
+    readDimension(0, static_cast<const char*>(info.ptr));
+
+    return result;
+}
+
+}
@@ -79,6 +79,99 @@ PatchControl& ScriptPatchNode::ctrlAt(std::size_t row, std::size_t col)
 	return patchNode->getPatch().ctrlAt(row, col);
 }
 
+ScriptGeometryBuffer ScriptPatchNode::getControlVertices() const
+{
+	IPatchNodePtr patchNode = std::dynamic_pointer_cast<IPatchNode>(_node.lock());
+	if (patchNode == NULL) return ScriptGeometryBuffer({ 0, 0, 3 });
+
+	const IPatch& patch = patchNode->getPatch();
+
+	ScriptGeometryBuffer buffer({ static_cast<py::ssize_t>(patch.getHeight()), static_cast<py::ssize_t>(patch.getWidth()), 3 });
+	auto* data = buffer.data();
+
+	for (std::size_t row = 0; row < patch.getHeight(); ++row)
+	{
+		for (std::size_t col = 0; col < patch.getWidth(); ++col)
+		{
+			const auto& vertex = patch.ctrlAt(row, col).vertex;
+
+			*data++ = vertex.x();
+			*data++ = vertex.y();
+			*data++ = vertex.z();
+		}
+	}
+
+	return buffer;
+}
+
+void ScriptPatchNode::setControlVertices(const py::buffer& vertices)
+{
+	IPatchNodePtr patchNode = std::dynamic_pointer_cast<IPatchNode>(_node.lock());
+	if (patchNode == NULL) return;
+
+	IPatch& patch = patchNode->getPatch();
+
+	auto values = readGeometryBuffer(vertices,
+		{ static_cast<py::ssize_t>(patch.getHeight()), static_cast<py::ssize_t>(patch.getWidth()), 3 });
+	const auto* data = values.data();
+
+	for (std::size_t row = 0; row < patch.getHeight(); ++row)
+	{
+		for (std::size_t col = 0; col < patch.getWidth(); ++col, data += 3)
+		{
+			patch.ctrlAt(row, col).vertex.set(data[0], data[1], data[2]);
+		}
+	}
+
+	patch.controlPointsChanged();
+}
+
+ScriptGeometryBuffer ScriptPatchNode::getControlTexcoords() const
+{
+	IPatchNodePtr patchNode = std::dynamic_pointer_cast<IPatchNode>(_node.lock());
+	if (patchNode == NULL) return ScriptGeometryBuffer({ 0, 0, 2 });
+
+	const IPatch& patch = patchNode->getPatch();
+
+	ScriptGeometryBuffer buffer({ static_cast<py::ssize_t>(patch.getHeight()), static_cast<py::ssize_t>(patch.getWidth()), 2 });
+	auto* data = buffer.data();
+
+	for (std::size_t row = 0; row < patch.getHeight(); ++row)
+	{
+		for (std::size_t col = 0; col < patch.getWidth(); ++col)
+		{
+			const auto& texcoord = patch.ctrlAt(row, col).texcoord;
+
+			*data++ = texcoord.x();
+			*data++ = texcoord.y();
+		}
+	}
+
+	return buffer;
+}
+
+void ScriptPatchNode::setControlTexcoords(const py::buffer& texcoords)
+{
+	IPatchNodePtr patchNode = std::dynamic_pointer_cast<IPatchNode>(_node.lock());
+	if (patchNode == NULL) return;
+
+	IPatch& patch = patchNode->getPatch();
+
+	auto values = readGeometryBuffer(texcoords,
+		{ static_cast<py::ssize_t>(patch.getHeight()), static_cast<py::ssize_t>(patch.getWidth()), 2 });
+	const auto* data = values.data();
+
+	for (std::size_t row = 0; row < patch.getHeight(); ++row)
+	{
+		for (std::size_t col = 0; col < patch.getWidth(); ++col, data += 2)
+		{
+			patch.ctrlAt(row, col).texcoord = Vector2(data[0], data[1]);
+		}
+	}
+
+	patch.controlPointsChanged();
+}
+
 void ScriptPatchNode::insertColumns(std::size_t colIndex)
 {
 	IPatchNodePtr patchNode = std::dynamic_pointer_cast<IPatchNode>(_node.lock());
@@ -251,6 +344,10 @@ void PatchInterface::registerInterface(py::module& scope, py::dict& globals)
 	patchNode.def("getWidth", &ScriptPatchNode::getWidth);
 	patchNode.def("getHeight", &ScriptPatchNode::getHeight);
 	patchNode.def("ctrlAt", &ScriptPatchNode::ctrlAt, py::return_value_policy::reference_internal);
+	patchNode.def("getControlVertices", &ScriptPatchNode::getControlVertices);
+	patchNode.def("setControlVertices", &ScriptPatchNode::setControlVertices);
+	patchNode.def("getControlTexcoords", &ScriptPatchNode::getControlTexcoords);
+	patchNode.def("setControlTexcoords", &ScriptPatchNode::setControlTexcoords);
 	patchNode.def("insertColumns", &ScriptPatchNode::insertColumns);
 	patchNode.def("insertRows", &ScriptPatchNode::insertRows);
 	patchNode.def("removePoints", &ScriptPatchNode::removePoints);
@@ -5,6 +5,7 @@
 #include "ipatch.h"
 
 #include "SceneGraphInterface.h"
+#include "GeometryBuffer.h"
 
 namespace script
 {
@@ -37,6 +38,19 @@ public:
 	// Return a defined patch control vertex at <row>,<col>
 	PatchControl& ctrlAt(std::size_t row, std::size_t col);
 
+	// Returns all control vertex positions as (height x width x 3) array
+	ScriptGeometryBuffer getControlVertices() const;
+
+	// Assigns the control vertex positions from a (height x width x 3) buffer,
+	// the buffer dimensions must match the patch dimensions
+	void setControlVertices(const py::buffer& vertices);
+
+	// Returns all control texture coordinates as (height x width x 2) array
+	ScriptGeometryBuffer getControlTexcoords() const;
+
+	// Assigns the control texture coordinates from a (height x width x 2) buffer
+	void setControlTexcoords(const py::buffer& texcoords);
+
 	void insertColumns(std::size_t colIndex);
 	void insertRows(std::size_t rowIndex);
 
@@ -4,6 +4,7 @@
 #include "scenelib.h"
 #include "iselection.h"
 #include "debugging/ScenegraphUtils.h"
+#include "string/convert.h"
 
 #include "ModelInterface.h"
 #include "BrushInterface.h"
@@ -119,8 +120,105 @@ ScriptSceneNode SceneGraphInterface::root()
 	return ScriptSceneNode(GlobalSceneGraph().root());
 }
 
+namespace
+{
+	py::list findNodes(const ScriptSceneNode& root, const std::function<bool(const scene::INodePtr&)>& predicate)
+	{
+		py::list result;
+
+		scene::INodePtr rootNode = root;
+		if (!rootNode) return result;
+
+		rootNode->foreachNode([&](const scene::INodePtr& node)
+		{
+			if (predicate(node))
+			{
+				result.append(ScriptSceneNode(node));
+			}
+
+			return true;
+		});
+
+		return result;
+	}
+}
+
+py::list SceneGraphInterface::findEntities(const ScriptSceneNode& root)
+{
+	return findNodes(root, Node_isEntity);
+}
+
+py::list SceneGraphInterface::findBrushes(const ScriptSceneNode& root)
+{
+	return findNodes(root, Node_isBrush);
+}
+
+py::list SceneGraphInterface::findPatches(const ScriptSceneNode& root)
+{
+	return findNodes(root, Node_isPatch);
+}
+
+ScriptGeometryBuffer SceneGraphInterface::getEntityOrigins(const py::list& nodes)
+{
+	ScriptGeometryBuffer buffer({ static_cast<py::ssize_t>(nodes.size()), 3 });
+	auto* data = buffer.data();
+
+	for (const auto& item : nodes)
+	{
+		auto* entity = Node_getEntity(item.cast<const ScriptSceneNode&>());
+		auto origin = entity != nullptr ? string::convert<Vector3>(entity->getKeyValue("origin")) : Vector3(0, 0, 0);
+
+		*data++ = origin.x();
+		*data++ = origin.y();
+		*data++ = origin.z();
+	}
+
+	return buffer;
+}
+
+void SceneGraphInterface::setEntityOrigins(const py::list& nodes, const py::buffer& origins)
+{
+	auto values = readGeometryBuffer(origins, { static_cast<py::ssize_t>(nodes.size()), 3 });
+	const auto* data = values.data();
+
+	for (const auto& item : nodes)
+	{
+		auto* entity = Node_getEntity(item.cast<const ScriptSceneNode&>());
+
+		if (entity != nullptr)
+		{
+			entity->setKeyValue("origin", string::to_string(Vector3(data[0], data[1], data[2])));
+		}
+
+		data += 3;
+	}
+}
+
+ScriptGeometryBuffer SceneGraphInterface::getWorldAABBs(const py::list& nodes)
+{
+	ScriptGeometryBuffer buffer({ static_cast<py::ssize_t>(nodes.size()), 6 });
+	auto* data = buffer.data();
+
+	for (const auto& item : nodes)
+	{
+		const auto& aabb = item.cast<const ScriptSceneNode&>().getWorldAABB();
+
+		*data++ = aabb.origin.x();
+		*data++ = aabb.origin.y();
+		*data++ = aabb.origin.z();
+		*data++ = aabb.extents.x();
+		*data++ = aabb.extents.y();
+		*data++ = aabb.extents.z();
+	}
+
+	return buffer;
+}
+
 void SceneGraphInterface::registerInterface(py::module& scope, py::dict& globals)
 {
+	// Array type returned by the bulk geometry accessors
+	ScriptGeometryBuffer::Register(scope);
+
 	// Expose the scene::Node interface
 	py::class_<ScriptSceneNode> sceneNode(scope, "SceneNode");
 
@@ -161,6 +259,12 @@ void SceneGraphInterface::registerInterface(py::module& scope, py::dict& globals
 	// Add the module declaration to the given python namespace
 	py::class_<SceneGraphInterface> sceneGraphInterface(scope, "SceneGraph");
 	sceneGraphInterface.def("root", &SceneGraphInterface::root);
+	sceneGraphInterface.def("findEntities", &SceneGraphInterface::findEntities);
+	sceneGraphInterface.def("findBrushes", &SceneGraphInterface::findBrushes);
+	sceneGraphInterface.def("findPatches", &SceneGraphInterface::findPatches);
+	sceneGraphInterface.def("getEntityOrigins", &SceneGraphInterface::getEntityOrigins);
+	sceneGraphInterface.def("setEntityOrigins", &SceneGraphInterface::setEntityOrigins);
+	sceneGraphInterface.def("getWorldAABBs", &SceneGraphInterface::getWorldAABBs);
 
 	// Now point the Python variable "GlobalSceneGraph" to this instance
 	globals["GlobalSceneGraph"] = this;
@@ -5,6 +5,7 @@
 #include "iscriptinterface.h"
 #include "iscenegraph.h"
 #include "math/AABB.h"
+#include "GeometryBuffer.h"
 
 #include <pybind11/pybind11.h>
 
@@ -80,6 +81,23 @@ class SceneGraphInterface :
 public:
 	ScriptSceneNode root();
 
+	// Batched queries, returning all entity/brush/patch nodes below the given root node
+	// as list, in traversal order. Avoids one Python callback per visited node.
+	py::list findEntities(const ScriptSceneNode& root);
+	py::list findBrushes(const ScriptSceneNode& root);
+	py::list findPatches(const ScriptSceneNode& root);
+
+	// Returns the "origin" spawnargs of the given entity nodes as Nx3 array
+	// (0,0,0 for nodes which are not entities)
+	ScriptGeometryBuffer getEntityOrigins(const py::list& nodes);
+
+	// Assigns the "origin" spawnarg of the given entity nodes from the rows of the Nx3 buffer
+	void setEntityOrigins(const py::list& nodes, const py::buffer& origins);
+
+	// Returns the world AABBs of the given nodes as Nx6 array,
+	// each row containing the origin followed by the extents
+	ScriptGeometryBuffer getWorldAABBs(const py::list& nodes);
+
 	void registerInterface(py::module& scope, py::dict& globals) override;
 };
 
@@ -12,6 +12,7 @@
 #include <fmt/format.h>
 
 #include "iarchive.h"
+#include "isound.h"
 #include "stream/ScopedArchiveBuffer.h"
 #include "OggFileStream.h"
 
@@ -65,14 +66,24 @@ private:
     };
 public:
     /**
-     * greebo: Determines the OGG file length in seconds.
+     * greebo: Determines the OGG file length in seconds, the number of
+     * channels and the sample rate using libvorbis. This loads the whole
+     * file into memory, OggMetadataReader should be preferred.
      * @throws: std::runtime_error if an error occurs.
      */
-    static float GetDuration(ArchiveFile& vfsFile)
+    static SoundFileMetadata GetMetadata(ArchiveFile& vfsFile)
     {
         FileWrapper file(vfsFile);
 
-        return static_cast<float>(ov_time_total(file.getHandle(), -1));
+        vorbis_info* vorbisInfo = ov_info(file.getHandle(), -1);
+
+        SoundFileMetadata metadata;
+
+        metadata.duration = static_cast<float>(ov_time_total(file.getHandle(), -1));
+        metadata.channels = static_cast<unsigned int>(vorbisInfo->channels);
+        metadata.sampleRate = static_cast<unsigned int>(vorbisInfo->rate);
+
+        return metadata;
     }
 
     /**
@@ -0,0 +1,255 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include "idatastream.h"
+#include "isound.h"
+
+namespace sound
+{
+
+/**
+ * Determines the metadata of an Ogg Vorbis file without decoding it.
+ *
+ * Channels and sample rate are taken from the Vorbis identification header
+ * in the first page, the length is derived from the granule position (the
+ * sample count) of the last page of the stream. On seekable streams only
+ * the tail of the file is read to locate the last page, other streams are
+ * skipped through page by page without buffering the whole file.
+ */
+class OggMetadataReader
+{
+private:
+    typedef StreamBase::byte_type byte;
+
+    // Size of the fixed part of an Ogg page header, followed by the segment table
+    static constexpr std::size_t PageHeaderSize = 27;
+
+    // Largest possible page: header, 255 segment entries and 255 segments of 255 bytes
+    static constexpr std::size_t MaxPageSize = PageHeaderSize + 255 + 255 * 255;
+
+    struct PageHeader
+    {
+        int64_t granulePosition = -1;
+        uint32_t serialNumber = 0;
+        std::size_t bodySize = 0;
+    };
+
+public:
+    /**
+     * Reads the metadata of the first logical stream in the given file.
+     * @throws: std::runtime_error if the stream is not a valid Ogg Vorbis stream.
+     */
+    static SoundFileMetadata Read(InputStream& stream, std::size_t fileSize)
+    {
+        SoundFileMetadata metadata;
+
+        // The first page carries the identification header and nothing else
+        PageHeader firstPage;
+        std::size_t firstPageSize = 0;
+
+        if (!ReadPageHeader(stream, firstPage, firstPageSize))
+        {
+            throw std::runtime_error("No Ogg page found");
+        }
+
+        std::vector<byte> body(firstPage.bodySize);
+
+        if (stream.read(body.data(), body.size()) != body.size() || body.size() < 30 ||
+            body[0] != 1 || std::memcmp(body.data() + 1, "vorbis", 6) != 0)
+        {
+            throw std::runtime_error("No Vorbis identification header");
+        }
+
+        metadata.channels = body[11];
+        metadata.sampleRate = ReadLittleEndian<uint32_t>(body.data() + 12);
+
+        if (metadata.channels == 0 || metadata.sampleRate == 0)
+        {
+            throw std::runtime_error("Invalid Vorbis identification header");
+        }
+
+        auto position = firstPageSize + firstPage.bodySize;
+
+        auto sampleCount = dynamic_cast<SeekableInputStream*>(&stream) != nullptr && fileSize > position ?
+            FindLastGranuleInTail(static_cast<SeekableInputStream&>(stream), fileSize, position, firstPage.serialNumber) :
+            FindLastGranuleInPages(stream, firstPage.serialNumber);
+
+        if (sampleCount < 0)
+        {
+            throw std::runtime_error("Could not determine the Ogg stream length");
+        }
+
+        metadata.duration = static_cast<float>(static_cast<double>(sampleCount) / metadata.sampleRate);
+
+        return metadata;
+    }
+
+private:
+    template<typename T>
+    static T ReadLittleEndian(const byte* data)
+    {
+        T value = 0;
+
+        for (std::size_t i = sizeof(T); i-- > 0;)
+        {
+            value = static_cast<T>((value << 8) | data[i]);
+        }
+
+        return value;
+    }
+
+    // Reads the page header including the segment table, returns false at the end of the stream
+    static bool ReadPageHeader(InputStream& stream, PageHeader& header, std::size_t& headerSize)
+    {
+        byte fixed[PageHeaderSize];
+
+        if (stream.read(fixed, PageHeaderSize) != PageHeaderSize)
+        {
+            return false;
+        }
+
+        if (std::memcmp(fixed, "OggS", 4) != 0)
+        {
+            throw std::runtime_error("Lost Ogg page synchronisation");
+        }
+
+        byte segments[255];
+        std::size_t numSegments = fixed[26];
+
+        if (stream.read(segments, numSegments) != numSegments)
+        {
+            return false;
+        }
+
+        header.granulePosition = static_cast<int64_t>(ReadLittleEndian<uint64_t>(fixed + 6));
+        header.serialNumber = ReadLittleEndian<uint32_t>(fixed + 14);
+        header.bodySize = 0;
+
+        for (std::size_t i = 0; i < numSegments; ++i)
+        {
+            header.bodySize += segments[i];
+        }
+
+        headerSize = PageHeaderSize + numSegments;
+        return true;
+    }
+
+    // Walks all remaining pages, returning the last granule position of the given stream
+    static int64_t FindLastGranuleInPages(InputStream& stream, uint32_t serialNumber)
+    {
+        int64_t granulePosition = -1;
+        std::vector<byte> scratch(255 * 255);
+
+        PageHeader header;
+        std::size_t headerSize = 0;
+
+        while (ReadPageHeader(stream, header, headerSize))
+        {
+            if (stream.read(scratch.data(), header.bodySize) != header.bodySize)
+            {
+                break;
+            }
+
+            if (header.serialNumber == serialNumber && header.granulePosition != -1)
+            {
+                granulePosition = header.granulePosition;
+            }
+        }
+
+        return granulePosition;
+    }
+
+    // Reads the end of the file and searches it backwards for the last complete page of the given stream
+    static int64_t FindLastGranuleInTail(SeekableInputStream& stream, std::size_t fileSize,
+        std::size_t position, uint32_t serialNumber)
+    {
+        auto tailStart = std::max(position, fileSize > MaxPageSize ? fileSize - MaxPageSize : 0);
+
+        std::vector<byte> tail(fileSize - tailStart);
+
+        stream.seek(static_cast<SeekableStream::position_type>(tailStart));
+        tail.resize(stream.read(tail.data(), tail.size()));
+
+        for (auto offset = tail.size(); offset-- > 0;)
+        {
+            if (offset + PageHeaderSize > tail.size() || std::memcmp(tail.data() + offset, "OggS", 4) != 0)
+            {
+                continue;
+            }
+
+            const auto* page = tail.data() + offset;
+            std::size_t numSegments = page[26];
+
+            if (offset + PageHeaderSize + numSegments > tail.size())
+            {
+                continue;
+            }
+
+            std::size_t pageSize = PageHeaderSize + numSegments;
+
+            for (std::size_t i = 0; i < numSegments; ++i)
+            {
+                pageSize += page[PageHeaderSize + i];
+            }
+
+            // The capture pattern can occur in packet data, the checksum rules out false positives
+            if (offset + pageSize > tail.size() || !CheckPageCrc(page, pageSize))
+            {
+                continue;
+            }
+
+            auto granulePosition = static_cast<int64_t>(ReadLittleEndian<uint64_t>(page + 6));
+
+            if (ReadLittleEndian<uint32_t>(page + 14) == serialNumber && granulePosition != -1)
+            {
+                return granulePosition;
+            }
+        }
+
+        return -1;
+    }
+
+    static bool CheckPageCrc(const byte* page, std::size_t size)
+    {
+        static const auto table = CreateCrcTable();
+
+        uint32_t crc = 0;
+
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            // The checksum field itself is treated as zero
+            byte value = i >= 22 && i < 26 ? 0 : page[i];
+            crc = (crc << 8) ^ table[((crc >> 24) & 0xff) ^ value];
+        }
+
+        return crc == ReadLittleEndian<uint32_t>(page + 22);
+    }
+
+    // Lookup table for the Ogg CRC-32 (polynomial 0x04c11db7, no reflection)
+    static std::array<uint32_t, 256> CreateCrcTable()
+    {
+        std::array<uint32_t, 256> table;
+
+        for (uint32_t i = 0; i < 256; ++i)
+        {
+            uint32_t r = i << 24;
+
+            for (int bit = 0; bit < 8; ++bit)
+            {
+                r = (r & 0x80000000) ? (r << 1) ^ 0x04c11db7 : r << 1;
+            }
+
+            table[i] = r;
+        }
+
+        return table;
+    }
+};
+
+}
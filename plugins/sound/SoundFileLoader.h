@@ -38,7 +38,9 @@ public:
     SoundFileLoader() :
         parser::ThreadedDeclParser<ShaderMap>(
             decl::Type::SoundShader, SOUND_FOLDER, SOUND_FILE_EXTENSION, 99)
-    {}
+    {
+        useBlockCache();
+    }
 
 protected:
     void onBeginParsing() override
@@ -46,26 +48,17 @@ protected:
         _shaders.clear();
     }
 
-    void parse(std::istream& stream, const vfs::FileInfo& fileInfo, const std::string& modDir) override
+    void parseBlock(const parser::BlockTokeniser::Block& block, const vfs::FileInfo& fileInfo, const std::string& modDir) override
     {
-        // Construct a DefTokeniser to tokenise the string into sound shader decls
-        parser::BasicDefBlockTokeniser<std::istream> tok(stream);
+        // Create a new shader with this name
+        auto result = _shaders.emplace(block.name,
+            std::make_shared<SoundShader>(block.name, block.contents, fileInfo, modDir)
+        );
 
-        while (tok.hasMoreBlocks())
+        if (!result.second)
         {
-            // Retrieve a named definition block from the parser
-            parser::BlockTokeniser::Block block = tok.nextBlock();
-
-            // Create a new shader with this name
-            auto result = _shaders.emplace(block.name,
-                std::make_shared<SoundShader>(block.name, block.contents, fileInfo, modDir)
-            );
-
-            if (!result.second)
-            {
-                rError() << "[SoundManager]: SoundShader with name "
-                    << block.name << " already exists." << std::endl;
-            }
+            rError() << "[SoundManager]: SoundShader with name "
+                << block.name << " already exists." << std::endl;
         }
     }
 
@@ -8,10 +8,12 @@
 #include "string/case_conv.h"
 
 #include <algorithm>
+#include <optional>
 #include "itextstream.h"
 
 #include "WavFileLoader.h"
 #include "OggFileLoader.h"
+#include "OggMetadataReader.h"
 
 namespace sound
 {
@@ -19,43 +21,82 @@ namespace sound
 namespace
 {
 
-// Load the given file, trying different extensions (first OGG, then WAV) as fallback
-ArchiveFilePtr openSoundFile(const std::string& fileName)
+// Resolves the given file name to an existing VFS file, trying different extensions
+// (first OGG, then WAV) as fallback. Returns an empty info structure if not found.
+vfs::FileInfo findSoundFile(const std::string& fileName)
 {
-    // Make a copy of the filename
-    std::string name = fileName;
-
-    // Try to open the file as it is
-    auto file = GlobalFileSystem().openFile(name);
+    // Try to find the file as it is
+    auto fileInfo = GlobalFileSystem().getFileInfo(fileName);
 
-    if (file)
+    if (!fileInfo.isEmpty())
     {
-        // File found, play it
-        return file;
+        return fileInfo;
     }
 
-    std::string root = name;
+    std::string root = fileName;
 
     // File not found, try to strip the extension
-    if (name.rfind(".") != std::string::npos)
+    if (fileName.rfind(".") != std::string::npos)
     {
-        root = name.substr(0, name.rfind("."));
+        root = fileName.substr(0, fileName.rfind("."));
     }
 
-    // Try to open the .ogg variant
-    name = root + ".ogg";
+    // Try the .ogg variant
+    fileInfo = GlobalFileSystem().getFileInfo(root + ".ogg");
+
+    if (!fileInfo.isEmpty())
+    {
+        return fileInfo;
+    }
 
-    file = GlobalFileSystem().openFile(name);
+    // Try the file with .wav extension
+    return GlobalFileSystem().getFileInfo(root + ".wav");
+}
 
-    if (file)
+// Load the given file, trying different extensions (first OGG, then WAV) as fallback
+ArchiveFilePtr openSoundFile(const std::string& fileName)
+{
+    auto fileInfo = findSoundFile(fileName);
+
+    return !fileInfo.isEmpty() ? GlobalFileSystem().openFile(fileInfo.fullPath()) : ArchiveFilePtr();
+}
+
+// Returns an empty value if the file can't be opened or is not a supported format,
+// throws std::runtime_error if the file can't be parsed
+std::optional<SoundFileMetadata> readSoundFileMetadata(const std::string& vfsPath)
+{
+    auto extension = string::to_lower_copy(os::getExtension(vfsPath));
+
+    if (extension == "wav")
     {
-        return file;
+        auto file = GlobalFileSystem().openFile(vfsPath);
+        if (!file) return std::nullopt;
+
+        return WavFileLoader::GetMetadata(file->getInputStream());
     }
 
-    // Try to open the file with .wav extension
-    name = root + ".wav";
+    if (extension == "ogg")
+    {
+        try
+        {
+            auto file = GlobalFileSystem().openFile(vfsPath);
+            if (!file) return std::nullopt;
+
+            return OggMetadataReader::Read(file->getInputStream(), file->size());
+        }
+        catch (const std::runtime_error& ex)
+        {
+            rWarning() << "Falling back to libvorbis to read " << vfsPath << ": " << ex.what() << std::endl;
+        }
+
+        // Re-open the file, the stream has been partially consumed
+        auto file = GlobalFileSystem().openFile(vfsPath);
+        if (!file) return std::nullopt;
+
+        return OggFileLoader::GetMetadata(*file);
+    }
 
-    return GlobalFileSystem().openFile(name);
+    return std::nullopt;
 }
 
 }
@@ -163,37 +204,54 @@ void SoundManager::initialiseModule(const IApplicationContext& ctx)
         rMessage() << "SoundManager: sound output disabled" << std::endl;
     }
 
+    _metadataIndex.setCachePath(ctx.getCacheDataPath());
+
     _defLoader.start();
 }
 
+void SoundManager::shutdownModule()
+{
+    _metadataIndex.save();
+}
+
 float SoundManager::getSoundFileDuration(const std::string& vfsPath)
 {
-    auto file = openSoundFile(vfsPath);
+    return getSoundFileMetadata(vfsPath).duration;
+}
+
+SoundFileMetadata SoundManager::getSoundFileMetadata(const std::string& vfsPath)
+{
+    auto fileInfo = findSoundFile(vfsPath);
 
-    if (!file)
+    if (fileInfo.isEmpty())
     {
         throw std::out_of_range("Could not resolve sound file " + vfsPath);
     }
 
-    auto extension = string::to_lower_copy(os::getExtension(file->getName()));
+    if (auto indexed = _metadataIndex.find(fileInfo); indexed)
+    {
+        return *indexed;
+    }
 
     try
     {
-        if (extension == "wav")
-        {
-            return WavFileLoader::GetDuration(file->getInputStream());
-        }
-        else if (extension == "ogg")
+        auto metadata = readSoundFileMetadata(fileInfo.fullPath());
+
+        // Failed reads are not indexed, they are attempted again on the next request
+        if (metadata && SoundMetadataIndex::IsValid(*metadata))
         {
-            return OggFileLoader::GetDuration(*file);
+            _metadataIndex.insert(fileInfo, *metadata);
+            return *metadata;
         }
+
+        rWarning() << "Could not read the metadata of sound file " << fileInfo.fullPath() << std::endl;
     }
     catch (const std::runtime_error& ex)
     {
         rError() << "Error determining sound file duration " << ex.what() << std::endl;
     }
 
-    return 0.0f;
+    return SoundFileMetadata();
 }
 
 void SoundManager::reloadSounds()
@@ -8,6 +8,7 @@
 
 #include "parser/ThreadedDeclParser.h"
 #include "SoundFileLoader.h"
+#include "SoundMetadataIndex.h"
 #include <map>
 
 namespace sound
@@ -32,6 +33,9 @@ private:
 
     sigc::signal<void> _sigSoundShadersReloaded;
 
+    // Durations of the sound files queried so far, persisted across sessions
+    SoundMetadataIndex _metadataIndex;
+
 private:
     void ensureShadersLoaded();
     void reloadSoundsCmd(const cmd::ArgumentList& args);
@@ -47,12 +51,14 @@ public:
 	void stopSound() override;
     void reloadSounds() override;
     float getSoundFileDuration(const std::string& vfsPath) override;
+    SoundFileMetadata getSoundFileMetadata(const std::string& vfsPath) override;
     sigc::signal<void>& signal_soundShadersReloaded() override;
 
 	// RegisterableModule implementation
 	const std::string& getName() const override;
 	const StringSet& getDependencies() const override;
 	void initialiseModule(const IApplicationContext& ctx) override;
+	void shutdownModule() override;
 };
 
 }
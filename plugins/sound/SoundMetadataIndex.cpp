@@ -0,0 +1,160 @@
+#include "SoundMetadataIndex.h"
+
+#include <fstream>
+#include <sstream>
+#include <fmt/format.h>
+
+#include "itextstream.h"
+#include "os/fs.h"
+#include "os/path.h"
+#include "string/convert.h"
+#include "string/split.h"
+
+namespace sound
+{
+
+namespace
+{
+    constexpr const char* const INDEX_FILENAME = "soundmetadata.txt";
+
+    // First line of the index file, changing it discards all existing indices
+    constexpr const char* const INDEX_HEADER = "DarkRadiant Sound Metadata Index 1";
+}
+
+SoundMetadataIndex::SoundMetadataIndex() :
+    _loaded(false),
+    _modified(false)
+{}
+
+void SoundMetadataIndex::setCachePath(const std::string& cachePath)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+
+    _filename = os::standardPathWithSlash(cachePath) + INDEX_FILENAME;
+}
+
+std::optional<SoundFileMetadata> SoundMetadataIndex::find(const vfs::FileInfo& fileInfo)
+{
+    auto stamp = GetStamp(fileInfo);
+
+    std::lock_guard<std::mutex> lock(_lock);
+
+    ensureLoaded();
+
+    auto existing = _entries.find(fileInfo.fullPath());
+
+    if (existing == _entries.end() || stamp.empty() || existing->second.stamp != stamp)
+    {
+        return std::nullopt;
+    }
+
+    return existing->second.metadata;
+}
+
+void SoundMetadataIndex::insert(const vfs::FileInfo& fileInfo, const SoundFileMetadata& metadata)
+{
+    auto stamp = GetStamp(fileInfo);
+    auto path = fileInfo.fullPath();
+
+    // Tabs and line breaks would break the file format
+    if (stamp.empty() || !IsValid(metadata) || path.find_first_of("\t\r\n") != std::string::npos)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_lock);
+
+    ensureLoaded();
+
+    _entries[path] = Entry{ stamp, metadata };
+    _modified = true;
+}
+
+void SoundMetadataIndex::save()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+
+    if (!_modified || _filename.empty()) return;
+
+    std::error_code ec;
+    fs::create_directories(fs::path(_filename).parent_path(), ec);
+
+    std::ofstream stream(_filename);
+
+    if (!stream)
+    {
+        rWarning() << "Cannot write sound metadata index to " << _filename << std::endl;
+        return;
+    }
+
+    stream << INDEX_HEADER << std::endl;
+
+    for (const auto& [path, entry] : _entries)
+    {
+        stream << fmt::format("{0}\t{1}\t{2}\t{3}\t{4}\n", path, entry.stamp,
+            entry.metadata.duration, entry.metadata.channels, entry.metadata.sampleRate);
+    }
+
+    _modified = false;
+}
+
+void SoundMetadataIndex::ensureLoaded()
+{
+    if (_loaded || _filename.empty()) return;
+
+    _loaded = true;
+
+    std::ifstream stream(_filename);
+    std::string line;
+
+    if (!stream || !std::getline(stream, line) || line != INDEX_HEADER)
+    {
+        return;
+    }
+
+    while (std::getline(stream, line))
+    {
+        std::vector<std::string> parts;
+        string::split(parts, line, "\t", false);
+
+        if (parts.size() != 5) continue;
+
+        Entry entry;
+        entry.stamp = parts[1];
+        entry.metadata.duration = string::convert<float>(parts[2]);
+        entry.metadata.channels = string::convert<unsigned int>(parts[3]);
+        entry.metadata.sampleRate = string::convert<unsigned int>(parts[4]);
+
+        // Older indices might contain entries of files that failed to load
+        if (!IsValid(entry.metadata)) continue;
+
+        _entries.emplace(parts[0], entry);
+    }
+
+    rMessage() << "SoundManager: " << _entries.size() << " entries in sound metadata index" << std::endl;
+}
+
+bool SoundMetadataIndex::IsValid(const SoundFileMetadata& metadata)
+{
+    return metadata.channels > 0 && metadata.sampleRate > 0;
+}
+
+std::string SoundMetadataIndex::GetStamp(const vfs::FileInfo& fileInfo)
+{
+    // Files in PK4s are stamped using the archive's modification time
+    auto sourcePath = fileInfo.getIsPhysicalFile() ?
+        os::standardPathWithSlash(fileInfo.getArchivePath()) + fileInfo.fullPath() :
+        fileInfo.getArchivePath();
+
+    std::error_code ec;
+    auto modificationTime = fs::last_write_time(sourcePath, ec);
+
+    if (ec)
+    {
+        return {};
+    }
+
+    return fmt::format("{0}|{1}|{2}", sourcePath, modificationTime.time_since_epoch().count(), fileInfo.getSize());
+}
+
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+
+#include "ifilesystem.h"
+#include "isound.h"
+
+namespace sound
+{
+
+/**
+ * Persistent index of sound file metadata (duration, channels, sample rate),
+ * such that the sound chooser doesn't need to open thousands of files to
+ * display their durations. Each entry remembers the modification time and
+ * size of the file (or the PK4 containing it) it has been created from,
+ * changed files are treated as missing from the index.
+ *
+ * The index is loaded from the cache folder on first access and written
+ * back on save(). All methods are thread-safe.
+ */
+class SoundMetadataIndex
+{
+private:
+    struct Entry
+    {
+        // Identifies the state of the source file this entry has been created from
+        std::string stamp;
+        SoundFileMetadata metadata;
+    };
+
+    std::string _filename;
+
+    // Entries by VFS path
+    std::map<std::string, Entry> _entries;
+    bool _loaded;
+    bool _modified;
+
+    std::mutex _lock;
+
+public:
+    SoundMetadataIndex();
+
+    // Sets the cache folder the index is stored in
+    void setCachePath(const std::string& cachePath);
+
+    // Returns the metadata of the given file, if it has been indexed since the file last changed
+    std::optional<SoundFileMetadata> find(const vfs::FileInfo& fileInfo);
+
+    // Stores the metadata of the given file in the index. Invalid metadata is not stored.
+    void insert(const vfs::FileInfo& fileInfo, const SoundFileMetadata& metadata);
+
+    // Returns true if the metadata describes a readable sound (at least one channel and a sample rate)
+    static bool IsValid(const SoundFileMetadata& metadata);
+
+    // Writes the index to disk, if it has been modified
+    void save();
+
+private:
+    void ensureLoaded();
+
+    // Returns the modification time and size identifying the current state of the file,
+    // or an empty string if the file can't be found on disk
+    static std::string GetStamp(const vfs::FileInfo& fileInfo);
+};
+
+}
@@ -2,6 +2,7 @@
 
 #include <stdexcept>
 #include "idatastream.h"
+#include "isound.h"
 
 #ifdef __APPLE__
 #include <OpenAL/al.h>
@@ -56,10 +57,11 @@ private:
 
 public:
     /**
-     * greebo: Determines the WAV file length in seconds.
+     * greebo: Determines the WAV file length in seconds, the number of
+     * channels and the sample rate.
      * @throws: std::runtime_error if an error occurs.
      */
-    static float GetDuration(InputStream& stream)
+    static SoundFileMetadata GetMetadata(InputStream& stream)
     {
         FileInfo info;
         ParseFileInfo(stream, info);
@@ -70,11 +72,22 @@ public:
         unsigned int remainingSize = 0;
         stream.read(reinterpret_cast<byte*>(&remainingSize), sizeof(remainingSize));
 
+        if (info.channels == 0 || info.freq == 0 || info.bps < 8)
+        {
+            throw std::runtime_error("Invalid 'fmt ' chunk.");
+        }
+
         // Calculate how many samples we have in the payload, then calculate the duration
         auto numSamples = remainingSize / (info.bps >> 3);
         auto numSamplesPerChannel = numSamples / info.channels;
 
-        return static_cast<float>(numSamplesPerChannel) / info.freq;
+        SoundFileMetadata metadata;
+
+        metadata.duration = static_cast<float>(numSamplesPerChannel) / info.freq;
+        metadata.channels = info.channels;
+        metadata.sampleRate = info.freq;
+
+        return metadata;
     }
 
 	/**
@@ -28,6 +28,7 @@
 
 #include "debugging/debugging.h"
 #include "debugging/gl.h"
+#include "debugging/ScopedTraceZone.h"
 #include <wx/sizer.h>
 #include "util/ScopedBoolLock.h"
 #include "CameraSettings.h"
@@ -662,6 +663,8 @@ void CamWnd::drawGrid()
 
 void CamWnd::Cam_Draw()
 {
+    profiling::ScopedTraceZone traceZone("render", "CamWnd::draw");
+
     wxSize glSize = _wxGLWidget->GetSize();
 
     if (_camera->getDeviceWidth() != glSize.GetWidth() || _camera->getDeviceHeight() != glSize.GetHeight())
@@ -804,7 +807,7 @@ void CamWnd::Cam_Draw()
         _renderer->prepare();
 
         // Front end (renderable collection from scene)
-        render::RenderableCollectionWalker::CollectRenderablesInScene(*_renderer, _view);
+        render::RenderableCollectionWalker::CollectRenderablesInScene(*_renderer, _view, _culledNodes);
 
         // Accumulate render statistics
         _renderStats.frontEndComplete();
@@ -19,6 +19,7 @@
 #include <wx/timer.h>
 #include <wx/stopwatch.h>
 #include "render/View.h"
+#include "render/RenderableCollectionWalker.h"
 
 #include "Rectangle.h"
 #include <memory>
@@ -62,6 +63,9 @@ class CamWnd :
 
     render::View _view;
 
+    // Nodes intersecting the view volume, re-used while the view doesn't change
+    render::CulledNodeCache _culledNodes;
+
     // The contained camera
     camera::ICameraView::Ptr _camera;
 
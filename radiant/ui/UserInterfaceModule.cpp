@@ -378,6 +378,18 @@ void UserInterfaceModule::refreshShadersCmd(const cmd::ArgumentList& args)
 	GlobalMainFrame().updateAllWindows();
 }
 
+void UserInterfaceModule::refreshChangedShadersCmd(const cmd::ArgumentList& args)
+{
+	// Only the materials of the changed files are updated, the rest stays realised
+	if (!GlobalMaterialManager().refreshChangedFiles())
+	{
+		rMessage() << "No changed material files found." << std::endl;
+		return;
+	}
+
+	GlobalMainFrame().updateAllWindows();
+}
+
 void UserInterfaceModule::registerUICommands()
 {
 	TexTool::registerCommands();
@@ -417,6 +429,7 @@ void UserInterfaceModule::registerUICommands()
 	GlobalCommandSystem().addCommand("EntityClassTree", EClassTree::ShowDialog);
 	GlobalCommandSystem().addCommand("EntityList", EntityList::toggle);
 	GlobalCommandSystem().addCommand("RefreshShaders", std::bind(&UserInterfaceModule::refreshShadersCmd, this, std::placeholders::_1));
+	GlobalCommandSystem().addCommand("RefreshChangedShaders", std::bind(&UserInterfaceModule::refreshChangedShadersCmd, this, std::placeholders::_1));
 
 	// ----------------------- Bind Events ---------------------------------------
 
@@ -86,6 +86,7 @@ private:
 	void applyBrushVertexColours();
 	void applyPatchVertexColours();
 	void refreshShadersCmd(const cmd::ArgumentList& args);
+	void refreshChangedShadersCmd(const cmd::ArgumentList& args);
 
 	void handleCommandExecutionFailure(radiant::CommandExecutionFailedMessage& msg);
 	static void HandleNotificationMessage(radiant::NotificationMessage& msg);
@@ -0,0 +1,184 @@
+#include "AasAreaTree.h"
+
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+#include "ivolumetest.h"
+
+namespace map
+{
+
+namespace
+{
+    // Maximum number of areas stored in a single leaf
+    constexpr std::size_t MAX_AREAS_PER_LEAF = 4;
+
+    // Squared distance of the given point to the box (0 if the point is inside)
+    inline double getDistanceSquared(const AABB& box, const Vector3& point)
+    {
+        double distSquared = 0;
+
+        for (int i = 0; i < 3; ++i)
+        {
+            auto delta = std::abs(point[i] - box.origin[i]) - box.extents[i];
+
+            if (delta > 0)
+            {
+                distSquared += delta * delta;
+            }
+        }
+
+        return distSquared;
+    }
+}
+
+void AasAreaTree::build(const std::vector<AABB>& areaBounds)
+{
+    clear();
+
+    _areaBounds = areaBounds;
+    _areaNumbers.resize(_areaBounds.size());
+    std::iota(_areaNumbers.begin(), _areaNumbers.end(), 0);
+
+    if (_areaNumbers.empty()) return;
+
+    // A binary tree with n leaves has 2n-1 nodes
+    _nodes.reserve(2 * (_areaNumbers.size() / MAX_AREAS_PER_LEAF + 1));
+
+    buildRecursively(0, _areaNumbers.size());
+}
+
+void AasAreaTree::clear()
+{
+    _nodes.clear();
+    _areaBounds.clear();
+    _areaNumbers.clear();
+}
+
+bool AasAreaTree::empty() const
+{
+    return _nodes.empty();
+}
+
+std::size_t AasAreaTree::buildRecursively(std::size_t first, std::size_t count)
+{
+    auto nodeIndex = _nodes.size();
+    _nodes.emplace_back();
+
+    AABB bounds;
+    AABB centroidBounds;
+
+    for (auto i = first; i < first + count; ++i)
+    {
+        const auto& areaBounds = _areaBounds[_areaNumbers[i]];
+
+        bounds.includeAABB(areaBounds);
+        centroidBounds.includePoint(areaBounds.origin);
+    }
+
+    _nodes[nodeIndex].bounds = bounds;
+
+    if (count <= MAX_AREAS_PER_LEAF)
+    {
+        _nodes[nodeIndex].firstArea = first;
+        _nodes[nodeIndex].numAreas = count;
+        _nodes[nodeIndex].secondChild = 0;
+        return nodeIndex;
+    }
+
+    // Split along the longest axis of the centroid bounds, at the median
+    std::size_t axis = 0;
+
+    for (std::size_t i = 1; i < 3; ++i)
+    {
+        if (centroidBounds.extents[i] > centroidBounds.extents[axis])
+        {
+            axis = i;
+        }
+    }
+
+    auto begin = _areaNumbers.begin() + first;
+    auto middle = begin + count / 2;
+
+    std::nth_element(begin, middle, begin + count, [&](std::size_t a, std::size_t b)
+    {
+        return _areaBounds[a].origin[axis] < _areaBounds[b].origin[axis];
+    });
+
+    auto firstHalf = count / 2;
+
+    // First child is placed right after this node
+    buildRecursively(first, firstHalf);
+    auto secondChild = buildRecursively(first + firstHalf, count - firstHalf);
+
+    _nodes[nodeIndex].firstArea = first;
+    _nodes[nodeIndex].numAreas = 0;
+    _nodes[nodeIndex].secondChild = secondChild;
+
+    return nodeIndex;
+}
+
+void AasAreaTree::forEachAreaInVolume(const VolumeTest& volume, const Vector3& viewPos,
+    double maxDistanceSquared, const std::function<void(std::size_t)>& functor) const
+{
+    if (_nodes.empty()) return;
+
+    bool testDistance = maxDistanceSquared >= 0;
+
+    // Nodes which are completely inside the view volume don't need to test their children
+    std::vector<std::pair<std::size_t, bool>> stack;
+    stack.reserve(64);
+    stack.emplace_back(0, true);
+
+    while (!stack.empty())
+    {
+        auto [nodeIndex, testVolume] = stack.back();
+        stack.pop_back();
+
+        const auto& node = _nodes[nodeIndex];
+
+        if (testDistance && getDistanceSquared(node.bounds, viewPos) > maxDistanceSquared)
+        {
+            continue;
+        }
+
+        if (testVolume)
+        {
+            auto intersection = volume.TestAABB(node.bounds);
+
+            if (intersection == VOLUME_OUTSIDE)
+            {
+                continue;
+            }
+
+            testVolume = intersection == VOLUME_PARTIAL;
+        }
+
+        if (node.numAreas == 0)
+        {
+            stack.emplace_back(node.secondChild, testVolume);
+            stack.emplace_back(nodeIndex + 1, testVolume);
+            continue;
+        }
+
+        for (auto i = node.firstArea; i < node.firstArea + node.numAreas; ++i)
+        {
+            auto areaNum = _areaNumbers[i];
+            const auto& areaBounds = _areaBounds[areaNum];
+
+            if (testDistance && (areaBounds.origin - viewPos).getLengthSquared() > maxDistanceSquared)
+            {
+                continue;
+            }
+
+            if (testVolume && volume.TestAABB(areaBounds) == VOLUME_OUTSIDE)
+            {
+                continue;
+            }
+
+            functor(areaNum);
+        }
+    }
+}
+
+} // namespace
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <vector>
+#include <functional>
+#include "math/AABB.h"
+
+class VolumeTest;
+
+namespace map
+{
+
+/**
+ * Bounding volume hierarchy over the area bounds of an AAS file.
+ * Used to quickly find the areas intersecting a view volume without
+ * having to test every single area.
+ *
+ * The tree is stored as flat array of nodes, the area indices are
+ * sorted such that every node references a contiguous range of them.
+ */
+class AasAreaTree
+{
+private:
+    struct Node
+    {
+        AABB bounds;
+
+        // Leaf nodes reference the range [firstArea, firstArea + numAreas)
+        // Inner nodes have numAreas == 0 and their second child at secondChild,
+        // the first child is always located right after the parent node
+        std::size_t firstArea;
+        std::size_t numAreas;
+        std::size_t secondChild;
+    };
+
+    std::vector<Node> _nodes;
+
+    // Area bounds, referenced by the area number
+    std::vector<AABB> _areaBounds;
+
+    // Area numbers, ordered such that each leaf refers to a contiguous block
+    std::vector<std::size_t> _areaNumbers;
+
+public:
+    // Rebuilds the tree from the given area bounds, the area number
+    // reported in queries is the index into the given vector
+    void build(const std::vector<AABB>& areaBounds);
+
+    void clear();
+
+    bool empty() const;
+
+    /**
+     * Invokes the functor for each area whose bounds are intersecting the given volume.
+     * If maxDistanceSquared is non-negative, areas whose origin is farther away from the
+     * given view position are skipped, along with all subtrees lying completely
+     * outside that radius.
+     */
+    void forEachAreaInVolume(const VolumeTest& volume, const Vector3& viewPos,
+        double maxDistanceSquared, const std::function<void(std::size_t)>& functor) const;
+
+private:
+    std::size_t buildRecursively(std::size_t first, std::size_t count);
+};
+
+} // namespace
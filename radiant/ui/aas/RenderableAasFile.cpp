@@ -6,6 +6,8 @@
 
 #include "registry/registry.h"
 
+#include <algorithm>
+
 namespace map
 {
 
@@ -13,6 +15,7 @@ RenderableAasFile::RenderableAasFile() :
 	_renderNumbers(registry::getValue<bool>(RKEY_SHOW_AAS_AREA_NUMBERS)),
 	_hideDistantAreas(registry::getValue<bool>(RKEY_HIDE_DISTANT_AAS_AREAS)),
 	_hideDistanceSquared(registry::getValue<float>(RKEY_AAS_AREA_HIDE_DISTANCE)),
+    _visibilityNeedsUpdate(true),
     _renderableAreas(_visibleAreas, { 1,1,1,1 })
 {
 	_hideDistanceSquared *= _hideDistanceSquared;
@@ -27,6 +30,7 @@ RenderableAasFile::RenderableAasFile() :
 void RenderableAasFile::onShowAreaNumbersChanged()
 {
     _renderNumbers = registry::getValue<bool>(RKEY_SHOW_AAS_AREA_NUMBERS);
+    _visibilityNeedsUpdate = true;
     GlobalMainFrame().updateAllWindows();
 }
 
@@ -35,13 +39,8 @@ void RenderableAasFile::onHideDistantAreasChanged()
     _hideDistantAreas = registry::getValue<bool>(RKEY_HIDE_DISTANT_AAS_AREAS);
     _hideDistanceSquared = registry::getValue<float>(RKEY_AAS_AREA_HIDE_DISTANCE);
     _hideDistanceSquared *= _hideDistanceSquared;
+    _visibilityNeedsUpdate = true;
 
-    if (!_hideDistantAreas)
-    {
-        _visibleAreas = _areas;
-    }
-
-    _renderableAreas.queueUpdate();
     GlobalMainFrame().updateAllWindows();
 }
 
@@ -64,45 +63,55 @@ void RenderableAasFile::onPreRender(const VolumeTest& volume)
     if (!_textRenderer)
     {
         _textRenderer = renderSystem->captureTextRenderer(IGLFont::Style::Sans, 14);
+        _visibilityNeedsUpdate = true;
     }
 
-    if (_hideDistantAreas)
+    updateVisibleAreas(volume);
+
+    _renderableAreas.update(_normalShader);
+}
+
+void RenderableAasFile::updateVisibleAreas(const VolumeTest& volume)
+{
+    // Get the camera position for distance clipping
+    auto invModelView = volume.GetModelview().getFullInverse();
+    auto viewPos = invModelView.tCol().getProjected();
+
+    // Cull the areas against the view frustum (and the distance if enabled)
+    _newlyVisibleAreaNumbers.clear();
+
+    _areaTree.forEachAreaInVolume(volume, viewPos, _hideDistantAreas ? _hideDistanceSquared : -1,
+        [&](std::size_t areaNum) { _newlyVisibleAreaNumbers.push_back(areaNum); });
+
+    std::sort(_newlyVisibleAreaNumbers.begin(), _newlyVisibleAreaNumbers.end());
+
+    // Leave the geometry alone if the set of visible areas didn't change
+    if (!_visibilityNeedsUpdate && _newlyVisibleAreaNumbers == _visibleAreaNumbers)
     {
-        // Get the camera position for distance clipping
-        auto invModelView = volume.GetModelview().getFullInverse();
-        auto viewPos = invModelView.tCol().getProjected();
-
-        _visibleAreas.clear();
-
-        for (const auto& area : _areas)
-        {
-            if ((area.getOrigin() - viewPos).getLengthSquared() > _hideDistanceSquared)
-            {
-                continue;
-            }
-
-            _visibleAreas.push_back(area);
-        }
-
-        for (auto& [areaNum, text] : _renderableNumbers)
-        {
-            text.setVisible(_renderNumbers && 
-                (_aasFile->getArea(areaNum).center - viewPos).getLengthSquared() <= _hideDistanceSquared);
-            text.update(_textRenderer);
-        }
-
-        _renderableAreas.queueUpdate();
+        return;
     }
-    else
+
+    _visibilityNeedsUpdate = false;
+
+    for (auto areaNum : _visibleAreaNumbers)
     {
-        for (auto& [_, text] : _renderableNumbers)
-        {
-            text.setVisible(_renderNumbers);
-            text.update(_textRenderer);
-        }
+        _renderableNumbers.at(areaNum).setVisible(false);
     }
 
-    _renderableAreas.update(_normalShader);
+    _visibleAreaNumbers.swap(_newlyVisibleAreaNumbers);
+    _visibleAreas.clear();
+    _visibleAreas.reserve(_visibleAreaNumbers.size());
+
+    for (auto areaNum : _visibleAreaNumbers)
+    {
+        _visibleAreas.push_back(_areas[areaNum]);
+
+        auto& text = _renderableNumbers.at(areaNum);
+        text.setVisible(_renderNumbers);
+        text.update(_textRenderer);
+    }
+
+    _renderableAreas.queueUpdate();
 }
 
 std::size_t RenderableAasFile::getHighlightFlags()
@@ -145,10 +154,11 @@ void RenderableAasFile::constructRenderables()
         _renderableNumbers.try_emplace(areaNum, string::to_string(areaNum), area.center, Vector4(1, 1, 1, 1));
 	}
 
-    if (!_hideDistantAreas)
-    {
-        _visibleAreas = _areas;
-    }
+    _areaTree.build(_areas);
+
+    _visibleAreas.clear();
+    _visibleAreaNumbers.clear();
+    _visibilityNeedsUpdate = true;
 
     _renderableAreas.queueUpdate();
 }
@@ -159,6 +169,8 @@ void RenderableAasFile::clear()
     _renderableAreas.clear();
     _areas.clear();
     _visibleAreas.clear();
+    _areaTree.clear();
+    _visibleAreaNumbers.clear();
     _renderableNumbers.clear();
     _normalShader.reset();
     _textRenderer.reset();
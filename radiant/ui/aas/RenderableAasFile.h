@@ -9,6 +9,7 @@
 
 #include "render/RenderableBoundingBoxes.h"
 #include "render/StaticRenderableText.h"
+#include "AasAreaTree.h"
 
 namespace map
 {
@@ -32,6 +33,14 @@ private:
     std::vector<AABB> _areas;
     std::vector<AABB> _visibleAreas;
 
+    // Spatial index used to cull the areas against the view
+    AasAreaTree _areaTree;
+
+    // The area numbers which passed the culling in the last frame (sorted)
+    std::vector<std::size_t> _visibleAreaNumbers;
+    std::vector<std::size_t> _newlyVisibleAreaNumbers;
+    bool _visibilityNeedsUpdate;
+
 	bool _renderNumbers;
 	bool _hideDistantAreas;
 	float _hideDistanceSquared;
@@ -58,6 +67,7 @@ private:
 	void constructRenderables();
     void onHideDistantAreasChanged();
     void onShowAreaNumbersChanged();
+    void updateVisibleAreas(const VolumeTest& volume);
 };
 
 } // namespace
@@ -295,7 +295,7 @@ bool ShaderSelector::onPreviewRender()
 	}
 	else {
 		// This is an "ordinary" texture, take the editor image
-		tex = shader->getEditorImage();
+		tex = shader->getEditorImagePreview();
 		if (tex != NULL) {
 			glBindTexture (GL_TEXTURE_2D, tex->getGLTexNum());
 			drawQuad = true;
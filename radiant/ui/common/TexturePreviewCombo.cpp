@@ -135,7 +135,7 @@ bool TexturePreviewCombo::_onRender()
 		MaterialPtr shader = GlobalMaterialManager().getMaterial(_texName);
 
 		// This is an "ordinary" texture, take the editor image
-		TexturePtr tex = shader->getEditorImage();
+		TexturePtr tex = shader->getEditorImagePreview();
 
 		if (tex != NULL)
 		{
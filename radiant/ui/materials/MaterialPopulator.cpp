@@ -1,6 +1,5 @@
 #include "MaterialPopulator.h"
 
-#include <map>
 #include "ifavourites.h"
 #include "i18n.h"
 #include "ishaders.h"
@@ -10,6 +9,7 @@
 #include "shaderlib.h"
 
 #include "wxutil/Bitmap.h"
+#include "wxutil/dataview/LazyVFSTreePopulator.h"
 #include "wxutil/dataview/TreeViewItemStyle.h"
 
 namespace ui
@@ -21,6 +21,27 @@ namespace
 
     constexpr const char* const FOLDER_ICON = "folder16.png";
     constexpr const char* const TEXTURE_ICON = "icon_texture.png";
+
+    // Returns the direct child of the given parent item with the given full name.
+    // This populates the children of the parent if they haven't been created yet.
+    wxDataViewItem findChildItem(wxutil::TreeModel& model, const wxDataViewItem& parent,
+        const wxutil::TreeModel::Column& fullNameColumn, const std::string& fullName)
+    {
+        wxDataViewItemArray children;
+        model.GetChildren(parent, children);
+
+        for (const auto& child : children)
+        {
+            wxutil::TreeModel::Row row(child, model);
+
+            if (static_cast<std::string>(row[fullNameColumn]) == fullName)
+            {
+                return child;
+            }
+        }
+
+        return wxDataViewItem();
+    }
 }
 
 struct ShaderNameFunctor
@@ -28,15 +49,8 @@ struct ShaderNameFunctor
     // TreeStore to populate
     wxutil::TreeModel& _store;
     const MaterialTreeView::TreeColumns& _columns;
-    const std::set<std::string>& _favourites;
-    wxDataViewItem _root;
-
-    std::string _otherMaterialsPath;
-
-    // Maps of names to corresponding treemodel items, for both intermediate
-    // paths and explicitly presented paths
-    using NamedIterMap = std::map<std::string, wxDataViewItem, string::ILess>;
-    NamedIterMap _iters;
+    // Copied, rows might be created after the populator is gone
+    std::set<std::string> _favourites;
 
     wxIcon _folderIcon;
     wxIcon _textureIcon;
@@ -44,9 +58,7 @@ struct ShaderNameFunctor
     ShaderNameFunctor(wxutil::TreeModel& store, const MaterialTreeView::TreeColumns& columns, const std::set<std::string>& favourites) :
         _store(store),
         _columns(columns),
-        _favourites(favourites),
-        _root(_store.GetRoot()),
-        _otherMaterialsPath(_(OTHER_MATERIALS_FOLDER))
+        _favourites(favourites)
     {
         _folderIcon.CopyFromBitmap(wxutil::GetLocalBitmap(FOLDER_ICON));
         _textureIcon.CopyFromBitmap(wxutil::GetLocalBitmap(TEXTURE_ICON));
@@ -56,21 +68,31 @@ struct ShaderNameFunctor
     {
         // Append a node to the tree view for this child
         auto row = _store.AddItem(parentItem);
+        populateFolder(row, path, leafName, isOtherMaterial);
+
+        return row;
+    }
+
+    wxutil::TreeModel::Row insertTexture(const std::string& path, const std::string& leafName, const wxDataViewItem& parentItem)
+    {
+        auto row = _store.AddItem(parentItem);
+        populateTexture(row, path, leafName);
+
+        return row;
+    }
 
+    void populateFolder(wxutil::TreeModel::Row& row, const std::string& path, const std::string& leafName, bool isOtherMaterial)
+    {
         row[_columns.iconAndName] = wxVariant(wxDataViewIconText(leafName, _folderIcon));
         row[_columns.leafName] = leafName;
         row[_columns.fullName] = path;
         row[_columns.isFolder] = true;
         row[_columns.isOtherMaterialsFolder] = isOtherMaterial;
         row[_columns.isFavourite] = false; // folders are not favourites
-
-        return row;
     }
 
-    wxutil::TreeModel::Row insertTexture(const std::string& path, const std::string& leafName, const wxDataViewItem& parentItem)
+    void populateTexture(wxutil::TreeModel::Row& row, const std::string& path, const std::string& leafName)
     {
-        auto row = _store.AddItem(parentItem);
-
         bool isFavourite = _favourites.count(path) > 0;
 
         row[_columns.iconAndName] = wxVariant(wxDataViewIconText(leafName, _textureIcon));
@@ -82,66 +104,6 @@ struct ShaderNameFunctor
 
         // Formatting
         row[_columns.iconAndName] = wxutil::TreeViewItemStyle::Declaration(isFavourite);
-
-        return row;
-    }
-
-    // Recursive add function
-    wxDataViewItem& addRecursive(const std::string& path, bool isOtherMaterial)
-    {
-        // Look up candidate in the map and return it if found
-        auto it = _iters.find(path);
-
-        if (it != _iters.end())
-        {
-            return it->second;
-        }
-
-        /* Otherwise, split the path on its rightmost slash, call recursively on the
-         * first half in order to add the parent node, then add the second half as
-         * a child. Recursive bottom-out is when there is no slash (top-level node).
-         */
-        // Find rightmost slash
-        std::size_t slashPos = path.rfind("/");
-
-        // Call recursively to get parent iter, leaving it at the toplevel if
-        // there is no slash
-        wxDataViewItem& parIter =
-            slashPos != std::string::npos ? addRecursive(path.substr(0, slashPos), isOtherMaterial) : _root;
-
-        std::string name = slashPos != std::string::npos ? path.substr(slashPos + 1) : path;
-
-        auto row = insertFolder(path, name, parIter, isOtherMaterial);
-
-        // Add a copy of the wxDataViewItem to our hashmap and return it
-        auto result = _iters.emplace(path, row.getItem());
-
-        return result.first->second;
-    }
-
-    void visit(const std::string& name)
-    {
-        // Find rightmost slash
-        std::size_t slashPos = name.rfind("/");
-
-        wxDataViewItem parent;
-
-        if (string::istarts_with(name, GlobalTexturePrefix_get()))
-        {
-            // Regular texture, ensure parent folder
-            parent = slashPos != std::string::npos ? addRecursive(name.substr(0, slashPos), false) : _root;
-        }
-        else
-        {
-            // Put it under "other materials", ensure parent folder
-            parent = slashPos != std::string::npos ?
-                addRecursive(_otherMaterialsPath + "/" + name.substr(0, slashPos), true) :
-                addRecursive(_otherMaterialsPath, true);
-        }
-
-        // Insert the actual leaf
-        auto leafName = slashPos != std::string::npos ? name.substr(slashPos + 1) : name;
-        insertTexture(name, leafName, parent);
     }
 };
 
@@ -193,7 +155,7 @@ void MaterialPopulator::AddSingleMaterial(const wxutil::TreeModel::Ptr& model, c
         parentPath += !parentPath.empty() ? "/" : "";
         parentPath += parts[i];
 
-        auto existingItem = model->FindString(parentPath, _columns.fullName, parentItem);
+        auto existingItem = findChildItem(*model, parentItem, _columns.fullName, parentPath);
 
         if (!existingItem.IsOk())
         {
@@ -214,7 +176,7 @@ void MaterialPopulator::AddSingleMaterial(const wxutil::TreeModel::Ptr& model, c
     itemPath += !itemPath.empty() ? "/" : "";
     itemPath += parts.back();
 
-    auto existingItem = model->FindString(itemPath, _columns.fullName, parentItem);
+    auto existingItem = findChildItem(*model, parentItem, _columns.fullName, itemPath);
 
     if (!existingItem.IsOk())
     {
@@ -251,39 +213,66 @@ void MaterialPopulator::PopulateModel(const wxutil::TreeModel::Ptr& model)
 {
     model->SetHasDefaultCompare(false);
 
-    ShaderNameFunctor functor(*model, _columns, _favourites);
+    // Materials are collected first, the rows of each folder are created
+    // in sorted order when the folder is expanded
+    wxutil::LazyVFSTreePopulator texturePopulator(model);
+    wxutil::LazyVFSTreePopulator otherMaterialsPopulator(model);
+
     GlobalMaterialManager().foreachShaderName([&](const std::string& name)
     {
         ThrowIfCancellationRequested();
-        functor.visit(name);
+
+        if (string::istarts_with(name, GlobalTexturePrefix_get()))
+        {
+            texturePopulator.addPath(name);
+        }
+        else
+        {
+            // Put it under "other materials"
+            otherMaterialsPopulator.addPath(name);
+        }
     });
-}
 
-void MaterialPopulator::SortModel(const wxutil::TreeModel::Ptr& model)
-{
-    // Sort the model while we're still in the worker thread
-    model->SortModelFoldersFirst(_columns.iconAndName, _columns.isFolder,
-        [&](const wxDataViewItem& a, const wxDataViewItem& b)
-    {
-        // Special folder comparison function
-        // A and B are both folders
-        wxVariant aIsOtherMaterialsFolder, bIsOtherMaterialsFolder;
+    ThrowIfCancellationRequested();
 
-        model->GetValue(aIsOtherMaterialsFolder, a, _columns.isOtherMaterialsFolder.getColumnIndex());
-        model->GetValue(bIsOtherMaterialsFolder, b, _columns.isOtherMaterialsFolder.getColumnIndex());
+    // The functor is used by the population functions, keep it alive along with the model
+    auto functor = std::make_shared<ShaderNameFunctor>(*model, _columns, _favourites);
 
-        // Special treatment for "Other Materials" folder, which always comes last
-        if (aIsOtherMaterialsFolder)
+    texturePopulator.populate([functor](wxutil::TreeModel&, wxutil::TreeModel::Row& row,
+        const std::string& path, const std::string& leafName, bool isFolder)
+    {
+        if (isFolder)
         {
-            return +1;
+            functor->populateFolder(row, path, leafName, false);
         }
-
-        if (bIsOtherMaterialsFolder)
+        else
         {
-            return -1;
+            functor->populateTexture(row, path, leafName);
         }
+    });
 
-        return 0; // no special folders, return equal to continue the regular sort algorithm
+    if (otherMaterialsPopulator.empty())
+    {
+        return;
+    }
+
+    // The "Other Materials" folder is added after all regular textures, it always comes last
+    std::string otherMaterialsPath = _(OTHER_MATERIALS_FOLDER);
+    auto otherMaterials = functor->insertFolder(otherMaterialsPath, otherMaterialsPath, model->GetRoot(), true);
+
+    otherMaterialsPopulator.setTopLevelItem(otherMaterials.getItem());
+    otherMaterialsPopulator.populate([functor, otherMaterialsPath](wxutil::TreeModel&, wxutil::TreeModel::Row& row,
+        const std::string& path, const std::string& leafName, bool isFolder)
+    {
+        // The folders carry the "Other Materials" prefix, the materials themselves don't
+        if (isFolder)
+        {
+            functor->populateFolder(row, otherMaterialsPath + "/" + path, leafName, true);
+        }
+        else
+        {
+            functor->populateTexture(row, path, leafName);
+        }
     });
 }
 
@@ -30,10 +30,9 @@ public:
     void RemoveSingleMaterial(const wxutil::TreeModel::Ptr& model, const std::string& materialName);
 
 protected:
+    // Creates the top-level rows, all folders are populated on demand
+    // with their children already in sorted order
     virtual void PopulateModel(const wxutil::TreeModel::Ptr& model) override;
-
-    // Special sort algorithm to sort the "Other Materials" separately
-    virtual void SortModel(const wxutil::TreeModel::Ptr& model) override;
 };
 
 }
@@ -1,10 +1,12 @@
 #pragma once
 
+#include <algorithm>
 #include "wxutil/dataview/VFSTreePopulator.h"
 #include "wxutil/dataview/TreeViewItemStyle.h"
 #include "ifavourites.h"
 #include "ModelSelector.h"
 #include "wxutil/Bitmap.h"
+#include "string/string.h"
 
 #include "ModelTreeView.h"
 
@@ -85,8 +87,9 @@ public:
 		if (!_includeSkins) return; // done
 
 		// Now check if there are any skins for this model, and add them as
-		// children if so
-		const StringList& skinList = GlobalModelSkinCache().getSkinsForModel(fullPath);
+		// children if so, the tree is not sorted after insertion
+		auto skinList = GlobalModelSkinCache().getSkinsForModel(fullPath);
+		std::sort(skinList.begin(), skinList.end(), string::ILess());
 
 		for (const auto& skinName : skinList)
 		{
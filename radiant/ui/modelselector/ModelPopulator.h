@@ -1,6 +1,6 @@
 #pragma once
 
-#include "wxutil/dataview/VFSTreePopulator.h"
+#include "wxutil/dataview/LazyVFSTreePopulator.h"
 #include "wxutil/dataview/ThreadedResourceTreePopulator.h"
 #include "iregistry.h"
 #include "igame.h"
@@ -25,7 +25,8 @@ namespace ui
 /**
  * Threaded functor object to visit the global VFS and add model paths 
  * to a new TreeModel object. Fires a PopulationFinished event once
- * its work is done.
+ * its work is done. Only the top-level rows are created in the worker,
+ * the folder contents are inserted (in sorted order) when they're expanded.
  */
 class ModelPopulator final :
     public wxutil::ThreadedResourceTreePopulator
@@ -63,7 +64,7 @@ public:
 protected:
     void PopulateModel(const wxutil::TreeModel::Ptr& model) override
     {
-        wxutil::VFSTreePopulator populator(model);
+        wxutil::LazyVFSTreePopulator populator(model);
         constexpr const char* MODELS_FOLDER = "models/";
 
         // Search for model files
@@ -88,9 +89,17 @@ protected:
 
         reportProgress(_("Building tree..."));
 
-        // Fill in the column data (TRUE = including skins)
-        ModelDataInserter inserterSkins(_columns, true);
-        populator.forEachNode(inserterSkins);
+        // Fill in the column data (TRUE = including skins). The inserter is shared
+        // by the population functions creating the rows on demand.
+        auto inserterSkins = std::make_shared<ModelDataInserter>(_columns, true);
+
+        auto insertRow = [inserterSkins](wxutil::TreeModel& store, wxutil::TreeModel::Row& row,
+            const std::string& path, const std::string& leafName, bool isFolder)
+        {
+            inserterSkins->visit(store, row, path, !isFolder);
+        };
+
+        populator.populate(insertRow);
 
         reportProgress(_("Adding Model Definitions..."));
 
@@ -108,7 +117,8 @@ protected:
         modelDefs[_columns.isModelDefFolder] = true;
         modelDefs.SendItemAdded();
 
-        wxutil::VFSTreePopulator modelDefPopulator(model, modelDefs.getItem());
+        // The modelDefs folder is added last, no need to sort it behind the others
+        wxutil::LazyVFSTreePopulator modelDefPopulator(model, modelDefs.getItem());
 
         GlobalEntityClassManager().forEachModelDef([&](const IModelDefPtr& def)
         {
@@ -116,37 +126,10 @@ protected:
             modelDefPopulator.addPath(def->name);
         });
 
-        modelDefPopulator.forEachNode(inserterSkins);
-    }
-
-    void SortModel(const wxutil::TreeModel::Ptr& model) override
-    {
-        // Sort the model before returning it
-        model->SortModelFoldersFirst(_columns.iconAndName, _columns.isFolder,
-            [&](const wxDataViewItem& a, const wxDataViewItem& b)
-        {
-            // Special folder comparison function
-            wxVariant aIsModelDef, bIsModelDef;
-
-            model->GetValue(aIsModelDef, a, _columns.isModelDefFolder.getColumnIndex());
-            model->GetValue(bIsModelDef, b, _columns.isModelDefFolder.getColumnIndex());
-
-            // Special treatment for "Other Materials" folder, which always comes last
-            if (aIsModelDef)
-            {
-                return +1;
-            }
-
-            if (bIsModelDef)
-            {
-                return -1;
-            }
-
-            return 0; // no special folders, return equal to continue the regular sort algorithm
-        });
+        modelDefPopulator.populate(insertRow);
     }
 
-    void visitModelFile(const std::string& file, wxutil::VFSTreePopulator& populator)
+    void visitModelFile(const std::string& file, wxutil::LazyVFSTreePopulator& populator)
 	{
         ThrowIfCancellationRequested();
 
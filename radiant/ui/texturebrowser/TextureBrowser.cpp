@@ -79,7 +79,9 @@ public:
             return;
         }
 
-        TexturePtr texture = material->getEditorImage();
+        // Tiles larger than the preview resolution are drawn using the full image
+        TexturePtr texture = std::max(size.x(), size.y()) > static_cast<int>(Material::EDITOR_IMAGE_PREVIEW_SIZE) ?
+            material->getEditorImage() : material->getEditorImagePreview();
         if (!texture) return;
 
         // Is this texture visible?
@@ -705,7 +707,7 @@ void TextureBrowser::performUpdate()
 
         tile.material = mat;
 
-        Texture& texture = *tile.material->getEditorImage();
+        Texture& texture = *tile.material->getEditorImagePreview();
 
         tile.position = getPositionForTexture(layout, texture);
         tile.size.x() = getTextureWidth(texture);
@@ -25,6 +25,7 @@
 #include "selection/SelectionVolume.h"
 #include "util/ScopedBoolLock.h"
 #include "debugging/gl.h"
+#include "debugging/ScopedTraceZone.h"
 
 #include "GlobalXYWnd.h"
 #include "XYRenderer.h"
@@ -1309,6 +1310,8 @@ void XYWnd::updateModelview() {
 
 void XYWnd::draw()
 {
+    profiling::ScopedTraceZone traceZone("render", "XYWnd::draw");
+
     ensureFont();
 
     // clear
@@ -1372,8 +1375,7 @@ void XYWnd::draw()
         XYRenderer renderer(flagsMask, _highlightShaders);
 
         // First pass (scenegraph traversal)
-        render::RenderableCollectionWalker::CollectRenderablesInScene(renderer,
-                                                                      _view);
+        render::RenderableCollectionWalker::CollectRenderablesInScene(renderer, _view, _culledNodes);
 
 
 		// Render any active mousetools
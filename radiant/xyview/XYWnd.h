@@ -17,6 +17,7 @@
 #include <sigc++/connection.h>
 
 #include "render/View.h"
+#include "render/RenderableCollectionWalker.h"
 #include "imousetool.h"
 #include "tools/XYMouseToolEvent.h"
 #include "wxutil/MouseToolHandler.h"
@@ -58,6 +59,9 @@ protected:
 
     render::View _view;
 
+    // Nodes intersecting the view volume, re-used while the view doesn't change
+    render::CulledNodeCache _culledNodes;
+
     // Shaders used for highlighting nodes
     static XYRenderer::HighlightShaders _highlightShaders;
 
@@ -1,6 +1,7 @@
 #include "Radiant.h"
 
 #include <iomanip>
+#include <algorithm>
 #include "version.h"
 
 #include "string/convert.h"
@@ -13,6 +14,7 @@
 #include "module/StaticModule.h"
 #include "messagebus/MessageBus.h"
 #include "settings/LanguageManager.h"
+#include "profiling/TraceCollector.h"
 
 #include "xmlutil/XmlModule.h"
 
@@ -26,8 +28,17 @@ namespace
 
 Radiant::Radiant(IApplicationContext& context) :
 	_context(context),
-	_messageBus(new MessageBus)
+	_messageBus(new MessageBus),
+	_traceCollector(new profiling::TraceCollector)
 {
+	// Tracing can be enabled right from the start to cover module initialisation
+	const auto& args = _context.getCmdLineArgs();
+
+	if (std::find(args.begin(), args.end(), "--trace-startup") != args.end())
+	{
+		_traceCollector->setEnabled(true);
+	}
+
     xmlutil::initModule();
 
 	// Set the stream references for rMessage(), redirect std::cout, etc.
@@ -87,6 +98,11 @@ language::ILanguageManager& Radiant::getLanguageManager()
 	return *_languageManager;
 }
 
+profiling::ITraceCollector& Radiant::getTraceCollector()
+{
+	return *_traceCollector;
+}
+
 void Radiant::startup()
 {
 	try
@@ -5,6 +5,7 @@
 
 namespace applog { class LogFile; }
 namespace language { class LanguageManager; }
+namespace profiling { class TraceCollector; }
 
 namespace radiant
 {
@@ -25,6 +26,8 @@ private:
 
 	std::unique_ptr<language::LanguageManager> _languageManager;
 
+	std::unique_ptr<profiling::TraceCollector> _traceCollector;
+
 public:
 	Radiant(IApplicationContext& context);
 
@@ -38,6 +41,7 @@ public:
 	module::ModuleRegistry& getModuleRegistry() override;
 	radiant::IMessageBus& getMessageBus() override;
 	language::ILanguageManager& getLanguageManager() override;
+	profiling::ITraceCollector& getTraceCollector() override;
 	void startup() override;
 
 	static std::shared_ptr<Radiant>& InstancePtr();
@@ -10,8 +10,13 @@
 #include "Face.h"
 #include "FixedWinding.h"
 #include "math/Ray.h"
+#include "util/MemoryUsage.h"
 
+#include <atomic>
 #include <functional>
+#include <future>
+#include <thread>
+#include <unordered_set>
 
 namespace {
     /// \brief Returns true if edge (\p x, \p y) is smaller than the epsilon used to classify winding points against a plane.
@@ -33,6 +38,25 @@ namespace {
     {
         return std::max(std::max(extents[0], extents[1]), extents[2]);
     }
+
+    // Batches smaller than this are not worth distributing to worker threads
+    constexpr std::size_t MinBrushesPerWorker = 64;
+
+    // The brushes whose B-Rep needs to be rebuilt. This is never destroyed,
+    // brushes might still be around during static destruction.
+    // The set is not synchronised: it must only be accessed from the thread
+    // that first used it (the main thread). The worker threads spawned by
+    // Brush::evaluateBReps() never touch it.
+    std::unordered_set<Brush*>& getChangedBrushes()
+    {
+        static auto* changedBrushes = new std::unordered_set<Brush*>();
+        static const auto owningThread = std::this_thread::get_id();
+
+        assert(std::this_thread::get_id() == owningThread);
+        (void)owningThread;
+
+        return *changedBrushes;
+    }
 }
 
 Brush::Brush(BrushNode& owner) :
@@ -60,6 +84,11 @@ Brush::Brush(BrushNode& owner, const Brush& other) :
 Brush::~Brush()
 {
     ASSERT_MESSAGE(m_observers.empty(), "Brush::~Brush: observers still attached");
+
+    if (m_planeChanged)
+    {
+        getChangedBrushes().erase(this);
+    }
 }
 
 BrushNode& Brush::getBrushNode()
@@ -233,10 +262,80 @@ BrushSplitType Brush::classifyPlane(const Plane3& plane) const
 void Brush::evaluateBRep() const {
     if(m_planeChanged) {
         m_planeChanged = false;
+        getChangedBrushes().erase(const_cast<Brush*>(this));
         const_cast<Brush*>(this)->buildBRep();
     }
 }
 
+void Brush::evaluateBReps(const std::vector<Brush*>& brushes)
+{
+    std::vector<Brush*> changed;
+
+    for (auto* brush : brushes)
+    {
+        // Pending transforms are applied through the node, do this up front
+        brush->evaluateTransform();
+
+        if (brush->m_planeChanged)
+        {
+            brush->m_planeChanged = false;
+            getChangedBrushes().erase(brush);
+            changed.push_back(brush);
+        }
+    }
+
+    if (changed.empty()) return;
+
+    // The windings and connectivity of each brush only depend on its own faces,
+    // they can be constructed in parallel
+    std::vector<char> consistent(changed.size());
+    std::atomic<std::size_t> nextBrush(0);
+
+    auto computeBReps = [&]()
+    {
+        for (auto i = nextBrush++; i < changed.size(); i = nextBrush++)
+        {
+            consistent[i] = changed[i]->computeBRep();
+        }
+    };
+
+    auto numWorkers = std::min<std::size_t>(std::max(std::thread::hardware_concurrency(), 1u),
+        changed.size() / MinBrushesPerWorker);
+
+    std::vector<std::future<void>> workers;
+
+    for (std::size_t i = 1; i < numWorkers; ++i)
+    {
+        workers.emplace_back(std::async(std::launch::async, computeBReps));
+    }
+
+    // The calling thread participates as well
+    computeBReps();
+
+    for (auto& worker : workers)
+    {
+        worker.get();
+    }
+
+    // Observers and renderables are notified on the calling thread, in order
+    for (std::size_t i = 0; i < changed.size(); ++i)
+    {
+        if (!consistent[i])
+        {
+            rError() << "Final B-Rep: inconsistent vertex count\n";
+        }
+
+        changed[i]->applyBRep();
+    }
+}
+
+void Brush::evaluateChangedBReps()
+{
+    const auto& changedBrushes = getChangedBrushes();
+
+    evaluateBReps(std::vector<Brush*>(changedBrushes.begin(), changedBrushes.end()));
+}
+
 void Brush::transformChanged() {
     m_transformChanged = true;
     onFacePlaneChanged();
@@ -439,7 +538,12 @@ void Brush::erase(std::size_t index)
 
 void Brush::onFacePlaneChanged()
 {
-    m_planeChanged = true;
+    if (!m_planeChanged)
+    {
+        m_planeChanged = true;
+        getChangedBrushes().insert(this);
+    }
+
     aabbChanged();
 }
 
@@ -486,6 +590,26 @@ std::size_t Brush::getNumFaces() const
     return m_faces.size();
 }
 
+std::size_t Brush::getHeapMemoryUsage() const
+{
+    std::size_t usage = util::getHeapMemoryUsage(m_faces);
+
+    for (const auto& face : m_faces)
+    {
+        usage += face->getMemoryUsage();
+    }
+
+    usage += util::getHeapMemoryUsage(_faceCentroidPoints);
+    usage += util::getHeapMemoryUsage(_uniqueVertexPoints);
+    usage += util::getHeapMemoryUsage(_uniqueEdgePoints);
+    usage += util::getHeapMemoryUsage(m_select_vertices);
+    usage += util::getHeapMemoryUsage(m_select_edges);
+    usage += util::getHeapMemoryUsage(_edgeIndices);
+    usage += util::getHeapMemoryUsage(_edgeFaces);
+
+    return usage;
+}
+
 bool Brush::empty() const {
     return m_faces.empty();
 }
@@ -533,33 +657,55 @@ void Brush::removeRedundantFaces()
 }
 
 /// \brief Constructs \p winding from the intersection of \p plane with the other planes of the brush.
-void Brush::windingForClipPlane(Winding& winding, const Plane3& plane) const {
-    FixedWinding buffer[2];
+void Brush::windingForClipPlane(Winding& winding, const Plane3& plane) const
+{
+    std::vector<bool> clippingFaces;
+    getClippingFaces(clippingFaces);
+
+    windingForClipPlane(winding, plane, clippingFaces);
+}
+
+void Brush::getClippingFaces(std::vector<bool>& clippingFaces) const
+{
+    clippingFaces.resize(m_faces.size());
+
+    for (std::size_t i = 0; i < m_faces.size(); ++i)
+    {
+        clippingFaces[i] = m_faces[i]->plane3().isValid() && plane_unique(i);
+    }
+}
+
+void Brush::windingForClipPlane(Winding& winding, const Plane3& plane, const std::vector<bool>& clippingFaces) const
+{
+    // The clip buffers are reused by all windings constructed on this thread,
+    // they don't need to allocate anything once they are large enough
+    thread_local FixedWinding buffer[2];
     bool swap = false;
 
+    buffer[0].clear();
+    buffer[1].clear();
+
     // get a poly that covers an effectively infinite area
     buffer[swap].createInfinite(plane, m_maxWorldCoord + 1);
 
     // chop the poly by all of the other faces
+    for (std::size_t i = 0; i < m_faces.size() && !buffer[swap].empty(); ++i)
     {
-        for (std::size_t i = 0;  i < m_faces.size(); ++i) {
-            const Face& clip = *m_faces[i];
+        if (!clippingFaces[i]) continue;
 
-            if (clip.plane3() == plane
-                || !clip.plane3().isValid() || !plane_unique(i)
-                || plane == -clip.plane3())
-            {
-                continue;
-            }
+        const auto& clipPlane3 = m_faces[i]->plane3();
 
-            buffer[!swap].clear();
+        if (clipPlane3 == plane || plane == -clipPlane3)
+        {
+            continue;
+        }
 
-            {
-                // flip the plane, because we want to keep the back side
-                Plane3 clipPlane(-clip.plane3().normal(), -clip.plane3().dist());
-                buffer[swap].clip(plane, clipPlane, i, buffer[!swap]);
-            }
+        // flip the plane, because we want to keep the back side
+        Plane3 clipPlane(-clipPlane3.normal(), -clipPlane3.dist());
 
+        // Windings that are entirely in front of the plane are left as they are
+        if (buffer[swap].clip(plane, clipPlane, i, buffer[!swap]))
+        {
             swap = !swap;
         }
     }
@@ -886,34 +1032,6 @@ sigc::signal<void>& Brush::signal_faceShaderChanged()
 	return _sigFaceShaderChanged;
 }
 
-void Brush::edge_push_back(FaceVertexId faceVertex) {
-    m_select_edges.push_back(SelectableEdge(m_faces, faceVertex));
-    for (Observers::iterator i = m_observers.begin(); i != m_observers.end(); ++i) {
-        (*i)->edge_push_back(m_select_edges.back());
-    }
-}
-
-void Brush::edge_clear() {
-    m_select_edges.clear();
-    for(Observers::iterator i = m_observers.begin(); i != m_observers.end(); ++i) {
-        (*i)->edge_clear();
-    }
-}
-
-void Brush::vertex_push_back(FaceVertexId faceVertex) {
-    m_select_vertices.push_back(SelectableVertex(m_faces, faceVertex));
-    for (Observers::iterator i = m_observers.begin(); i != m_observers.end(); ++i) {
-        (*i)->vertex_push_back(m_select_vertices.back());
-    }
-}
-
-void Brush::vertex_clear() {
-    m_select_vertices.clear();
-    for (Observers::iterator i = m_observers.begin(); i != m_observers.end(); ++i) {
-        (*i)->vertex_clear();
-    }
-}
-
 /// \brief Returns true if the face identified by \p index is preceded by another plane that takes priority over it.
 bool Brush::plane_unique(std::size_t index) const {
     // duplicate plane
@@ -1070,17 +1188,21 @@ bool Brush::buildWindings()
 {
     m_aabb_local = AABB();
 
+    // Determine the clipping faces once, instead of once per winding
+    thread_local std::vector<bool> clippingFaces;
+    getClippingFaces(clippingFaces);
+
     for (std::size_t i = 0;  i < m_faces.size(); ++i)
     {
         auto& face = *m_faces[i];
 
-        if (!face.plane3().isValid() || !plane_unique(i))
+        if (!clippingFaces[i])
         {
             face.getWinding().resize(0);
         }
         else
         {
-            windingForClipPlane(face.getWinding(), face.plane3());
+            windingForClipPlane(face.getWinding(), face.plane3(), clippingFaces);
 
             // update brush bounds
             const auto& winding = face.getWinding();
@@ -1093,9 +1215,6 @@ bool Brush::buildWindings()
             // update texture coordinates
             face.emitTextureCoordinates();
         }
-
-        // greebo: Update the winding, now that it's constructed
-        face.updateWinding();
     }
 
     bool degenerate = !isBounded();
@@ -1157,12 +1276,19 @@ std::size_t ProximalVertexArray_index(const ProximalVertexArray& array, const Pr
 }
 
 /// \brief Constructs the face windings and updates anything that depends on them.
-void Brush::buildBRep() {
-  bool degenerate = buildWindings();
+void Brush::buildBRep()
+{
+    if (!computeBRep())
+    {
+        rError() << "Final B-Rep: inconsistent vertex count\n";
+    }
+
+    applyBRep();
+}
 
-  static const Vector3& colourVertexVec = GlobalBrush().getSettings().getVertexColour();
-  const Colour4b colour_vertex(int(colourVertexVec[0]*255), int(colourVertexVec[1]*255),
-                                   int(colourVertexVec[2]*255), 255);
+bool Brush::computeBRep() {
+  bool consistent = true;
+  bool degenerate = buildWindings();
 
   std::size_t faces_size = 0;
   std::size_t faceVerticesCount = 0;
@@ -1177,8 +1303,8 @@ void Brush::buildBRep() {
   {
     _uniqueVertexPoints.resize(0);
 
-    vertex_clear();
-    edge_clear();
+    m_select_vertices.clear();
+    m_select_edges.clear();
 
     _edgeIndices.resize(0);
     _edgeFaces.resize(0);
@@ -1235,11 +1361,11 @@ void Brush::buildBRep() {
         }
 
         {
-          edge_clear();
+          m_select_edges.clear();
           m_select_edges.reserve(uniqueEdges.size());
           for(UniqueEdges::iterator i = uniqueEdges.begin(); i != uniqueEdges.end(); ++i)
           {
-            edge_push_back(faceVertices[ProximalVertexArray_index(edgePairs, *i)]);
+            m_select_edges.push_back(SelectableEdge(m_faces, faceVertices[ProximalVertexArray_index(edgePairs, *i)]));
           }
         }
 
@@ -1296,11 +1422,11 @@ void Brush::buildBRep() {
         }
 
         {
-          vertex_clear();
+          m_select_vertices.clear();
           m_select_vertices.reserve(uniqueVertices.size());
           for(UniqueVertices::iterator i = uniqueVertices.begin(); i != uniqueVertices.end(); ++i)
           {
-            vertex_push_back(faceVertices[ProximalVertexArray_index(vertexRings, (*i))]);
+            m_select_vertices.push_back(SelectableVertex(m_faces, faceVertices[ProximalVertexArray_index(vertexRings, (*i))]));
           }
         }
 
@@ -1319,7 +1445,7 @@ void Brush::buildBRep() {
 
       if((uniqueVertices.size() + faces_size) - uniqueEdges.size() != 2)
       {
-        rError() << "Final B-Rep: inconsistent vertex count\n";
+        consistent = false;
       }
 
       // edge-index list for wireframe rendering
@@ -1351,6 +1477,35 @@ void Brush::buildBRep() {
       }
     }
   }
+
+  return consistent;
+}
+
+void Brush::applyBRep()
+{
+    for (const auto& face : m_faces)
+    {
+        // greebo: Update the winding, now that it's constructed
+        face->updateWinding();
+    }
+
+    // Let the observers re-create their component instances
+    for (auto observer : m_observers)
+    {
+        observer->edge_clear();
+
+        for (auto& edge : m_select_edges)
+        {
+            observer->edge_push_back(edge);
+        }
+
+        observer->vertex_clear();
+
+        for (auto& vertex : m_select_vertices)
+        {
+            observer->vertex_push_back(vertex);
+        }
+    }
 }
 
 const std::vector<Vector3>& Brush::getVertices(selection::ComponentSelectionMode mode) const
@@ -216,6 +216,15 @@ public:
 
 	void evaluateBRep() const override;
 
+	// Rebuilds the B-Rep of those brushes that need it. Windings, connectivity and
+	// texture coordinates are constructed on worker threads for larger batches, the
+	// observers and renderables are updated on the calling thread afterwards.
+	// Like any other brush modification, this must be called from the main thread.
+	static void evaluateBReps(const std::vector<Brush*>& brushes);
+
+	// Runs evaluateBReps() on all brushes whose planes changed since their last evaluation
+	static void evaluateChangedBReps();
+
     void transformChanged();
     void evaluateTransform();
 
@@ -268,6 +277,9 @@ public:
 
 	std::size_t getNumFaces() const override;
 
+	// Returns the estimated number of bytes allocated by this brush, including its faces
+	std::size_t getHeapMemoryUsage() const;
+
 	bool empty() const override;
 
 	/// \brief Returns true if any face of the brush contributes to the final B-Rep.
@@ -307,17 +319,15 @@ public:
     const std::vector<Vector3>& getVertices(selection::ComponentSelectionMode mode) const;
 
 private:
-	void edge_push_back(FaceVertexId faceVertex);
-
-	void edge_clear();
-
-	void vertex_push_back(FaceVertexId faceVertex);
-
-	void vertex_clear();
-
 	/// \brief Returns true if the face identified by \p index is preceded by another plane that takes priority over it.
 	bool plane_unique(std::size_t index) const;
 
+	// Fills in which faces have a valid and unique plane, only these are clipping the windings
+	void getClippingFaces(std::vector<bool>& clippingFaces) const;
+
+	// Constructs the winding of the given plane, using the flags returned by getClippingFaces()
+	void windingForClipPlane(Winding& winding, const Plane3& plane, const std::vector<bool>& clippingFaces) const;
+
     // Returns true if the plane with the given index has already been defined. Only faces in the range [0..i-1) will be checked
 	bool planeAlreadyDefined(std::size_t index) const;
 
@@ -341,6 +351,13 @@ private:
 
 	/// \brief Constructs the face windings and updates anything that depends on them.
 	void buildBRep();
+
+	// The part of buildBRep() only touching this brush, which is safe to run on a worker thread.
+	// Returns false if the resulting vertex, edge and face counts don't match.
+	bool computeBRep();
+
+	// Notifies the faces and observers about the B-Rep constructed by computeBRep()
+	void applyBRep();
 }; // class Brush
 
 typedef std::vector<Brush*> BrushVector;
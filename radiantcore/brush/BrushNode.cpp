@@ -9,6 +9,7 @@
 #include "ientity.h"
 #include "math/Frustum.h"
 #include "math/Hash.h"
+#include "util/MemoryUsage.h"
 #include <functional>
 
 // Constructor
@@ -60,6 +61,14 @@ scene::INode::Type BrushNode::getNodeType() const
 	return Type::Brush;
 }
 
+std::size_t BrushNode::getMemoryUsage() const
+{
+	return sizeof(BrushNode) + getNodeHeapMemoryUsage() + m_brush.getHeapMemoryUsage() +
+		util::getHeapMemoryUsage(m_faceInstances) +
+		util::getHeapMemoryUsage(m_edgeInstances) +
+		util::getHeapMemoryUsage(m_vertexInstances);
+}
+
 const AABB& BrushNode::localAABB() const {
 	return m_brush.localAABB();
 }
@@ -380,16 +389,24 @@ void BrushNode::onFaceNeedsRenderableUpdate()
     _facesNeedRenderableUpdate = true;
 }
 
+bool BrushNode::isRenderStateDirty() const
+{
+    // Selected brushes need to refresh their component renderables in every frame
+    return renderStateUpdateQueued() || _facesNeedRenderableUpdate || isSelected();
+}
+
 void BrushNode::onPreRender(const VolumeTest& volume)
 {
     m_brush.evaluateBRep();
 
     assert(_renderEntity);
 
-    // Run the face updates only if requested
-    if (_facesNeedRenderableUpdate)
+    // Run the face updates only if requested, or if the wire shader of
+    // the parent entity has changed (e.g. along with its entity class)
+    if (_facesNeedRenderableUpdate || _faceWireShader != _renderEntity->getWireShader())
     {
         _facesNeedRenderableUpdate = false;
+        _faceWireShader = _renderEntity->getWireShader();
 
         // Every face is asked to run the rendering preparations
         // to link/unlink their geometry to/from the active shader
@@ -470,6 +487,8 @@ void BrushNode::setRenderSystem(const RenderSystemPtr& renderSystem)
         _renderableVertices.clear();
 	}
 
+    _faceWireShader.reset();
+
 	m_brush.setRenderSystem(renderSystem);
 	m_clipPlane.setRenderSystem(renderSystem);
 }
@@ -592,13 +611,14 @@ void BrushNode::onPostUndo()
     // The windings are usually lazy-evaluated when some code
     // is calling localAABB() during rendering.
     // To avoid the texture tool from rendering old texture coords
-    // We evaluate the windings right after undo
-    m_brush.evaluateBRep();
+    // We evaluate the windings right after undo. The first brush
+    // rebuilds all the brushes touched by the operation in one batch.
+    Brush::evaluateChangedBReps();
 }
 
 void BrushNode::onPostRedo()
 {
-    m_brush.evaluateBRep();
+    Brush::evaluateChangedBReps();
 }
 
 void BrushNode::_onTransformationChanged()
@@ -63,6 +63,10 @@ class BrushNode :
 
     bool _facesNeedRenderableUpdate;
 
+    // The wire shader of the render entity the face windings have been attached to.
+    // It changes along with the entity class of the parent entity.
+    ShaderPtr _faceWireShader;
+
 public:
 	// Constructor
 	BrushNode();
@@ -83,6 +87,8 @@ public:
 
 	Type getNodeType() const override;
 
+	std::size_t getMemoryUsage() const override;
+
     // IComparable implementation
     std::string getFingerprint() override;
 
@@ -137,6 +143,7 @@ public:
 	void DEBUG_verify() override;
 
 	// Renderable implementation
+    bool isRenderStateDirty() const override;
     void onPreRender(const VolumeTest& volume) override;
 	void renderHighlights(IRenderableCollector& collector, const VolumeTest& volume) override;
 	void setRenderSystem(const RenderSystemPtr& renderSystem) override;
@@ -10,6 +10,7 @@
 #include "texturelib.h"
 #include "Winding.h"
 #include "selection/algorithm/Texturing.h"
+#include "util/MemoryUsage.h"
 
 #include "Brush.h"
 #include "BrushNode.h"
@@ -229,7 +230,7 @@ bool Face::intersectVolume(const VolumeTest& volume) const
 {
     if (!m_winding.empty())
     {
-        const Plane3& plane = m_planeTransformed.getPlane();
+        const Plane3& plane = getTransformedPlane().getPlane();
         return volume.TestPlane(Plane3(plane.normal(), -plane.dist()));
     }
     else
@@ -286,12 +287,13 @@ void Face::transformTexDefLocked(const Matrix4& transform)
     vertices[2] = transform.transformPoint(vertices[2]);
 
     // Keep the texture coords, recalculate the texture projection
-    m_texdefTransformed.calculateFromPoints(vertices, texcoords, m_planeTransformed.getPlane().normal());
+    auto& state = getTransformedState();
+    state.texdef.calculateFromPoints(vertices, texcoords, state.plane.getPlane().normal());
 }
 
 void Face::translate(const Vector3& translation)
 {
-    m_planeTransformed.translate(translation);
+    getTransformedState().plane.translate(translation);
     
     if (GlobalBrush().textureLockEnabled() && m_winding.size() >= 3)
     {
@@ -305,7 +307,7 @@ void Face::translate(const Vector3& translation)
 void Face::transform(const Matrix4& transform)
 {
     // Transform the FacePlane using the given matrix (before the tex def is recalculated)
-    m_planeTransformed.transform(transform);
+    getTransformedState().plane.transform(transform);
 
     if (GlobalBrush().textureLockEnabled() && m_winding.size() >= 3)
     {
@@ -318,7 +320,7 @@ void Face::transform(const Matrix4& transform)
 
 void Face::assign_planepts(const PlanePoints planepts)
 {
-    m_planeTransformed.initialiseFromPoints(
+    getTransformedState().plane.initialiseFromPoints(
         planepts[0], planepts[1], planepts[2]
     );
     _owner.onFacePlaneChanged();
@@ -328,9 +330,7 @@ void Face::assign_planepts(const PlanePoints planepts)
 /// \brief Reverts the transformable state of the brush to identity.
 void Face::revertTransform()
 {
-    m_planeTransformed = m_plane;
-    planepts_assign(m_move_planeptsTransformed, m_move_planepts);
-    m_texdefTransformed = _texdef;
+    _transformed.reset();
     updateWinding();
     emitTextureCoordinates();
 }
@@ -338,12 +338,47 @@ void Face::revertTransform()
 void Face::freezeTransform()
 {
     undoSave();
-    m_plane = m_planeTransformed;
-    planepts_assign(m_move_planepts, m_move_planeptsTransformed);
-    _texdef = m_texdefTransformed;
+
+    if (_transformed)
+    {
+        m_plane = _transformed->plane;
+        planepts_assign(m_move_planepts, _transformed->planepts);
+        _texdef = _transformed->texdef;
+        _transformed.reset();
+    }
+
     updateWinding();
 }
 
+Face::TransformedState& Face::getTransformedState()
+{
+    if (!_transformed)
+    {
+        // Start out with the untransformed values
+        _transformed = std::make_unique<TransformedState>();
+        _transformed->plane = m_plane;
+        planepts_assign(_transformed->planepts, m_move_planepts);
+        _transformed->texdef = _texdef;
+    }
+
+    return *_transformed;
+}
+
+const FacePlane& Face::getTransformedPlane() const
+{
+    return _transformed ? _transformed->plane : m_plane;
+}
+
+const TextureProjection& Face::getTransformedTexdef() const
+{
+    return _transformed ? _transformed->texdef : _texdef;
+}
+
+PlanePoints& Face::getTransformedPlanePoints()
+{
+    return getTransformedState().planepts;
+}
+
 void Face::clearRenderables()
 {
     _windingSurfaceSolid.clear();
@@ -440,7 +475,10 @@ void Face::setShader(const std::string& name)
 
 void Face::revertTexdef()
 {
-    m_texdefTransformed = _texdef;
+    if (_transformed)
+    {
+        _transformed->texdef = _texdef;
+    }
 }
 
 void Face::texdefChanged()
@@ -574,20 +612,20 @@ void Face::applyShaderFromFace(const Face& other)
         auto edge = other.m_winding[edgeIndices.second].vertex - other.m_winding[edgeIndices.first].vertex;
 
         // Construct a vector that is orthogonal to the edge, pointing outwards
-        auto outwardsDirection = edge.cross(other.m_planeTransformed.getPlane().normal());
+        auto outwardsDirection = edge.cross(other.getTransformedPlane().getPlane().normal());
 
         // Pick a point outside face, placing that orthogonal vector on the edge center
         auto extrapolatedPoint = edgeCenter + outwardsDirection;
         auto extrapolationLength = outwardsDirection.getLength();
-        auto extrapolatedTexcoords = other.m_texdefTransformed.getTextureCoordsForVertex(
-            extrapolatedPoint, other.m_planeTransformed.getPlane().normal(), Matrix4::getIdentity()
+        auto extrapolatedTexcoords = other.getTransformedTexdef().getTextureCoordsForVertex(
+            extrapolatedPoint, other.getTransformedPlane().getPlane().normal(), Matrix4::getIdentity()
         );
 
         // Construct an edge vector on this target face, keeping the winding order
         edgeIndices = getEdgeIndexPair(sharedVertices[0].second, sharedVertices[1].second, m_winding.size());
 
         auto targetFaceEdge = m_winding[edgeIndices.second].vertex - m_winding[edgeIndices.first].vertex;
-        auto inwardsDirection = -targetFaceEdge.cross(m_planeTransformed.getPlane().normal()).getNormalised();
+        auto inwardsDirection = -targetFaceEdge.cross(getTransformedPlane().getPlane().normal()).getNormalised();
 
         // Calculate a point on this face plane, with the same distance from the edge center as on the source face
         auto pointOnThisFacePlane = edgeCenter + inwardsDirection * extrapolationLength;
@@ -609,7 +647,7 @@ void Face::applyShaderFromFace(const Face& other)
         };
 
         setTexDefFromPoints(vertices, texcoords);
-        _texdef = m_texdefTransformed; // freeze that matrix
+        _texdef = getTransformedTexdef(); // freeze that matrix
         return;
     }
     else
@@ -621,7 +659,7 @@ void Face::applyShaderFromFace(const Face& other)
 
 void Face::setTexDefFromPoints(const Vector3 points[3], const Vector2 uvs[3])
 {
-    m_texdefTransformed.calculateFromPoints(points, uvs, getPlane3().normal());
+    getTransformedState().texdef.calculateFromPoints(points, uvs, getPlane3().normal());
 
     emitTextureCoordinates();
 
@@ -672,7 +710,7 @@ void Face::alignTexture(AlignEdge align)
 
 void Face::emitTextureCoordinates() 
 {
-    m_texdefTransformed.emitTextureCoordinates(m_winding, m_planeTransformed.getPlane().normal(), Matrix4::getIdentity());
+    getTransformedTexdef().emitTextureCoordinates(m_winding, getTransformedPlane().getPlane().normal(), Matrix4::getIdentity());
 }
 
 void Face::applyDefaultTextureScale()
@@ -710,7 +748,7 @@ render::RenderableWinding& Face::getWindingSurfaceWireframe()
 const Plane3& Face::plane3() const
 {
     _owner.onFaceEvaluateTransform();
-    return m_planeTransformed.getPlane();
+    return getTransformedPlane().getPlane();
 }
 
 const Plane3& Face::getPlane3() const
@@ -718,6 +756,14 @@ const Plane3& Face::getPlane3() const
     return m_plane.getPlane();
 }
 
+void Face::setPlane(const Plane3& plane)
+{
+    undoSave();
+
+    m_plane.setPlane(plane);
+    planeChanged();
+}
+
 FacePlane& Face::getPlane() {
     return m_plane;
 }
@@ -780,6 +826,18 @@ void Face::updateFaceVisibility()
     }
 }
 
+std::size_t Face::getMemoryUsage() const
+{
+    std::size_t usage = sizeof(Face) + util::getHeapMemoryUsage(m_winding);
+
+    if (_transformed)
+    {
+        usage += sizeof(TransformedState);
+    }
+
+    return usage + util::getHeapMemoryUsage(_shader.getMaterialName());
+}
+
 sigc::signal<void>& Face::signal_texdefChanged()
 {
     static sigc::signal<void> _sigTexdefChanged;
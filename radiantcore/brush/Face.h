@@ -33,22 +33,31 @@ private:
     // The structure which is saved to the undo stack
     class SavedState;
 
+    // The transformed state of a face, which is only allocated
+    // while the face is being manipulated, until it is frozen or reverted
+    struct TransformedState
+    {
+        FacePlane plane;
+        PlanePoints planepts;
+        TextureProjection texdef;
+    };
+
 public:
 	PlanePoints m_move_planepts;
-	PlanePoints m_move_planeptsTransformed;
 
 private:
 	// The parent brush
 	Brush& _owner;
 
 	FacePlane m_plane;
-	FacePlane m_planeTransformed;
 
     // Face shader, stores material name and GL shader object
 	SurfaceShader _shader;
 
 	TextureProjection _texdef;
-	TextureProjection m_texdefTransformed;
+
+	// Empty as long as the face is untransformed
+	std::unique_ptr<TransformedState> _transformed;
 
 	Winding m_winding;
 	Vector3 m_centroid;
@@ -120,6 +129,10 @@ public:
 
 	void update_move_planepts_vertex(std::size_t index, PlanePoints planePoints);
 
+	// The plane points used for component manipulation, starting out
+	// as copy of m_move_planepts. Allocates the transformed state.
+	PlanePoints& getTransformedPlanePoints();
+
 	void snapto(float snap);
 
 	void testSelect(SelectionTest& test, SelectionIntersection& best);
@@ -196,6 +209,7 @@ public:
 
 	// Returns the Doom 3 plane
 	const Plane3& getPlane3() const override;
+	void setPlane(const Plane3& plane) override;
 
 	FacePlane& getPlane();
 	const FacePlane& getPlane() const;
@@ -216,6 +230,9 @@ public:
 
 	void updateFaceVisibility();
 
+	// Returns the estimated number of bytes occupied by this face and its winding
+	std::size_t getMemoryUsage() const;
+
 	// Signal for external code to get notified each time the texdef of any face changes
 	static sigc::signal<void>& signal_texdefChanged();
 
@@ -231,4 +248,10 @@ private:
 
     void clearRenderables();
     void updateRenderables();
+
+    // Accessors to the transformed state, falling back to the untransformed
+    // members if the face is not being manipulated right now
+    TransformedState& getTransformedState();
+    const FacePlane& getTransformedPlane() const;
+    const TextureProjection& getTransformedTexdef() const;
 };
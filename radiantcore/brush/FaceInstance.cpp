@@ -219,21 +219,21 @@ void FaceInstance::transformComponents(const Matrix4& matrix) {
 	{
 		if (m_vertexSelection.size() == 1)
 		{
-			m_face->m_move_planeptsTransformed[1] = matrix.transformPoint(m_face->m_move_planeptsTransformed[1]);
-			m_face->assign_planepts(m_face->m_move_planeptsTransformed);
+			m_face->getTransformedPlanePoints()[1] = matrix.transformPoint(m_face->getTransformedPlanePoints()[1]);
+			m_face->assign_planepts(m_face->getTransformedPlanePoints());
 		}
 		else if (m_vertexSelection.size() == 2)
 		{
-			m_face->m_move_planeptsTransformed[1] = matrix.transformPoint(m_face->m_move_planeptsTransformed[1]);
-			m_face->m_move_planeptsTransformed[2] = matrix.transformPoint(m_face->m_move_planeptsTransformed[2]);
-			m_face->assign_planepts(m_face->m_move_planeptsTransformed);
+			m_face->getTransformedPlanePoints()[1] = matrix.transformPoint(m_face->getTransformedPlanePoints()[1]);
+			m_face->getTransformedPlanePoints()[2] = matrix.transformPoint(m_face->getTransformedPlanePoints()[2]);
+			m_face->assign_planepts(m_face->getTransformedPlanePoints());
 		}
 		else if (m_vertexSelection.size() >= 3)
 		{
-			m_face->m_move_planeptsTransformed[0] = matrix.transformPoint(m_face->m_move_planeptsTransformed[0]);
-			m_face->m_move_planeptsTransformed[1] = matrix.transformPoint(m_face->m_move_planeptsTransformed[1]);
-			m_face->m_move_planeptsTransformed[2] = matrix.transformPoint(m_face->m_move_planeptsTransformed[2]);
-			m_face->assign_planepts(m_face->m_move_planeptsTransformed);
+			m_face->getTransformedPlanePoints()[0] = matrix.transformPoint(m_face->getTransformedPlanePoints()[0]);
+			m_face->getTransformedPlanePoints()[1] = matrix.transformPoint(m_face->getTransformedPlanePoints()[1]);
+			m_face->getTransformedPlanePoints()[2] = matrix.transformPoint(m_face->getTransformedPlanePoints()[2]);
+			m_face->assign_planepts(m_face->getTransformedPlanePoints());
 		}
 	}
 
@@ -241,16 +241,16 @@ void FaceInstance::transformComponents(const Matrix4& matrix) {
 	{
 		if (m_edgeSelection.size() == 1)
 		{
-			m_face->m_move_planeptsTransformed[0] = matrix.transformPoint(m_face->m_move_planeptsTransformed[0]);
-			m_face->m_move_planeptsTransformed[1] = matrix.transformPoint(m_face->m_move_planeptsTransformed[1]);
-			m_face->assign_planepts(m_face->m_move_planeptsTransformed);
+			m_face->getTransformedPlanePoints()[0] = matrix.transformPoint(m_face->getTransformedPlanePoints()[0]);
+			m_face->getTransformedPlanePoints()[1] = matrix.transformPoint(m_face->getTransformedPlanePoints()[1]);
+			m_face->assign_planepts(m_face->getTransformedPlanePoints());
 		}
 		else if (m_edgeSelection.size() >= 2)
 		{
-			m_face->m_move_planeptsTransformed[0] = matrix.transformPoint(m_face->m_move_planeptsTransformed[0]);
-			m_face->m_move_planeptsTransformed[1] = matrix.transformPoint(m_face->m_move_planeptsTransformed[1]);
-			m_face->m_move_planeptsTransformed[2] = matrix.transformPoint(m_face->m_move_planeptsTransformed[2]);
-			m_face->assign_planepts(m_face->m_move_planeptsTransformed);
+			m_face->getTransformedPlanePoints()[0] = matrix.transformPoint(m_face->getTransformedPlanePoints()[0]);
+			m_face->getTransformedPlanePoints()[1] = matrix.transformPoint(m_face->getTransformedPlanePoints()[1]);
+			m_face->getTransformedPlanePoints()[2] = matrix.transformPoint(m_face->getTransformedPlanePoints()[2]);
+			m_face->assign_planepts(m_face->getTransformedPlanePoints());
 		}
 	}
 }
@@ -269,7 +269,7 @@ void FaceInstance::snapComponents(float snap) {
 		m_face->m_move_planepts[1].snap(snap);
 		m_face->m_move_planepts[2].snap(snap);
 		m_face->assign_planepts(m_face->m_move_planepts);
-		planepts_assign(m_face->m_move_planeptsTransformed, m_face->m_move_planepts);
+		planepts_assign(m_face->getTransformedPlanePoints(), m_face->m_move_planepts);
 		m_face->freezeTransform();
 	}
 
@@ -278,7 +278,7 @@ void FaceInstance::snapComponents(float snap) {
 		m_face->m_move_planepts[1].snap(snap);
 		m_face->m_move_planepts[2].snap(snap);
 		m_face->assign_planepts(m_face->m_move_planepts);
-		planepts_assign(m_face->m_move_planeptsTransformed, m_face->m_move_planepts);
+		planepts_assign(m_face->getTransformedPlanePoints(), m_face->m_move_planepts);
 		m_face->freezeTransform();
 	}
 }
@@ -122,17 +122,44 @@ void FixedWinding::createInfinite(const Plane3& plane, double infinity) {
 	push_back(FixedWindingVertex(r4.origin, r4, brush::c_brush_maxFaces));
 }
 
-/// \brief Clip \p winding which lies on \p plane by \p clipPlane, resulting in \p clipped.
-/// If \p winding is completely in front of the plane, \p clipped will be identical to \p winding.
-/// If \p winding is completely in back of the plane, \p clipped will be empty.
-/// If \p winding intersects the plane, the edge of \p clipped which lies on \p clipPlane will store the value of \p adjacent.
-void FixedWinding::clip(const Plane3& plane, const Plane3& clipPlane, std::size_t adjacent, FixedWinding& clipped)
+/// \brief Clip this winding which lies on \p plane by \p clipPlane, resulting in \p clipped.
+/// If this winding is completely in front of the plane, \p clipped is left untouched and false is returned.
+/// If this winding is completely in back of the plane, \p clipped will be empty.
+/// If this winding intersects the plane, the edge of \p clipped which lies on \p clipPlane will store the value of \p adjacent.
+bool FixedWinding::clip(const Plane3& plane, const Plane3& clipPlane, std::size_t adjacent, FixedWinding& clipped)
 {
 	if (size() == 0) {
-		return; // Degenerate winding, exit
+		return false; // Degenerate winding, exit
 	}
 
-	PlaneClassification classification = Winding::classifyDistance(clipPlane.distanceToPoint(back().vertex), ON_EPSILON);
+	// Classify all vertices up front, the loop has no branches and the
+	// compiler is free to vectorise it. This is the same test as Winding::classifyDistance.
+	_classifications.resize(size());
+
+	std::size_t numBack = 0;
+
+	for (std::size_t i = 0; i < size(); ++i)
+	{
+		auto distance = clipPlane.distanceToPoint((*this)[i].vertex);
+
+		auto classification = distance > ON_EPSILON ? ePlaneFront : distance < -ON_EPSILON ? ePlaneBack : ePlaneOn;
+
+		_classifications[i] = classification;
+		numBack += classification == ePlaneBack;
+	}
+
+	// Nothing is cut off, the clipped winding would be identical to this one
+	if (numBack == 0) {
+		return false;
+	}
+
+	clipped.clear();
+
+	if (numBack == size()) {
+		return true;
+	}
+
+	PlaneClassification classification = _classifications.back();
 	PlaneClassification nextClassification;
 
 	// for each edge
@@ -140,7 +167,7 @@ void FixedWinding::clip(const Plane3& plane, const Plane3& clipPlane, std::size_
 		 next != size();
 		 i = next, ++next, classification = nextClassification)
 	{
-		nextClassification = Winding::classifyDistance(clipPlane.distanceToPoint((*this)[next].vertex), ON_EPSILON);
+		nextClassification = _classifications[next];
 		const FixedWindingVertex& vertex = (*this)[i];
 
 		// if first vertex of edge is ON
@@ -191,4 +218,6 @@ void FixedWinding::clip(const Plane3& plane, const Plane3& clipPlane, std::size_
 			}
 		}
 	}
+
+	return true;
 }
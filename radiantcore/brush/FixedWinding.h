@@ -2,6 +2,7 @@
 
 #include "math/Vector3.h"
 #include "math/Plane3.h"
+#include "iclipper.h"
 
 #include <vector>
 
@@ -32,24 +33,29 @@ public:
 		edge(edge_),
 		adjacent(adjacent_)
 	{}
-
-	virtual ~FixedWindingVertex() {}
 };
 
 /**
  * greebo: A FixedWinding is a vector of FixedWindingVertices
  *         with a pre-allocated size of MAX_POINTS_ON_WINDING.
+ *
+ * Clearing a FixedWinding keeps its capacity, windings that are reused
+ * (like the per-thread buffers of the brush B-Rep construction) stop
+ * allocating once they have grown to the largest size needed.
  */
 class FixedWinding :
 	public std::vector<FixedWindingVertex>
 {
+private:
+	// Scratch space for clip(), the classification of each vertex against the clip plane
+	std::vector<PlaneClassification> _classifications;
+
 public:
 	FixedWinding() {
 		reserve(MAX_POINTS_ON_WINDING);
+		_classifications.reserve(MAX_POINTS_ON_WINDING);
 	}
 
-	virtual ~FixedWinding() {}
-
 	// Writes the FixedWinding data into the given Winding
 	void writeToWinding(Winding& winding);
 
@@ -57,8 +63,9 @@ public:
 	void createInfinite(const Plane3& plane, double infinity);
 
 	/// \brief Clip this winding which lies on \p plane by \p clipPlane, resulting in \p clipped.
-	/// If \p winding is completely in front of the plane, \p clipped will be identical to \p winding.
-	/// If \p winding is completely in back of the plane, \p clipped will be empty.
-	/// If \p winding intersects the plane, the edge of \p clipped which lies on \p clipPlane will store the value of \p adjacent.
-	void clip(const Plane3& plane, const Plane3& clipPlane, std::size_t adjacent, FixedWinding& clipped);
+	/// If this winding is completely in front of the plane, \p clipped is left untouched and false is returned,
+	/// since the result would be identical to this winding. Otherwise \p clipped is overwritten and true is returned.
+	/// If this winding is completely in back of the plane, \p clipped will be empty.
+	/// If this winding intersects the plane, the edge of \p clipped which lies on \p clipPlane will store the value of \p adjacent.
+	bool clip(const Plane3& plane, const Plane3& clipPlane, std::size_t adjacent, FixedWinding& clipped);
 };
@@ -63,6 +63,7 @@ void CommandSystem::shutdownModule()
 	saveBinds();
 
 	// Free all commands
+	std::lock_guard<std::recursive_mutex> lock(_commandsLock);
 	_commands.clear();
 }
 
@@ -97,6 +98,7 @@ void CommandSystem::loadBinds() {
 			(node.getAttributeValue("readonly") == "1")
 		));
 
+		std::lock_guard<std::recursive_mutex> lock(_commandsLock);
 		std::pair<CommandMap::iterator, bool> result = _commands.insert(
 			CommandMap::value_type(name, st)
 		);
@@ -112,6 +114,8 @@ void CommandSystem::saveBinds() {
 	// Delete all previous binds
 	GlobalRegistry().deleteXPath(RKEY_COMMANDSYSTEM_BINDS + "//bind");
 
+	std::lock_guard<std::recursive_mutex> lock(_commandsLock);
+
 	for (CommandMap::const_iterator i = _commands.begin(); i != _commands.end(); ++i)
 	{
 		// Check if this is actually a statement
@@ -146,6 +150,7 @@ void CommandSystem::unbindCmd(const ArgumentList& args)
 	if (args.size() != 1) return;
 
 	// First argument is the statement to unbind
+	std::lock_guard<std::recursive_mutex> lock(_commandsLock);
 	auto found = _commands.find(args[0].getString());
 
 	if (found == _commands.end())
@@ -170,6 +175,7 @@ void CommandSystem::unbindCmd(const ArgumentList& args)
 
 void CommandSystem::listCmds(const ArgumentList& args) {
 	// Dump all commands
+	std::lock_guard<std::recursive_mutex> lock(_commandsLock);
 	for (CommandMap::const_iterator i = _commands.begin(); i != _commands.end(); ++i) {
 		rMessage() << i->first;
 
@@ -184,6 +190,8 @@ void CommandSystem::listCmds(const ArgumentList& args) {
 
 void CommandSystem::foreachCommand(const std::function<void(const std::string&)>& functor)
 {
+	std::lock_guard<std::recursive_mutex> lock(_commandsLock);
+
 	for (const auto& pair : _commands)
 	{
 		functor(pair.first);
@@ -196,6 +204,7 @@ void CommandSystem::addCommand(const std::string& name, Function func,
 	// Create a new command
 	auto cmd = std::make_shared<Command>(func, signature);
 
+	std::lock_guard<std::recursive_mutex> lock(_commandsLock);
 	auto result = _commands.emplace(name, cmd);
 
 	if (!result.second)
@@ -207,11 +216,13 @@ void CommandSystem::addCommand(const std::string& name, Function func,
 
 bool CommandSystem::commandExists(const std::string& name)
 {
+	std::lock_guard<std::recursive_mutex> lock(_commandsLock);
 	return _commands.find(name) != _commands.end();
 }
 
 void CommandSystem::removeCommand(const std::string& name)
 {
+	std::lock_guard<std::recursive_mutex> lock(_commandsLock);
 	auto i = _commands.find(name);
 
 	if (i != _commands.end())
@@ -230,6 +241,7 @@ void CommandSystem::addStatement(const std::string& statementName,
 		!saveStatementToRegistry // read-only if we should not save this statement
 	);
 
+	std::lock_guard<std::recursive_mutex> lock(_commandsLock);
 	auto result = _commands.emplace(statementName, st);
 
 	if (!result.second)
@@ -242,6 +254,8 @@ void CommandSystem::addStatement(const std::string& statementName,
 void CommandSystem::foreachStatement(const std::function<void(const std::string&)>& functor,
 									 bool customStatementsOnly)
 {
+	std::lock_guard<std::recursive_mutex> lock(_commandsLock);
+
 	for (const auto& pair : _commands)
 	{
 		auto statement = std::dynamic_pointer_cast<Statement>(pair.second);
@@ -256,6 +270,7 @@ void CommandSystem::foreachStatement(const std::function<void(const std::string&
 Signature CommandSystem::getSignature(const std::string& name)
 {
 	// Lookup the named command
+	std::lock_guard<std::recursive_mutex> lock(_commandsLock);
 	auto i = _commands.find(name);
 
 	// not found => empty signature
@@ -368,10 +383,20 @@ void CommandSystem::executeCommand(const std::string& name,
 
 void CommandSystem::executeCommand(const std::string& name, const ArgumentList& args)
 {
-	// Find the named command
-	auto i = _commands.find(name);
+	// Find the named command, but invoke it without holding the lock
+	ExecutablePtr executable;
 
-	if (i == _commands.end())
+	{
+		std::lock_guard<std::recursive_mutex> lock(_commandsLock);
+		auto i = _commands.find(name);
+
+		if (i != _commands.end())
+		{
+			executable = i->second;
+		}
+	}
+
+	if (!executable)
 	{
 		rError() << "Cannot execute command " << name << ": Command not found." << std::endl;
 		return;
@@ -379,7 +404,7 @@ void CommandSystem::executeCommand(const std::string& name, const ArgumentList&
 
 	try
 	{
-		i->second->execute(args);
+		executable->execute(args);
 	}
 	catch (const ExecutionNotPossible& ex)
 	{
@@ -404,6 +429,8 @@ AutoCompletionInfo CommandSystem::getAutoCompletionInfo(const std::string& prefi
 
 	returnValue.prefix = prefix;
 
+	std::lock_guard<std::recursive_mutex> lock(_commandsLock);
+
 	for (const auto& pair : _commands)
 	{
 		// Check if the command matches the given prefix
@@ -2,6 +2,7 @@
 
 #include "icommandsystem.h"
 #include <map>
+#include <mutex>
 #include "Executable.h"
 
 #include "string/string.h"
@@ -16,6 +17,10 @@ class CommandSystem :
 	typedef std::map<std::string, ExecutablePtr, string::ILess> CommandMap;
 	CommandMap _commands;
 
+	// Modules initialised on worker threads register their commands
+	// concurrently, so every access to the map is guarded by this lock
+	std::recursive_mutex _commandsLock;
+
 public:
 	void foreachCommand(const std::function<void(const std::string&)>& functor) override;
 
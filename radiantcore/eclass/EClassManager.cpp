@@ -174,6 +174,21 @@ void EClassManager::reloadDefs()
     _defsReloadedSignal.emit();
 }
 
+bool EClassManager::reloadChangedDefs()
+{
+    // Wait for any running parse, the recorded file stamps are updated by it
+    ensureDefsLoaded();
+
+    if (!_defLoader.parseChangedFiles())
+    {
+        return false;
+    }
+
+    _defsReloadedSignal.emit();
+
+    return true;
+}
+
 // RegisterableModule implementation
 const std::string& EClassManager::getName() const
 {
@@ -206,6 +221,7 @@ void EClassManager::initialiseModule(const IApplicationContext& ctx)
     }
 
 	GlobalCommandSystem().addCommand("ReloadDefs", std::bind(&EClassManager::reloadDefsCmd, this, std::placeholders::_1));
+	GlobalCommandSystem().addCommand("ReloadChangedDefs", std::bind(&EClassManager::reloadChangedDefsCmd, this, std::placeholders::_1));
 
     _eclassColoursChanged = GlobalEclassColourManager().sig_overrideColourChanged().connect(
         sigc::mem_fun(this, &EClassManager::onEclassOverrideColourChanged));
@@ -263,6 +279,16 @@ void EClassManager::reloadDefsCmd(const cmd::ArgumentList& args)
     reloadDefs();
 }
 
+void EClassManager::reloadChangedDefsCmd(const cmd::ArgumentList& args)
+{
+	radiant::ScopedLongRunningOperation operation(_("Reloading Defs"));
+
+    if (!reloadChangedDefs())
+    {
+        rMessage() << "No changed def files found." << std::endl;
+    }
+}
+
 // Gets called on VFS initialise
 void EClassManager::onFileSystemInitialise()
 {
@@ -25,8 +25,8 @@ namespace eclass
  *
  * This class is the loader for the entity classes. It ensures that the
  * loadFile() function is called for every .def file in the def/ directory,
- * which in turn kicks off the parse process (including the resolution of
- * inheritance).
+ * which in turn kicks off the parse process. The inheritance of each class
+ * is resolved the first time the class is accessed.
  *
  */
 class EClassManager final :
@@ -78,6 +78,9 @@ public:
 	// Reloads all entityDefs/modelDefs
     void reloadDefs() override;
 
+    // Reloads the entityDefs/modelDefs of the changed files
+    bool reloadChangedDefs() override;
+
     // RegisterableModule implementation
 	const std::string& getName() const override;
     const StringSet& getDependencies() const override;
@@ -95,6 +98,7 @@ private:
     EntityClass::Ptr findInternal(const std::string& name);
 
 	void reloadDefsCmd(const cmd::ArgumentList& args);
+	void reloadChangedDefsCmd(const cmd::ArgumentList& args);
 
     void onEclassOverrideColourChanged(const std::string& eclass, bool overrideRemoved);
 };
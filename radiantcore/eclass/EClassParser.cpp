@@ -1,6 +1,5 @@
 #include "EClassParser.h"
 
-#include "ieclasscolours.h"
 #include "itextstream.h"
 
 #include "string/case_conv.h"
@@ -109,10 +108,91 @@ void EClassParser::parse(std::istream& stream, const vfs::FileInfo& fileInfo, co
     }
 }
 
+bool EClassParser::parseChangedFiles()
+{
+    auto changes = findChangedFiles();
+
+    if (changes.empty()) return false;
+
+    onBeginParsing();
+
+    processChangedFiles(changes);
+
+    // Inheriting declarations copy some of their parent's values when being resolved,
+    // so their files need to be parsed again, until no further files are affected
+    std::map<std::string, vfs::FileInfo> filesByPath;
+
+    for (const auto& fileInfo : collectFiles())
+    {
+        filesByPath.emplace(fileInfo.fullPath(), fileInfo);
+    }
+
+    std::set<std::string> parsedFiles;
+
+    for (const auto& fileInfo : changes.changedFiles)
+    {
+        parsedFiles.insert(fileInfo.fullPath());
+    }
+
+    while (true)
+    {
+        FileChanges dependentChanges;
+
+        // The set is sorted, which keeps the parse order of a full run
+        for (const auto& fullPath : findFilesInheritingFromCurrentParse())
+        {
+            auto fileInfo = filesByPath.find(fullPath);
+
+            if (fileInfo != filesByPath.end() && parsedFiles.insert(fullPath).second)
+            {
+                dependentChanges.changedFiles.push_back(fileInfo->second);
+            }
+        }
+
+        if (dependentChanges.empty()) break;
+
+        processChangedFiles(dependentChanges);
+    }
+
+    onFinishParsing();
+
+    return true;
+}
+
+std::set<std::string> EClassParser::findFilesInheritingFromCurrentParse()
+{
+    std::set<std::string> files;
+
+    auto parsedInThisRun = [&](const auto& map, const std::string& name)
+    {
+        auto found = map.find(name);
+        return found != map.end() && found->second->getParseStamp() == _curParseStamp;
+    };
+
+    for (const auto& [name, model] : _modelDefs)
+    {
+        if (model->getParseStamp() != _curParseStamp && parsedInThisRun(_modelDefs, model->parent))
+        {
+            files.insert(model->defFilename);
+        }
+    }
+
+    for (const auto& [name, eclass] : _entityClasses)
+    {
+        if (eclass->getParseStamp() != _curParseStamp &&
+            (parsedInThisRun(_entityClasses, eclass->getAttributeValue("inherit", false)) ||
+             parsedInThisRun(_modelDefs, eclass->getAttributeValue("model", false))))
+        {
+            files.insert(eclass->getDefFileName());
+        }
+    }
+
+    return files;
+}
+
 void EClassParser::onFinishParsing()
 {
     resolveInheritance();
-    applyColours();
 
     for (const auto& eclass : _entityClasses)
     {
@@ -165,40 +245,34 @@ void EClassParser::resolveInheritance()
         resolveModelInheritance(pair.first, pair.second);
     }
 
-    // Resolve inheritance for the entities. At this stage the classes
-    // will have the name of their parent, but not an actual pointer to it
+    // The entities are resolved when they're first accessed, most of them
+    // are never used in a session. This includes applying the override colours.
+    auto resolver = [this](EntityClass& eclass) { resolveInheritance(eclass); };
+
     for (auto& pair : _entityClasses)
     {
-        // Tell the class to resolve its own inheritance using the given
-        // map as a source for parent lookup
-        pair.second->resolveInheritance(_entityClasses);
-
-        // If the entity has a model path ("model" key), lookup the actual
-        // model and apply its mesh and skin to this entity.
-        if (!pair.second->getModelPath().empty())
-        {
-            auto j = _modelDefs.find(pair.second->getModelPath());
-
-            if (j != _modelDefs.end())
-            {
-                pair.second->setModelPath(j->second->mesh);
-                pair.second->setSkin(j->second->skin);
-            }
-        }
+        pair.second->setInheritanceResolver(resolver);
     }
 }
 
-void EClassParser::applyColours()
+void EClassParser::resolveInheritance(EntityClass& eclass)
 {
-    GlobalEclassColourManager().foreachOverrideColour([&](const std::string& eclass, const Vector4& colour)
+    // Tell the class to resolve its own inheritance using the given
+    // map as a source for parent lookup
+    eclass.resolveInheritance(_entityClasses);
+
+    // If the entity has a model path ("model" key), lookup the actual
+    // model and apply its mesh and skin to this entity.
+    if (!eclass.getModelPath().empty())
     {
-        auto foundEclass = _entityClasses.find(string::to_lower_copy(eclass));
+        auto j = _modelDefs.find(eclass.getModelPath());
 
-        if (foundEclass != _entityClasses.end())
+        if (j != _modelDefs.end())
         {
-            foundEclass->second->setColour(colour);
+            eclass.setModelPath(j->second->mesh);
+            eclass.setSkin(j->second->skin);
         }
-    });
+    }
 }
 
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <map>
+#include <set>
 #include "ieclass.h"
 #include "parser/ThreadedDeclParser.h"
 
@@ -38,6 +39,11 @@ public:
         _curParseStamp(0)
     {}
 
+    // Re-parses the .def files that have been added or modified since the last run,
+    // along with the files declaring classes or models that inherit from the re-parsed ones.
+    // Returns false if no file has changed.
+    bool parseChangedFiles();
+
 protected:
     void onBeginParsing() override;
 
@@ -49,8 +55,9 @@ protected:
 
 private:
     void resolveInheritance();
+    void resolveInheritance(EntityClass& eclass);
     void resolveModelInheritance(const std::string& name, const Doom3ModelDef::Ptr& model);
-    void applyColours();
+    std::set<std::string> findFilesInheritingFromCurrentParse();
 };
 
 }
@@ -7,6 +7,7 @@
 
 #include "string/predicate.h"
 #include <functional>
+#include <mutex>
 
 namespace eclass
 {
@@ -15,6 +16,14 @@ namespace
 {
     const Vector3 DefaultEntityColour(0.3, 0.3, 1);
     const Vector4 UndefinedColour(-1, -1, -1, -1);
+
+    // Guards the parsing and resolution of all classes. Resolving a class resolves
+    // its ancestors on the same thread, hence the recursive mutex.
+    std::recursive_mutex& getResolveMutex()
+    {
+        static std::recursive_mutex mutex;
+        return mutex;
+    }
 }
 
 EntityClass::EntityClass(const std::string& name, bool fixedSize)
@@ -42,6 +51,7 @@ const std::string& EntityClass::getName() const
 
 const IEntityClass* EntityClass::getParent() const
 {
+    ensureResolved();
     return _parent;
 }
 
@@ -57,6 +67,8 @@ sigc::signal<void>& EntityClass::changedSignal()
 
 bool EntityClass::isFixedSize() const
 {
+    ensureResolved();
+
     if (_fixedSize) {
         return true;
     }
@@ -85,6 +97,7 @@ AABB EntityClass::getBounds() const
 
 bool EntityClass::isLight() const
 {
+    ensureResolved();
     return _isLight;
 }
 
@@ -113,6 +126,10 @@ void EntityClass::setColour(const Vector4& colour)
 
 void EntityClass::resetColour()
 {
+    // Unresolved classes pick up their colour once they're resolved
+    if (!_inheritanceResolved && !_resolving)
+        return;
+
     // An override colour which matches this exact class is final, and overrides
     // everything else
     if (GlobalEclassColourManager().applyColours(*this))
@@ -139,6 +156,7 @@ void EntityClass::resetColour()
 
 const Vector4& EntityClass::getColour() const
 {
+    ensureResolved();
     return _colour;
 }
 
@@ -150,6 +168,8 @@ const Vector4& EntityClass::getColour() const
  */
 void EntityClass::emplaceAttribute(EntityClassAttribute&& attribute)
 {
+    ensureParsed();
+
     // Try to emplace the class attribute
     auto result = _attributes.try_emplace(attribute.getName(), std::move(attribute));
 
@@ -203,6 +223,8 @@ void EntityClass::forEachAttributeInternal(InternalAttrVisitor visitor,
 void EntityClass::forEachAttribute(AttributeVisitor visitor,
                                    bool editorKeys) const
 {
+    ensureResolved();
+
     // First compile a map of all attributes we need to pass to the visitor,
     // ensuring that there is only one attribute per name (i.e. we don't want to
     // visit the same-named attribute on both a child and one of its ancestors)
@@ -229,14 +251,13 @@ void EntityClass::forEachAttribute(AttributeVisitor visitor,
 // Resolve inheritance for this class
 void EntityClass::resolveInheritance(EntityClasses& classmap)
 {
-    // If we have already resolved inheritance, do nothing
-    if (_inheritanceResolved)
-        return;
+    // Drop the parent of a previous resolution, the inherit key might be gone
+    _parent = nullptr;
 
     // Lookup the parent name and return if it is not set. Also return if the
     // parent name is the same as our own classname, to avoid infinite
     // recursion.
-    std::string parentName = getAttributeValue("inherit");
+    std::string parentName = getAttributeValue("inherit", false);
     if (parentName.empty() || parentName == _name)
     {
         resetColour();
@@ -248,10 +269,21 @@ void EntityClass::resolveInheritance(EntityClasses& classmap)
     if (pIter != classmap.end())
     {
         // Recursively resolve inheritance of parent
-        pIter->second->resolveInheritance(classmap);
+        pIter->second->ensureResolved();
 
-        // Set our parent pointer
-        _parent = pIter->second.get();
+        // A parent still being resolved at this point is inheriting from us,
+        // the loop would send every attribute lookup into an endless walk
+        if (pIter->second->_resolving)
+        {
+            rWarning() << "[eclassmgr] Entity class " << _name
+                << " is part of an inheritance loop, ignoring parent class "
+                << parentName << std::endl;
+        }
+        else
+        {
+            // Set our parent pointer
+            _parent = pIter->second.get();
+        }
     }
     else
     {
@@ -260,9 +292,6 @@ void EntityClass::resolveInheritance(EntityClasses& classmap)
                               << parentName << std::endl;
     }
 
-    // Set the resolved flag
-    _inheritanceResolved = true;
-
     if (!getAttributeValue("model").empty())
     {
         // We have a model path (probably an inherited one)
@@ -296,6 +325,70 @@ void EntityClass::resolveInheritance(EntityClasses& classmap)
     }
 }
 
+void EntityClass::setInheritanceResolver(const InheritanceResolver& resolver)
+{
+    std::lock_guard<std::recursive_mutex> lock(getResolveMutex());
+
+    _resolver = resolver;
+    _inheritanceResolved = false;
+}
+
+void EntityClass::ensureParsed() const
+{
+    if (_parsed) return;
+
+    std::lock_guard<std::recursive_mutex> lock(getResolveMutex());
+
+    // Another thread might have been quicker
+    if (_parsed || _resolving) return;
+
+    // Parsing modifies the class, but not what it declares
+    auto& self = const_cast<EntityClass&>(*this);
+
+    self._resolving = true;
+    self.parsePendingKeyValues();
+    self._resolving = false;
+}
+
+void EntityClass::ensureResolved() const
+{
+    if (_inheritanceResolved) return;
+
+    std::lock_guard<std::recursive_mutex> lock(getResolveMutex());
+
+    // Classes currently being resolved by this thread (i.e. inheritance loops) are skipped
+    if (_inheritanceResolved || _resolving) return;
+
+    auto& self = const_cast<EntityClass&>(*this);
+
+    self._resolving = true;
+
+    if (!_parsed)
+    {
+        self.parsePendingKeyValues();
+    }
+
+    if (_resolver)
+    {
+        _resolver(self);
+    }
+
+    self._inheritanceResolved = true;
+    self._resolving = false;
+}
+
+const std::string& EntityClass::getModelPath() const
+{
+    ensureResolved();
+    return _model;
+}
+
+const std::string& EntityClass::getSkin() const
+{
+    ensureResolved();
+    return _skin;
+}
+
 bool EntityClass::isOfType(const std::string& className)
 {
 	for (const IEntityClass* currentClass = this;
@@ -345,6 +438,12 @@ const EntityClassAttribute* EntityClass::getAttribute(const std::string& name, b
 
 std::string EntityClass::getAttributeValue(const std::string& name, bool includeInherited) const
 {
+    // Looking up own attributes doesn't require the parents
+    if (includeInherited)
+        ensureResolved();
+    else
+        ensureParsed();
+
     if (auto* attr = getAttribute(name, includeInherited); attr)
         return attr->getValue();
     else
@@ -353,6 +452,8 @@ std::string EntityClass::getAttributeValue(const std::string& name, bool include
 
 std::string EntityClass::getAttributeType(const std::string& name) const
 {
+    ensureResolved();
+
     // Check the attributes on this class
     const auto& attribute = _attributes.find(name);
 
@@ -372,6 +473,8 @@ std::string EntityClass::getAttributeType(const std::string& name) const
 
 std::string EntityClass::getAttributeDescription(const std::string& name) const
 {
+    ensureResolved();
+
     // Check the attributes on this class first
     const auto& attribute = _attributes.find(name);
 
@@ -400,6 +503,8 @@ void EntityClass::clear()
     _fixedSize = false;
 
     _attributes.clear();
+    _pendingKeyValues.clear();
+    _parsed = true;
     _model.clear();
     _skin.clear();
     _inheritanceResolved = false;
@@ -450,12 +555,26 @@ void EntityClass::parseFromTokens(parser::DefTokeniser& tokeniser)
     // Required open brace (the name has already been parsed by the EClassManager)
     tokeniser.assertNextToken("{");
 
-    // Loop over all of the keys in this entitydef
+    // Only collect the keys and values, most classes are never accessed in
+    // a session, so the attributes are set up when they are needed
     std::string key;
     while ((key = tokeniser.nextToken()) != "}")
     {
-        const std::string value = tokeniser.nextToken();
+        auto value = tokeniser.nextToken();
+        _pendingKeyValues.emplace_back(std::move(key), std::move(value));
+    }
+
+    _parsed = false;
+
+    // Notify the observers
+    emitChangedSignal();
+}
 
+void EntityClass::parsePendingKeyValues()
+{
+    // Loop over all of the keys in this entitydef
+    for (const auto& [key, value] : _pendingKeyValues)
+    {
         // Handle some keys specially
         if (key == "model")
         {
@@ -501,10 +620,10 @@ void EntityClass::parseFromTokens(parser::DefTokeniser& tokeniser)
             rWarning() << "[eclassmgr] attribute " << key
                 << " already set on entityclass " << _name << std::endl;
         }
-    } // while true
+    }
 
-    // Notify the observers
-    emitChangedSignal();
+    _pendingKeyValues.clear();
+    _parsed = true;
 }
 
 } // namespace eclass
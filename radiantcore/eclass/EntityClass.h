@@ -11,6 +11,8 @@
 
 #include "parser/DefTokeniser.h"
 
+#include <atomic>
+#include <functional>
 #include <vector>
 #include <map>
 #include <memory>
@@ -34,6 +36,9 @@ public:
     /// EntityClass pointer type
     using Ptr = std::shared_ptr<EntityClass>;
 
+    /// Function resolving the inheritance of the given class, provided by the parser
+    using InheritanceResolver = std::function<void(EntityClass&)>;
+
 private:
 
     // The name of this entity class
@@ -68,10 +73,21 @@ private:
     std::string _model;
     std::string _skin;
 
+    // The key/value pairs of the last parse, they are turned into attributes
+    // the first time this class is accessed
+    std::vector<std::pair<std::string, std::string>> _pendingKeyValues;
+    std::atomic<bool> _parsed{ true };
+
     // Flag to indicate inheritance resolved. An EntityClass resolves its
     // inheritance by copying all values from the parent onto the child,
     // after recursively instructing the parent to resolve its own inheritance.
-    bool _inheritanceResolved = false;
+    // This happens on first access, using the resolver assigned by the parser.
+    // Classes created in code have nothing to resolve until they are parsed.
+    std::atomic<bool> _inheritanceResolved{ true };
+    InheritanceResolver _resolver;
+
+    // True while the pending key/values are parsed or the inheritance is resolved
+    std::atomic<bool> _resolving{ false };
 
     // Name of the mod owning this class
     std::string _modName = "base";
@@ -87,6 +103,7 @@ private:
 private:
     // Clear all contents (done before parsing from tokens)
     void clear();
+    void parsePendingKeyValues();
     void parseEditorSpawnarg(const std::string& key, const std::string& value);
     void setIsLight(bool val);
 
@@ -130,8 +147,8 @@ public:
     std::string getAttributeDescription(const std::string& name) const override;
     void forEachAttribute(AttributeVisitor, bool) const override;
 
-    const std::string& getModelPath() const override { return _model; }
-    const std::string& getSkin() const override { return _skin; }
+    const std::string& getModelPath() const override;
+    const std::string& getSkin() const override;
 
 	bool isOfType(const std::string& className) override;
 
@@ -147,7 +164,8 @@ public:
     void setSkin(const std::string& skin) { _skin = skin; }
 
     /**
-     * Resolve inheritance for this class.
+     * Resolve inheritance for this class. This is invoked by the resolver
+     * the first time the class is accessed, don't call it directly.
      *
      * @param classmap
      * A reference to the global map of entity classes, which should be searched
@@ -156,6 +174,19 @@ public:
     typedef std::map<std::string, EntityClass::Ptr> EntityClasses;
     void resolveInheritance(EntityClasses& classmap);
 
+    /**
+     * Assigns the function resolving the inheritance of this class and marks
+     * the class as unresolved. Resolution happens on first access.
+     */
+    void setInheritanceResolver(const InheritanceResolver& resolver);
+
+    // Parses the pending key/values of this class, if not done yet. Thread-safe.
+    void ensureParsed() const;
+
+    // Parses this class and resolves its inheritance (including all ancestors),
+    // if not done yet. Thread-safe.
+    void ensureResolved() const;
+
     /**
      * Return the mod name.
      */
@@ -185,7 +216,8 @@ public:
 
     void emitChangedSignal()
     {
-        if (!_blockChangeSignal)
+        // Classes are resolved on any thread, the observers will see the changes anyway
+        if (!_blockChangeSignal && !_resolving)
         {
             _changedSignal.emit();
         }
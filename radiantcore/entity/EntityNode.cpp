@@ -7,6 +7,7 @@
 #include "imap.h"
 #include "itransformable.h"
 #include "math/Hash.h"
+#include "util/MemoryUsage.h"
 #include "string/case_conv.h"
 
 #include "EntitySettings.h"
@@ -186,6 +187,13 @@ void EntityNode::onEntityClassChanged()
 
     // The colour might have changed too, so re-acquire the shaders if possible
     acquireShaders();
+
+    // Child primitives need to pick up the new wire shader
+    foreachNode([](const scene::INodePtr& child)
+    {
+        child->queueRenderStateUpdate();
+        return true;
+    });
 }
 
 void EntityNode::observeKey(const std::string& key, KeyObserverFunc func)
@@ -413,6 +421,20 @@ scene::INode::Type EntityNode::getNodeType() const
 	return Type::Entity;
 }
 
+std::size_t EntityNode::getMemoryUsage() const
+{
+	std::size_t usage = sizeof(EntityNode) + getNodeHeapMemoryUsage();
+
+	// Every spawnarg is stored as key string plus a separately allocated value object
+	_spawnArgs.forEachKeyValue([&](const std::string& key, const std::string& value)
+	{
+		usage += sizeof(std::pair<std::string, std::shared_ptr<KeyValue>>) + sizeof(KeyValue) +
+			util::getHeapMemoryUsage(key) + util::getHeapMemoryUsage(value);
+	}, false);
+
+	return usage;
+}
+
 void EntityNode::onPreRender(const VolumeTest& volume)
 {
     if (EntitySettings::InstancePtr()->getRenderEntityNames())
@@ -174,6 +174,7 @@ public:
 
 	virtual std::string name() const override;
 	Type getNodeType() const override;
+	std::size_t getMemoryUsage() const override;
 
 	// Renderable implementation, can be overridden by subclasses
 	virtual void onPreRender(const VolumeTest& volume) override;
@@ -95,6 +95,62 @@ ImagePtr ImageLoader::imageFromVFS(const std::string& rawName) const
 	return ImagePtr();
 }
 
+ImagePtr ImageLoader::previewImageFromVFS(const std::string& rawName, std::size_t maxSize) const
+{
+    auto name = os::standardPath(rawName).substr(0, rawName.rfind("."));
+
+    for (const auto& extension : _extensions)
+    {
+        auto loaderIter = _loadersByExtension.find(extension);
+
+        if (loaderIter == _loadersByExtension.end())
+        {
+            continue;
+        }
+
+        ImageTypeLoader& ldr = *loaderIter->second;
+
+        std::string fullName = ldr.getPrefix() + name + "." + extension;
+
+        auto fileInfo = GlobalFileSystem().getFileInfo(fullName);
+
+        if (fileInfo.isEmpty())
+        {
+            continue;
+        }
+
+        // Check the thumbnail cache before decoding anything
+        auto key = _thumbnailCache ? ThumbnailCache::GetKey(fileInfo, maxSize) : std::string();
+
+        if (!key.empty())
+        {
+            if (auto cached = _thumbnailCache->load(key, maxSize); cached)
+            {
+                return cached;
+            }
+        }
+
+        auto file = GlobalFileSystem().openFile(fullName);
+
+        if (!file)
+        {
+            continue;
+        }
+
+        auto image = ldr.loadPreview(*file, maxSize);
+
+        // Formats that can't be previewed are returned as they are and not cached
+        if (auto preview = std::dynamic_pointer_cast<PreviewImage>(image); preview && !key.empty())
+        {
+            _thumbnailCache->store(key, preview);
+        }
+
+        return image;
+    }
+
+    return ImagePtr();
+}
+
 ImagePtr ImageLoader::imageFromFile(const std::string& filename) const
 {
     ImagePtr image;
@@ -136,13 +192,16 @@ const StringSet& ImageLoader::getDependencies() const
     if (_dependencies.empty())
     {
         _dependencies.insert(MODULE_GAMEMANAGER);
+        _dependencies.insert(MODULE_VIRTUALFILESYSTEM);
     }
 
     return _dependencies;
 }
 
-void ImageLoader::initialiseModule(const IApplicationContext&)
+void ImageLoader::initialiseModule(const IApplicationContext& ctx)
 {
+    _thumbnailCache = std::make_unique<ThumbnailCache>(ctx.getCacheDataPath());
+
     // Load the texture types from the .game file
     auto texTypes = GlobalGameManager().currentGame()->getLocalXPath(GKEY_IMAGE_TYPES);
 
@@ -152,6 +211,22 @@ void ImageLoader::initialiseModule(const IApplicationContext&)
         std::string extension = node.getContent();
         _extensions.emplace_back(string::to_lower_copy(extension));
     }
+
+    GlobalFileSystem().addObserver(*this);
+}
+
+void ImageLoader::shutdownModule()
+{
+    GlobalFileSystem().removeObserver(*this);
+    _thumbnailCache.reset();
+}
+
+void ImageLoader::onFileSystemShutdown()
+{
+    if (_thumbnailCache)
+    {
+        _thumbnailCache->clearMemory();
+    }
 }
 
 // Static module instance
@@ -1,16 +1,20 @@
 #pragma once
 
 #include "iimage.h"
+#include "ifilesystem.h"
 #include "ImageTypeLoader.h"
+#include "ThumbnailCache.h"
 
 #include <map>
+#include <memory>
 
 namespace image
 {
 
 /// ImageLoader implementing module
 class ImageLoader: 
-    public IImageLoader
+    public IImageLoader,
+    public vfs::VirtualFileSystem::Observer
 {
 private:
     // Map of image extension to loader class. Multiple image extensions may
@@ -20,6 +24,8 @@ private:
 
     ImageTypeLoader::Extensions _extensions;
 
+    std::unique_ptr<ThumbnailCache> _thumbnailCache;
+
 private:
     void addLoaderToMap(const ImageTypeLoader::Ptr& loader);
 
@@ -30,12 +36,20 @@ public:
 
     // ImageLoader implementation
     ImagePtr imageFromVFS(const std::string& vfsPath) const override;
+    ImagePtr previewImageFromVFS(const std::string& vfsPath, std::size_t maxSize) const override;
 	ImagePtr imageFromFile(const std::string& filename) const override;
 
     // RegisterableModule implementation
     const std::string& getName() const override;
     const StringSet& getDependencies() const override;
-    void initialiseModule(const IApplicationContext&) override;
+    void initialiseModule(const IApplicationContext& ctx) override;
+    void shutdownModule() override;
+
+    // VFS observer, the thumbnails held in memory are dropped with the VFS
+    void onFileSystemShutdown() override;
+
+    // Only reads the image types from the game config
+    bool supportsParallelInitialisation() const override { return true; }
 };
 
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "iimage.h"
+#include "PreviewImage.h"
 
 namespace image
 {
@@ -17,6 +18,28 @@ public:
 	 */
 	virtual ImagePtr load(ArchiveFile& file) const = 0;
 
+    /**
+     * Loads a low-resolution version of the image from the given file, fitting
+     * into maxSize x maxSize pixels. The default implementation decodes the
+     * full image and scales it down, loaders able to decode a smaller version
+     * directly should override this.
+     *
+     * @returns: NULL if the load failed. Images which can't be downscaled
+     * are returned at full resolution.
+     */
+    virtual ImagePtr loadPreview(ArchiveFile& file, std::size_t maxSize) const
+    {
+        auto image = load(file);
+
+        if (!image || image->isPrecompressed() || image->getGLFormat() != GL_RGBA)
+        {
+            return image;
+        }
+
+        return createPreviewImage(image->getPixels(), image->getWidth(), image->getHeight(),
+            maxSize, image->getWidth(), image->getHeight());
+    }
+
     typedef std::list<std::string> Extensions;
 
     /**
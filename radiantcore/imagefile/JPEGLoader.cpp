@@ -12,6 +12,7 @@
 
 #include "stream/ScopedArchiveBuffer.h"
 #include "RGBAImage.h"
+#include "PreviewImage.h"
 
 typedef unsigned char byte;
 
@@ -316,7 +317,9 @@ static void j_putGrayScanlineToRGB(unsigned char* jpegline, int widthPix, unsign
     }
 }
 
-static RGBAImagePtr LoadJPGBuff_(const void* src_buffer, int src_size)
+// Decodes the given JPEG data. If previewSize is non-zero, the image is decoded at a reduced
+// scale and downsampled to a preview image fitting into previewSize x previewSize pixels.
+static RGBAImagePtr LoadJPGBuff_(const void* src_buffer, int src_size, std::size_t previewSize = 0)
 {
     struct jpeg_decompress_struct cinfo;
     struct my_jpeg_error_mgr jerr;
@@ -334,6 +337,20 @@ static RGBAImagePtr LoadJPGBuff_(const void* src_buffer, int src_size)
     jpeg_create_decompress(&cinfo);
     jpeg_buffer_src(&cinfo, const_cast<void*>(src_buffer), src_size);
     jpeg_read_header(&cinfo, TRUE);
+
+    // libjpeg can skip most of the IDCT work when decoding at 1/2, 1/4 or 1/8 scale
+    if (previewSize > 0)
+    {
+        cinfo.scale_num = 1;
+        cinfo.scale_denom = 1;
+
+        while (cinfo.scale_denom < 8 &&
+               std::max(cinfo.image_width, cinfo.image_height) / (cinfo.scale_denom * 2) >= previewSize)
+        {
+            cinfo.scale_denom *= 2;
+        }
+    }
+
     jpeg_start_decompress(&cinfo);
 
     int row_stride = cinfo.output_width * cinfo.output_components;
@@ -354,9 +371,18 @@ static RGBAImagePtr LoadJPGBuff_(const void* src_buffer, int src_size)
             j_putGrayScanlineToRGB(buffer[0], cinfo.output_width, image->getPixels(), cinfo.output_scanline - 1);
     }
 
+    std::size_t originalWidth = cinfo.image_width;
+    std::size_t originalHeight = cinfo.image_height;
+
     jpeg_finish_decompress(&cinfo);
     jpeg_destroy_decompress(&cinfo);
 
+    if (previewSize > 0)
+    {
+        return image::createPreviewImage(image->getPixels(), image->getWidth(), image->getHeight(),
+            previewSize, originalWidth, originalHeight);
+    }
+
     return image;
 }
 
@@ -369,6 +395,12 @@ ImagePtr JPEGLoader::load(ArchiveFile& file) const
     return LoadJPGBuff_(buffer.buffer, static_cast<int>(buffer.length));
 }
 
+ImagePtr JPEGLoader::loadPreview(ArchiveFile& file, std::size_t maxSize) const
+{
+    archive::ScopedArchiveBuffer buffer(file);
+    return LoadJPGBuff_(buffer.buffer, static_cast<int>(buffer.length), maxSize);
+}
+
 ImageTypeLoader::Extensions JPEGLoader::getExtensions() const
 {
     Extensions extensions;
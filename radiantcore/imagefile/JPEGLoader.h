@@ -14,6 +14,7 @@ class JPEGLoader : public ImageTypeLoader
 public:
     // ImageTypeLoader implementation
     ImagePtr load(ArchiveFile& file) const override;
+    ImagePtr loadPreview(ArchiveFile& file, std::size_t maxSize) const override;
     Extensions getExtensions() const override;
 };
 
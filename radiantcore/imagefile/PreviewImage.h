@@ -0,0 +1,111 @@
+#pragma once
+
+#include <algorithm>
+#include <utility>
+#include "RGBAImage.h"
+
+namespace image
+{
+
+/**
+ * Low-resolution RGBA version of an image, used for thumbnails and previews.
+ * The texture it binds reports the dimensions of the full-resolution source,
+ * such that clients can lay out the preview like the original image.
+ */
+class PreviewImage :
+    public RGBAImage
+{
+private:
+    std::size_t _originalWidth;
+    std::size_t _originalHeight;
+
+public:
+    PreviewImage(std::size_t width, std::size_t height, std::size_t originalWidth, std::size_t originalHeight) :
+        RGBAImage(width, height),
+        _originalWidth(originalWidth),
+        _originalHeight(originalHeight)
+    {}
+
+    std::size_t getOriginalWidth() const { return _originalWidth; }
+    std::size_t getOriginalHeight() const { return _originalHeight; }
+
+    TexturePtr bindTexture(const std::string& name, Role role) const override
+    {
+        auto texture = std::static_pointer_cast<BasicTexture2D>(RGBAImage::bindTexture(name, role));
+
+        texture->setWidth(_originalWidth);
+        texture->setHeight(_originalHeight);
+
+        return texture;
+    }
+};
+typedef std::shared_ptr<PreviewImage> PreviewImagePtr;
+
+// Returns the dimensions of the given image size after fitting it into maxSize x maxSize, keeping the aspect ratio
+inline std::pair<std::size_t, std::size_t> getPreviewSize(std::size_t width, std::size_t height, std::size_t maxSize)
+{
+    auto largest = std::max(width, height);
+
+    if (largest <= maxSize || largest == 0)
+    {
+        return { width, height };
+    }
+
+    return {
+        std::max<std::size_t>(width * maxSize / largest, 1),
+        std::max<std::size_t>(height * maxSize / largest, 1)
+    };
+}
+
+/**
+ * Creates a preview from the given RGBA pixels, downscaled to fit into maxSize x maxSize.
+ * Each preview pixel is the average of the source pixels it covers.
+ * The original dimensions are those of the full-resolution image the pixels
+ * have been taken from, which might be larger than width x height (e.g. a mipmap level).
+ */
+inline PreviewImagePtr createPreviewImage(const uint8_t* rgba, std::size_t width, std::size_t height,
+    std::size_t maxSize, std::size_t originalWidth, std::size_t originalHeight)
+{
+    auto [targetWidth, targetHeight] = getPreviewSize(width, height, maxSize);
+
+    auto preview = std::make_shared<PreviewImage>(targetWidth, targetHeight, originalWidth, originalHeight);
+    auto* out = preview->getPixels();
+
+    for (std::size_t y = 0; y < targetHeight; ++y)
+    {
+        auto y0 = y * height / targetHeight;
+        auto y1 = std::max((y + 1) * height / targetHeight, y0 + 1);
+
+        for (std::size_t x = 0; x < targetWidth; ++x, out += 4)
+        {
+            auto x0 = x * width / targetWidth;
+            auto x1 = std::max((x + 1) * width / targetWidth, x0 + 1);
+
+            unsigned int sum[4] = { 0, 0, 0, 0 };
+
+            for (auto sy = y0; sy < y1; ++sy)
+            {
+                const auto* in = rgba + (sy * width + x0) * 4;
+
+                for (auto sx = x0; sx < x1; ++sx, in += 4)
+                {
+                    sum[0] += in[0];
+                    sum[1] += in[1];
+                    sum[2] += in[2];
+                    sum[3] += in[3];
+                }
+            }
+
+            auto count = static_cast<unsigned int>((y1 - y0) * (x1 - x0));
+
+            for (int c = 0; c < 4; ++c)
+            {
+                out[c] = static_cast<uint8_t>(sum[c] / count);
+            }
+        }
+    }
+
+    return preview;
+}
+
+}
@@ -0,0 +1,260 @@
+#include "ThumbnailCache.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include <fmt/format.h>
+
+#include "itextstream.h"
+#include "os/fs.h"
+#include "os/path.h"
+
+namespace image
+{
+
+namespace
+{
+    const char* const THUMBNAIL_MAGIC = "DRTN";
+    constexpr uint32_t THUMBNAIL_VERSION = 1;
+
+    // FNV-1a, stable across platforms and standard library implementations
+    uint64_t getStableHash(const std::string& str)
+    {
+        uint64_t hash = 14695981039346656037ull;
+
+        for (auto c : str)
+        {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 1099511628211ull;
+        }
+
+        return hash;
+    }
+
+    template<typename T>
+    void writeValue(std::ostream& stream, T value)
+    {
+        stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template<typename T>
+    bool readValue(std::istream& stream, T& value)
+    {
+        return static_cast<bool>(stream.read(reinterpret_cast<char*>(&value), sizeof(T)));
+    }
+}
+
+ThumbnailCache::ThumbnailCache(const std::string& cachePath,
+    std::size_t maxEntriesInMemory, std::size_t maxFilesOnDisk) :
+    _path(os::standardPathWithSlash(cachePath) + "thumbnails/"),
+    _maxEntriesInMemory(std::max<std::size_t>(maxEntriesInMemory, 1))
+{
+    pruneFiles(maxFilesOnDisk);
+}
+
+std::string ThumbnailCache::GetKey(const vfs::FileInfo& fileInfo, std::size_t maxSize)
+{
+    // Files in PK4s are keyed on the archive's modification time
+    auto sourcePath = fileInfo.getIsPhysicalFile() ?
+        os::standardPathWithSlash(fileInfo.getArchivePath()) + fileInfo.fullPath() :
+        fileInfo.getArchivePath();
+
+    std::error_code ec;
+    auto modificationTime = fs::last_write_time(sourcePath, ec);
+
+    if (ec)
+    {
+        return {};
+    }
+
+    return fmt::format("{0}|{1}|{2}|{3}|{4}", fileInfo.fullPath(), sourcePath,
+        modificationTime.time_since_epoch().count(), fileInfo.getSize(), maxSize);
+}
+
+std::string ThumbnailCache::getFilename(const std::string& key) const
+{
+    return _path + fmt::format("{0:016x}.bin", getStableHash(key));
+}
+
+PreviewImagePtr ThumbnailCache::load(const std::string& key, std::size_t maxSize) const
+{
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+
+        auto found = _entries.find(key);
+
+        if (found != _entries.end())
+        {
+            // Move the entry to the front of the usage list
+            _usage.splice(_usage.begin(), _usage, found->second.usage);
+            return found->second.image;
+        }
+    }
+
+    auto image = loadFromDisk(key, maxSize);
+
+    if (image)
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        insertIntoMemory(key, image);
+    }
+
+    return image;
+}
+
+void ThumbnailCache::clearMemory()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+
+    _entries.clear();
+    _usage.clear();
+}
+
+void ThumbnailCache::insertIntoMemory(const std::string& key, const PreviewImagePtr& image) const
+{
+    auto found = _entries.find(key);
+
+    if (found != _entries.end())
+    {
+        found->second.image = image;
+        _usage.splice(_usage.begin(), _usage, found->second.usage);
+        return;
+    }
+
+    _usage.push_front(key);
+    _entries.emplace(key, CachedThumbnail{ image, _usage.begin() });
+
+    while (_entries.size() > _maxEntriesInMemory)
+    {
+        _entries.erase(_usage.back());
+        _usage.pop_back();
+    }
+}
+
+void ThumbnailCache::pruneFiles(std::size_t maxFiles)
+{
+    std::error_code ec;
+    std::vector<std::pair<decltype(fs::last_write_time(_path, ec)), fs::path>> files;
+
+    for (fs::directory_iterator i(_path, ec), end; !ec && i != end; i.increment(ec))
+    {
+        if (fs::is_regular_file(i->path(), ec))
+        {
+            files.emplace_back(fs::last_write_time(i->path(), ec), i->path());
+        }
+    }
+
+    if (files.size() <= maxFiles) return;
+
+    // Newest first, everything past the limit is removed
+    std::sort(files.begin(), files.end(), [](const auto& a, const auto& b)
+    {
+        return a.first > b.first;
+    });
+
+    for (auto i = files.begin() + maxFiles; i != files.end(); ++i)
+    {
+        fs::remove(i->second, ec);
+    }
+}
+
+PreviewImagePtr ThumbnailCache::loadFromDisk(const std::string& key, std::size_t maxSize) const
+{
+    std::ifstream stream(getFilename(key), std::ios::binary);
+
+    if (!stream) return {};
+
+    char magic[4];
+    uint32_t version = 0;
+    uint32_t keyLength = 0;
+
+    if (!stream.read(magic, 4) || std::string(magic, 4) != THUMBNAIL_MAGIC ||
+        !readValue(stream, version) || version != THUMBNAIL_VERSION ||
+        !readValue(stream, keyLength) || keyLength != key.length())
+    {
+        return {};
+    }
+
+    // Compare the full key to rule out hash collisions and stale entries
+    std::string storedKey(keyLength, '\0');
+
+    if (!stream.read(storedKey.data(), keyLength) || storedKey != key)
+    {
+        return {};
+    }
+
+    uint32_t originalWidth, originalHeight, width, height;
+
+    if (!readValue(stream, originalWidth) || !readValue(stream, originalHeight) ||
+        !readValue(stream, width) || !readValue(stream, height) || width == 0 || height == 0)
+    {
+        return {};
+    }
+
+    // Don't trust the file, a preview is never larger than the requested size
+    if (width > maxSize || height > maxSize)
+    {
+        rWarning() << "Ignoring corrupt thumbnail " << getFilename(key) << std::endl;
+        return {};
+    }
+
+    auto image = std::make_shared<PreviewImage>(width, height, originalWidth, originalHeight);
+
+    if (!stream.read(reinterpret_cast<char*>(image->getPixels()), static_cast<std::streamsize>(width) * height * 4))
+    {
+        return {};
+    }
+
+    return image;
+}
+
+void ThumbnailCache::store(const std::string& key, const PreviewImagePtr& preview) const
+{
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        insertIntoMemory(key, preview);
+    }
+
+    const auto& image = *preview;
+
+    std::error_code ec;
+    fs::create_directories(_path, ec);
+
+    auto filename = getFilename(key);
+
+    // Write to a temporary file first, thumbnails might be generated from several threads
+    std::ostringstream tempSuffix;
+    tempSuffix << ".tmp" << std::this_thread::get_id();
+    auto tempFilename = filename + tempSuffix.str();
+
+    {
+        std::ofstream stream(tempFilename, std::ios::binary);
+
+        if (!stream)
+        {
+            rWarning() << "Cannot write thumbnail to " << tempFilename << std::endl;
+            return;
+        }
+
+        stream.write(THUMBNAIL_MAGIC, 4);
+        writeValue<uint32_t>(stream, THUMBNAIL_VERSION);
+        writeValue<uint32_t>(stream, static_cast<uint32_t>(key.length()));
+        stream.write(key.data(), key.length());
+        writeValue<uint32_t>(stream, static_cast<uint32_t>(image.getOriginalWidth()));
+        writeValue<uint32_t>(stream, static_cast<uint32_t>(image.getOriginalHeight()));
+        writeValue<uint32_t>(stream, static_cast<uint32_t>(image.getWidth()));
+        writeValue<uint32_t>(stream, static_cast<uint32_t>(image.getHeight()));
+        stream.write(reinterpret_cast<const char*>(image.getPixels()), image.getWidth() * image.getHeight() * 4);
+    }
+
+    fs::rename(tempFilename, filename, ec);
+
+    if (ec)
+    {
+        fs::remove(tempFilename, ec);
+    }
+}
+
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "ifilesystem.h"
+#include "PreviewImage.h"
+
+namespace image
+{
+
+/**
+ * Persistent on-disk storage of preview images, such that the texture browser
+ * and similar views don't need to decode the full-resolution source images
+ * again in the next session.
+ *
+ * Entries are identified by a key string which includes the modification time
+ * and size of the source file (or the PK4 it is contained in), which
+ * invalidates the cached thumbnail as soon as the source changes.
+ *
+ * The most recently used thumbnails are additionally kept in memory, up to a
+ * fixed number of entries. The on-disk storage is trimmed to a maximum number
+ * of files on construction, dropping the least recently written ones.
+ */
+class ThumbnailCache
+{
+private:
+    // Folder the thumbnail files are written to, including trailing slash
+    std::string _path;
+
+    struct CachedThumbnail
+    {
+        PreviewImagePtr image;
+
+        // The position of this entry in the usage list
+        std::list<std::string>::iterator usage;
+    };
+
+    // Thumbnails held in memory, bounded by _maxEntriesInMemory
+    mutable std::unordered_map<std::string, CachedThumbnail> _entries;
+
+    // The keys of the thumbnails in memory, most recently used first
+    mutable std::list<std::string> _usage;
+
+    // Thumbnails are requested from several threads
+    mutable std::mutex _lock;
+
+    std::size_t _maxEntriesInMemory;
+
+public:
+    static constexpr std::size_t DefaultMaxEntriesInMemory = 512;
+    static constexpr std::size_t DefaultMaxFilesOnDisk = 8192;
+
+    ThumbnailCache(const std::string& cachePath,
+        std::size_t maxEntriesInMemory = DefaultMaxEntriesInMemory,
+        std::size_t maxFilesOnDisk = DefaultMaxFilesOnDisk);
+
+    // Returns the cache key for the given source file and preview size.
+    // Returns an empty string if the source file can't be located on disk.
+    static std::string GetKey(const vfs::FileInfo& fileInfo, std::size_t maxSize);
+
+    // Returns the cached thumbnail for the given key, or an empty pointer if not present.
+    // Entries exceeding the given preview size are considered corrupt and ignored.
+    PreviewImagePtr load(const std::string& key, std::size_t maxSize) const;
+
+    // Writes the given thumbnail to the cache, replacing any previous entry
+    void store(const std::string& key, const PreviewImagePtr& preview) const;
+
+    // Releases the thumbnails held in memory, the files on disk are kept
+    void clearMemory();
+
+private:
+    std::string getFilename(const std::string& key) const;
+
+    PreviewImagePtr loadFromDisk(const std::string& key, std::size_t maxSize) const;
+
+    // Adds or refreshes the in-memory entry, evicting the least recently used
+    // thumbnails beyond the capacity. Must be called with _lock held.
+    void insertIntoMemory(const std::string& key, const PreviewImagePtr& image) const;
+
+    // Removes the oldest thumbnail files until at most maxFiles remain
+    void pruneFiles(std::size_t maxFiles);
+};
+
+}
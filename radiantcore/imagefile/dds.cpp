@@ -32,6 +32,7 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 #include "ddslib.h"
 #include "util/Noncopyable.h"
 #include "RGBAImage.h"
+#include "BCnDecoder.h"
 
 namespace image
 {
@@ -200,7 +201,25 @@ static const std::map<std::string, GLenum> GL_FMT_FOR_FOURCC
     { "DXT1", GL_COMPRESSED_RGBA_S3TC_DXT1_EXT },
     { "DXT3", GL_COMPRESSED_RGBA_S3TC_DXT3_EXT },
     { "DXT5", GL_COMPRESSED_RGBA_S3TC_DXT5_EXT },
-    { "ATI2", GL_COMPRESSED_RG_RGTC2 }
+    { "ATI1", GL_COMPRESSED_RED_RGTC1 },
+    { "BC4U", GL_COMPRESSED_RED_RGTC1 },
+    { "ATI2", GL_COMPRESSED_RG_RGTC2 },
+    { "BC5U", GL_COMPRESSED_RG_RGTC2 }
+};
+
+// Map the DXGI formats of the DX10 extended header to GLenum compression formats
+static const std::map<uint32_t, GLenum> GL_FMT_FOR_DXGI_FORMAT
+{
+    { DXGI_FORMAT_BC1_UNORM, GL_COMPRESSED_RGBA_S3TC_DXT1_EXT },
+    { DXGI_FORMAT_BC1_UNORM_SRGB, GL_COMPRESSED_RGBA_S3TC_DXT1_EXT },
+    { DXGI_FORMAT_BC2_UNORM, GL_COMPRESSED_RGBA_S3TC_DXT3_EXT },
+    { DXGI_FORMAT_BC2_UNORM_SRGB, GL_COMPRESSED_RGBA_S3TC_DXT3_EXT },
+    { DXGI_FORMAT_BC3_UNORM, GL_COMPRESSED_RGBA_S3TC_DXT5_EXT },
+    { DXGI_FORMAT_BC3_UNORM_SRGB, GL_COMPRESSED_RGBA_S3TC_DXT5_EXT },
+    { DXGI_FORMAT_BC4_UNORM, GL_COMPRESSED_RED_RGTC1 },
+    { DXGI_FORMAT_BC5_UNORM, GL_COMPRESSED_RG_RGTC2 },
+    { DXGI_FORMAT_BC7_UNORM, GL_COMPRESSED_RGBA_BPTC_UNORM },
+    { DXGI_FORMAT_BC7_UNORM_SRGB, GL_COMPRESSED_RGBA_BPTC_UNORM },
 };
 
 // Map uncompressed DDS bit depths to GLenum memory layouts
@@ -210,7 +229,22 @@ static const std::map<int, GLenum> GL_FMT_FOR_BITDEPTH
     { 32, GL_BGRA }
 };
 
-DDSImagePtr LoadDDSFromStream(InputStream& stream)
+// Format and mipmap layout of a DDS file, as described by its header
+struct DDSLayout
+{
+    GLenum format = 0;
+    bool compressed = false;
+    int bitDepth = 0;
+
+    MipMapInfoList mipMapInfo;
+
+    // Total size of the pixel data of all mipmaps
+    std::size_t size = 0;
+};
+
+// Reads the header(s) from the stream and calculates the mipmap layout.
+// The stream is positioned at the beginning of the first mipmap afterwards.
+bool ReadDDSLayout(InputStream& stream, DDSLayout& layout)
 {
     // Load the header
     typedef StreamBase::byte_type byteType;
@@ -221,28 +255,55 @@ DDSImagePtr LoadDDSFromStream(InputStream& stream)
     if (!header.isValid())
     {
         rError() << "Invalid DDS header" << std::endl;
-        return {};
+        return false;
     }
 
     // Extract basic metadata: width, height, format and mipmap count
     int width = header.getWidth(), height = header.getHeight();
     std::string compressionFormat = header.getCompressionFormat();
-    int bitDepth = header.getRGBBits();
     std::size_t mipMapCount = header.getMipMapCount();
 
-    MipMapInfoList mipMapInfo;
-    mipMapInfo.resize(mipMapCount);
+    layout.bitDepth = header.getRGBBits();
+    layout.compressed = header.isCompressed();
 
-    // Calculate the total memory requirements (greebo: DXT1 has 8 bytes per block)
-    std::size_t blockBytes = (compressionFormat == "DXT1") ? 8 : 16;
+    // Determine the GL format, BC7 and friends are only defined in the DX10 extended header
+    if (compressionFormat == "DX10")
+    {
+        DDSHeaderDX10 headerDX10;
+        stream.read(reinterpret_cast<byteType*>(&headerDX10), sizeof(headerDX10));
+
+        if (GL_FMT_FOR_DXGI_FORMAT.count(headerDX10.dxgiFormat) == 1)
+        {
+            layout.format = GL_FMT_FOR_DXGI_FORMAT.at(headerDX10.dxgiFormat);
+        }
+    }
+    else if (GL_FMT_FOR_FOURCC.count(compressionFormat) == 1)
+    {
+        layout.format = GL_FMT_FOR_FOURCC.at(compressionFormat);
+    }
+    else if (!layout.compressed && GL_FMT_FOR_BITDEPTH.count(layout.bitDepth) == 1)
+    {
+        layout.format = GL_FMT_FOR_BITDEPTH.at(layout.bitDepth);
+    }
+
+    if (layout.format == 0)
+    {
+        rError() << "Unknown DDS format (" << compressionFormat << ")" << std::endl;
+        return false;
+    }
+
+    layout.mipMapInfo.resize(mipMapCount);
+
+    // Calculate the total memory requirements (BC1 and BC4 have 8 bytes per block, the others 16)
+    auto blockFormat = getBlockFormat(layout.format);
+    std::size_t blockBytes = blockFormat ? getBlockSize(*blockFormat) : 16;
 
-    std::size_t size = 0;
     std::size_t offset = 0;
 
     for (std::size_t i = 0; i < mipMapCount; ++i)
     {
         // Create a new mipmap structure
-        MipMapInfo& mipMap = mipMapInfo[i];
+        MipMapInfo& mipMap = layout.mipMapInfo[i];
 
         mipMap.offset = offset;
         mipMap.width = width;
@@ -251,42 +312,47 @@ DDSImagePtr LoadDDSFromStream(InputStream& stream)
         // Calculate size in bytes for this mipmap. For compressed formats,
         // this is based on the block size, otherwise it derives from the bytes
         // per pixel.
-        if (header.isCompressed())
+        if (layout.compressed)
             mipMap.size = ((width + 3) / 4) * ((height + 3) / 4) * blockBytes;
         else
-            mipMap.size = width * height * (bitDepth / 8);
+            mipMap.size = width * height * (layout.bitDepth / 8);
 
         // Update the offset for the next mipmap
         offset += mipMap.size;
 
         // Increase the size counter
-        size += mipMap.size;
+        layout.size += mipMap.size;
 
         // Go to the next mipmap
         width = std::max(width/2, 1);
         height = std::max(height/2, 1);
     }
 
-    // Allocate a new DDS image with that size
-    DDSImagePtr image(new DDSImage(size));
+    return true;
+}
 
-    // Set the format of this DDS image
-    if (GL_FMT_FOR_FOURCC.count(compressionFormat) == 1) {
-        image->setFormat(GL_FMT_FOR_FOURCC.at(compressionFormat), true);
-    }
-    else if (GL_FMT_FOR_BITDEPTH.count(bitDepth) == 1) {
-        image->setFormat(GL_FMT_FOR_BITDEPTH.at(bitDepth), false);
-    }
-    else {
-        rError() << "Unknown DDS format (" << compressionFormat << ")" << std::endl;
+DDSImagePtr LoadDDSFromStream(InputStream& stream)
+{
+    typedef StreamBase::byte_type byteType;
+
+    DDSLayout layout;
+
+    if (!ReadDDSLayout(stream, layout))
+    {
         return {};
     }
 
+    // Allocate a new DDS image with that size
+    DDSImagePtr image(new DDSImage(layout.size));
+
+    // Set the format of this DDS image
+    image->setFormat(layout.format, layout.compressed);
+
     // Load the mipmaps into the allocated memory
-    for (std::size_t i = 0; i < mipMapInfo.size(); ++i)
+    for (std::size_t i = 0; i < layout.mipMapInfo.size(); ++i)
     {
         // Appaned a new mipmap and store the offset
-        const MipMapInfo& mipMap = mipMapInfo[i];
+        const MipMapInfo& mipMap = layout.mipMapInfo[i];
         uint8_t* mipMapBytes = image->addMipMap(mipMap);
 
         // Read the data into the DDSImage's memory
@@ -299,6 +365,90 @@ DDSImagePtr LoadDDSFromStream(InputStream& stream)
     return image;
 }
 
+// Skips the given number of bytes in the stream, seeking if the stream supports it
+void SkipStreamBytes(InputStream& stream, std::size_t numBytes)
+{
+    if (auto seekable = dynamic_cast<SeekableInputStream*>(&stream); seekable)
+    {
+        seekable->seek(static_cast<SeekableStream::offset_type>(numBytes), SeekableStream::cur);
+        return;
+    }
+
+    std::vector<StreamBase::byte_type> scratch(std::min<std::size_t>(numBytes, 65536));
+
+    while (numBytes > 0)
+    {
+        auto bytesRead = stream.read(scratch.data(), std::min(numBytes, scratch.size()));
+        if (bytesRead == 0) break;
+
+        numBytes -= bytesRead;
+    }
+}
+
+// Loads the largest mipmap fitting into maxSize x maxSize and converts it to a preview image.
+// The pixel data of the larger mipmaps is skipped without being decoded.
+ImagePtr LoadDDSPreviewFromStream(InputStream& stream, std::size_t maxSize)
+{
+    DDSLayout layout;
+
+    if (!ReadDDSLayout(stream, layout) || layout.mipMapInfo.empty())
+    {
+        return {};
+    }
+
+    std::size_t level = 0;
+
+    while (level + 1 < layout.mipMapInfo.size() &&
+           std::max(layout.mipMapInfo[level].width, layout.mipMapInfo[level].height) > maxSize)
+    {
+        ++level;
+    }
+
+    const auto& mipMap = layout.mipMapInfo[level];
+    SkipStreamBytes(stream, mipMap.offset);
+
+    std::vector<uint8_t> data(mipMap.size);
+
+    if (stream.read(reinterpret_cast<StreamBase::byte_type*>(data.data()), mipMap.size) != mipMap.size)
+    {
+        rError() << "DDS file is truncated" << std::endl;
+        return {};
+    }
+
+    std::vector<uint8_t> rgba(mipMap.width * mipMap.height * 4);
+
+    if (layout.compressed)
+    {
+        auto blockFormat = getBlockFormat(layout.format);
+
+        if (!blockFormat)
+        {
+            rWarning() << "Cannot create a preview of DDS format " << layout.format << std::endl;
+            return {};
+        }
+
+        decodeBlocks(*blockFormat, data.data(), mipMap.width, mipMap.height, rgba.data());
+    }
+    else
+    {
+        // Uncompressed DDS images are stored in BGR(A) order
+        auto bytesPerPixel = static_cast<std::size_t>(layout.bitDepth / 8);
+
+        for (std::size_t i = 0; i < mipMap.width * mipMap.height; ++i)
+        {
+            const auto* in = data.data() + i * bytesPerPixel;
+
+            rgba[i * 4 + 0] = in[2];
+            rgba[i * 4 + 1] = in[1];
+            rgba[i * 4 + 2] = in[0];
+            rgba[i * 4 + 3] = bytesPerPixel == 4 ? in[3] : 255;
+        }
+    }
+
+    return createPreviewImage(rgba.data(), mipMap.width, mipMap.height, maxSize,
+        layout.mipMapInfo.front().width, layout.mipMapInfo.front().height);
+}
+
 ImagePtr LoadDDS(ArchiveFile& file) {
     return LoadDDSFromStream(file.getInputStream());
 }
@@ -309,6 +459,11 @@ ImagePtr DDSLoader::load(ArchiveFile& file) const
     return LoadDDS(file);
 }
 
+ImagePtr DDSLoader::loadPreview(ArchiveFile& file, std::size_t maxSize) const
+{
+    return LoadDDSPreviewFromStream(file.getInputStream(), maxSize);
+}
+
 ImageTypeLoader::Extensions DDSLoader::getExtensions() const
 {
     Extensions extensions;
@@ -13,6 +13,9 @@ public:
     // ImageTypeLoader implementation
 	ImagePtr load(ArchiveFile& file) const;
 
+    // Reads only the mipmap level closest to the requested preview size
+    ImagePtr loadPreview(ArchiveFile& file, std::size_t maxSize) const override;
+
 	Extensions getExtensions() const;
 
 	/* greebo: Returns the prefix that is necessary to construct the
@@ -50,6 +50,8 @@ enum ddsPF_t
     DDS_PF_DXT4,
     DDS_PF_DXT5,
     DDS_PF_DXT5_RXGB,   /* Doom 3's swizzled format */
+    DDS_PF_BC4,         /* ATI1 / BC4U */
+    DDS_PF_BC5,         /* ATI2 / BC5U */
     DDS_PF_UNKNOWN
 };
 
@@ -250,41 +252,48 @@ struct DDSHeader
     }
 };
 
-// Debug output for DDSHeader
-std::ostream& operator<< (std::ostream& os, const DDSHeader& h);
-
-struct ddsBuffer_t
+/// DXGI formats of the block-compressed textures, as found in the DX10 extended header
+enum DXGIFormat
 {
-    DDSHeader           header;
-
-    /* data (Varying size) */
-    unsigned char       data[ 4 ];
+    DXGI_FORMAT_BC1_TYPELESS = 70,
+    DXGI_FORMAT_BC1_UNORM = 71,
+    DXGI_FORMAT_BC1_UNORM_SRGB = 72,
+    DXGI_FORMAT_BC2_TYPELESS = 73,
+    DXGI_FORMAT_BC2_UNORM = 74,
+    DXGI_FORMAT_BC2_UNORM_SRGB = 75,
+    DXGI_FORMAT_BC3_TYPELESS = 76,
+    DXGI_FORMAT_BC3_UNORM = 77,
+    DXGI_FORMAT_BC3_UNORM_SRGB = 78,
+    DXGI_FORMAT_BC4_TYPELESS = 79,
+    DXGI_FORMAT_BC4_UNORM = 80,
+    DXGI_FORMAT_BC4_SNORM = 81,
+    DXGI_FORMAT_BC5_TYPELESS = 82,
+    DXGI_FORMAT_BC5_UNORM = 83,
+    DXGI_FORMAT_BC5_SNORM = 84,
+    DXGI_FORMAT_BC7_TYPELESS = 97,
+    DXGI_FORMAT_BC7_UNORM = 98,
+    DXGI_FORMAT_BC7_UNORM_SRGB = 99,
 };
 
-/** greebo: This represents a 64 bit DDS block containing
- *          either the alpha or the colour data.
- */
-struct ddsColorBlock_t
+/// Extended header following the DDSHeader if the FOURCC is "DX10"
+struct DDSHeaderDX10
 {
-    unsigned short      colors[ 2 ];// 32 bit (2 x 16 bit)
-    unsigned char       row[ 4 ];   // 32 bit (4 x 8 bit)
+    uint32_t            dxgiFormat;
+    uint32_t            resourceDimension;
+    uint32_t            miscFlag;
+    uint32_t            arraySize;
+    uint32_t            miscFlags2;
 };
 
-struct ddsAlphaBlockExplicit_t
-{
-    unsigned short      row[ 4 ];
-};
+// Debug output for DDSHeader
+std::ostream& operator<< (std::ostream& os, const DDSHeader& h);
 
-struct ddsAlphaBlock3BitLinear_t
+struct ddsBuffer_t
 {
-    unsigned char       alpha0;
-    unsigned char       alpha1;
-    unsigned char       stuff[ 6 ];
-};
+    DDSHeader           header;
 
-struct ddsColor_t
-{
-    unsigned char       r, g, b, a;
+    /* data (Varying size) */
+    unsigned char       data[ 4 ];
 };
 
 /* public functions */
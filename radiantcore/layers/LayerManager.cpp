@@ -6,16 +6,15 @@
 #include "icommandsystem.h"
 #include "scene/Node.h"
 #include "scenelib.h"
+#include "entitylib.h"
 #include "module/StaticModule.h"
 
-#include "AddToLayerWalker.h"
-#include "MoveToLayerWalker.h"
-#include "RemoveFromLayerWalker.h"
-#include "SetLayerSelectedWalker.h"
 #include "LayerInfoFileModule.h"
 
 #include <functional>
+#include <algorithm>
 #include <climits>
+#include <unordered_set>
 
 namespace scene
 {
@@ -24,6 +23,35 @@ namespace
 {
 	const char* const DEFAULT_LAYER_NAME = N_("Default");
 	const int DEFAULT_LAYER = 0;
+
+	// Checks whether any direct child of the visited node is not hidden by layers
+	class VisibleChildFinder :
+		public NodeVisitor
+	{
+	public:
+		bool found = false;
+
+		bool pre(const INodePtr& node) override
+		{
+			if (!node->checkStateFlag(Node::eLayered))
+			{
+				found = true;
+			}
+
+			return false; // don't descend
+		}
+	};
+
+	// Returns true if the node and all its ancestors (except for the root) are visible
+	bool isVisibleInScene(const INodePtr& node)
+	{
+		for (auto n = node; n && !n->isRoot(); n = n->getParent())
+		{
+			if (!n->visible()) return false;
+		}
+
+		return true;
+	}
 }
 
 LayerManager::LayerManager() :
@@ -99,8 +127,12 @@ void LayerManager::deleteLayer(const std::string& name)
 	}
 
 	// Remove all nodes from this layer first, but don't de-select them yet
-	RemoveFromLayerWalker walker(layerID);
-	GlobalSceneGraph().root()->traverse(walker);
+	auto members = getLayerMembers(layerID);
+
+	for (const auto& node : members)
+	{
+		node->removeFromLayer(layerID);
+	}
 
 	// Remove the layer
 	_layers.erase(layerID);
@@ -119,7 +151,7 @@ void LayerManager::deleteLayer(const std::string& name)
 
 	// Nodes might have switched to default, fire the visibility 
 	// changed event, update the scenegraph and redraw the views
-	onNodeMembershipChanged();
+	onNodeMembershipChanged(members);
 }
 
 void LayerManager::foreachLayer(const LayerVisitFunc& visitor)
@@ -253,7 +285,7 @@ void LayerManager::setLayerVisibility(int layerID, bool visible)
     }
 
 	// Fire the visibility changed event
-	onLayerVisibilityChanged();
+	onLayerVisibilityChanged(layerID);
 }
 
 void LayerManager::setLayerVisibility(const std::string& layerName, bool visible) 
@@ -271,31 +303,120 @@ void LayerManager::setLayerVisibility(const std::string& layerName, bool visible
 	setLayerVisibility(layerID, visible);
 }
 
-void LayerManager::updateSceneGraphVisibility()
+void LayerManager::updateNodesVisibility(const std::vector<INodePtr>& nodes)
 {
-	UpdateNodeVisibilityWalker walker(GlobalSceneGraph().root());
-	GlobalSceneGraph().root()->traverseChildren(walker);
+	// The visibility of a parent depends on its children, so the ancestors
+	// of the given nodes need to be re-evaluated too, deepest nodes first
+	std::vector<std::pair<std::size_t, INodePtr>> nodesByDepth;
+	std::unordered_set<INode*> visited;
+
+	for (const auto& node : nodes)
+	{
+		std::vector<INodePtr> ancestry;
+
+		for (auto n = node; n && !n->isRoot(); n = n->getParent())
+		{
+			ancestry.push_back(n);
+		}
+
+		for (std::size_t i = 0; i < ancestry.size(); ++i)
+		{
+			if (visited.insert(ancestry[i].get()).second)
+			{
+				nodesByDepth.emplace_back(ancestry.size() - i, ancestry[i]);
+			}
+		}
+	}
+
+	std::stable_sort(nodesByDepth.begin(), nodesByDepth.end(), [](const auto& a, const auto& b)
+	{
+		return a.first > b.first;
+	});
+
+	for (const auto& pair : nodesByDepth)
+	{
+		const auto& node = pair.second;
+
+		if (!updateNodeVisibility(node))
+		{
+			// A node with visible children is shown, regardless of its own layers
+			VisibleChildFinder finder;
+			node->traverseChildren(finder);
+
+			if (finder.found)
+			{
+				node->disable(Node::eLayered);
+			}
+		}
+
+		if (node->checkStateFlag(Node::eLayered))
+		{
+			// Node is hidden by layers after update (and no children are visible), de-select
+			Node_setSelected(node, false);
+		}
+	}
 
 	// Redraw
 	SceneChangeNotify();
 }
 
+std::vector<INodePtr> LayerManager::getLayerMembers(int layerID) const
+{
+	std::vector<INodePtr> result;
+
+	auto found = _layerMembers.find(layerID);
+
+	if (found != _layerMembers.end())
+	{
+		result.reserve(found->second.size());
+
+		for (auto node : found->second)
+		{
+			result.push_back(node->getSelf());
+		}
+	}
+
+	return result;
+}
+
+std::vector<INodePtr> LayerManager::getSelectedNodesAndEntityChildren() const
+{
+	std::vector<INodePtr> result;
+
+	GlobalSelectionSystem().foreachSelected([&](const INodePtr& node)
+	{
+		result.push_back(node);
+
+		if (Node_isEntity(node))
+		{
+			// We have an entity, take all children along
+			node->foreachNode([&](const INodePtr& child)
+			{
+				result.push_back(child);
+				return true;
+			});
+		}
+	});
+
+	return result;
+}
+
 void LayerManager::onLayersChanged()
 {
 	_layersChangedSignal.emit();
 }
 
-void LayerManager::onNodeMembershipChanged()
+void LayerManager::onNodeMembershipChanged(const std::vector<INodePtr>& affectedNodes)
 {
 	_nodeMembershipChangedSignal.emit();
 
-	updateSceneGraphVisibility();
+	updateNodesVisibility(affectedNodes);
 }
 
-void LayerManager::onLayerVisibilityChanged()
+void LayerManager::onLayerVisibilityChanged(int layerID)
 {
-	// Update all nodes and views
-	updateSceneGraphVisibility();
+	// Update the members of this layer and the views
+	updateNodesVisibility(getLayerMembers(layerID));
 
 	// Update the LayerControlDialog
 	_layerVisibilityChangedSignal.emit();
@@ -307,11 +428,14 @@ void LayerManager::addSelectionToLayer(int layerID) {
 		return;
 	}
 
-	// Instantiate a Selectionwalker and traverse the selection
-	AddToLayerWalker walker(layerID);
-	GlobalSelectionSystem().foreachSelected(walker);
+	auto nodes = getSelectedNodesAndEntityChildren();
+
+	for (const auto& node : nodes)
+	{
+		node->addToLayer(layerID);
+	}
 
-	onNodeMembershipChanged();
+	onNodeMembershipChanged(nodes);
 }
 
 void LayerManager::addSelectionToLayer(const std::string& layerName) {
@@ -348,11 +472,7 @@ void LayerManager::moveSelectionToLayer(int layerID) {
 		return;
 	}
 
-	// Instantiate a Selectionwalker and traverse the selection
-	MoveToLayerWalker walker(layerID);
-	GlobalSelectionSystem().foreachSelected(walker);
-
-	onNodeMembershipChanged();
+	assignNodesToLayers(getSelectedNodesAndEntityChildren(), LayerList{ layerID });
 }
 
 void LayerManager::removeSelectionFromLayer(const std::string& layerName) {
@@ -375,11 +495,14 @@ void LayerManager::removeSelectionFromLayer(int layerID) {
 		return;
 	}
 
-	// Instantiate a Selectionwalker and traverse the selection
-	RemoveFromLayerWalker walker(layerID);
-	GlobalSelectionSystem().foreachSelected(walker);
+	auto nodes = getSelectedNodesAndEntityChildren();
+
+	for (const auto& node : nodes)
+	{
+		node->removeFromLayer(layerID);
+	}
 
-	onNodeMembershipChanged();
+	onNodeMembershipChanged(nodes);
 }
 
 bool LayerManager::updateNodeVisibility(const scene::INodePtr& node)
@@ -420,14 +543,58 @@ bool LayerManager::updateNodeVisibility(const scene::INodePtr& node)
 	return !isHidden;
 }
 
+void LayerManager::assignNodesToLayers(const std::vector<INodePtr>& nodes, const LayerList& layers)
+{
+	if (layers.empty()) return;
+
+	for (const auto& node : nodes)
+	{
+		node->assignToLayers(layers);
+	}
+
+	onNodeMembershipChanged(nodes);
+}
+
+void LayerManager::registerNode(INode& node)
+{
+	// The root node is not subject to layer visibility
+	if (node.isRoot()) return;
+
+	for (int layerId : node.getLayers())
+	{
+		_layerMembers[layerId].insert(&node);
+	}
+}
+
+void LayerManager::unregisterNode(INode& node)
+{
+	for (int layerId : node.getLayers())
+	{
+		auto found = _layerMembers.find(layerId);
+
+		if (found == _layerMembers.end()) continue;
+
+		found->second.erase(&node);
+
+		if (found->second.empty())
+		{
+			_layerMembers.erase(found);
+		}
+	}
+}
+
 void LayerManager::setSelected(int layerID, bool selected)
 {
-	SetLayerSelectedWalker walker(layerID, selected);
+	for (const auto& node : getLayerMembers(layerID))
+	{
+		// Skip the worldspawn and any nodes hidden by themselves or their parents
+		if (Node_isWorldspawn(node) || !isVisibleInScene(node))
+		{
+			continue;
+		}
 
-    if (GlobalSceneGraph().root())
-    {
-        GlobalSceneGraph().root()->traverseChildren(walker);
-    }
+		Node_setSelected(node, selected);
+	}
 }
 
 sigc::signal<void> LayerManager::signal_layersChanged()
@@ -2,6 +2,8 @@
 
 #include <vector>
 #include <map>
+#include <list>
+#include <unordered_map>
 #include "ilayer.h"
 #include "imap.h"
 
@@ -22,6 +24,44 @@ private:
 	typedef std::map<int, std::string> LayerMap;
 	LayerMap _layers;
 
+	// The member nodes of a single layer. Iteration follows the order the nodes
+	// have been registered in (which is the scene graph order when loading a map),
+	// such that selecting a layer's members is deterministic.
+	class LayerMembers
+	{
+	private:
+		std::list<INode*> _nodes;
+		std::unordered_map<INode*, std::list<INode*>::iterator> _positions;
+
+	public:
+		void insert(INode* node)
+		{
+			if (_positions.count(node) > 0) return;
+
+			_positions.emplace(node, _nodes.insert(_nodes.end(), node));
+		}
+
+		void erase(INode* node)
+		{
+			auto found = _positions.find(node);
+
+			if (found == _positions.end()) return;
+
+			_nodes.erase(found->second);
+			_positions.erase(found);
+		}
+
+		bool empty() const { return _nodes.empty(); }
+		std::size_t size() const { return _nodes.size(); }
+
+		std::list<INode*>::const_iterator begin() const { return _nodes.begin(); }
+		std::list<INode*>::const_iterator end() const { return _nodes.end(); }
+	};
+
+	// The nodes of the scene which are member of each layer, indexed by layer ID.
+	// The nodes (un-)register themselves when entering or leaving the scene.
+	std::map<int, LayerMembers> _layerMembers;
+
 	// The ID of the active layer
 	int _activeLayer;
 
@@ -111,6 +151,11 @@ public:
 
 	bool updateNodeVisibility(const scene::INodePtr& node) override;
 
+	void assignNodesToLayers(const std::vector<INodePtr>& nodes, const LayerList& layers) override;
+
+	void registerNode(INode& node) override;
+	void unregisterNode(INode& node) override;
+
 	// Selects/unselects an entire layer
 	void setSelected(int layerID, bool selected) override;
 
@@ -122,14 +167,20 @@ private:
 	// Internal event emitter
 	void onLayersChanged();
 
-	// Internal event, updates the scenegraph
-	void onLayerVisibilityChanged();
+	// Internal event, updates the members of the given layer
+	void onLayerVisibilityChanged(int layerID);
 
-	// Internal event emitter
-	void onNodeMembershipChanged();
+	// Internal event emitter, updates the visibility of the given nodes
+	void onNodeMembershipChanged(const std::vector<INodePtr>& affectedNodes);
+
+	// Updates the visibility state of the given nodes and their ancestors
+	void updateNodesVisibility(const std::vector<INodePtr>& nodes);
+
+	// Returns the current members of the given layer
+	std::vector<INodePtr> getLayerMembers(int layerID) const;
 
-	// Updates the visibility state of the entire scenegraph
-	void updateSceneGraphVisibility();
+	// Returns the selected nodes, including the children of selected entities
+	std::vector<INodePtr> getSelectedNodesAndEntityChildren() const;
 
 	// Returns the highest used layer Id
 	int getHighestLayerID() const;
@@ -27,13 +27,16 @@
 #include "os/path.h"
 #include "os/file.h"
 #include "time/ScopeTimer.h"
+#include "debugging/ScopedTraceZone.h"
 
+#include "brush/Brush.h"
 #include "brush/BrushModule.h"
 #include "scene/BasicRootNode.h"
 #include "scene/PrefabBoundsAccumulator.h"
 #include "map/MapFileManager.h"
 #include "map/MapPositionManager.h"
 #include "map/MapResource.h"
+#include "map/NodeCounter.h"
 #include "map/algorithm/Import.h"
 #include "map/algorithm/Export.h"
 #include "scene/Traverse.h"
@@ -41,6 +44,7 @@
 #include "model/export/ModelExporter.h"
 #include "model/export/ModelScalePreserver.h"
 #include "map/algorithm/Skins.h"
+#include "map/algorithm/MemoryUsage.h"
 #include "messages/ScopedLongRunningOperation.h"
 #include "messages/FileOverwriteConfirmation.h"
 #include "messages/FileSaveConfirmation.h"
@@ -137,6 +141,8 @@ void Map::loadMapResourceFromArchive(const std::string& archive, const std::stri
 
 void Map::loadMapResourceFromLocation(const MapLocation& location)
 {
+    profiling::ScopedTraceZone zone("map", "Map::loadMapResource", location.path);
+
     rMessage() << "Loading map from " << location.path <<
         (location.isArchive ? " [" + location.archiveRelativePath + "]" : "") << std::endl;
 
@@ -155,11 +161,16 @@ void Map::loadMapResourceFromLocation(const MapLocation& location)
     try
     {
         util::ScopeTimer timer("map load");
+        profiling::ScopedTraceZone loadZone("map", "MapResource::load");
 
         if (isUnnamed() || !_resource->load())
         {
             clearMapResource();
         }
+
+        // Build the windings of the parsed brushes in one batch,
+        // instead of one after the other when they're inserted into the scene
+        Brush::evaluateChangedBReps();
     }
     catch (const IMapResource::OperationException& ex)
     {
@@ -172,6 +183,13 @@ void Map::loadMapResourceFromLocation(const MapLocation& location)
     // Take the new node and insert it as map root
     GlobalSceneGraph().setRoot(_resource->getRootNode());
 
+    if (GlobalTraceCollector().isEnabled())
+    {
+        NodeCounter counter;
+        GlobalSceneGraph().root()->traverse(counter);
+        profiling::recordTraceCounter("map.loadedNodes", static_cast<double>(counter.getCount()));
+    }
+
 	// Traverse the scenegraph and find the worldspawn
 	findWorldspawn();
 
@@ -179,6 +197,7 @@ void Map::loadMapResourceFromLocation(const MapLocation& location)
     // This usually takes a while since all editor textures are loaded - display a dialog to inform the user
     {
         radiant::ScopedLongRunningOperation blocker(_("Loading textures..."));
+        profiling::ScopedTraceZone renderSystemZone("map", "Map::setRenderSystem");
 
         GlobalSceneGraph().root()->setRenderSystem(std::dynamic_pointer_cast<RenderSystem>(
             module::GlobalModuleRegistry().getModule(MODULE_RENDERSYSTEM)));
@@ -630,6 +649,7 @@ bool Map::save(const MapFormatPtr& mapFormat)
     emitMapEvent(MapSaving);
 
     util::ScopeTimer timer("map save");
+    profiling::ScopedTraceZone zone("map", "Map::save", _mapName);
 
     bool success = false;
 
@@ -726,6 +746,7 @@ void Map::saveDirect(const std::string& filename, const MapFormatPtr& mapFormat)
 
     try
     {
+        profiling::ScopedTraceZone zone("map", "Map::saveDirect", filename);
         MapResource::saveFile(*format, GlobalSceneGraph().root(), scene::traverse, filename);
     }
     catch (const IMapResource::OperationException& ex)
@@ -1000,6 +1021,7 @@ void Map::registerCommands()
     GlobalCommandSystem().addCommand("ExportMap", std::bind(&Map::exportMap, this, std::placeholders::_1));
     GlobalCommandSystem().addCommand("SaveSelected", Map::exportSelection);
 	GlobalCommandSystem().addCommand("ReloadSkins", map::algorithm::reloadSkins);
+    GlobalCommandSystem().addCommand("PrintNodeMemoryUsage", map::algorithm::printNodeMemoryUsage);
     GlobalCommandSystem().addCommand("FocusViews", std::bind(&Map::focusViewCmd, this, std::placeholders::_1), { cmd::ARGTYPE_VECTOR3, cmd::ARGTYPE_VECTOR3 });
     GlobalCommandSystem().addCommand("FocusCameraOnSelection", std::bind(&Map::focusCameraOnSelectionCmd, this, std::placeholders::_1));
 	GlobalCommandSystem().addCommand("ExportSelectedAsModel", map::algorithm::exportSelectedAsModelCmd,
@@ -1,15 +1,60 @@
 #include "MapResourceLoader.h"
 
 #include "i18n.h"
+#include "imodelcache.h"
+#include "iradiant.h"
+#include <set>
 #include "fmt/format.h"
 #include "scene/ChildPrimitives.h"
 #include "scenelib.h"
 #include "algorithm/MapImporter.h"
 #include "messages/MapFileOperation.h"
+#include "string/replace.h"
 
 namespace map
 {
 
+namespace
+{
+    const std::string MODEL_KEY("\"model\"");
+    const std::string XML_VALUE_ATTRIBUTE("value=");
+
+    // Collects the values of all "model" spawnargs in the given map text. This covers the
+    // quoted key/value pairs of the idTech formats as well as the keyValue tags of the
+    // portable format. Anything else matching the pattern is harmless, the model cache
+    // skips values it can't resolve to a model file.
+    std::set<std::string> findModelSpawnargs(std::istream& stream)
+    {
+        std::set<std::string> modelPaths;
+        std::string line;
+
+        while (std::getline(stream, line))
+        {
+            for (auto keyPos = line.find(MODEL_KEY); keyPos != std::string::npos;
+                 keyPos = line.find(MODEL_KEY, keyPos + MODEL_KEY.length()))
+            {
+                auto valuePos = line.find_first_not_of(" \t", keyPos + MODEL_KEY.length());
+
+                if (valuePos != std::string::npos && line.compare(valuePos, XML_VALUE_ATTRIBUTE.length(), XML_VALUE_ATTRIBUTE) == 0)
+                {
+                    valuePos += XML_VALUE_ATTRIBUTE.length();
+                }
+
+                if (valuePos == std::string::npos || valuePos >= line.length() || line[valuePos] != '"') continue;
+
+                auto valueEnd = line.find('"', valuePos + 1);
+
+                if (valueEnd == std::string::npos || valueEnd == valuePos + 1) continue;
+
+                // Sanitise the value the same way the entity's model key does
+                modelPaths.emplace(string::replace_all_copy(line.substr(valuePos + 1, valueEnd - valuePos - 1), "\\", "/"));
+            }
+        }
+
+        return modelPaths;
+    }
+}
+
 MapResourceLoader::MapResourceLoader(std::istream& stream, const MapFormat& format) :
     _stream(stream),
     _format(format)
@@ -30,6 +75,9 @@ RootNodePtr MapResourceLoader::load()
 
         rMessage() << "Using " << _format.getMapFormatName() << " format to load the data." << std::endl;
 
+        // Load the referenced models up front, the entities will find them in the cache
+        preloadModels();
+
         // Start parsing
         reader->readFromStream(_stream);
 
@@ -60,6 +108,25 @@ RootNodePtr MapResourceLoader::load()
     }
 }
 
+void MapResourceLoader::preloadModels()
+{
+    auto startPos = _stream.tellg();
+
+    // Only seekable streams can be scanned before parsing
+    if (startPos == std::istream::pos_type(-1)) return;
+
+    FileOperation msg(FileOperation::Type::Import, FileOperation::Progress, false);
+    msg.setText(_("Loading models"));
+    GlobalRadiantCore().getMessageBus().sendMessage(msg);
+
+    auto modelPaths = findModelSpawnargs(_stream);
+
+    _stream.clear();
+    _stream.seekg(startPos);
+
+    GlobalModelCache().preloadModels(modelPaths);
+}
+
 void MapResourceLoader::loadInfoFile(std::istream& stream, const RootNodePtr& root)
 {
     if (!stream.good())
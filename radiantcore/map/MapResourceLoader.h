@@ -35,6 +35,10 @@ public:
 
     // Load the info file from the given stream, apply it to the root node
     void loadInfoFile(std::istream& stream, const RootNodePtr& root);
+
+private:
+    // Scans the stream for model spawnargs and loads these models into the model cache
+    void preloadModels();
 };
 
 }
@@ -1,7 +1,6 @@
 #include "Doom3AasFile.h"
 
 #include "itextstream.h"
-#include "string/convert.h"
 #include "Util.h"
 
 namespace map
@@ -95,11 +94,11 @@ const IAasFile::Area& Doom3AasFile::getArea(int areaNum) const
     return _areas[areaNum];
 }
 
-void Doom3AasFile::parseFromTokens(parser::DefTokeniser& tok)
+void Doom3AasFile::parseFromTokens(parser::BufferTokeniser& tok)
 {
     while (tok.hasMoreTokens())
     {
-        std::string token = tok.nextToken();
+        auto token = tok.nextTokenView();
 
         if (token == "settings")
         {
@@ -107,7 +106,7 @@ void Doom3AasFile::parseFromTokens(parser::DefTokeniser& tok)
         }
         else if (token == "planes")
         {
-            std::size_t planesCount = string::convert<std::size_t>(tok.nextToken());
+            auto planesCount = tok.nextNumber<std::size_t>();
 
             _planes.reserve(planesCount);
 
@@ -116,15 +115,15 @@ void Doom3AasFile::parseFromTokens(parser::DefTokeniser& tok)
             // num ( a b c dist )
             for (std::size_t i = 0; i < planesCount; ++i)
             {
-                string::convert<int>(tok.nextToken()); // plane index
+                tok.nextNumber<int>(); // plane index
 
                 tok.assertNextToken("(");
 
                 Plane3 plane;
-                plane.normal().x() = string::convert<Vector3::ElementType>(tok.nextToken());
-                plane.normal().y() = string::convert<Vector3::ElementType>(tok.nextToken());
-                plane.normal().z() = string::convert<Vector3::ElementType>(tok.nextToken());
-                plane.dist() = string::convert<Vector3::ElementType>(tok.nextToken());
+                plane.normal().x() = tok.nextNumber<Vector3::ElementType>();
+                plane.normal().y() = tok.nextNumber<Vector3::ElementType>();
+                plane.normal().z() = tok.nextNumber<Vector3::ElementType>();
+                plane.dist() = tok.nextNumber<Vector3::ElementType>();
 
                 _planes.push_back(plane);
 
@@ -135,7 +134,7 @@ void Doom3AasFile::parseFromTokens(parser::DefTokeniser& tok)
         }
         else if (token == "vertices")
         {
-            std::size_t vertCount = string::convert<std::size_t>(tok.nextToken());
+            auto vertCount = tok.nextNumber<std::size_t>();
 
             _vertices.reserve(vertCount);
 
@@ -144,7 +143,7 @@ void Doom3AasFile::parseFromTokens(parser::DefTokeniser& tok)
             // num ( x y z )
             for (std::size_t i = 0; i < vertCount; ++i)
             {
-                string::convert<int>(tok.nextToken()); // index
+                tok.nextNumber<int>(); // index
                 _vertices.push_back(parseVector3(tok)); // components
             }
 
@@ -152,7 +151,7 @@ void Doom3AasFile::parseFromTokens(parser::DefTokeniser& tok)
         }
         else if (token == "edges")
         {
-            std::size_t edgeCount = string::convert<std::size_t>(tok.nextToken());
+            auto edgeCount = tok.nextNumber<std::size_t>();
 
             _edges.reserve(edgeCount);
 
@@ -161,13 +160,13 @@ void Doom3AasFile::parseFromTokens(parser::DefTokeniser& tok)
             // num ( vertIdx1 vertIdx2 )
             for (std::size_t i = 0; i < edgeCount; ++i)
             {
-                string::convert<int>(tok.nextToken()); // index
+                tok.nextNumber<int>(); // index
 
                 tok.assertNextToken("(");
 
                 Edge edge;
-                edge.vertexNumber[0] = string::convert<int>(tok.nextToken());
-                edge.vertexNumber[1] = string::convert<int>(tok.nextToken());
+                edge.vertexNumber[0] = tok.nextNumber<int>();
+                edge.vertexNumber[1] = tok.nextNumber<int>();
 
                 tok.assertNextToken(")");
 
@@ -182,7 +181,7 @@ void Doom3AasFile::parseFromTokens(parser::DefTokeniser& tok)
         }
         else if (token == "faces")
         {
-            std::size_t faceCount = string::convert<std::size_t>(tok.nextToken());
+            auto faceCount = tok.nextNumber<std::size_t>();
 
             _faces.reserve(faceCount);
 
@@ -191,18 +190,18 @@ void Doom3AasFile::parseFromTokens(parser::DefTokeniser& tok)
             // num ( planeNum flags areas[0] areas[1] firstEdge numEdges )
             for (std::size_t i = 0; i < faceCount; ++i)
             {
-                string::convert<int>(tok.nextToken()); // number
+                tok.nextNumber<int>(); // number
 
                 tok.assertNextToken("(");
 
                 Face face;
 
-                face.planeNum = string::convert<int>(tok.nextToken());
-                face.flags = string::convert<unsigned short>(tok.nextToken());
-                face.areas[0] = string::convert<short>(tok.nextToken());
-                face.areas[1] = string::convert<short>(tok.nextToken());
-                face.firstEdge = string::convert<int>(tok.nextToken());
-                face.numEdges = string::convert<int>(tok.nextToken());
+                face.planeNum = tok.nextNumber<int>();
+                face.flags = tok.nextNumber<unsigned short>();
+                face.areas[0] = tok.nextNumber<short>();
+                face.areas[1] = tok.nextNumber<short>();
+                face.firstEdge = tok.nextNumber<int>();
+                face.numEdges = tok.nextNumber<int>();
 
                 _faces.push_back(face);
 
@@ -217,7 +216,7 @@ void Doom3AasFile::parseFromTokens(parser::DefTokeniser& tok)
         }
         else if (token == "areas")
         {
-            std::size_t areaCount = string::convert<std::size_t>(tok.nextToken());
+            auto areaCount = tok.nextNumber<std::size_t>();
 
             _areas.reserve(areaCount);
 
@@ -226,31 +225,27 @@ void Doom3AasFile::parseFromTokens(parser::DefTokeniser& tok)
             // num ( flags contents firstFace numFaces cluster clusterAreaNum ) reachabilityCount { reachabilities }
             for (std::size_t i = 0; i < areaCount; ++i)
             {
-                string::convert<int>(tok.nextToken()); // number
+                tok.nextNumber<int>(); // number
 
                 tok.assertNextToken("(");
 
                 Area area;
 
-                area.flags = string::convert<unsigned short>(tok.nextToken());
-                area.contents = string::convert<unsigned short>(tok.nextToken());
-                area.firstFace = string::convert<int>(tok.nextToken());
-                area.numFaces = string::convert<int>(tok.nextToken());
-                area.cluster = string::convert<short>(tok.nextToken());
-                area.clusterAreaNum = string::convert<short>(tok.nextToken());
+                area.flags = tok.nextNumber<unsigned short>();
+                area.contents = tok.nextNumber<unsigned short>();
+                area.firstFace = tok.nextNumber<int>();
+                area.numFaces = tok.nextNumber<int>();
+                area.cluster = tok.nextNumber<short>();
+                area.clusterAreaNum = tok.nextNumber<short>();
 
                 _areas.push_back(area);
 
                 tok.assertNextToken(")");
 
                 // Skip over reachabilities for the moment being
-                /*std::size_t reachCount = */string::convert<std::size_t>(tok.nextToken());
+                /*std::size_t reachCount = */tok.nextNumber<std::size_t>();
                 tok.assertNextToken("{");
-
-                while (tok.nextToken() != "}")
-                {
-                    // do nothing
-                }
+                tok.skipBlock();
             }
 
             // Skip the step LinkReversedReachability();
@@ -259,17 +254,13 @@ void Doom3AasFile::parseFromTokens(parser::DefTokeniser& tok)
         }
         else if (token == "nodes" || token == "portals" || token == "portalIndex" || token == "clusters")
         {
-            tok.nextToken(); // integer
+            tok.nextNumber<std::size_t>(); // integer
             tok.assertNextToken("{");
-
-            while (tok.nextToken() != "}")
-            {
-                // do nothing
-            }
+            tok.skipBlock();
         }
         else
         {
-            throw parser::ParseException("Unknown token: " + token);
+            throw parser::ParseException("Unknown token: " + std::string(token));
         }
     }
 
@@ -389,9 +380,9 @@ Vector3 Doom3AasFile::calcReachableGoalForArea(const IAasFile::Area& area) const
     return center;
 }
 
-void Doom3AasFile::parseIndex(parser::DefTokeniser& tok, Index& index)
+void Doom3AasFile::parseIndex(parser::BufferTokeniser& tok, Index& index)
 {
-    std::size_t idxCount = string::convert<std::size_t>(tok.nextToken());
+    auto idxCount = tok.nextNumber<std::size_t>();
 
     index.reserve(idxCount);
 
@@ -400,10 +391,10 @@ void Doom3AasFile::parseIndex(parser::DefTokeniser& tok, Index& index)
     // num ( idx )
     for (std::size_t i = 0; i < idxCount; ++i)
     {
-        string::convert<int>(tok.nextToken()); // number
+        tok.nextNumber<int>(); // number
 
         tok.assertNextToken("(");
-        index.push_back(string::convert<int>(tok.nextToken()));
+        index.push_back(tok.nextNumber<int>());
         tok.assertNextToken(")");
     }
 
@@ -1,7 +1,7 @@
 #pragma once
 
 #include "iaasfile.h"
-#include "parser/DefTokeniser.h"
+#include "parser/BufferTokeniser.h"
 #include "Doom3AasFileSettings.h"
 #include <vector>
 #include "math/Plane3.h"
@@ -49,10 +49,10 @@ public:
     virtual std::size_t     getNumAreas() const override;
     virtual const Area&     getArea(int areaNum) const override;
 
-    void parseFromTokens(parser::DefTokeniser& tok);
+    void parseFromTokens(parser::BufferTokeniser& tok);
 
 private:
-    void parseIndex(parser::DefTokeniser& tok, Index& index);
+    void parseIndex(parser::BufferTokeniser& tok, Index& index);
     void finishAreas();
     Vector3 calcReachableGoalForArea(const IAasFile::Area& area) const;
     Vector3 calcFaceCenter(int faceNum) const;
@@ -1,9 +1,10 @@
 #include "Doom3AasFileLoader.h"
 
 #include "itextstream.h"
+#include <iterator>
 
 #include "parser/DefTokeniser.h"
-#include "string/convert.h"
+#include "parser/BufferTokeniser.h"
 #include "Doom3AasFile.h"
 #include "module/StaticModule.h"
 
@@ -53,17 +54,19 @@ IAasFilePtr Doom3AasFileLoader::loadFromStream(std::istream& stream)
     Doom3AasFilePtr aasFile = std::make_shared<Doom3AasFile>();
 
     // We assume that the stream is rewound to the beginning
+    // Read the whole file into memory in one go, the tokeniser's numeric
+    // fast path is converting the values directly from this buffer
+    std::string buffer(std::istreambuf_iterator<char>(stream), {});
 
-    // Instantiate a tokeniser to read the version tag
-	parser::BasicDefTokeniser<std::istream> tok(stream);
+	parser::BufferTokeniser tok(buffer);
 
     try
 	{
         // File header
         parseVersion(tok);
 
-        // Checksum (will throw if the string conversion fails)
-        string::convert<long>(tok.nextToken());
+        // Checksum, written as unsigned 32 bit value, it's not used
+        tok.skipTokens(1);
 
         aasFile->parseFromTokens(tok);
 	}
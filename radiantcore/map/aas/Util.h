@@ -2,6 +2,7 @@
 
 #include "math/Vector3.h"
 #include "parser/DefTokeniser.h"
+#include "parser/BufferTokeniser.h"
 #include "string/convert.h"
 
 namespace map
@@ -18,4 +19,18 @@ namespace map
 
         return vec;
     }
+
+    // Numeric fast path, converting the components directly from the buffer
+    inline Vector3 parseVector3(parser::BufferTokeniser& tok)
+    {
+        Vector3 vec;
+
+        tok.assertNextToken("(");
+        vec[0] = tok.nextNumber<Vector3::ElementType>();
+        vec[1] = tok.nextNumber<Vector3::ElementType>();
+        vec[2] = tok.nextNumber<Vector3::ElementType>();
+        tok.assertNextToken(")");
+
+        return vec;
+    }
 }
@@ -1,9 +1,15 @@
 #include "MapExporter.h"
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
 #include <ostream>
+#include <sstream>
+#include <thread>
 #include "i18n.h"
 #include "itextstream.h"
 #include "ibrush.h"
+#include "brush/Brush.h"
 #include "ipatch.h"
 #include "ientity.h"
 #include "imapresource.h"
@@ -34,7 +40,8 @@ MapExporter::MapExporter(IMapWriter& writer, const scene::IMapRootNodePtr& root,
 	_curNodeCount(0),
 	_entityNum(0),
 	_primitiveNum(0),
-    _sendProgressMessages(true)
+    _sendProgressMessages(true),
+	_currentEntity(nullptr)
 {
 	construct();
 }
@@ -50,7 +57,8 @@ MapExporter::MapExporter(IMapWriter& writer, const scene::IMapRootNodePtr& root,
 	_curNodeCount(0),
 	_entityNum(0),
 	_primitiveNum(0),
-    _sendProgressMessages(true)
+    _sendProgressMessages(true),
+	_currentEntity(nullptr)
 {
 	construct();
 }
@@ -113,6 +121,9 @@ void MapExporter::exportMap(const scene::INodePtr& root, const GraphTraversalFun
 	// Perform the actual map traversal
 	traverse(root, *this);
 
+	// Write the entities collected during traversal
+	writePendingEntities();
+
 	try
 	{
 		auto mapRoot = std::dynamic_pointer_cast<scene::IMapRootNode>(root);
@@ -145,10 +156,24 @@ bool MapExporter::pre(const scene::INodePtr& node)
 
 		if (entity)
 		{
-			// Progress dialog handling
-			onNodeProgress();
-			
-			_writer.beginWriteEntity(entity, _mapStream);
+			auto entityWriter = _writer.createEntityWriter(_entityNum);
+
+			if (entityWriter)
+			{
+				// Collect the entity and its primitives, it will be written after traversal
+				_pendingEntities.emplace_back(std::make_unique<EntityExport>(entity, entityWriter));
+				_currentEntity = _pendingEntities.back().get();
+			}
+			else
+			{
+				// Keep the order of any entities written before
+				writePendingEntities();
+
+				// Progress dialog handling
+				onNodeProgress();
+
+				_writer.beginWriteEntity(entity, _mapStream);
+			}
 
 			if (_infoFileExporter) _infoFileExporter->visitEntity(node, _entityNum);
 
@@ -159,10 +184,19 @@ bool MapExporter::pre(const scene::INodePtr& node)
 
 		if (brush && brush->getIBrush().hasContributingFaces())
 		{
-			// Progress dialog handling
-			onNodeProgress();
+			if (_currentEntity)
+			{
+				_currentEntity->primitives.push_back(node);
+			}
+			else
+			{
+				writePendingEntities();
 
-			_writer.beginWriteBrush(brush, _mapStream);
+				// Progress dialog handling
+				onNodeProgress();
+
+				_writer.beginWriteBrush(brush, _mapStream);
+			}
 
 			if (_infoFileExporter) _infoFileExporter->visitPrimitive(node, _entityNum, _primitiveNum);
 
@@ -173,10 +207,19 @@ bool MapExporter::pre(const scene::INodePtr& node)
 
 		if (patch)
 		{
-			// Progress dialog handling
-			onNodeProgress();
+			if (_currentEntity)
+			{
+				_currentEntity->primitives.push_back(node);
+			}
+			else
+			{
+				writePendingEntities();
+
+				// Progress dialog handling
+				onNodeProgress();
 
-			_writer.beginWritePatch(patch, _mapStream);
+				_writer.beginWritePatch(patch, _mapStream);
+			}
 
 			if (_infoFileExporter) _infoFileExporter->visitPrimitive(node, _entityNum, _primitiveNum);
 
@@ -199,7 +242,14 @@ void MapExporter::post(const scene::INodePtr& node)
 
 		if (entity)
 		{
-			_writer.endWriteEntity(entity, _mapStream);
+			if (_currentEntity)
+			{
+				_currentEntity = nullptr;
+			}
+			else
+			{
+				_writer.endWriteEntity(entity, _mapStream);
+			}
 
 			_entityNum++;
 			return;
@@ -209,7 +259,11 @@ void MapExporter::post(const scene::INodePtr& node)
 
 		if (brush && brush->getIBrush().hasContributingFaces())
 		{
-			_writer.endWriteBrush(brush, _mapStream);
+			if (!_currentEntity)
+			{
+				_writer.endWriteBrush(brush, _mapStream);
+			}
+
 			_primitiveNum++;
 			return;
 		}
@@ -218,7 +272,11 @@ void MapExporter::post(const scene::INodePtr& node)
 
 		if (patch)
 		{
-			_writer.endWritePatch(patch, _mapStream);
+			if (!_currentEntity)
+			{
+				_writer.endWritePatch(patch, _mapStream);
+			}
+
 			_primitiveNum++;
 			return;
 		}
@@ -229,6 +287,128 @@ void MapExporter::post(const scene::INodePtr& node)
 	}
 }
 
+void MapExporter::writePendingEntities()
+{
+	if (_pendingEntities.empty()) return;
+
+	auto entities = std::move(_pendingEntities);
+	_pendingEntities.clear();
+
+	auto precision = _mapStream.precision();
+
+	std::atomic<std::size_t> nextEntity(0);
+	std::atomic<bool> cancelled(false);
+
+	auto writeEntities = [&]()
+	{
+		for (auto i = nextEntity++; i < entities.size() && !cancelled; i = nextEntity++)
+		{
+			WriteEntity(*entities[i], precision);
+		}
+	};
+
+	auto numWorkers = std::min<std::size_t>(std::max(std::thread::hardware_concurrency(), 1u), entities.size());
+
+	std::vector<std::future<void>> workers;
+
+	if (numWorkers > 1)
+	{
+		for (std::size_t i = 0; i < numWorkers; ++i)
+		{
+			workers.emplace_back(std::async(std::launch::async, writeEntities));
+		}
+	}
+	else
+	{
+		writeEntities();
+	}
+
+	try
+	{
+		// Copy the buffers to the stream in traversal order, while the workers continue
+		for (auto& entityExport : entities)
+		{
+			entityExport->result.get();
+
+			for (std::size_t i = 0; i < entityExport->primitives.size() + 1; ++i)
+			{
+				onNodeProgress();
+			}
+
+			for (const auto& error : entityExport->errors)
+			{
+				rError() << error << std::endl;
+			}
+
+			_mapStream.write(entityExport->output.data(), static_cast<std::streamsize>(entityExport->output.size()));
+
+			// Free the buffer, the rest is released once all workers are done
+			entityExport->output = std::string();
+		}
+	}
+	catch (...)
+	{
+		// Progress handling might cancel the operation, stop the workers before leaving
+		cancelled = true;
+
+		for (auto& worker : workers)
+		{
+			worker.wait();
+		}
+
+		throw;
+	}
+}
+
+void MapExporter::WriteEntity(EntityExport& entityExport, std::streamsize precision)
+{
+	try
+	{
+		std::ostringstream stream;
+		stream.precision(precision);
+
+		auto& writer = *entityExport.writer;
+
+		auto writeNode = [&](const std::string& stage, const std::function<void()>& write)
+		{
+			try
+			{
+				write();
+			}
+			catch (IMapWriter::FailureException& ex)
+			{
+				entityExport.errors.push_back("Failure exporting a node (" + stage + "): " + ex.what());
+			}
+		};
+
+		writeNode("pre", [&]() { writer.beginWriteEntity(entityExport.entity, stream); });
+
+		for (const auto& node : entityExport.primitives)
+		{
+			if (auto brush = std::dynamic_pointer_cast<IBrushNode>(node); brush)
+			{
+				writeNode("pre", [&]() { writer.beginWriteBrush(brush, stream); });
+				writeNode("post", [&]() { writer.endWriteBrush(brush, stream); });
+			}
+			else if (auto patch = std::dynamic_pointer_cast<IPatchNode>(node); patch)
+			{
+				writeNode("pre", [&]() { writer.beginWritePatch(patch, stream); });
+				writeNode("post", [&]() { writer.endWritePatch(patch, stream); });
+			}
+		}
+
+		writeNode("post", [&]() { writer.endWriteEntity(entityExport.entity, stream); });
+
+		entityExport.output = stream.str();
+		entityExport.written.set_value();
+	}
+	catch (...)
+	{
+		// Rethrown on the exporting thread
+		entityExport.written.set_exception(std::current_exception());
+	}
+}
+
 void MapExporter::onNodeProgress()
 {
 	_curNodeCount++;
@@ -298,17 +478,21 @@ void MapExporter::finishScene()
 
 void MapExporter::recalculateBrushWindings()
 {
-	_root->foreachNode([] (const scene::INodePtr& child)->bool
+	std::vector<Brush*> brushes;
+
+	_root->foreachNode([&] (const scene::INodePtr& child)->bool
 	{
-		auto* brush = Node_getIBrush(child);
+		auto* brush = Node_getBrush(child);
 
 		if (brush != nullptr)
 		{
-			brush->evaluateBRep();
+			brushes.push_back(brush);
 		}
 
 		return true;
 	});
+
+	Brush::evaluateBReps(brushes);
 }
 
 } // namespace
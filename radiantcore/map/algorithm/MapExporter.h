@@ -9,6 +9,9 @@
 #include "../infofile/InfoFileExporter.h"
 #include "EventRateLimiter.h"
 
+#include <future>
+#include <memory>
+#include <vector>
 #include <sigc++/signal.h>
 
 namespace map
@@ -24,6 +27,10 @@ namespace map
  * If the progress dialog is enabled (i.e. nodeCount > 0 in constructor)
  * a gtkutil::OperationAbortedException& might be thrown during traversal, 
  * the calling code needs to be able to handle that.
+ *
+ * If the writer supports it (see IMapWriter::createEntityWriter), entities are
+ * collected during traversal and written into separate memory buffers on worker
+ * threads. The buffers are written to the output stream in traversal order.
  */
 class MapExporter :
 	public IMapExporter,
@@ -55,6 +62,32 @@ private:
 
     bool _sendProgressMessages;
 
+	// An entity and its primitives, written to a memory buffer by its own writer
+	struct EntityExport
+	{
+		IEntityNodePtr entity;
+		IMapWriterPtr writer;
+		std::vector<scene::INodePtr> primitives;
+
+		std::string output;
+		std::vector<std::string> errors;
+
+		std::promise<void> written;
+		std::future<void> result;
+
+		EntityExport(const IEntityNodePtr& entity_, const IMapWriterPtr& writer_) :
+			entity(entity_),
+			writer(writer_),
+			result(written.get_future())
+		{}
+	};
+
+	// Entities waiting to be written, in traversal order
+	std::vector<std::unique_ptr<EntityExport>> _pendingEntities;
+
+	// The pending entity receiving the visited primitives, nullptr if writing directly
+	EntityExport* _currentEntity;
+
 public:
 	// The constructor prepares the scene and the output stream
 	MapExporter(IMapWriter& writer, const scene::IMapRootNodePtr& root,
@@ -86,6 +119,11 @@ private:
 
 	void onNodeProgress();
 
+	// Writes all pending entities to the map stream, serialising them in parallel
+	void writePendingEntities();
+
+	static void WriteEntity(EntityExport& entityExport, std::streamsize precision);
+
 	// Is called before exporting the scene to prepare func_* groups.
 	void prepareScene();
 
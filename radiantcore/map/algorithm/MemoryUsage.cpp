@@ -0,0 +1,81 @@
+#include "MemoryUsage.h"
+
+#include "imap.h"
+#include "itextstream.h"
+#include <fmt/format.h>
+
+namespace map
+{
+
+namespace algorithm
+{
+
+namespace
+{
+    std::string getNodeTypeName(scene::INode::Type type)
+    {
+        switch (type)
+        {
+        case scene::INode::Type::MapRoot: return "MapRoot";
+        case scene::INode::Type::Entity: return "Entity";
+        case scene::INode::Type::Brush: return "Brush";
+        case scene::INode::Type::Patch: return "Patch";
+        case scene::INode::Type::Model: return "Model";
+        case scene::INode::Type::Particle: return "Particle";
+        case scene::INode::Type::EntityConnection: return "EntityConnection";
+        case scene::INode::Type::MergeAction: return "MergeAction";
+        default: return "Unknown";
+        }
+    }
+}
+
+std::map<std::string, NodeMemoryUsage> getNodeMemoryUsage(const scene::INodePtr& root)
+{
+    std::map<std::string, NodeMemoryUsage> result;
+
+    auto addNode = [&](const scene::INodePtr& node)
+    {
+        auto& usage = result[getNodeTypeName(node->getNodeType())];
+
+        usage.numNodes++;
+        usage.numBytes += node->getMemoryUsage();
+
+        return true;
+    };
+
+    addNode(root);
+    root->foreachNode(addNode);
+
+    return result;
+}
+
+void printNodeMemoryUsage(const cmd::ArgumentList& args)
+{
+    auto root = GlobalMapModule().getRoot();
+
+    if (!root)
+    {
+        rWarning() << "No map loaded." << std::endl;
+        return;
+    }
+
+    NodeMemoryUsage total;
+
+    rMessage() << fmt::format("{0:<18} {1:>10} {2:>14} {3:>12}", "Node Type", "Count", "Bytes", "Bytes/Node") << std::endl;
+
+    for (const auto& [typeName, usage] : getNodeMemoryUsage(root))
+    {
+        rMessage() << fmt::format("{0:<18} {1:>10} {2:>14} {3:>12}", typeName, usage.numNodes,
+            usage.numBytes, usage.numBytes / usage.numNodes) << std::endl;
+
+        total.numNodes += usage.numNodes;
+        total.numBytes += usage.numBytes;
+    }
+
+    rMessage() << fmt::format("{0:<18} {1:>10} {2:>14} {3:>12}", "Total", total.numNodes,
+        total.numBytes, total.numNodes > 0 ? total.numBytes / total.numNodes : 0) << std::endl;
+}
+
+} // namespace
+
+} // namespace
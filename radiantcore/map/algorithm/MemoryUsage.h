@@ -0,0 +1,30 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include "inode.h"
+#include "icommandsystem.h"
+
+namespace map
+{
+
+namespace algorithm
+{
+
+// Number of nodes and their accumulated memory footprint
+struct NodeMemoryUsage
+{
+    std::size_t numNodes = 0;
+    std::size_t numBytes = 0;
+};
+
+// Collects the estimated memory usage of all nodes below the given root,
+// grouped by the node type name
+std::map<std::string, NodeMemoryUsage> getNodeMemoryUsage(const scene::INodePtr& root);
+
+// Prints the memory usage of the current map per node type to the console
+void printNodeMemoryUsage(const cmd::ArgumentList& args);
+
+} // namespace
+
+} // namespace
@@ -96,4 +96,9 @@ void Doom3MapWriter::endWritePatch(const IPatchNodePtr& patch, std::ostream& str
 	// nothing
 }
 
+IMapWriterPtr Doom3MapWriter::createEntityWriter(std::size_t entityNumber)
+{
+	return CreateEntityWriter<Doom3MapWriter>(entityNumber);
+}
+
 } // namespace
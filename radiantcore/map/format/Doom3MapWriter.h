@@ -36,8 +36,21 @@ public:
 	virtual void beginWritePatch(const IPatchNodePtr& patch, std::ostream& stream) override;
 	virtual void endWritePatch(const IPatchNodePtr& patch, std::ostream& stream) override;
 
+	// Entities are written independently, subclasses need to return an instance of their own type
+	virtual IMapWriterPtr createEntityWriter(std::size_t entityNumber) override;
+
 protected:
 	void writeEntityKeyValues(const IEntityNodePtr& entity, std::ostream& stream);
+
+	// Creates a writer of the given type, numbering its single entity as specified
+	template<typename WriterT>
+	static IMapWriterPtr CreateEntityWriter(std::size_t entityNumber)
+	{
+		auto writer = std::make_shared<WriterT>();
+		writer->_entityCount = entityNumber;
+
+		return writer;
+	}
 };
 
 } // namespace
@@ -39,6 +39,11 @@ public:
 		// Export patchDef2 to stream (patchDef3 is not supported)
 		PatchDefExporter::exportQ3PatchDef2(stream, patch);
 	}
+
+	virtual IMapWriterPtr createEntityWriter(std::size_t entityNumber) override
+	{
+		return CreateEntityWriter<Quake3MapWriter>(entityNumber);
+	}
 };
 
 class Quake3AlternateMapWriter :
@@ -54,6 +59,11 @@ public:
         // Export brushDef definition to stream
         BrushDefExporter::exportBrush(stream, brush);
     }
+
+    virtual IMapWriterPtr createEntityWriter(std::size_t entityNumber) override
+    {
+        return CreateEntityWriter<Quake3AlternateMapWriter>(entityNumber);
+    }
 };
 
 } // namespace
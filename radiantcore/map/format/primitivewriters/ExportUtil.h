@@ -1,7 +1,10 @@
 #pragma once
 
+#include <algorithm>
+#include <iterator>
 #include <ostream>
 #include "math/FloatTools.h"
+#include "fmt/format.h"
 
 namespace map
 {
@@ -9,22 +12,36 @@ namespace map
 // Writes a double to the given stream and checks for NaN and infinity
 inline void writeDoubleSafe(const double d, std::ostream& os)
 {
-	if (isValid(d))
+	if (!isValid(d))
 	{
-		if (d == -0.0)
-		{
-			os << 0; // convert -0 to 0
-		}
-		else
-		{
-			os << d;
-		}
+		// Is infinity or NaN, write 0
+		os.put('0');
+		return;
 	}
-	else
+
+	if (d == -0.0)
 	{
-		// Is infinity or NaN, write 0
-		os << "0";
+		os.put('0'); // convert -0 to 0
+		return;
 	}
+
+	// Formatting flags other than the precision are never set by the map exporter,
+	// let the stream take care of them if there are any
+	constexpr auto CustomFlags = std::ios_base::floatfield | std::ios_base::showpos |
+		std::ios_base::showpoint | std::ios_base::uppercase;
+
+	if ((os.flags() & CustomFlags) != 0 || os.width() != 0)
+	{
+		os << d;
+		return;
+	}
+
+	// Same output as operator<< (%g using the stream precision, where 0 means 1),
+	// but without going through the locale facets of the stream
+	fmt::memory_buffer buffer;
+	fmt::format_to(std::back_inserter(buffer), "{:.{}g}", d, std::max<std::streamsize>(os.precision(), 1));
+
+	os.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
 }
 
 }
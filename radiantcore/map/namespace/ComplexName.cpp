@@ -1,6 +1,7 @@
 #include "ComplexName.h"
 
 #include <climits>
+#include <iterator>
 #include "string/trim.h"
 #include "string/convert.h"
 
@@ -25,33 +26,161 @@ std::string ComplexName::getFullname() const
 
 namespace
 {
-    // Find the first integer not in the given set
-    std::string findFirstUnusedNumber(const PostfixSet& set)
+    // Parses postfixes like "6" or "123" as number, returns false for
+    // non-canonical postfixes like "06", "0" or numbers exceeding the int range
+    bool parseCanonicalNumber(const std::string& postfix, int& number)
     {
-        static const int LOWEST_VAL = 1;
+        if (postfix.empty() || postfix.size() > 10 || postfix[0] < '1' || postfix[0] > '9')
+        {
+            return false;
+        }
+
+        long long value = 0;
 
-        for (int i = LOWEST_VAL; i < INT_MAX; ++i)
+        for (auto c : postfix)
         {
-			std::string testPostfix = string::to_string(i);
+            if (c < '0' || c > '9') return false;
+
+            value = value * 10 + (c - '0');
+        }
+
+        if (value > INT_MAX) return false;
+
+        number = static_cast<int>(value);
+        return true;
+    }
+}
+
+bool PostfixSet::insert(const std::string& postfix)
+{
+    if (!_postfixes.insert(postfix).second)
+    {
+        return false; // already present
+    }
+
+    int number;
+
+    if (parseCanonicalNumber(postfix, number))
+    {
+        addNumber(number);
+    }
+
+    return true;
+}
+
+bool PostfixSet::erase(const std::string& postfix)
+{
+    if (_postfixes.erase(postfix) == 0)
+    {
+        return false;
+    }
+
+    int number;
+
+    if (parseCanonicalNumber(postfix, number))
+    {
+        removeNumber(number);
+    }
+
+    return true;
+}
+
+void PostfixSet::insert(const PostfixSet& other)
+{
+    for (const auto& postfix : other._postfixes)
+    {
+        insert(postfix);
+    }
+}
 
-            if (set.find(testPostfix) == set.end())
-            {
-                // Found an unused value
-                return testPostfix;
-            }
+int PostfixSet::getLowestUnusedNumber() const
+{
+    static const int LOWEST_VAL = 1;
+
+    if (_usedRanges.empty() || _usedRanges.begin()->first > LOWEST_VAL)
+    {
+        return LOWEST_VAL;
+    }
+
+    // The first range starts at the lowest value, take the number right after it.
+    // Pathological case: every number is in use, return INT_MAX.
+    auto rangeEnd = _usedRanges.begin()->second;
+
+    return rangeEnd < INT_MAX ? rangeEnd + 1 : INT_MAX;
+}
+
+void PostfixSet::addNumber(int number)
+{
+    // The first range starting after the number, and the one before it
+    auto next = _usedRanges.upper_bound(number);
+    auto prev = next != _usedRanges.begin() ? std::prev(next) : _usedRanges.end();
+
+    bool joinsPrev = prev != _usedRanges.end() && prev->second == number - 1;
+    bool joinsNext = next != _usedRanges.end() && next->first == number + 1;
+
+    if (joinsPrev && joinsNext)
+    {
+        // The number closes the gap between two ranges
+        prev->second = next->second;
+        _usedRanges.erase(next);
+    }
+    else if (joinsPrev)
+    {
+        prev->second = number;
+    }
+    else if (joinsNext)
+    {
+        auto rangeEnd = next->second;
+        _usedRanges.erase(next);
+        _usedRanges.emplace(number, rangeEnd);
+    }
+    else
+    {
+        _usedRanges.emplace_hint(next, number, number);
+    }
+}
+
+void PostfixSet::removeNumber(int number)
+{
+    // Find the range containing this number
+    auto range = _usedRanges.upper_bound(number);
+
+    if (range == _usedRanges.begin()) return;
+
+    --range;
+
+    if (range->second < number) return;
+
+    auto rangeStart = range->first;
+    auto rangeEnd = range->second;
+
+    if (rangeStart == number)
+    {
+        _usedRanges.erase(range);
+
+        if (rangeEnd > number)
+        {
+            _usedRanges.emplace(number + 1, rangeEnd);
         }
+    }
+    else
+    {
+        // Cut the range at the number, and keep the upper part (if any)
+        range->second = number - 1;
 
-        // Pathological case, could not find a value
-        return string::to_string(INT_MAX);
+        if (rangeEnd > number)
+        {
+            _usedRanges.emplace(number + 1, rangeEnd);
+        }
     }
 }
 
 std::string ComplexName::makePostfixUnique(const PostfixSet& postfixes)
 {
     // If our postfix is already in the set, change it to a unique value
-    if (postfixes.find(_postFix) != postfixes.end())
+    if (postfixes.contains(_postFix))
     {
-        _postFix = findFirstUnusedNumber(postfixes);
+        _postFix = string::to_string(postfixes.getLowestUnusedNumber());
     }
 
     return _postFix;
@@ -2,9 +2,55 @@
 
 #include <string>
 #include <set>
+#include <map>
 
-/// Set of unique postfixes, e.g. "1", "6" or "04"
-typedef std::set<std::string> PostfixSet;
+/**
+ * Set of unique postfixes, e.g. "1", "6" or "04".
+ *
+ * The numbers in canonical form ("6", but not "06") are additionally tracked
+ * as sorted ranges of used numbers, such that the lowest unused number can be
+ * determined in O(log n) instead of probing every candidate.
+ */
+class PostfixSet
+{
+    // All postfixes in string form, including non-canonical ones like "04" or "-"
+    std::set<std::string> _postfixes;
+
+    // The used canonical numbers, mapping range start => range end (inclusive)
+    std::map<int, int> _usedRanges;
+
+public:
+    bool empty() const
+    {
+        return _postfixes.empty();
+    }
+
+    std::size_t size() const
+    {
+        return _postfixes.size();
+    }
+
+    bool contains(const std::string& postfix) const
+    {
+        return _postfixes.count(postfix) > 0;
+    }
+
+    /// Adds the postfix, returns true if it was not present yet
+    bool insert(const std::string& postfix);
+
+    /// Removes the postfix, returns true if it was present
+    bool erase(const std::string& postfix);
+
+    /// Adds all postfixes of the other set to this one
+    void insert(const PostfixSet& other);
+
+    /// Returns the lowest number (starting at 1) which is not in use yet
+    int getLowestUnusedNumber() const;
+
+private:
+    void addNumber(int number);
+    void removeNumber(int number);
+};
 
 /// Name consisting of initial text and optional unique-making number-postfix 
 /// e.g. "Carl" + "6", or "Mary" + "03"
@@ -286,32 +286,33 @@ void Namespace::ensureNoConflicts(const scene::INodePtr& foreignRoot, const std:
     UniqueNameSet allNames = _uniqueNames;
     allNames.merge(foreignNamespace._uniqueNames);
 
-    // Process each object in the to-be-imported tree of nodes, ensuring that it
-    // has a unique name
+    // Collect the imported objects which conflict with a name in THIS namespace,
+    // they need to be given a new name which is unique in BOTH namespaces.
+    // All non-conflicting names are already part of the combined set.
+    std::vector<NamespacedPtr> conflictingNodes;
+    std::vector<std::string> conflictingNames;
+
     for (const auto& foreignNode : foreignNodes)
     {
-        // If the imported node conflicts with a name in THIS namespace, then it
-        // needs to be given a new name which is unique in BOTH namespaces.
         if (_uniqueNames.nameExists(foreignNode->getName()))
         {
-            // Name exists in the target namespace, get a new name
-            std::string uniqueName = allNames.insertUnique(foreignNode->getName());
+            conflictingNodes.push_back(foreignNode);
+            conflictingNames.push_back(foreignNode->getName());
+        }
+    }
 
-            rMessage() << "Namespace::ensureNoConflicts(): '" << foreignNode->getName()
-                << "' already exists in this namespace. Rename it to '"
-                << uniqueName << "'\n";
+    // Acquire all new names in one batch
+    auto uniqueNames = allNames.insertUnique(conflictingNames);
 
-            // Change the name of the imported node, this should trigger all
-            // observers in the foreign namespace
-            foreignNode->changeName(uniqueName);
-        }
-        else
-        {
-            // Name does not exist yet, insert it into the local combined
-            // namespace (but not our destination namespace, this will be
-            // populated in the subsequent call to connect()).
-            allNames.insert(foreignNode->getName());
-        }
+    for (std::size_t i = 0; i < conflictingNodes.size(); ++i)
+    {
+        rMessage() << "Namespace::ensureNoConflicts(): '" << conflictingNames[i]
+            << "' already exists in this namespace. Rename it to '"
+            << uniqueNames[i] << "'\n";
+
+        // Change the name of the imported node, this should trigger all
+        // observers in the foreign namespace
+        conflictingNodes[i]->changeName(uniqueNames[i]);
     }
 
     // at this point, all names in the foreign namespace have been converted to
@@ -2,6 +2,7 @@
 
 #include <set>
 #include <map>
+#include <vector>
 
 #include "ComplexName.h"
 
@@ -59,10 +60,8 @@ public:
         }
 
         // The prefix is inserted at this point, add the postfix to the set
-        auto result = found->second.insert(name.getPostfix());
-
         // Return the boolean of the insertion result, it is true on successful insertion
-        return result.second;
+        return found->second.insert(name.getPostfix());
     }
 
     /**
@@ -83,7 +82,7 @@ public:
 
         // The prefix has been found, remove the postfix from the set
         // Return true if the erase method removed any elements
-        return found->second.erase(name.getPostfix()) > 0;
+        return found->second.erase(name.getPostfix());
     }
 
     /**
@@ -97,33 +96,50 @@ public:
      */
     std::string insertUnique(const ComplexName& name)
     {
-        // Lookup the name in the map to see if we know this prefix
-        Names::iterator found = _names.find(name.getNameWithoutPostfix());
+        // Acquire a new unique postfix (if necessary) for this name to make it
+        // unique
+        return insertUnique(name, getPostfixSet(name.getNameWithoutPostfix()));
+    }
 
-        if (found == _names.end()) 
-		{
-            // The name is not yet in the list, we can add it with the given postfix
-            auto result = _names.insert(std::make_pair(name.getNameWithoutPostfix(), PostfixSet()));
+    /**
+     * \brief
+     * Batch variant of insertUnique(), used when importing many nodes at once.
+     * The names are processed in the given order, names sharing the same trunk
+     * (e.g. "light_") are looked up only once.
+     *
+     * \return
+     * The unique names, in the same order as the input names.
+     */
+    std::vector<std::string> insertUnique(const std::vector<std::string>& names)
+    {
+        std::vector<std::string> result;
+        result.reserve(names.size());
 
-            assert(result.second); // insert must succeed, we didn't find this just before
+        const std::string* lastTrunk = nullptr;
+        PostfixSet* postfixSet = nullptr;
 
-            // Overwrite the iterator
-            found = result.first;
-        }
+        for (const auto& name : names)
+        {
+            ComplexName complexName(name);
 
-        // At this point, the "trunk" of the complex name is already in the list
-        // The found iterator points to a valid prefix => PostFixSet mapping
+            // Imported names tend to come in runs of the same trunk
+            if (lastTrunk == nullptr || *lastTrunk != complexName.getNameWithoutPostfix())
+            {
+                auto found = _names.find(complexName.getNameWithoutPostfix());
 
-        // Acquire a new unique postfix (if necessary) for this name to make it
-        // unique
-        PostfixSet& postfixSet = found->second;
+                if (found == _names.end())
+                {
+                    found = _names.emplace(complexName.getNameWithoutPostfix(), PostfixSet()).first;
+                }
 
-        ComplexName uniqueName(name);
+                lastTrunk = &found->first;
+                postfixSet = &found->second;
+            }
 
-        std::string postfix = uniqueName.makePostfixUnique(postfixSet);
-        postfixSet.insert(postfix);
+            result.emplace_back(insertUnique(complexName, *postfixSet));
+        }
 
-        return uniqueName.getFullname();
+        return result;
     }
 
     /**
@@ -155,7 +171,7 @@ public:
             const PostfixSet& postfixSet = found->second;
 
             // If we know the number too, the full name exists
-            return postfixSet.find(name.getPostfix()) != postfixSet.end();
+            return postfixSet.contains(name.getPostfix());
         }
 
         // Prefix is not known, hence full name is not known
@@ -178,7 +194,7 @@ public:
             if (local != _names.end())
 			{
                 // Prefix exists, merge the postfixes
-                local->second.insert(i.second.begin(), i.second.end());
+                local->second.insert(i.second);
             }
             else
 			{
@@ -187,4 +203,30 @@ public:
             }
         }
     }
+
+private:
+    // Returns the postfix set for the given name trunk, creating it if necessary
+    PostfixSet& getPostfixSet(const std::string& trunk)
+    {
+        // Lookup the name in the map to see if we know this prefix
+        Names::iterator found = _names.find(trunk);
+
+        if (found == _names.end())
+        {
+            // The name is not yet in the list, we can add it with the given postfix
+            found = _names.emplace(trunk, PostfixSet()).first;
+        }
+
+        return found->second;
+    }
+
+    static std::string insertUnique(const ComplexName& name, PostfixSet& postfixSet)
+    {
+        ComplexName uniqueName(name);
+
+        std::string postfix = uniqueName.makePostfixUnique(postfixSet);
+        postfixSet.insert(postfix);
+
+        return uniqueName.getFullname();
+    }
 };
@@ -7,20 +7,41 @@
 #include "imd5anim.h"
 #include "iparticles.h"
 #include "iparticlenode.h"
+#include "ishaders.h"
+#include "iregistry.h"
+#include "imodelsurface.h"
 
 #include <iostream>
+#include <atomic>
+#include <future>
+#include <thread>
+#include <vector>
 #include "os/path.h"
 #include "os/file.h"
+#include "registry/registry.h"
+#include <fmt/format.h>
 
 #include "module/StaticModule.h"
 #include <functional>
 
 #include "map/algorithm/Models.h"
+#include "ModelPath.h"
 
 namespace model
 {
 
+namespace
+{
+	// The memory budget of the cache in MiB, 0 disables eviction
+	const char* const RKEY_MODEL_CACHE_MEMORY_BUDGET = "user/ui/modelCache/memoryBudget";
+}
+
 ModelCache::ModelCache() :
+	_totalSize(0),
+	_memoryBudget(0),
+	_numHits(0),
+	_numMisses(0),
+	_numEvictions(0),
 	_enabled(true)
 {}
 
@@ -106,9 +127,16 @@ IModelPtr ModelCache::getModel(const std::string& modelPath)
 
 	if (_enabled && found != _modelMap.end())
 	{
-		return found->second;
+		++_numHits;
+
+		// Move the model to the front of the usage list
+		_usage.splice(_usage.begin(), _usage, found->second.usage);
+
+		return found->second.model;
 	}
 
+	++_numMisses;
+
 	// The model is not cached or the cache is disabled, load afresh
 
 	// Get the extension of this model
@@ -119,15 +147,108 @@ IModelPtr ModelCache::getModel(const std::string& modelPath)
 
 	IModelPtr model = modelLoader->loadModelFromPath(modelPath);
 
-	if (model)
+	if (model && found == _modelMap.end())
 	{
 		// Model successfully loaded, insert a reference into the map
-		_modelMap.emplace(modelPath, model);
+		insertModel(modelPath, model);
+		evictUnusedModels();
 	}
 
 	return model;
 }
 
+void ModelCache::preloadModels(const std::set<std::string>& modelPaths)
+{
+	if (!_enabled) return;
+
+	struct PendingModel
+	{
+		std::string cacheKey;
+		IModelImporterPtr importer;
+		IModelPtr model;
+	};
+
+	std::vector<PendingModel> pending;
+	std::set<std::string> pendingKeys;
+
+	// Resolve the paths the same way getModelNode() and the importers do
+	for (const auto& modelPath : modelPaths)
+	{
+		auto modelDef = GlobalEntityClassManager().findModel(modelPath);
+		const auto& actualModelPath = modelDef ? modelDef->mesh : modelPath;
+
+		auto type = os::getExtension(actualModelPath);
+
+		if (type.empty() || type == "prt") continue;
+
+		auto modelLoader = GlobalModelFormatManager().getImporter(type);
+
+		// The NullModelLoader doesn't load anything worth caching
+		if (modelLoader->getExtension().empty()) continue;
+
+		auto cacheKey = os::getRelativePath(actualModelPath, rootPath(actualModelPath));
+
+		if (_modelMap.count(cacheKey) > 0 || !pendingKeys.insert(cacheKey).second) continue;
+
+		pending.push_back(PendingModel{ cacheKey, modelLoader, IModelPtr() });
+	}
+
+	if (pending.empty()) return;
+
+	// The model loaders look up the default materials of the surfaces,
+	// make sure the material library is available before going parallel
+	GlobalMaterialManager().materialExists("");
+
+	std::atomic<std::size_t> nextModel(0);
+
+	auto loadModels = [&]()
+	{
+		for (auto i = nextModel++; i < pending.size(); i = nextModel++)
+		{
+			try
+			{
+				pending[i].model = pending[i].importer->loadModelFromPath(pending[i].cacheKey);
+			}
+			catch (const std::exception& ex)
+			{
+				// Leave it to the regular load to deal with this model
+				rWarning() << "Failed to preload model " << pending[i].cacheKey << ": " << ex.what() << std::endl;
+			}
+		}
+	};
+
+	auto numWorkers = std::min<std::size_t>(std::max(std::thread::hardware_concurrency(), 1u), pending.size());
+
+	std::vector<std::future<void>> workers;
+
+	for (std::size_t i = 1; i < numWorkers; ++i)
+	{
+		workers.emplace_back(std::async(std::launch::async, loadModels));
+	}
+
+	// The calling thread participates as well
+	loadModels();
+
+	for (auto& worker : workers)
+	{
+		worker.get();
+	}
+
+	std::size_t numLoaded = 0;
+
+	for (auto& pendingModel : pending)
+	{
+		if (!pendingModel.model) continue;
+
+		insertModel(pendingModel.cacheKey, pendingModel.model);
+		++numLoaded;
+	}
+
+	evictUnusedModels();
+
+	rMessage() << "ModelCache: preloaded " << numLoaded << " of " << pending.size() << " models" << std::endl;
+}
+
 scene::INodePtr ModelCache::getModelNodeForStaticResource(const std::string& resourcePath)
 {
     // Get the extension of this model
@@ -161,7 +282,7 @@ void ModelCache::removeModel(const std::string& modelPath)
 
 	if (found != _modelMap.end())
 	{
-		_modelMap.erase(found);
+		eraseModel(found);
 	}
 
 	// Allow usage of the modelnodemap again.
@@ -175,11 +296,88 @@ void ModelCache::clear()
 	_enabled = false;
 
 	_modelMap.clear();
+	_usage.clear();
+	_totalSize = 0;
 
 	// Allow usage of the modelnodemap again.
 	_enabled = true;
 }
 
+IModelCache::Statistics ModelCache::getStatistics() const
+{
+	Statistics statistics;
+
+	statistics.numModels = _modelMap.size();
+	statistics.totalSize = _totalSize;
+	statistics.memoryBudget = _memoryBudget;
+	statistics.numHits = _numHits;
+	statistics.numMisses = _numMisses;
+	statistics.numEvictions = _numEvictions;
+
+	return statistics;
+}
+
+void ModelCache::insertModel(const std::string& modelPath, const IModelPtr& model)
+{
+	auto size = EstimateSize(*model);
+
+	_usage.push_front(modelPath);
+	_modelMap.emplace(modelPath, CachedModel{ model, size, _usage.begin() });
+	_totalSize += size;
+}
+
+void ModelCache::eraseModel(ModelMap::iterator found)
+{
+	_totalSize -= found->second.size;
+	_usage.erase(found->second.usage);
+	_modelMap.erase(found);
+}
+
+void ModelCache::evictUnusedModels()
+{
+	if (_memoryBudget == 0) return;
+
+	// Walk from the least recently used model towards the front
+	auto i = _usage.end();
+
+	while (i != _usage.begin() && _totalSize > _memoryBudget)
+	{
+		auto found = _modelMap.find(*--i);
+
+		// Models still referenced elsewhere (e.g. by model nodes) wouldn't free anything
+		if (found->second.model.use_count() > 1) continue;
+
+		// Step back from the successor of the erased element in the next round
+		i = std::next(i);
+
+		eraseModel(found);
+		++_numEvictions;
+	}
+}
+
+void ModelCache::onMemoryBudgetChanged()
+{
+	auto budget = registry::getValue<double>(RKEY_MODEL_CACHE_MEMORY_BUDGET, 512);
+	_memoryBudget = budget > 0 ? static_cast<std::size_t>(budget * 1024 * 1024) : 0;
+
+	evictUnusedModels();
+}
+
+std::size_t ModelCache::EstimateSize(const IModel& model)
+{
+	std::size_t size = 0;
+
+	for (int i = 0; i < model.getSurfaceCount(); ++i)
+	{
+		const auto& surface = model.getSurface(i);
+
+		size += surface.getNumVertices() * sizeof(MeshVertex) +
+			surface.getNumTriangles() * 3 * sizeof(unsigned int);
+	}
+
+	return size;
+}
+
 sigc::signal<void> ModelCache::signal_modelsReloaded()
 {
 	return _sigModelsReloaded;
@@ -200,6 +398,7 @@ const StringSet& ModelCache::getDependencies() const
 	{
 		_dependencies.insert(MODULE_MODELFORMATMANAGER);
 		_dependencies.insert(MODULE_COMMANDSYSTEM);
+		_dependencies.insert(MODULE_XMLREGISTRY);
 	}
 
 	return _dependencies;
@@ -213,6 +412,14 @@ void ModelCache::initialiseModule(const IApplicationContext& ctx)
 		std::bind(&ModelCache::refreshModelsCmd, this, std::placeholders::_1));
 	GlobalCommandSystem().addCommand("RefreshSelectedModels",
 		std::bind(&ModelCache::refreshSelectedModelsCmd, this, std::placeholders::_1));
+	GlobalCommandSystem().addCommand("ShowModelCacheStats",
+		std::bind(&ModelCache::showStatisticsCmd, this, std::placeholders::_1));
+
+	onMemoryBudgetChanged();
+
+	GlobalRegistry().signalForKey(RKEY_MODEL_CACHE_MEMORY_BUDGET).connect(
+		sigc::mem_fun(this, &ModelCache::onMemoryBudgetChanged)
+	);
 }
 
 void ModelCache::shutdownModule()
@@ -240,6 +447,27 @@ void ModelCache::refreshSelectedModelsCmd(const cmd::ArgumentList& args)
 	map::algorithm::refreshSelectedModels(true);
 }
 
+void ModelCache::showStatisticsCmd(const cmd::ArgumentList& args)
+{
+	auto numRequests = _numHits + _numMisses;
+
+	rMessage() << fmt::format("ModelCache: {0} models, {1} bytes, budget {2} bytes", _modelMap.size(), _totalSize,
+		_memoryBudget) << std::endl;
+	rMessage() << fmt::format("ModelCache: {0} hits, {1} misses, hit rate {2:.1f}%, {3} evictions", _numHits, _numMisses,
+		numRequests > 0 ? 100.0 * _numHits / numRequests : 0.0, _numEvictions) << std::endl;
+
+	rMessage() << fmt::format("{0:>12} {1:>6}  {2}", "Bytes", "Refs", "Model (most recently used first)") << std::endl;
+
+	for (const auto& modelPath : _usage)
+	{
+		const auto& cachedModel = _modelMap.at(modelPath);
+
+		// Don't count the reference held by the cache
+		rMessage() << fmt::format("{0:>12} {1:>6}  {2}", cachedModel.size,
+			cachedModel.model.use_count() - 1, modelPath) << std::endl;
+	}
+}
+
 // The static module
 module::StaticModuleRegistration<ModelCache> modelCacheModule;
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <list>
 #include <map>
 #include <string>
 #include "imodelcache.h"
@@ -12,10 +13,33 @@ class ModelCache :
 	public IModelCache
 {
 private:
+	struct CachedModel
+	{
+		IModelPtr model;
+
+		// Estimated memory used by the model's geometry
+		std::size_t size;
+
+		// The position of this model in the usage list
+		std::list<std::string>::iterator usage;
+	};
+
 	// The container maps model names to instances
-	typedef std::map<std::string, IModelPtr> ModelMap;
+	typedef std::map<std::string, CachedModel> ModelMap;
 	ModelMap _modelMap;
 
+	// The model names, most recently used first
+	std::list<std::string> _usage;
+
+	std::size_t _totalSize;
+
+	// Unused models are evicted when exceeding this size, 0 disables eviction
+	std::size_t _memoryBudget;
+
+	std::size_t _numHits;
+	std::size_t _numMisses;
+	std::size_t _numEvictions;
+
 	// Flag to disable the cache on demand (used during clear())
 	bool _enabled;
 
@@ -30,12 +54,16 @@ public:
 	// greebo: For documentation, see the abstract base class.
 	IModelPtr getModel(const std::string& modelPath) override;
 
+	void preloadModels(const std::set<std::string>& modelPaths) override;
+
     scene::INodePtr getModelNodeForStaticResource(const std::string& resourcePath) override;
 
 	// Clear methods
 	void removeModel(const std::string& modelPath) override;
 	void clear() override;
 
+	Statistics getStatistics() const override;
+
 	void refreshModels(bool blockScreenUpdates = true) override;
 	void refreshSelectedModels(bool blockScreenUpdates = true) override;
 
@@ -51,9 +79,21 @@ public:
 private:
     scene::INodePtr loadNullModel(const std::string& modelPath);
 
+	void insertModel(const std::string& modelPath, const IModelPtr& model);
+	void eraseModel(ModelMap::iterator found);
+
+	// Drops the least recently used models nobody else is referencing,
+	// until the cache fits into the memory budget again
+	void evictUnusedModels();
+
+	void onMemoryBudgetChanged();
+
+	static std::size_t EstimateSize(const IModel& model);
+
 	// Command targets
 	void refreshModelsCmd(const cmd::ArgumentList& args);
 	void refreshSelectedModelsCmd(const cmd::ArgumentList& args);
+	void showStatisticsCmd(const cmd::ArgumentList& args);
 };
 
 } // namespace model
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <string>
+#include "ifilesystem.h"
+#include "os/path.h"
+
+namespace model
+{
+
+/**
+ * Returns the VFS root folder containing the given model file,
+ * the name may be absolute or relative to the VFS. Returns an empty
+ * string for models in PK4 files.
+ */
+inline std::string rootPath(const std::string& name)
+{
+    return GlobalFileSystem().findRoot(
+        path_is_absolute(name.c_str()) ? name : GlobalFileSystem().findFile(name)
+    );
+}
+
+}
@@ -50,6 +50,11 @@ public:
         return _surface.getIndexArray();
     }
 
+    std::uint64_t getGeometryKey() override
+    {
+        return _surface.getGeometryKey();
+    }
+
     bool isOriented() override
     {
         return true;
@@ -16,6 +16,7 @@ namespace model
 
 StaticModelNode::StaticModelNode(const StaticModelPtr& picoModel) :
     _model(new StaticModel(*picoModel)),
+    _sourceModel(picoModel),
     _name(picoModel->getFilename()),
     _attachedToShaders(false)
 {
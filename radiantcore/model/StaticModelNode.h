@@ -35,6 +35,10 @@ private:
 	// The actual model
 	StaticModelPtr _model;
 
+	// The cached model this node has been copied from, referencing
+	// it keeps the ModelCache from evicting it while the node exists
+	StaticModelPtr _sourceModel;
+
 	std::string _name;
 
 	// The name of this model's skin
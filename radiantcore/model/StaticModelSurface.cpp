@@ -10,12 +10,16 @@
 
 #include "string/replace.h"
 
+#include <atomic>
+
 namespace model
 {
 
 StaticModelSurface::StaticModelSurface(std::vector<MeshVertex>&& vertices, std::vector<unsigned int>&& indices) :
     _vertices(vertices),
-    _indices(indices)
+    _indices(indices),
+    _bvh(std::make_shared<TriangleBVH>()),
+    _geometryKey(GenerateGeometryKey())
 {
     // Expand the local AABB to include all vertices
     for (const auto& vertex : _vertices)
@@ -30,9 +34,23 @@ StaticModelSurface::StaticModelSurface(const StaticModelSurface& other) :
     _defaultMaterial(other._defaultMaterial),
     _vertices(other._vertices),
     _indices(other._indices),
-    _localAABB(other._localAABB)
+    _localAABB(other._localAABB),
+    _bvh(other._bvh),
+    _geometryKey(other._geometryKey)
 {}
 
+std::uint64_t StaticModelSurface::GenerateGeometryKey()
+{
+    // Models are loaded on several threads, 0 is reserved for unshared geometry
+    static std::atomic<std::uint64_t> _nextKey(1);
+    return _nextKey++;
+}
+
+std::uint64_t StaticModelSurface::getGeometryKey() const
+{
+    return _geometryKey;
+}
+
 void StaticModelSurface::calculateTangents()
 {
 	// Calculate the tangents and bitangents using the indices into the vertex
@@ -63,16 +81,22 @@ void StaticModelSurface::testSelect(Selector& selector, SelectionTest& test,
 {
 	if (!_vertices.empty() && !_indices.empty())
 	{
-		// Test for triangle selection
+		// Test for triangle selection, skipping the parts of the
+		// surface that are outside the selection volume
 		test.BeginMesh(localToWorld, twoSided);
 		SelectionIntersection result;
 
-		test.TestTriangles(
-			VertexPointer(&_vertices[0].vertex, sizeof(MeshVertex)),
-      		IndexPointer(&_indices[0],
-      					 IndexPointer::index_type(_indices.size())),
-			result
-		);
+		VertexPointer vertexPointer(&_vertices[0].vertex, sizeof(MeshVertex));
+
+		_bvh->foreachTriangleRange([&](const AABB& bounds)
+		{
+			return test.getVolume().TestAABB(bounds, localToWorld);
+		},
+		[&](const unsigned int* indices, std::size_t numIndices)
+		{
+			test.TestTriangles(vertexPointer,
+				IndexPointer(indices, IndexPointer::index_type(numIndices)), result);
+		}, _vertices, _indices);
 
 		// Add the intersection to the selector if it is valid
 		if(result.isValid()) {
@@ -151,43 +175,20 @@ const AABB& StaticModelSurface::getSurfaceBounds() const
 
 bool StaticModelSurface::getIntersection(const Ray& ray, Vector3& intersection, const Matrix4& localToWorld)
 {
-	Vector3 bestIntersection = ray.origin;
-	Vector3 triIntersection;
-
-	for (Indices::const_iterator i = _indices.begin();
-		 i != _indices.end();
-		 i += 3)
-	{
-		// Get the vertices for this triangle
-		const MeshVertex& p1 = _vertices[*(i)];
-		const MeshVertex& p2 = _vertices[*(i+1)];
-		const MeshVertex& p3 = _vertices[*(i+2)];
+	// Transform the ray into model space once, the direction is not normalised
+	// afterwards, which keeps the order of the hits along the ray intact
+	Ray localRay(ray);
+	localRay.transform(localToWorld.getInverse());
 
-		if (ray.intersectTriangle(localToWorld.transformPoint(p1.vertex), 
-			localToWorld.transformPoint(p2.vertex), localToWorld.transformPoint(p3.vertex), triIntersection))
-		{
-			intersection = triIntersection;
-			
-			// Test if this surface intersection is better than what we currently have
-			auto oldDistSquared = (bestIntersection - ray.origin).getLengthSquared();
-			auto newDistSquared = (triIntersection - ray.origin).getLengthSquared();
-
-			if ((oldDistSquared == 0 && newDistSquared > 0) || newDistSquared < oldDistSquared)
-			{
-				bestIntersection = triIntersection;
-			}
-		}
-	}
+	Vector3 localIntersection;
 
-	if ((bestIntersection - ray.origin).getLengthSquared() > 0)
-	{
-		intersection = bestIntersection;
-		return true;
-	}
-	else
+	if (!_bvh->getIntersection(localRay, localIntersection, _vertices, _indices))
 	{
 		return false;
 	}
+
+	intersection = localToWorld.transformPoint(localIntersection);
+	return true;
 }
 
 void StaticModelSurface::applyScale(const Vector3& scale, const StaticModelSurface& originalSurface)
@@ -198,6 +199,16 @@ void StaticModelSurface::applyScale(const Vector3& scale, const StaticModelSurfa
 		return;
 	}
 
+	if (scale == Vector3(1, 1, 1))
+	{
+		// The unscaled geometry equals the original, share its tree and renderer geometry again
+		_vertices = originalSurface._vertices;
+		_localAABB = originalSurface._localAABB;
+		_bvh = originalSurface._bvh;
+		_geometryKey = originalSurface._geometryKey;
+		return;
+	}
+
 	_localAABB = AABB();
 
 	Matrix4 scaleMatrix = Matrix4::getScale(scale);
@@ -215,6 +226,16 @@ void StaticModelSurface::applyScale(const Vector3& scale, const StaticModelSurfa
 	}
 
 	calculateTangents();
+
+	// The tree needs to be rebuilt for the changed vertices
+	_bvh = std::make_shared<TriangleBVH>();
+
+	// Stop sharing the renderer geometry of the unscaled surface. A surface that
+	// has already been scaled keeps its private key, its geometry is updated in place.
+	if (_geometryKey == originalSurface._geometryKey)
+	{
+		_geometryKey = GenerateGeometryKey();
+	}
 }
 
 } // namespace model
@@ -4,6 +4,7 @@
 #include "ishaders.h"
 
 #include "math/AABB.h"
+#include "TriangleBVH.h"
 
 /* FORWARD DECLS */
 class ModelSkin;
@@ -47,10 +48,21 @@ private:
 	// The AABB containing this surface, in local object space.
 	AABB _localAABB;
 
+	// Accelerates ray and selection tests, shared with the copies of this surface
+	// until their geometry is changed by applyScale()
+	std::shared_ptr<TriangleBVH> _bvh;
+
+	// Identifies the geometry of this surface, copies keep the key of the
+	// surface they've been copied from until applyScale() assigns them a
+	// private one. Scaling them back to (1,1,1) restores the shared key.
+	std::uint64_t _geometryKey;
+
 private:
 	// Calculate tangent and bitangent vectors for all vertices.
 	void calculateTangents();
 
+	static std::uint64_t GenerateGeometryKey();
+
 public:
     // Move-construct this static model surface from the given vertex- and index array
 	StaticModelSurface(std::vector<MeshVertex>&& vertices, std::vector<unsigned int>&& indices);
@@ -79,6 +91,7 @@ public:
 
 	const std::vector<MeshVertex>& getVertexArray() const override;
 	const std::vector<unsigned int>& getIndexArray() const override;
+	std::uint64_t getGeometryKey() const override;
 
 	const std::string& getDefaultMaterial() const override;
 	void setDefaultMaterial(const std::string& defaultMaterial);
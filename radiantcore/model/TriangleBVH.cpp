@@ -0,0 +1,240 @@
+#include "TriangleBVH.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include "math/Ray.h"
+
+namespace model
+{
+
+namespace
+{
+    // Nodes with this many triangles or less are not split any further
+    constexpr std::size_t MaxLeafTriangles = 4;
+
+    // Relative amount the node bounds are enlarged by
+    constexpr double BoundsPadding = 1e-6;
+
+    // Returns the ray parameter at which the ray enters the given box,
+    // or a negative value if the ray misses it. Rays starting inside return 0.
+    double getEntryDistance(const Ray& ray, const Vector3& min, const Vector3& max)
+    {
+        double tEnter = 0;
+        double tExit = std::numeric_limits<double>::max();
+
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            if (ray.direction[axis] == 0)
+            {
+                // Parallel to this slab, the origin needs to be in between
+                if (ray.origin[axis] < min[axis] || ray.origin[axis] > max[axis])
+                {
+                    return -1;
+                }
+
+                continue;
+            }
+
+            auto t1 = (min[axis] - ray.origin[axis]) / ray.direction[axis];
+            auto t2 = (max[axis] - ray.origin[axis]) / ray.direction[axis];
+
+            if (t1 > t2) std::swap(t1, t2);
+
+            tEnter = std::max(tEnter, t1);
+            tExit = std::min(tExit, t2);
+
+            if (tEnter > tExit) return -1;
+        }
+
+        return tEnter;
+    }
+}
+
+TriangleBVH::TriangleBVH() :
+    _built(false)
+{}
+
+void TriangleBVH::ensureBuilt(const std::vector<MeshVertex>& vertices, const std::vector<unsigned int>& indices)
+{
+    if (_built) return;
+
+    _built = true;
+
+    auto numTriangles = indices.size() / 3;
+
+    if (numTriangles == 0) return;
+
+    std::vector<Vector3> centroids;
+    centroids.reserve(numTriangles);
+
+    for (std::size_t i = 0; i < numTriangles; ++i)
+    {
+        centroids.emplace_back((vertices[indices[i * 3]].vertex +
+            vertices[indices[i * 3 + 1]].vertex + vertices[indices[i * 3 + 2]].vertex) / 3);
+    }
+
+    std::vector<std::size_t> triangles(numTriangles);
+    std::iota(triangles.begin(), triangles.end(), 0);
+
+    _nodes.reserve(2 * (numTriangles / MaxLeafTriangles + 1));
+
+    // Subdivide at the centroid median of the longest axis, the node ranges are created
+    // in depth-first order, which places the first child right after its parent
+    std::function<void(std::size_t, std::size_t)> subdivide = [&](std::size_t first, std::size_t count)
+    {
+        auto nodeIndex = _nodes.size();
+        _nodes.push_back(Node{ Vector3(), Vector3(), first, count, 0 });
+
+        AABB bounds;
+        AABB centroidBounds;
+
+        for (auto i = first; i < first + count; ++i)
+        {
+            auto triangle = triangles[i];
+
+            bounds.includePoint(vertices[indices[triangle * 3]].vertex);
+            bounds.includePoint(vertices[indices[triangle * 3 + 1]].vertex);
+            bounds.includePoint(vertices[indices[triangle * 3 + 2]].vertex);
+            centroidBounds.includePoint(centroids[triangle]);
+        }
+
+        // Pad the bounds a bit, such that rounding errors in the box tests can't discard any hits
+        auto halfSize = bounds.getExtents() + Vector3(BoundsPadding, BoundsPadding, BoundsPadding) * bounds.getExtents().getLength();
+
+        _nodes[nodeIndex].min = bounds.getOrigin() - halfSize;
+        _nodes[nodeIndex].max = bounds.getOrigin() + halfSize;
+
+        const auto& extents = centroidBounds.getExtents();
+        auto axis = extents.x() >= extents.y() && extents.x() >= extents.z() ? 0 : extents.y() >= extents.z() ? 1 : 2;
+
+        // Triangles with coinciding centroids can't be separated
+        if (count <= MaxLeafTriangles || extents[axis] == 0) return;
+
+        auto middle = first + count / 2;
+
+        std::nth_element(triangles.begin() + first, triangles.begin() + middle, triangles.begin() + first + count,
+            [&](std::size_t a, std::size_t b) { return centroids[a][axis] < centroids[b][axis]; });
+
+        subdivide(first, middle - first);
+
+        _nodes[nodeIndex].secondChild = _nodes.size();
+
+        subdivide(middle, first + count - middle);
+    };
+
+    subdivide(0, numTriangles);
+
+    _indices.reserve(numTriangles * 3);
+
+    for (auto triangle : triangles)
+    {
+        _indices.push_back(indices[triangle * 3]);
+        _indices.push_back(indices[triangle * 3 + 1]);
+        _indices.push_back(indices[triangle * 3 + 2]);
+    }
+}
+
+bool TriangleBVH::getIntersection(const Ray& ray, Vector3& intersection,
+    const std::vector<MeshVertex>& vertices, const std::vector<unsigned int>& indices)
+{
+    ensureBuilt(vertices, indices);
+
+    if (_nodes.empty() || getEntryDistance(ray, _nodes.front().min, _nodes.front().max) < 0)
+    {
+        return false;
+    }
+
+    auto directionLengthSquared = ray.direction.getLengthSquared();
+    auto bestDistSquared = std::numeric_limits<double>::max();
+    Vector3 triIntersection;
+
+    std::vector<std::size_t> stack{ 0 };
+
+    while (!stack.empty())
+    {
+        auto nodeIndex = stack.back();
+        stack.pop_back();
+
+        const auto& node = _nodes[nodeIndex];
+
+        if (node.secondChild == 0)
+        {
+            for (auto i = node.firstTriangle * 3; i < (node.firstTriangle + node.numTriangles) * 3; i += 3)
+            {
+                if (ray.intersectTriangle(vertices[_indices[i]].vertex, vertices[_indices[i + 1]].vertex,
+                    vertices[_indices[i + 2]].vertex, triIntersection) != Ray::POINT)
+                {
+                    continue;
+                }
+
+                auto distSquared = (triIntersection - ray.origin).getLengthSquared();
+
+                if (distSquared > 0 && distSquared < bestDistSquared)
+                {
+                    bestDistSquared = distSquared;
+                    intersection = triIntersection;
+                }
+            }
+
+            continue;
+        }
+
+        // Visit the nearer child first, skip the children behind the best hit so far
+        std::size_t children[2] = { nodeIndex + 1, node.secondChild };
+        double distances[2] =
+        {
+            getEntryDistance(ray, _nodes[children[0]].min, _nodes[children[0]].max),
+            getEntryDistance(ray, _nodes[children[1]].min, _nodes[children[1]].max)
+        };
+
+        if (distances[1] >= 0 && (distances[0] < 0 || distances[1] < distances[0]))
+        {
+            std::swap(children[0], children[1]);
+            std::swap(distances[0], distances[1]);
+        }
+
+        // Push the farther one first, such that the nearer one is popped next
+        for (int i = 1; i >= 0; --i)
+        {
+            if (distances[i] >= 0 && distances[i] * distances[i] * directionLengthSquared <= bestDistSquared)
+            {
+                stack.push_back(children[i]);
+            }
+        }
+    }
+
+    return bestDistSquared < std::numeric_limits<double>::max();
+}
+
+void TriangleBVH::foreachTriangleRange(const BoundsTest& testBounds, const TriangleRangeVisitor& visitor,
+    const std::vector<MeshVertex>& vertices, const std::vector<unsigned int>& indices)
+{
+    ensureBuilt(vertices, indices);
+
+    if (_nodes.empty()) return;
+
+    std::vector<std::size_t> stack{ 0 };
+
+    while (!stack.empty())
+    {
+        auto nodeIndex = stack.back();
+        stack.pop_back();
+
+        const auto& node = _nodes[nodeIndex];
+        auto result = testBounds(AABB::createFromMinMax(node.min, node.max));
+
+        if (result == VOLUME_OUTSIDE) continue;
+
+        if (result == VOLUME_INSIDE || node.secondChild == 0)
+        {
+            visitor(_indices.data() + node.firstTriangle * 3, node.numTriangles * 3);
+            continue;
+        }
+
+        stack.push_back(node.secondChild);
+        stack.push_back(nodeIndex + 1);
+    }
+}
+
+}
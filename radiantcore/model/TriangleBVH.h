@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include "render/MeshVertex.h"
+#include "math/AABB.h"
+#include "VolumeIntersectionValue.h"
+
+class Ray;
+
+namespace model
+{
+
+/**
+ * Bounding volume hierarchy over the triangles of an indexed model surface,
+ * in the surface's local space. It accelerates ray intersections and
+ * selection tests, which would otherwise have to test every triangle.
+ *
+ * The tree is built on the first query, using the vertex and index arrays
+ * passed to it. Surfaces sharing the same geometry (e.g. the instances
+ * copied from a cached model) can share the same TriangleBVH, as long as
+ * they pass identical arrays. Surfaces changing their geometry need to
+ * discard their TriangleBVH and start using a new one.
+ */
+class TriangleBVH
+{
+private:
+    struct Node
+    {
+        Vector3 min;
+        Vector3 max;
+
+        // The triangle range covered by this node (in _indices, 3 indices per triangle)
+        std::size_t firstTriangle;
+        std::size_t numTriangles;
+
+        // The first child immediately follows its parent, this is the second one.
+        // Leaf nodes have no children (secondChild == 0).
+        std::size_t secondChild;
+    };
+
+    std::vector<Node> _nodes;
+
+    // The surface indices, reordered such that the triangles of each node are contiguous
+    std::vector<unsigned int> _indices;
+
+    bool _built;
+
+public:
+    using TriangleRangeVisitor = std::function<void(const unsigned int* indices, std::size_t numIndices)>;
+    using BoundsTest = std::function<VolumeIntersectionValue(const AABB& bounds)>;
+
+    TriangleBVH();
+
+    /**
+     * Finds the intersection of the given ray with the surface that is nearest
+     * to the ray origin, both ray and intersection point are in local space.
+     * Intersections at the ray origin itself are ignored.
+     * Returns false if the ray doesn't hit any triangle.
+     */
+    bool getIntersection(const Ray& ray, Vector3& intersection,
+        const std::vector<MeshVertex>& vertices, const std::vector<unsigned int>& indices);
+
+    /**
+     * Invokes the visitor for the triangles whose bounds are not entirely outside
+     * according to the given test, in contiguous ranges of 3 indices per triangle.
+     * Triangles of nodes that are entirely inside are passed in a single range.
+     */
+    void foreachTriangleRange(const BoundsTest& testBounds, const TriangleRangeVisitor& visitor,
+        const std::vector<MeshVertex>& vertices, const std::vector<unsigned int>& indices);
+
+private:
+    void ensureBuilt(const std::vector<MeshVertex>& vertices, const std::vector<unsigned int>& indices);
+};
+
+}
@@ -7,21 +7,11 @@
 #include "os/path.h"
 #include "../StaticModelNode.h"
 #include "../StaticModel.h"
+#include "../ModelPath.h"
 
 namespace model
 {
 
-namespace
-{
-    // name may be absolute or relative
-    inline std::string rootPath(const std::string& name)
-    {
-        return GlobalFileSystem().findRoot(
-            path_is_absolute(name.c_str()) ? name : GlobalFileSystem().findFile(name)
-        );
-    }
-}
-
 ModelImporterBase::ModelImporterBase(const std::string& extension) :
     _extension(string::to_upper_copy(extension))
 {
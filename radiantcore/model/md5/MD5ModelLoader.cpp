@@ -10,21 +10,11 @@
 #include "os/path.h"
 
 #include "MD5ModelNode.h"
+#include "../ModelPath.h"
 
 namespace md5
  {
 
-namespace
-{
-	// name may be absolute or relative
-	inline std::string rootPath(const std::string& name)
-	{
-		return GlobalFileSystem().findRoot(
-			path_is_absolute(name.c_str()) ? name : GlobalFileSystem().findFile(name)
-		);
-	}
-} // namespace
-
 const std::string& MD5ModelLoader::getExtension() const
 {
 	static std::string _ext("MD5MESH");
@@ -34,7 +24,7 @@ const std::string& MD5ModelLoader::getExtension() const
 scene::INodePtr MD5ModelLoader::loadModel(const std::string& modelName)
 {
 	// Initialise the paths, this is all needed for realisation
-	auto path = rootPath(modelName);
+	auto path = model::rootPath(modelName);
 	auto name = os::getRelativePath(modelName, path);
 
 	// greebo: Path is empty for models in PK4 files, don't check for that
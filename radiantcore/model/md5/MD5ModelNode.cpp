@@ -11,6 +11,7 @@ namespace md5
 
 MD5ModelNode::MD5ModelNode(const MD5ModelPtr& model) :
     _model(new MD5Model(*model)), // create a copy of the incoming model, we need our own instance
+    _sourceModel(model),
     _attachedToShaders(false),
     _showSkeleton(RKEY_RENDER_SKELETON),
     _renderableSkeleton(_model->getSkeleton(), localToWorld())
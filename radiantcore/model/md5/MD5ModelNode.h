@@ -23,6 +23,10 @@ class MD5ModelNode :
 {
 	MD5ModelPtr _model;
 
+	// The cached model this node has been copied from, referencing
+	// it keeps the ModelCache from evicting it while the node exists
+	MD5ModelPtr _sourceModel;
+
 	// The name of this model's skin
 	std::string _skin;
 
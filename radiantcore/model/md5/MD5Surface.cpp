@@ -16,13 +16,15 @@ inline VertexPointer vertexpointer_Meshvertex(const MeshVertex* array)
 // Constructor
 MD5Surface::MD5Surface() :
 	_originalShaderName(""),
-	_mesh(new MD5Mesh)
+	_mesh(new MD5Mesh),
+	_bvh(std::make_shared<model::TriangleBVH>())
 {}
 
 MD5Surface::MD5Surface(const MD5Surface& other) :
 	_aabb_local(other._aabb_local),
 	_originalShaderName(other._originalShaderName),
-	_mesh(other._mesh)
+	_mesh(other._mesh),
+	_bvh(std::make_shared<model::TriangleBVH>())
 {}
 
 // Update geometry
@@ -51,6 +53,9 @@ void MD5Surface::updateGeometry()
 		vertex.tangent.normalise();
 		vertex.bitangent.normalise();
 	}
+
+	// The tree is rebuilt on demand for the new vertex positions
+	_bvh = std::make_shared<model::TriangleBVH>();
 }
 
 void MD5Surface::testSelect(Selector& selector,
@@ -60,11 +65,17 @@ void MD5Surface::testSelect(Selector& selector,
 	test.BeginMesh(localToWorld);
 
 	SelectionIntersection best;
-	test.TestTriangles(
-	  vertexpointer_Meshvertex(_vertices.data()),
-	  IndexPointer(_indices.data(), IndexPointer::index_type(_indices.size())),
-	  best
-	);
+	auto vertexPointer = vertexpointer_Meshvertex(_vertices.data());
+
+	_bvh->foreachTriangleRange([&](const AABB& bounds)
+	{
+		return test.getVolume().TestAABB(bounds, localToWorld);
+	},
+	[&](const unsigned int* indices, std::size_t numIndices)
+	{
+		test.TestTriangles(vertexPointer,
+			IndexPointer(indices, IndexPointer::index_type(numIndices)), best);
+	}, _vertices, _indices);
 
 	if(best.isValid()) {
 		selector.addIntersection(best);
@@ -73,43 +84,20 @@ void MD5Surface::testSelect(Selector& selector,
 
 bool MD5Surface::getIntersection(const Ray& ray, Vector3& intersection, const Matrix4& localToWorld)
 {
-	Vector3 bestIntersection = ray.origin;
-	Vector3 triIntersection;
-
-	for (Indices::const_iterator i = _indices.begin();
-		 i != _indices.end();
-		 i += 3)
-	{
-		// Get the vertices for this triangle
-		const auto& p1 = _vertices[*(i)];
-		const auto& p2 = _vertices[*(i+1)];
-		const auto& p3 = _vertices[*(i+2)];
+	// Transform the ray into model space once, the direction is not normalised
+	// afterwards, which keeps the order of the hits along the ray intact
+	Ray localRay(ray);
+	localRay.transform(localToWorld.getInverse());
 
-		if (ray.intersectTriangle(localToWorld.transformPoint(p1.vertex),
-			localToWorld.transformPoint(p2.vertex), localToWorld.transformPoint(p3.vertex), triIntersection))
-		{
-			intersection = triIntersection;
-
-			// Test if this surface intersection is better than what we currently have
-            auto oldDistSquared = (bestIntersection - ray.origin).getLengthSquared();
-            auto newDistSquared = (triIntersection - ray.origin).getLengthSquared();
-
-			if ((oldDistSquared == 0 && newDistSquared > 0) || newDistSquared < oldDistSquared)
-			{
-				bestIntersection = triIntersection;
-			}
-		}
-	}
+	Vector3 localIntersection;
 
-	if ((bestIntersection - ray.origin).getLengthSquared() > 0)
-	{
-		intersection = bestIntersection;
-		return true;
-	}
-	else
+	if (!_bvh->getIntersection(localRay, localIntersection, _vertices, _indices))
 	{
 		return false;
 	}
+
+	intersection = localToWorld.transformPoint(localIntersection);
+	return true;
 }
 
 void MD5Surface::setDefaultMaterial(const std::string& name)
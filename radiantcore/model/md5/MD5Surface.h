@@ -9,6 +9,7 @@
 #include "imodelsurface.h"
 
 #include "MD5DataStructures.h"
+#include "../TriangleBVH.h"
 #include "parser/DefTokeniser.h"
 
 class Ray;
@@ -42,6 +43,9 @@ private:
 	Vertices _vertices;
 	Indices _indices;
 
+	// Accelerates ray and selection tests, replaced whenever the pose changes
+	std::shared_ptr<model::TriangleBVH> _bvh;
+
 public:
 
 	MD5Surface();
@@ -25,7 +25,14 @@ read requests until flen is reset.
 #define INT_MIN     (-2147483647 - 1) /* minimum (signed) int value */
 #define FLEN_ERROR INT_MIN
 
-static int flen;
+/* one counter per thread, models may be loaded concurrently */
+#ifdef _MSC_VER
+#define FLEN_THREAD_LOCAL __declspec( thread )
+#else
+#define FLEN_THREAD_LOCAL __thread
+#endif
+
+static FLEN_THREAD_LOCAL int flen;
 
 void set_flen( int i ) { flen = i; }
 
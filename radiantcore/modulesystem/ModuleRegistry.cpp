@@ -2,9 +2,15 @@
 
 #include "i18n.h"
 #include "iradiant.h"
+#include "itracecollector.h"
 #include "itextstream.h"
 #include <stdexcept>
 #include <iostream>
+#include <algorithm>
+#include <condition_variable>
+#include <future>
+#include <set>
+#include <vector>
 #include "ModuleLoader.h"
 
 #include <fmt/format.h>
@@ -42,7 +48,11 @@ void ModuleRegistry::unloadModules()
     // method which in turn refers to a semi-destructed ModulesMap instance.
     // So, copy the contents to a temporary map before clearing it out.
     ModulesMap tempMap;
-    tempMap.swap(_initialisedModules);
+
+    {
+        std::lock_guard<std::mutex> lock(_modulesLock);
+        tempMap.swap(_initialisedModules);
+    }
     
 	tempMap.clear();
 
@@ -91,11 +101,54 @@ void ModuleRegistry::registerModule(const RegisterableModulePtr& module)
 	rMessage() << "Module registered: " << module->getName() << std::endl;
 }
 
+bool ModuleRegistry::markModuleAsInitialised(const RegisterableModulePtr& module)
+{
+	std::size_t numInitialised = 0;
+
+	{
+		std::lock_guard<std::mutex> lock(_modulesLock);
+
+		if (!_initialisedModules.emplace(module->getName(), module).second)
+		{
+			return false;
+		}
+
+		numInitialised = _initialisedModules.size();
+	}
+
+	_progress = 0.1f + (static_cast<float>(numInitialised)/_uninitialisedModules.size())*0.9f;
+
+	_sigModuleInitialisationProgress.emit(
+		fmt::format(_("Initialising Module: {0}"), module->getName()),
+		_progress);
+
+	return true;
+}
+
+void ModuleRegistry::initialiseModuleTimed(const RegisterableModulePtr& module)
+{
+	auto start = std::chrono::steady_clock::now();
+
+	module->initialiseModule(_context);
+
+	auto end = std::chrono::steady_clock::now();
+	auto duration = end - start;
+
+	// The core module hosting the trace collector is the first one to be initialised
+	if (module->getName() != MODULE_RADIANT_CORE && GlobalTraceCollector().isEnabled())
+	{
+		GlobalTraceCollector().recordZone("module", "initialiseModule", module->getName().c_str(), start, end);
+	}
+
+	std::lock_guard<std::mutex> lock(_modulesLock);
+	_initialisationDurations[module->getName()] = duration;
+}
+
 // Initialise the module (including dependencies, if necessary)
 void ModuleRegistry::initialiseModuleRecursive(const std::string& name)
 {
 	// Check if the module is already initialised
-	if (_initialisedModules.find(name) != _initialisedModules.end())
+	if (moduleExists(name))
     {
 		return;
 	}
@@ -107,7 +160,9 @@ void ModuleRegistry::initialiseModuleRecursive(const std::string& name)
 	}
 
 	// Tag this module as "ready" by moving it into the initialised list.
-	RegisterableModulePtr module = _initialisedModules.emplace(name, _uninitialisedModules[name]).first->second;
+	RegisterableModulePtr module = _uninitialisedModules[name];
+	markModuleAsInitialised(module);
+
 	const StringSet& dependencies = module->getDependencies();
 
     // Debug builds should ensure that the dependencies don't reference the
@@ -120,14 +175,206 @@ void ModuleRegistry::initialiseModuleRecursive(const std::string& name)
         initialiseModuleRecursive(namedDependency);
 	}
 
-	_progress = 0.1f + (static_cast<float>(_initialisedModules.size())/_uninitialisedModules.size())*0.9f;
+	// Initialise the module itself, now that the dependencies are ready
+	initialiseModuleTimed(module);
+}
 
-	_sigModuleInitialisationProgress.emit(
-		fmt::format(_("Initialising Module: {0}"), module->getName()),
-		_progress);
+void ModuleRegistry::initialiseModulesInDependencyOrder()
+{
+	// Build the dependency graph: the number of outstanding dependencies
+	// per module and the list of modules depending on each module
+	std::map<std::string, std::size_t> numPendingDependencies;
+	std::map<std::string, std::vector<std::string>> dependentModules;
 
-	// Initialise the module itself, now that the dependencies are ready
-	module->initialiseModule(_context);
+	for (const auto& [name, module] : _uninitialisedModules)
+	{
+		std::size_t numPending = 0;
+
+		for (const auto& dependency : module->getDependencies())
+		{
+			assert(dependency != name);
+
+			if (moduleExists(dependency))
+			{
+				continue; // already initialised (like the core module)
+			}
+
+			if (_uninitialisedModules.find(dependency) == _uninitialisedModules.end())
+			{
+				throw std::logic_error("ModuleRegistry: Module doesn't exist: " + dependency);
+			}
+
+			dependentModules[dependency].push_back(name);
+			++numPending;
+		}
+
+		numPendingDependencies[name] = numPending;
+	}
+
+	// Modules ready for initialisation, ordered by name to be deterministic
+	std::set<std::string> readyModules;
+
+	for (const auto& [name, numPending] : numPendingDependencies)
+	{
+		if (numPending == 0)
+		{
+			readyModules.insert(name);
+		}
+	}
+
+	auto numRemaining = numPendingDependencies.size();
+
+	auto onModuleFinished = [&](const std::string& name)
+	{
+		--numRemaining;
+
+		for (const auto& dependent : dependentModules[name])
+		{
+			if (--numPendingDependencies[dependent] == 0)
+			{
+				readyModules.insert(dependent);
+			}
+		}
+	};
+
+	// Worker threads report back through this queue
+	std::mutex finishedLock;
+	std::condition_variable finishedCondition;
+	std::vector<std::pair<std::string, std::exception_ptr>> finishedModules;
+	std::size_t numRunningWorkers = 0;
+	std::exception_ptr workerException;
+
+	// Declared last such that the futures are waited on before the
+	// state above goes out of scope, in case an exception is thrown
+	std::vector<std::future<void>> workers;
+
+	while (numRemaining > 0)
+	{
+		// Process the modules finished by the workers in the meantime
+		{
+			std::unique_lock<std::mutex> lock(finishedLock);
+
+			for (const auto& [name, exception] : finishedModules)
+			{
+				--numRunningWorkers;
+
+				if (exception && !workerException)
+				{
+					workerException = exception;
+				}
+
+				onModuleFinished(name);
+			}
+
+			finishedModules.clear();
+		}
+
+		if (workerException)
+		{
+			// Don't start anything new, wait for the running ones to finish
+			if (numRunningWorkers == 0)
+			{
+				std::rethrow_exception(workerException);
+			}
+
+			std::unique_lock<std::mutex> lock(finishedLock);
+			finishedCondition.wait(lock, [&] { return !finishedModules.empty(); });
+			continue;
+		}
+
+		// Dispatch all ready modules that can run on a worker thread
+		for (auto i = readyModules.begin(); i != readyModules.end();)
+		{
+			const auto& module = _uninitialisedModules[*i];
+
+			if (!module->supportsParallelInitialisation())
+			{
+				++i;
+				continue;
+			}
+
+			markModuleAsInitialised(module);
+			++numRunningWorkers;
+
+			workers.emplace_back(std::async(std::launch::async, [&, module]()
+			{
+				std::exception_ptr exception;
+
+				try
+				{
+					initialiseModuleTimed(module);
+				}
+				catch (...)
+				{
+					exception = std::current_exception();
+				}
+
+				std::lock_guard<std::mutex> lock(finishedLock);
+				finishedModules.emplace_back(module->getName(), exception);
+				finishedCondition.notify_one();
+			}));
+
+			i = readyModules.erase(i);
+		}
+
+		// Initialise the next main-thread module, then check back on the workers
+		if (!readyModules.empty())
+		{
+			auto name = *readyModules.begin();
+			readyModules.erase(readyModules.begin());
+
+			const auto& module = _uninitialisedModules[name];
+
+			markModuleAsInitialised(module);
+			initialiseModuleTimed(module);
+
+			onModuleFinished(name);
+			continue;
+		}
+
+		if (numRunningWorkers > 0)
+		{
+			std::unique_lock<std::mutex> lock(finishedLock);
+			finishedCondition.wait(lock, [&] { return !finishedModules.empty(); });
+			continue;
+		}
+
+		// Nothing is ready and nothing is running, there must be a dependency cycle.
+		// Fall back to the recursive initialisation on this thread for the rest.
+		rWarning() << "ModuleRegistry: Circular module dependencies detected, "
+			<< "initialising the remaining modules sequentially." << std::endl;
+
+		for (const auto& [name, numPending] : numPendingDependencies)
+		{
+			initialiseModuleRecursive(name);
+		}
+
+		break;
+	}
+}
+
+void ModuleRegistry::logInitialisationDurations(std::chrono::steady_clock::duration totalTime)
+{
+	std::vector<std::pair<std::string, std::chrono::steady_clock::duration>> durations(
+		_initialisationDurations.begin(), _initialisationDurations.end());
+
+	// Longest first
+	std::sort(durations.begin(), durations.end(), [](const auto& a, const auto& b)
+	{
+		return a.second > b.second;
+	});
+
+	auto toMilliseconds = [](std::chrono::steady_clock::duration duration)
+	{
+		return std::chrono::duration<double, std::milli>(duration).count();
+	};
+
+	rMessage() << fmt::format("Module initialisation took {0:.1f} ms in total:", toMilliseconds(totalTime)) << std::endl;
+
+	for (const auto& [name, duration] : durations)
+	{
+		rMessage() << fmt::format("  {0:>9.2f} ms  {1}", toMilliseconds(duration), name) << std::endl;
+	}
 }
 
 void ModuleRegistry::initialiseCoreModule()
@@ -140,12 +387,15 @@ void ModuleRegistry::initialiseCoreModule()
 	assert(_initialisedModules.find(coreModuleName) == _initialisedModules.end());
 
 	// Tag this module as "ready" by inserting it into the initialised list.
-	moduleIter = _initialisedModules.emplace(moduleIter->second->getName(), moduleIter->second).first;
+	{
+		std::lock_guard<std::mutex> lock(_modulesLock);
+		_initialisedModules.emplace(moduleIter->second->getName(), moduleIter->second);
+	}
 
 	// We assume that the core module doesn't have any dependencies
 	assert(moduleIter->second->getDependencies().empty());
 
-	moduleIter->second->initialiseModule(_context);
+	initialiseModuleTimed(moduleIter->second);
 
 	_uninitialisedModules.erase(coreModuleName);
 }
@@ -171,16 +421,14 @@ void ModuleRegistry::loadAndInitialiseModules()
 	_progress = 0.1f;
 	_sigModuleInitialisationProgress.emit(_("Initialising Modules"), _progress);
 
-	for (ModulesMap::iterator i = _uninitialisedModules.begin();
-		 i != _uninitialisedModules.end(); ++i)
-	{
-		// greebo: Dive into the recursion
-		// (this will return immediately if the module is already initialised).
-		initialiseModuleRecursive(i->first);
-	}
+	auto start = std::chrono::steady_clock::now();
+
+	initialiseModulesInDependencyOrder();
 
 	_uninitialisedModules.clear();
 
+	logInitialisationDurations(std::chrono::steady_clock::now() - start);
+
 	// Make sure this isn't called again
 	_modulesInitialised = true;
 
@@ -220,6 +468,8 @@ void ModuleRegistry::shutdownModules()
 
 bool ModuleRegistry::moduleExists(const std::string& name) const
 {
+	std::lock_guard<std::mutex> lock(_modulesLock);
+
 	// Try to find the initialised module, uninitialised don't count as existing
     return _initialisedModules.find(name) != _initialisedModules.end();
 }
@@ -230,12 +480,16 @@ RegisterableModulePtr ModuleRegistry::getModule(const std::string& name) const {
 	// The return value (NULL) by default
 	RegisterableModulePtr returnValue;
 
-	// Try to find the module
-	ModulesMap::const_iterator found = _initialisedModules.find(name);
+	{
+		std::lock_guard<std::mutex> lock(_modulesLock);
 
-	if (found != _initialisedModules.end())
-    {
-		returnValue = found->second;
+		// Try to find the module
+		ModulesMap::const_iterator found = _initialisedModules.find(name);
+
+		if (found != _initialisedModules.end())
+		{
+			returnValue = found->second;
+		}
 	}
 
 	if (!returnValue)
@@ -292,6 +546,11 @@ sigc::signal<void>& ModuleRegistry::signal_modulesUnloading()
     return _sigModulesUnloading;
 }
 
+std::mutex& ModuleRegistry::getSignalLock()
+{
+	return _signalLock;
+}
+
 std::size_t ModuleRegistry::getCompatibilityLevel() const
 {
 	return MODULE_COMPATIBILITY_LEVEL;
@@ -2,6 +2,8 @@
 
 #include <map>
 #include <list>
+#include <mutex>
+#include <chrono>
 #include "imodule.h"
 
 namespace module 
@@ -31,6 +33,16 @@ private:
 	// After initialisiation, modules get enlisted here.
 	ModulesMap _initialisedModules;
 
+	// Protects the modules maps, modules initialised on worker threads
+	// might query the registry while the main thread is adding to it
+	mutable std::mutex _modulesLock;
+
+	// Held by code connecting to the signals below from a worker thread
+	std::mutex _signalLock;
+
+	// The time spent in each module's initialiseModule() call
+	std::map<std::string, std::chrono::steady_clock::duration> _initialisationDurations;
+
 	// Set to TRUE as soon as initialiseModules() is finished
 	bool _modulesInitialised;
 
@@ -81,6 +93,8 @@ public:
     sigc::signal<void>& signal_allModulesUninitialised() override;
     sigc::signal<void>& signal_modulesUnloading() override;
 
+	std::mutex& getSignalLock() override;
+
 	std::size_t getCompatibilityLevel() const override;
 
 	// Returns a list of modules
@@ -101,6 +115,21 @@ private:
 	// Initialises the module (including dependencies, recursively).
 	void initialiseModuleRecursive(const std::string& name);
 
+	// Initialises all uninitialised modules following the dependency graph.
+	// Modules supporting it are initialised on worker threads as soon as all
+	// of their dependencies are ready, all others run on the calling thread.
+	void initialiseModulesInDependencyOrder();
+
+	// Moves the module into the initialised list and reports progress,
+	// returns false if the module has already been tagged before
+	bool markModuleAsInitialised(const RegisterableModulePtr& module);
+
+	// Invokes initialiseModule() and records the time it took
+	void initialiseModuleTimed(const RegisterableModulePtr& module);
+
+	// Writes the recorded initialisation durations to the log
+	void logInitialisationDurations(std::chrono::steady_clock::duration totalTime);
+
 }; // class Registry
 
 } // namespace module
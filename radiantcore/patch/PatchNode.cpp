@@ -6,6 +6,7 @@
 #include "icounter.h"
 #include "math/Frustum.h"
 #include "math/Hash.h"
+#include "util/MemoryUsage.h"
 
 PatchNode::PatchNode(patch::PatchDefType type) :
 	scene::SelectableNode(),
@@ -46,6 +47,17 @@ scene::INode::Type PatchNode::getNodeType() const
 	return Type::Patch;
 }
 
+std::size_t PatchNode::getMemoryUsage() const
+{
+	return sizeof(PatchNode) + getNodeHeapMemoryUsage() +
+		util::getHeapMemoryUsage(m_ctrl_instances) +
+		util::getHeapMemoryUsage(m_patch._ctrl) +
+		util::getHeapMemoryUsage(m_patch._ctrlTransformed) +
+		util::getHeapMemoryUsage(m_patch._mesh.vertices) +
+		util::getHeapMemoryUsage(m_patch._mesh.indices) +
+		util::getHeapMemoryUsage(m_patch.getShader());
+}
+
 std::string PatchNode::getFingerprint()
 {
     constexpr std::size_t SignificantDigits = scene::SignificantFingerprintDoubleDigits;
@@ -281,6 +293,8 @@ void PatchNode::updateAllRenderables()
     _renderableSurfaceWireframe.queueUpdate();
     _renderableCtrlLattice.queueUpdate();
     _renderableCtrlPoints.queueUpdate();
+
+    queueRenderStateUpdate();
 }
 
 void PatchNode::hideAllRenderables()
@@ -343,6 +357,14 @@ bool PatchNode::getIntersection(const Ray& ray, Vector3& intersection)
 	return m_patch.getIntersection(ray, intersection);
 }
 
+bool PatchNode::isRenderStateDirty() const
+{
+    // Pending tesselation changes are evaluated in onPreRender, selected
+    // patches need to refresh their control point renderables in every frame
+    return renderStateUpdateQueued() || isSelected() ||
+        m_patch._transformChanged || m_patch._tesselationChanged;
+}
+
 void PatchNode::onPreRender(const VolumeTest& volume)
 {
     // Defer the tesselation calculation to the last minute
@@ -504,6 +526,8 @@ void PatchNode::onMaterialChanged()
 {
     _renderableSurfaceSolid.queueUpdate();
     _renderableSurfaceWireframe.queueUpdate();
+
+    queueRenderStateUpdate();
 }
 
 void PatchNode::onVisibilityChanged(bool visible)
@@ -58,6 +58,7 @@ public:
 
 	std::string name() const override;
 	Type getNodeType() const override;
+	std::size_t getMemoryUsage() const override;
 
     // IComparableNode implementation
     std::string getFingerprint() override;
@@ -124,6 +125,7 @@ public:
 
 	// Render functions, these make sure that all things get rendered properly. The calls are also passed on
 	// to the contained patch <m_patch>
+    bool isRenderStateDirty() const override;
     void onPreRender(const VolumeTest& volume) override;
 	void renderHighlights(IRenderableCollector& collector, const VolumeTest& volume) override;
 	void setRenderSystem(const RenderSystemPtr& renderSystem) override;
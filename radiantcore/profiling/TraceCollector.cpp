@@ -0,0 +1,288 @@
+#include "TraceCollector.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fmt/format.h>
+
+namespace profiling
+{
+
+namespace
+{
+    std::atomic<std::uint64_t> NextInstanceId(1);
+
+    // Each thread caches the buffer it is writing to, along with
+    // the ID of the collector that buffer is belonging to.
+    // The buffer is released when the thread exits.
+    struct ThreadBufferCache
+    {
+        std::uint64_t instanceId = 0;
+        void* buffer = nullptr;
+        std::shared_ptr<std::atomic<bool>> bufferInUse;
+
+        ~ThreadBufferCache()
+        {
+            release();
+        }
+
+        void release()
+        {
+            if (bufferInUse)
+            {
+                *bufferInUse = false;
+                bufferInUse.reset();
+            }
+
+            instanceId = 0;
+            buffer = nullptr;
+        }
+    };
+
+    thread_local ThreadBufferCache CurrentThreadBuffer;
+
+    // Writes the string as quoted JSON string
+    void writeJsonString(std::ostream& stream, const char* str)
+    {
+        stream << '"';
+
+        for (auto c = str; *c != '\0'; ++c)
+        {
+            switch (*c)
+            {
+            case '"': stream << "\\\""; break;
+            case '\\': stream << "\\\\"; break;
+            case '\n': stream << "\\n"; break;
+            case '\r': stream << "\\r"; break;
+            case '\t': stream << "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(*c) < 0x20)
+                {
+                    stream << fmt::format("\\u{0:04x}", static_cast<int>(*c));
+                }
+                else
+                {
+                    stream << *c;
+                }
+            }
+        }
+
+        stream << '"';
+    }
+}
+
+TraceCollector::TraceCollector() :
+    _instanceId(NextInstanceId++),
+    _enabled(false),
+    _epoch(Clock::now()),
+    _mainThreadId(std::this_thread::get_id())
+{}
+
+bool TraceCollector::isEnabled() const
+{
+    return _enabled.load(std::memory_order_relaxed);
+}
+
+void TraceCollector::setEnabled(bool enabled)
+{
+    _enabled = enabled;
+}
+
+void TraceCollector::clear()
+{
+    std::lock_guard<std::mutex> lock(_buffersLock);
+
+    for (const auto& buffer : _buffers)
+    {
+        std::lock_guard<std::mutex> bufferLock(buffer->lock);
+
+        buffer->events.clear();
+        buffer->nextEvent = 0;
+        buffer->wrapped = false;
+    }
+}
+
+void TraceCollector::recordZone(const char* category, const char* name, const char* detail,
+    Clock::time_point start, Clock::time_point end)
+{
+    auto& buffer = getBufferForCurrentThread();
+
+    std::lock_guard<std::mutex> lock(buffer.lock);
+
+    auto& event = allocateEvent(buffer);
+
+    event.type = Event::Type::Zone;
+    event.category = category;
+    event.name = name;
+    event.timestamp = getMicroseconds(start);
+    event.value = std::chrono::duration<double, std::micro>(end - start).count();
+
+    if (detail != nullptr)
+    {
+        std::strncpy(event.detail, detail, MaxDetailLength);
+        event.detail[MaxDetailLength] = '\0';
+    }
+    else
+    {
+        event.detail[0] = '\0';
+    }
+}
+
+void TraceCollector::recordCounter(const char* name, double value)
+{
+    auto& buffer = getBufferForCurrentThread();
+
+    std::lock_guard<std::mutex> lock(buffer.lock);
+
+    auto& event = allocateEvent(buffer);
+
+    event.type = Event::Type::Counter;
+    event.category = "counter";
+    event.name = name;
+    event.detail[0] = '\0';
+    event.timestamp = getMicroseconds(Clock::now());
+    event.value = value;
+}
+
+void TraceCollector::exportChromeTrace(std::ostream& stream)
+{
+    std::lock_guard<std::mutex> lock(_buffersLock);
+
+    stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    bool first = true;
+
+    auto beginEvent = [&]()
+    {
+        stream << (first ? "\n" : ",\n");
+        first = false;
+    };
+
+    for (const auto& buffer : _buffers)
+    {
+        std::lock_guard<std::mutex> bufferLock(buffer->lock);
+
+        // Metadata event naming the thread
+        beginEvent();
+        stream << fmt::format("{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{0},\"args\":{{\"name\":", buffer->threadIndex);
+        writeJsonString(stream, buffer->isMainThread ? "Main Thread" :
+            fmt::format("Thread {0}", buffer->threadIndex).c_str());
+        stream << "}}";
+
+        // Start with the oldest event if the ring buffer has wrapped around
+        auto numEvents = buffer->events.size();
+        auto firstEvent = buffer->wrapped ? buffer->nextEvent : 0;
+
+        for (std::size_t i = 0; i < numEvents; ++i)
+        {
+            const auto& event = buffer->events[(firstEvent + i) % buffer->events.size()];
+
+            beginEvent();
+            stream << "{\"name\":";
+            writeJsonString(stream, event.name);
+            stream << ",\"cat\":";
+            writeJsonString(stream, event.category);
+
+            if (event.type == Event::Type::Zone)
+            {
+                stream << fmt::format(",\"ph\":\"X\",\"pid\":1,\"tid\":{0},\"ts\":{1:.3f},\"dur\":{2:.3f}",
+                    buffer->threadIndex, event.timestamp, event.value);
+
+                if (event.detail[0] != '\0')
+                {
+                    stream << ",\"args\":{\"detail\":";
+                    writeJsonString(stream, event.detail);
+                    stream << "}";
+                }
+            }
+            else
+            {
+                // JSON has no representation for NaN or infinity
+                stream << fmt::format(",\"ph\":\"C\",\"pid\":1,\"tid\":{0},\"ts\":{1:.3f},\"args\":{{\"value\":{2}}}",
+                    buffer->threadIndex, event.timestamp,
+                    std::isfinite(event.value) ? fmt::format("{0}", event.value) : "null");
+            }
+
+            stream << "}";
+        }
+    }
+
+    stream << "\n]}\n";
+}
+
+TraceCollector::ThreadBuffer& TraceCollector::getBufferForCurrentThread()
+{
+    auto& cache = CurrentThreadBuffer;
+
+    if (cache.instanceId == _instanceId)
+    {
+        return *static_cast<ThreadBuffer*>(cache.buffer);
+    }
+
+    // Hand back a buffer this thread might have been using for another collector
+    cache.release();
+
+    auto isMainThread = std::this_thread::get_id() == _mainThreadId;
+    ThreadBuffer* buffer = nullptr;
+
+    {
+        std::lock_guard<std::mutex> lock(_buffersLock);
+
+        // Reuse the buffer of a thread that has exited, such that short-lived
+        // worker threads don't allocate a new buffer each
+        if (!isMainThread)
+        {
+            for (const auto& candidate : _buffers)
+            {
+                auto expected = false;
+
+                if (candidate->inUse->compare_exchange_strong(expected, true))
+                {
+                    buffer = candidate.get();
+                    break;
+                }
+            }
+        }
+
+        // First event recorded by this thread, allocate a new buffer
+        if (buffer == nullptr)
+        {
+            auto newBuffer = std::make_shared<ThreadBuffer>();
+            newBuffer->isMainThread = isMainThread;
+            newBuffer->threadIndex = _buffers.size() + 1;
+            _buffers.push_back(newBuffer);
+
+            buffer = newBuffer.get();
+        }
+    }
+
+    cache.instanceId = _instanceId;
+    cache.buffer = buffer;
+    cache.bufferInUse = buffer->inUse;
+
+    return *buffer;
+}
+
+TraceCollector::Event& TraceCollector::allocateEvent(ThreadBuffer& buffer)
+{
+    // Grow the buffer until it reached its capacity, then start overwriting
+    if (!buffer.wrapped)
+    {
+        buffer.events.emplace_back();
+        buffer.wrapped = buffer.events.size() == EventsPerThread;
+
+        return buffer.events.back();
+    }
+
+    auto& event = buffer.events[buffer.nextEvent];
+    buffer.nextEvent = (buffer.nextEvent + 1) % EventsPerThread;
+
+    return event;
+}
+
+double TraceCollector::getMicroseconds(Clock::time_point time) const
+{
+    return std::chrono::duration<double, std::micro>(time - _epoch).count();
+}
+
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "itracecollector.h"
+
+namespace profiling
+{
+
+class TraceCollector :
+    public ITraceCollector
+{
+public:
+    // Number of events kept per thread before the oldest ones are overwritten
+    static constexpr std::size_t EventsPerThread = 1 << 15;
+
+    // Maximum length of the detail string stored along with a zone
+    static constexpr std::size_t MaxDetailLength = 47;
+
+private:
+    struct Event
+    {
+        enum class Type : std::uint8_t
+        {
+            Zone,
+            Counter,
+        };
+
+        Type type;
+        const char* category;
+        const char* name;
+        char detail[MaxDetailLength + 1];
+
+        // Microseconds since the collector's epoch
+        double timestamp;
+
+        // Zone duration in microseconds, or the counter value
+        double value;
+    };
+
+    // Ring buffer owned by a single recording thread. The lock is only
+    // contended while exporting or clearing.
+    struct ThreadBuffer
+    {
+        std::mutex lock;
+        std::size_t threadIndex;
+        bool isMainThread;
+        std::vector<Event> events;
+
+        // Cleared when the owning thread exits, the buffer (and its thread index)
+        // is then reused by the next thread starting to record events. The flag is
+        // shared with the thread, it might outlive the collector.
+        std::shared_ptr<std::atomic<bool>> inUse = std::make_shared<std::atomic<bool>>(true);
+
+        // Once the buffer is full (wrapped), this is the oldest event
+        // which is going to be overwritten next
+        std::size_t nextEvent = 0;
+        bool wrapped = false;
+    };
+
+    // Identifies this collector instance in the thread-local buffer cache
+    const std::uint64_t _instanceId;
+
+    std::atomic<bool> _enabled;
+
+    Clock::time_point _epoch;
+    std::thread::id _mainThreadId;
+
+    std::mutex _buffersLock;
+    std::vector<std::shared_ptr<ThreadBuffer>> _buffers;
+
+public:
+    TraceCollector();
+
+    bool isEnabled() const override;
+    void setEnabled(bool enabled) override;
+    void clear() override;
+
+    void recordZone(const char* category, const char* name, const char* detail,
+        Clock::time_point start, Clock::time_point end) override;
+    void recordCounter(const char* name, double value) override;
+
+    void exportChromeTrace(std::ostream& stream) override;
+
+private:
+    ThreadBuffer& getBufferForCurrentThread();
+    Event& allocateEvent(ThreadBuffer& buffer);
+    double getMicroseconds(Clock::time_point time) const;
+};
+
+}
@@ -0,0 +1,92 @@
+#include "i18n.h"
+#include "icommandsystem.h"
+#include "itracecollector.h"
+#include "itextstream.h"
+
+#include <fstream>
+#include "os/path.h"
+#include "module/StaticModule.h"
+#include "messages/NotificationMessage.h"
+#include <fmt/format.h>
+
+namespace profiling
+{
+
+/**
+ * Registers the commands controlling the performance trace:
+ *
+ * StartTrace: discards any previous events and starts recording
+ * StopTrace: stops recording, the events are kept for exporting
+ * ExportTrace [path]: writes the recorded events in Chrome trace format,
+ *                     by default to darkradiant_trace.json in the cache folder
+ */
+class TraceCommandsModule :
+    public RegisterableModule
+{
+public:
+    const std::string& getName() const override
+    {
+        static std::string _name("TraceCommands");
+        return _name;
+    }
+
+    const StringSet& getDependencies() const override
+    {
+        static StringSet _dependencies;
+
+        if (_dependencies.empty())
+        {
+            _dependencies.insert(MODULE_COMMANDSYSTEM);
+        }
+
+        return _dependencies;
+    }
+
+    void initialiseModule(const IApplicationContext& ctx) override
+    {
+        rMessage() << getName() << "::initialiseModule called." << std::endl;
+
+        GlobalCommandSystem().addCommand("StartTrace", std::bind(&TraceCommandsModule::startTrace, this, std::placeholders::_1));
+        GlobalCommandSystem().addCommand("StopTrace", std::bind(&TraceCommandsModule::stopTrace, this, std::placeholders::_1));
+        GlobalCommandSystem().addCommand("ExportTrace", std::bind(&TraceCommandsModule::exportTrace, this, std::placeholders::_1),
+            { cmd::ARGTYPE_STRING | cmd::ARGTYPE_OPTIONAL });
+    }
+
+private:
+    void startTrace(const cmd::ArgumentList& args)
+    {
+        GlobalTraceCollector().clear();
+        GlobalTraceCollector().setEnabled(true);
+
+        rMessage() << "Performance trace started." << std::endl;
+    }
+
+    void stopTrace(const cmd::ArgumentList& args)
+    {
+        GlobalTraceCollector().setEnabled(false);
+
+        rMessage() << "Performance trace stopped." << std::endl;
+    }
+
+    void exportTrace(const cmd::ArgumentList& args)
+    {
+        auto path = !args.empty() && !args[0].getString().empty() ? args[0].getString() :
+            os::standardPathWithSlash(module::GlobalModuleRegistry().getApplicationContext().getCacheDataPath()) + "darkradiant_trace.json";
+
+        std::ofstream stream(path);
+
+        if (!stream.good())
+        {
+            radiant::NotificationMessage::SendError(fmt::format(_("Cannot open {0} for writing"), path));
+            return;
+        }
+
+        GlobalTraceCollector().exportChromeTrace(stream);
+
+        rMessage() << "Performance trace exported to " << path << std::endl;
+    }
+};
+
+module::StaticModuleRegistration<TraceCommandsModule> traceCommandsModule;
+
+}
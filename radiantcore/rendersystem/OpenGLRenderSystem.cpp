@@ -31,7 +31,7 @@ OpenGLRenderSystem::OpenGLRenderSystem() :
     _currentShaderProgram(SHADER_PROGRAM_NONE),
     _time(0),
     _geometryStore(_syncObjectProvider, _bufferObjectProvider),
-    _objectRenderer(_geometryStore),
+    _objectRenderer(_geometryStore, _bufferObjectProvider),
     m_traverseRenderablesMutex(false)
 {
     bool shouldRealise = false;
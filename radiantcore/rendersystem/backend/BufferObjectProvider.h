@@ -23,7 +23,7 @@ private:
         BufferObject(IBufferObject::Type type) :
             _type(type),
             _buffer(0),
-            _target(_type == Type::Vertex ? GL_ARRAY_BUFFER : GL_ELEMENT_ARRAY_BUFFER)
+            _target(GetTarget(type))
         {}
 
         ~BufferObject()
@@ -73,6 +73,19 @@ private:
 
             glBindBuffer(_target, 0);
         }
+
+    private:
+        static GLenum GetTarget(IBufferObject::Type type)
+        {
+            switch (type)
+            {
+            case Type::Vertex: return GL_ARRAY_BUFFER;
+            case Type::Index: return GL_ELEMENT_ARRAY_BUFFER;
+            case Type::DrawIndirect: return GL_DRAW_INDIRECT_BUFFER;
+            }
+
+            throw std::logic_error("Unknown buffer object type");
+        }
     };
 
 public:
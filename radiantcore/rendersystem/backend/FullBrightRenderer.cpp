@@ -2,6 +2,8 @@
 
 #include "OpenGLShaderPass.h"
 #include "OpenGLShader.h"
+#include "fmt/format.h"
+#include "debugging/ScopedTraceZone.h"
 
 namespace render
 {
@@ -47,6 +49,7 @@ IRenderResult::Ptr FullBrightRenderer::render(RenderStateFlags globalstate, cons
 
     // Set the attribute pointers
     _objectRenderer.initAttributePointers();
+    _objectRenderer.resetDrawCallCount();
 
     // Iterate over the sorted mapping between OpenGLStates and their
     // OpenGLShaderPasses (containing the renderable geometry), and render the
@@ -83,7 +86,10 @@ IRenderResult::Ptr FullBrightRenderer::render(RenderStateFlags globalstate, cons
 
     cleanupState();
 
-    return std::make_shared<FullBrightRenderResult>(view.getCullStats());
+    profiling::recordTraceCounter("render.drawCalls", static_cast<double>(_objectRenderer.getDrawCallCount()));
+
+    return std::make_shared<FullBrightRenderResult>(
+        fmt::format("{0} | Draws: {1}", view.getCullStats(), _objectRenderer.getDrawCallCount()));
 }
 
 }
@@ -1,13 +1,183 @@
 #include "InteractingLight.h"
 
+#include <optional>
 #include "OpenGLShader.h"
 #include "ObjectRenderer.h"
 #include "glprogram/DepthFillAlphaProgram.h"
+#include "glprogram/InteractionProgram.h"
 #include "glprogram/ShadowMapProgram.h"
 
 namespace render
 {
 
+namespace
+{
+
+// Collects objects along with their object transforms, such that objects of
+// different entities can be submitted in a single draw call
+class ObjectBatch
+{
+private:
+    std::vector<IGeometryStore::Slot> _slots;
+    std::vector<Matrix4> _transforms;
+
+public:
+    void add(IRenderableObject& object)
+    {
+        _slots.push_back(object.getStorageLocation());
+        _transforms.push_back(object.isOriented() ? object.getObjectTransform() : Matrix4::getIdentity());
+    }
+
+    // Draws all pending objects, returns the number of submitted batches (0 or 1)
+    std::size_t submit(IObjectRenderer& renderer, int numInstances)
+    {
+        if (_slots.empty()) return 0;
+
+        renderer.submitOrientedObjects(_slots, _transforms, numInstances);
+
+        _slots.clear();
+        _transforms.clear();
+
+        return 1;
+    }
+};
+
+// The evaluated alpha test of a material, as needed by the depth fill and shadow map programs
+struct AlphaTestParameters
+{
+    float value = -1; // -1 deactivates the alpha test
+    GLint texture = 0;
+    Matrix4 textureTransform = Matrix4::getIdentity();
+
+    bool operator==(const AlphaTestParameters& other) const
+    {
+        return value == other.value && texture == other.texture && textureTransform == other.textureTransform;
+    }
+
+    bool operator!=(const AlphaTestParameters& other) const
+    {
+        return !operator==(other);
+    }
+};
+
+// The alpha test value might be affected by time and entity parms
+AlphaTestParameters evaluateAlphaTest(OpenGLShader* shader, DepthFillPass* depthFillPass,
+    std::size_t renderTime, IRenderEntity* entity)
+{
+    const auto& material = shader->getMaterial();
+    assert(material);
+
+    AlphaTestParameters parameters;
+
+    if (material->getCoverage() == Material::MC_PERFORATED && depthFillPass != nullptr)
+    {
+        // Evaluate the shader stages of this material
+        depthFillPass->evaluateShaderStages(renderTime, entity);
+
+        parameters.value = depthFillPass->getAlphaTestValue();
+        parameters.texture = depthFillPass->state().texture0;
+        parameters.textureTransform = depthFillPass->getDiffuseTextureTransform();
+    }
+
+    return parameters;
+}
+
+void applyAlphaTest(OpenGLState& state, const AlphaTestParameters& parameters, ISupportsAlphaTest& program)
+{
+    // Passing -1 deactivates texture sampling in the GLSL program
+    program.setAlphaTest(parameters.value);
+
+    if (parameters.value < 0) return;
+
+    // If there's a diffuse stage, apply the correct texture
+    OpenGLState::SetTextureState(state.texture0, parameters.texture, GL_TEXTURE0, GL_TEXTURE_2D);
+
+    // Set evaluated stage texture transformation matrix to the GLSL uniform
+    program.setDiffuseTextureTransform(parameters.textureTransform);
+}
+
+// The evaluated stages of an interaction pass
+struct InteractionStageParameters
+{
+    float alphaTest; // -1 if the diffuse stage has no alpha test
+    GLint diffuseTexture;
+    GLint bumpTexture;
+    GLint specularTexture;
+    Matrix4 diffuseTextureTransform;
+    Matrix4 bumpTextureTransform;
+    Matrix4 specularTextureTransform;
+    IShaderLayer::VertexColourMode vertexColourMode;
+    Colour4 stageColour;
+
+    bool operator==(const InteractionStageParameters& other) const
+    {
+        return alphaTest == other.alphaTest &&
+            diffuseTexture == other.diffuseTexture &&
+            bumpTexture == other.bumpTexture &&
+            specularTexture == other.specularTexture &&
+            diffuseTextureTransform == other.diffuseTextureTransform &&
+            bumpTextureTransform == other.bumpTextureTransform &&
+            specularTextureTransform == other.specularTextureTransform &&
+            vertexColourMode == other.vertexColourMode &&
+            stageColour == other.stageColour;
+    }
+
+    bool operator!=(const InteractionStageParameters& other) const
+    {
+        return !operator==(other);
+    }
+};
+
+InteractionStageParameters evaluateInteractionStages(InteractionPass& pass, std::size_t renderTime, IRenderEntity* entity)
+{
+    // Evaluate the expressions in the material stages
+    pass.evaluateShaderStages(renderTime, entity);
+
+    const auto& state = pass.state();
+
+    return InteractionStageParameters
+    {
+        state.stage0 && state.stage0->hasAlphaTest() ? state.stage0->getAlphaTest() : -1.0f,
+        state.texture0,
+        state.texture1,
+        state.texture2,
+        pass.getDiffuseTextureTransform(),
+        pass.getBumpTextureTransform(),
+        pass.getSpecularTextureTransform(),
+        state.getVertexColourMode(),
+        state.stage0 ? state.stage0->getColour() : Colour4::WHITE()
+    };
+}
+
+void applyInteractionStages(OpenGLState& state, const InteractionStageParameters& parameters, InteractionProgram& program)
+{
+    // Enable alphatest if required
+    if (parameters.alphaTest >= 0)
+    {
+        glEnable(GL_ALPHA_TEST);
+        glAlphaFunc(GL_GEQUAL, parameters.alphaTest);
+    }
+    else
+    {
+        glDisable(GL_ALPHA_TEST);
+    }
+
+    // Bind textures
+    OpenGLState::SetTextureState(state.texture0, parameters.diffuseTexture, GL_TEXTURE0, GL_TEXTURE_2D);
+    OpenGLState::SetTextureState(state.texture1, parameters.bumpTexture, GL_TEXTURE1, GL_TEXTURE_2D);
+    OpenGLState::SetTextureState(state.texture2, parameters.specularTexture, GL_TEXTURE2, GL_TEXTURE_2D);
+
+    // Load stage texture matrices
+    program.setDiffuseTextureTransform(parameters.diffuseTextureTransform);
+    program.setBumpTextureTransform(parameters.bumpTextureTransform);
+    program.setSpecularTextureTransform(parameters.specularTextureTransform);
+
+    // Vertex colour mode and diffuse stage colour setup for this pass
+    program.setStageVertexColour(parameters.vertexColourMode, parameters.stageColour);
+}
+
+}
+
 InteractingLight::InteractingLight(RendererLight& light, IGeometryStore& store, IObjectRenderer& objectRenderer) :
     _light(light),
     _store(store),
@@ -25,13 +195,14 @@ InteractingLight::InteractingLight(RendererLight& light, IGeometryStore& store,
 
 void InteractingLight::addObject(IRenderableObject& object, IRenderEntity& entity, OpenGLShader* shader)
 {
-    auto& objectsByMaterial = _objectsByEntity.emplace(
-        &entity, ObjectsByMaterial{}).first->second;
+    auto& objectsByEntity = _objectsByMaterial.emplace(
+        shader, ObjectsByEntity{}).first->second;
 
-    auto& surfaces = objectsByMaterial.emplace(
-        shader, ObjectList{}).first->second;
+    auto& surfaces = objectsByEntity.emplace(
+        &entity, ObjectList{}).first->second;
 
     surfaces.emplace_back(std::ref(object));
+    _entities.insert(&entity);
 
     ++_objectCount;
 }
@@ -100,55 +271,62 @@ void InteractingLight::collectSurfaces(const IRenderView& view, const std::set<I
 void InteractingLight::fillDepthBuffer(OpenGLState& state, DepthFillAlphaProgram& program, 
     std::size_t renderTime, std::vector<IGeometryStore::Slot>& untransformedObjectsWithoutAlphaTest)
 {
-    std::vector<IGeometryStore::Slot> untransformedObjects;
-    untransformedObjects.reserve(1000);
+    // Oriented objects without alpha test are drawn in a single batch at the end
+    ObjectBatch objectsWithoutAlphaTest;
 
-    for (const auto& [entity, objectsByShader] : _objectsByEntity)
+    // Alpha-tested objects are batched as long as their alpha test evaluates to the same parameters
+    ObjectBatch alphaTestedObjects;
+    std::optional<AlphaTestParameters> currentAlphaTest;
+
+    for (const auto& [shader, objectsByEntity] : _objectsByMaterial)
     {
-        for (const auto& [shader, objects] : objectsByShader)
-        {
-            auto depthFillPass = shader->getDepthFillPass();
+        auto depthFillPass = shader->getDepthFillPass();
 
-            if (!depthFillPass) continue;
+        if (!depthFillPass) continue;
 
-            setupAlphaTest(state, shader, depthFillPass, program, renderTime, entity);
+        auto isPerforated = shader->getMaterial()->getCoverage() == Material::MC_PERFORATED;
 
-            for (const auto& object : objects)
+        for (const auto& [entity, objects] : objectsByEntity)
+        {
+            if (!isPerforated)
             {
-                // We submit all objects with an identity matrix in a single multi draw call
-                if (!object.get().isOriented())
+                for (const auto& object : objects)
                 {
-                    if (shader->getMaterial()->getCoverage() == Material::MC_PERFORATED)
+                    if (object.get().isOriented())
                     {
-                        untransformedObjects.push_back(object.get().getStorageLocation());
+                        objectsWithoutAlphaTest.add(object.get());
                     }
                     else
                     {
                         // Put it on the huge pile of non-alphatest materials
                         untransformedObjectsWithoutAlphaTest.push_back(object.get().getStorageLocation());
                     }
-
-                    continue;
                 }
 
-                program.setObjectTransform(object.get().getObjectTransform());
-
-                _objectRenderer.submitGeometry(object.get().getStorageLocation(), GL_TRIANGLES);
-                ++_depthDrawCalls;
+                continue;
             }
 
-            // All alpha-tested materials without transform need to be submitted now
-            if (!untransformedObjects.empty())
+            auto alphaTest = evaluateAlphaTest(shader, depthFillPass, renderTime, entity);
+
+            if (!currentAlphaTest || alphaTest != *currentAlphaTest)
             {
-                program.setObjectTransform(Matrix4::getIdentity());
+                _depthDrawCalls += alphaTestedObjects.submit(_objectRenderer, 1);
 
-                _objectRenderer.submitGeometry(untransformedObjects, GL_TRIANGLES);
-                ++_depthDrawCalls;
+                applyAlphaTest(state, alphaTest, program);
+                currentAlphaTest = alphaTest;
+            }
 
-                untransformedObjects.clear();
+            for (const auto& object : objects)
+            {
+                alphaTestedObjects.add(object.get());
             }
         }
     }
+
+    _depthDrawCalls += alphaTestedObjects.submit(_objectRenderer, 1);
+
+    program.setAlphaTest(-1);
+    _depthDrawCalls += objectsWithoutAlphaTest.submit(_objectRenderer, 1);
 }
 
 void InteractingLight::drawShadowMap(OpenGLState& state, const Rectangle& rectangle, 
@@ -157,8 +335,8 @@ void InteractingLight::drawShadowMap(OpenGLState& state, const Rectangle& rectan
     // Set up the viewport to write to a specific area within the shadow map texture
     glViewport(rectangle.x, rectangle.y, 6 * rectangle.width, rectangle.width);
 
-    std::vector<IGeometryStore::Slot> untransformedObjects;
-    untransformedObjects.reserve(1000);
+    ObjectBatch shadowCastingObjects;
+    std::optional<AlphaTestParameters> currentAlphaTest;
 
     program.setLightOrigin(_light.getLightOrigin());
 
@@ -166,174 +344,91 @@ void InteractingLight::drawShadowMap(OpenGLState& state, const Rectangle& rectan
     program.setDiffuseTextureTransform(Matrix4::getIdentity());
 
     // Render all the objects that have a depth filling stage
-    for (const auto& [entity, objectsByShader] : _objectsByEntity)
+    for (const auto& [shader, objectsByEntity] : _objectsByMaterial)
     {
-        if (!entity->isShadowCasting()) continue; // skip all entities with "noshadows" set
+        const auto& material = shader->getMaterial();
 
-        for (const auto& [shader, objects] : objectsByShader)
-        {
-            const auto& material = shader->getMaterial();
+        // Skip materials not casting any shadow. This includes all
+        // translucent materials, they get the noshadows flag set implicitly
+        if (!material->surfaceCastsShadow()) continue;
 
-            // Skip materials not casting any shadow. This includes all
-            // translucent materials, they get the noshadows flag set implicitly
-            if (!material->surfaceCastsShadow()) continue;
+        for (const auto& [entity, objects] : objectsByEntity)
+        {
+            if (!entity->isShadowCasting()) continue; // skip all entities with "noshadows" set
 
             // Set up alphatest (it's ok to pass a nullptr as depth fill pass)
-            setupAlphaTest(state, shader, shader->getDepthFillPass(), program, renderTime, entity);
+            auto alphaTest = evaluateAlphaTest(shader, shader->getDepthFillPass(), renderTime, entity);
 
-            for (const auto& object : objects)
+            if (!currentAlphaTest || alphaTest != *currentAlphaTest)
             {
-                // Skip models with "noshadows" set (this might be redundant to the entity check above)
-                if (!object.get().isShadowCasting()) continue;
+                // Every object is drawn once for each of the 6 cube map faces
+                _shadowMapDrawCalls += shadowCastingObjects.submit(_objectRenderer, 6);
 
-                // We submit all objects with an identity matrix in a single multi draw call
-                if (!object.get().isOriented())
-                {
-                    untransformedObjects.push_back(object.get().getStorageLocation());
-                    continue;
-                }
-
-                program.setObjectTransform(object.get().getObjectTransform());
-
-                _objectRenderer.submitInstancedGeometry(object.get().getStorageLocation(), 6, GL_TRIANGLES);
-                ++_shadowMapDrawCalls;
+                applyAlphaTest(state, alphaTest, program);
+                currentAlphaTest = alphaTest;
             }
 
-            if (!untransformedObjects.empty())
+            for (const auto& object : objects)
             {
-                program.setObjectTransform(Matrix4::getIdentity());
-
-                _objectRenderer.submitInstancedGeometry(untransformedObjects, 6, GL_TRIANGLES);
-                ++_shadowMapDrawCalls;
+                // Skip models with "noshadows" set (this might be redundant to the entity check above)
+                if (!object.get().isShadowCasting()) continue;
 
-                untransformedObjects.clear();
+                shadowCastingObjects.add(object.get());
             }
         }
     }
 
+    _shadowMapDrawCalls += shadowCastingObjects.submit(_objectRenderer, 6);
+
     debug::assertNoGlErrors();
 }
 
 void InteractingLight::drawInteractions(OpenGLState& state, InteractionProgram& program, 
     const IRenderView& view, std::size_t renderTime)
 {
-    if (_objectsByEntity.empty())
+    if (_objectsByMaterial.empty())
     {
         return;
     }
 
-    auto worldLightOrigin = _light.getLightOrigin();
-
-    std::vector<IGeometryStore::Slot> untransformedObjects;
-    untransformedObjects.reserve(10000);
-
     // Set up textures used by this light
     program.setupLightParameters(state, _light, renderTime);
+    program.setLightAndViewOrigin(_light.getLightOrigin(), view.getViewer());
 
-    for (const auto& [entity, objectsByShader] : _objectsByEntity)
-    {
-        for (const auto& [shader, objects] : objectsByShader)
-        {
-            const auto pass = shader->getInteractionPass();
-
-            if (!pass || !pass->stateIsActive()) continue;
-
-            // Evaluate the expressions in the material stages
-            pass->evaluateShaderStages(renderTime, entity);
+    // Objects are batched as long as the interaction stages evaluate to the same parameters
+    ObjectBatch interactingObjects;
+    std::optional<InteractionStageParameters> currentStages;
 
-            // Enable alphatest if required
-            if (pass->state().stage0 && pass->state().stage0->hasAlphaTest())
-            {
-                glEnable(GL_ALPHA_TEST);
-                glAlphaFunc(GL_GEQUAL, pass->state().stage0->getAlphaTest());
-            }
-            else
-            {
-                glDisable(GL_ALPHA_TEST);
-            }
-
-            // Bind textures
-            OpenGLState::SetTextureState(state.texture0, pass->state().texture0, GL_TEXTURE0, GL_TEXTURE_2D);
-            OpenGLState::SetTextureState(state.texture1, pass->state().texture1, GL_TEXTURE1, GL_TEXTURE_2D);
-            OpenGLState::SetTextureState(state.texture2, pass->state().texture2, GL_TEXTURE2, GL_TEXTURE_2D);
+    for (const auto& [shader, objectsByEntity] : _objectsByMaterial)
+    {
+        auto pass = shader->getInteractionPass();
 
-            // Load stage texture matrices
-            program.setDiffuseTextureTransform(pass->getDiffuseTextureTransform());
-            program.setBumpTextureTransform(pass->getBumpTextureTransform());
-            program.setSpecularTextureTransform(pass->getSpecularTextureTransform());
+        if (!pass || !pass->stateIsActive()) continue;
 
-            // Vertex colour mode and diffuse stage colour setup for this pass
-            program.setStageVertexColour(pass->state().getVertexColourMode(), 
-                pass->state().stage0 ? pass->state().stage0->getColour() : Colour4::WHITE());
+        for (const auto& [entity, objects] : objectsByEntity)
+        {
+            auto stages = evaluateInteractionStages(*pass, renderTime, entity);
 
-            for (const auto& object : objects)
+            if (!currentStages || stages != *currentStages)
             {
-                // We submit all objects with an identity matrix in a single multi draw call
-                if (!object.get().isOriented())
-                {
-                    untransformedObjects.push_back(object.get().getStorageLocation());
-                    continue;
-                }
-
-                program.setUpObjectLighting(worldLightOrigin, view.getViewer(), 
-                    object.get().getObjectTransform().getInverse());
+                _interactionDrawCalls += interactingObjects.submit(_objectRenderer, 1);
 
-                pass->getProgram().setObjectTransform(object.get().getObjectTransform());
-
-                _objectRenderer.submitGeometry(object.get().getStorageLocation(), GL_TRIANGLES);
-                ++_interactionDrawCalls;
+                applyInteractionStages(state, stages, program);
+                currentStages = stages;
             }
 
-            if (!untransformedObjects.empty())
+            for (const auto& object : objects)
             {
-                program.setUpObjectLighting(worldLightOrigin, view.getViewer(), Matrix4::getIdentity());
-
-                pass->getProgram().setObjectTransform(Matrix4::getIdentity());
-
-                _objectRenderer.submitGeometry(untransformedObjects, GL_TRIANGLES);
-                ++_interactionDrawCalls;
-
-                untransformedObjects.clear();
+                interactingObjects.add(object.get());
             }
         }
     }
 
+    _interactionDrawCalls += interactingObjects.submit(_objectRenderer, 1);
+
     // Unbind the light textures
     OpenGLState::SetTextureState(state.texture3, 0, GL_TEXTURE3, GL_TEXTURE_2D);
     OpenGLState::SetTextureState(state.texture4, 0, GL_TEXTURE4, GL_TEXTURE_2D);
 }
 
-void InteractingLight::setupAlphaTest(OpenGLState& state, OpenGLShader* shader, DepthFillPass* depthFillPass,
-    ISupportsAlphaTest& program, std::size_t renderTime, IRenderEntity* entity)
-{
-    const auto& material = shader->getMaterial();
-    assert(material);
-
-    auto coverage = material->getCoverage();
-
-    // Skip translucent materials
-    if (coverage == Material::MC_TRANSLUCENT) return;
-
-    if (coverage == Material::MC_PERFORATED && depthFillPass != nullptr)
-    {
-        // Evaluate the shader stages of this material
-        depthFillPass->evaluateShaderStages(renderTime, entity);
-
-        // Apply the alpha test value, it might be affected by time and entity parms
-        program.setAlphaTest(depthFillPass->getAlphaTestValue());
-
-        // If there's a diffuse stage, apply the correct texture
-        OpenGLState::SetTextureState(state.texture0, depthFillPass->state().texture0, GL_TEXTURE0, GL_TEXTURE_2D);
-
-        // Set evaluated stage texture transformation matrix to the GLSL uniform
-        program.setDiffuseTextureTransform(depthFillPass->getDiffuseTextureTransform());
-    }
-    else
-    {
-        // No alpha test on this material, pass -1 to deactivate texture sampling
-        // in the GLSL program
-        program.setAlphaTest(-1);
-    }
-}
-
 }
@@ -17,14 +17,15 @@ class OpenGLShader;
 class DepthFillAlphaProgram;
 class InteractionProgram;
 class ShadowMapProgram;
-class DepthFillPass;
 
 /**
  * Defines interactions between a light and one or more entity renderables
  * It only lives through the course of a single render pass, therefore direct
  * references without ref-counting are used.
  * 
- * Objects are grouped by entity, then by shader.
+ * Objects are grouped by shader, then by entity. Objects of the same shader
+ * are submitted in shared draw calls across entities, as long as the
+ * material stages evaluate to the same parameters for each entity.
  */
 class InteractingLight
 {
@@ -37,11 +38,14 @@ private:
     // A flat list of renderables
     using ObjectList = std::vector<std::reference_wrapper<IRenderableObject>>;
 
-    // All objects, grouped by material
-    using ObjectsByMaterial = std::map<OpenGLShader*, ObjectList>;
+    // All objects, grouped by entity
+    using ObjectsByEntity = std::map<IRenderEntity*, ObjectList>;
 
-    // object mappings, grouped by entity
-    std::map<IRenderEntity*, ObjectsByMaterial> _objectsByEntity;
+    // object mappings, grouped by material
+    std::map<OpenGLShader*, ObjectsByEntity> _objectsByMaterial;
+
+    // All entities owning at least one of the objects
+    std::set<IRenderEntity*> _entities;
 
     std::size_t _interactionDrawCalls;
     std::size_t _depthDrawCalls;
@@ -96,7 +100,7 @@ public:
 
     std::size_t getEntityCount() const
     {
-        return _objectsByEntity.size();
+        return _entities.size();
     }
 
     void addObject(IRenderableObject& object, IRenderEntity& entity, OpenGLShader* shader);
@@ -113,9 +117,6 @@ public:
     void drawShadowMap(OpenGLState& state, const Rectangle& rectangle, ShadowMapProgram& program, std::size_t renderTime);
 
     void drawInteractions(OpenGLState& state, InteractionProgram& program, const IRenderView& view, std::size_t renderTime);
-
-    void setupAlphaTest(OpenGLState& state, OpenGLShader* shader, DepthFillPass* depthFillPass,
-        ISupportsAlphaTest& alphaTestProgram, std::size_t renderTime, IRenderEntity* entity);
 };
 
 }
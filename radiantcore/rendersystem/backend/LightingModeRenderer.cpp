@@ -11,6 +11,7 @@
 #include "glprogram/DepthFillAlphaProgram.h"
 #include "glprogram/InteractionProgram.h"
 #include "glprogram/RegularStageProgram.h"
+#include "debugging/ScopedTraceZone.h"
 
 namespace render
 {
@@ -82,6 +83,7 @@ IRenderResult::Ptr LightingModeRenderer::render(RenderStateFlags globalFlagsMask
 
     // Set the vertex attribute pointers
     _objectRenderer.initAttributePointers();
+    _objectRenderer.resetDrawCallCount();
 
     // Render depth information to the shadow maps
     drawShadowMaps(current, time);
@@ -98,6 +100,9 @@ IRenderResult::Ptr LightingModeRenderer::render(RenderStateFlags globalFlagsMask
     // Draw any surfaces without any light interactions
     drawNonInteractionPasses(current, globalFlagsMask, view, time);
 
+    _result->glDrawCalls = _objectRenderer.getDrawCallCount();
+    profiling::recordTraceCounter("render.drawCalls", static_cast<double>(_result->glDrawCalls));
+
     vertexBuffer->unbind();
     indexBuffer->unbind();
 
@@ -1,13 +1,57 @@
 #include "ObjectRenderer.h"
 
+#include <cassert>
+#include <cstdint>
+
 #include "math/Matrix4.h"
 #include "render/RenderVertex.h"
+#include "glprogram/GLSLProgramBase.h"
 
 namespace render
 {
 
-ObjectRenderer::ObjectRenderer(IGeometryStore& store) :
-    _store(store)
+namespace
+{
+
+// Memory layout of a single glMultiDrawElementsIndirect command as defined by the GL spec
+struct DrawElementsIndirectCommand
+{
+    GLuint count;
+    GLuint instanceCount;
+    GLuint firstIndex;
+    GLint baseVertex;
+    GLuint baseInstance;
+};
+
+// Floats per object in the transform buffer: the object transform (4 columns),
+// followed by the first three rows of its inverse
+constexpr std::size_t FloatsPerObjectTransform = 16 + 12;
+
+// Uploads the commands to the given draw indirect buffer and issues them in a single call
+void multiDrawElementsIndirect(IBufferObject& commandBuffer, GLenum primitiveMode,
+    const std::vector<DrawElementsIndirectCommand>& commands)
+{
+    auto numBytes = commands.size() * sizeof(DrawElementsIndirectCommand);
+
+    // Resizing orphans the storage used by the previous draw call
+    commandBuffer.resize(numBytes);
+    commandBuffer.bind();
+    commandBuffer.setData(0, reinterpret_cast<const unsigned char*>(commands.data()), numBytes);
+
+    // With a GL_DRAW_INDIRECT_BUFFER bound, the pointer argument is an offset into that buffer
+    glMultiDrawElementsIndirect(primitiveMode, GL_UNSIGNED_INT, nullptr,
+        static_cast<GLsizei>(commands.size()), 0);
+
+    commandBuffer.unbind();
+}
+
+}
+
+ObjectRenderer::ObjectRenderer(IGeometryStore& store, IBufferObjectProvider& bufferObjectProvider) :
+    _store(store),
+    _objectTransformBuffer(bufferObjectProvider.createBufferObject(IBufferObject::Type::Vertex)),
+    _drawCommandBuffer(bufferObjectProvider.createBufferObject(IBufferObject::Type::DrawIndirect)),
+    _drawCalls(0)
 {}
 
 void ObjectRenderer::submitObject(IRenderableObject& object)
@@ -23,6 +67,140 @@ void ObjectRenderer::submitObject(IRenderableObject& object)
     glPopMatrix();
 }
 
+void ObjectRenderer::submitObjects(const std::vector<IGeometryStore::Slot>& slots, const Matrix4& objectTransform)
+{
+    if (slots.empty()) return;
+
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+    glMultMatrixd(objectTransform);
+
+    submitGeometry(slots, GL_TRIANGLES);
+
+    glPopMatrix();
+}
+
+void ObjectRenderer::submitOrientedObjects(const std::vector<IGeometryStore::Slot>& slots,
+    const std::vector<Matrix4>& objectTransforms, int numInstances)
+{
+    if (slots.empty()) return;
+
+    assert(slots.size() == objectTransforms.size());
+
+    if (!GLEW_ARB_multi_draw_indirect || !GLEW_ARB_base_instance)
+    {
+        // Fall back to one draw call per run of slots sharing their transform
+        std::vector<IGeometryStore::Slot> run;
+
+        for (std::size_t i = 0; i < slots.size(); ++i)
+        {
+            run.push_back(slots[i]);
+
+            if (i + 1 < slots.size() && objectTransforms[i + 1] == objectTransforms[i]) continue;
+
+            GLSLProgramBase::SetObjectTransformAttribute(objectTransforms[i]);
+
+            if (numInstances > 1)
+            {
+                submitInstancedGeometry(run, numInstances, GL_TRIANGLES);
+            }
+            else
+            {
+                submitGeometry(run, GL_TRIANGLES);
+            }
+
+            run.clear();
+        }
+
+        return;
+    }
+
+    // Upload the transforms as column-major float matrices, each followed by the
+    // rows of its inverse, such that the shaders don't need to invert them per vertex
+    _objectTransformData.clear();
+    _objectTransformData.reserve(objectTransforms.size() * FloatsPerObjectTransform);
+
+    for (const auto& transform : objectTransforms)
+    {
+        for (std::size_t i = 0; i < 16; ++i)
+        {
+            _objectTransformData.push_back(static_cast<float>(transform[i]));
+        }
+
+        // Object transforms are affine, the last row of the inverse is always 0,0,0,1
+        auto inverse = transform.getInverse();
+
+        for (std::size_t row = 0; row < 3; ++row)
+        {
+            for (std::size_t column = 0; column < 4; ++column)
+            {
+                _objectTransformData.push_back(static_cast<float>(inverse[column * 4 + row]));
+            }
+        }
+    }
+
+    auto numBytes = _objectTransformData.size() * sizeof(float);
+
+    // Resizing orphans the storage used by the previous batch
+    _objectTransformBuffer->resize(numBytes);
+    _objectTransformBuffer->bind();
+    _objectTransformBuffer->setData(0, reinterpret_cast<const unsigned char*>(_objectTransformData.data()), numBytes);
+
+    // The mat4 attribute occupies four consecutive locations, one per column, the inverse
+    // rows take three more. All instances of a slot share the transform selected by the
+    // command's base instance.
+    for (GLuint i = 0; i < 7; ++i)
+    {
+        auto location = i < 4 ? GLProgramAttribute::ObjectTransform + i : GLProgramAttribute::WorldToObject + i - 4;
+
+        glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, FloatsPerObjectTransform * sizeof(float),
+            reinterpret_cast<const void*>(i * 4 * sizeof(float)));
+        glVertexAttribDivisor(location, static_cast<GLuint>(numInstances));
+        glEnableVertexAttribArray(location);
+    }
+
+    // Restore the vertex buffer binding of the geometry store
+    _store.getBufferObjects().first->bind();
+
+    std::vector<DrawElementsIndirectCommand> commands;
+    commands.reserve(slots.size());
+
+    for (std::size_t i = 0; i < slots.size(); ++i)
+    {
+        auto renderParams = _store.getRenderParameters(slots[i]);
+
+        commands.push_back(DrawElementsIndirectCommand
+        {
+            static_cast<GLuint>(renderParams.indexCount),
+            static_cast<GLuint>(numInstances),
+            static_cast<GLuint>(reinterpret_cast<std::uintptr_t>(renderParams.firstIndex) / sizeof(GLuint)),
+            static_cast<GLint>(renderParams.firstVertex),
+            static_cast<GLuint>(i)
+        });
+    }
+
+    multiDrawElementsIndirect(*_drawCommandBuffer, GL_TRIANGLES, commands);
+    ++_drawCalls;
+
+    for (GLuint i = 0; i < 7; ++i)
+    {
+        auto location = i < 4 ? GLProgramAttribute::ObjectTransform + i : GLProgramAttribute::WorldToObject + i - 4;
+
+        glDisableVertexAttribArray(location);
+        glVertexAttribDivisor(location, 0);
+    }
+}
+
+std::size_t ObjectRenderer::getDrawCallCount() const
+{
+    return _drawCalls;
+}
+
+void ObjectRenderer::resetDrawCallCount()
+{
+    _drawCalls = 0;
+}
+
 void ObjectRenderer::initAttributePointers()
 {
     const RenderVertex* bufferStart = nullptr;
@@ -46,6 +224,7 @@ void ObjectRenderer::submitGeometry(IGeometryStore::Slot slot, GLenum primitiveM
 
     glDrawElementsBaseVertex(primitiveMode, static_cast<GLsizei>(renderParams.indexCount),
         GL_UNSIGNED_INT, renderParams.firstIndex, static_cast<GLint>(renderParams.firstVertex));
+    ++_drawCalls;
 }
 
 void ObjectRenderer::submitInstancedGeometry(IGeometryStore::Slot slot, int numInstances, GLenum primitiveMode)
@@ -54,6 +233,7 @@ void ObjectRenderer::submitInstancedGeometry(IGeometryStore::Slot slot, int numI
 
     glDrawElementsInstancedBaseVertex(primitiveMode, static_cast<GLsizei>(renderParams.indexCount),
         GL_UNSIGNED_INT, renderParams.firstIndex, static_cast<GLint>(numInstances), static_cast<GLint>(renderParams.firstVertex));
+    ++_drawCalls;
 }
 
 void ObjectRenderer::submitGeometryWithCustomIndices(IGeometryStore::Slot slot, GLenum primitiveMode, 
@@ -67,16 +247,17 @@ void ObjectRenderer::submitGeometryWithCustomIndices(IGeometryStore::Slot slot,
 
     glDrawElementsBaseVertex(primitiveMode, static_cast<GLsizei>(indices.size()),
         GL_UNSIGNED_INT, const_cast<unsigned int*>(indices.data()), static_cast<GLint>(renderParams.firstVertex));
+    ++_drawCalls;
 
     indexBuffer->bind();
 }
 
 template<typename ContainerT>
-void SubmitGeometryInternal(const ContainerT& slots, GLenum primitiveMode, IGeometryStore& store)
+std::size_t SubmitGeometryInternal(const ContainerT& slots, GLenum primitiveMode, IGeometryStore& store)
 {
     auto surfaceCount = slots.size();
 
-    if (surfaceCount == 0) return;
+    if (surfaceCount == 0) return 0;
 
     // Build the indices and offsets used for the glMulti draw call
     std::vector<GLsizei> sizes;
@@ -98,24 +279,56 @@ void SubmitGeometryInternal(const ContainerT& slots, GLenum primitiveMode, IGeom
 
     glMultiDrawElementsBaseVertex(primitiveMode, sizes.data(), GL_UNSIGNED_INT,
         firstIndices.data(), static_cast<GLsizei>(sizes.size()), firstVertices.data());
+
+    return 1;
 }
 
 void ObjectRenderer::submitGeometry(const std::set<IGeometryStore::Slot>& slots, GLenum primitiveMode)
 {
-    SubmitGeometryInternal(slots, primitiveMode, _store);
+    _drawCalls += SubmitGeometryInternal(slots, primitiveMode, _store);
 }
 
 void ObjectRenderer::submitGeometry(const std::vector<IGeometryStore::Slot>& slots, GLenum primitiveMode)
 {
-    SubmitGeometryInternal(slots, primitiveMode, _store);
+    _drawCalls += SubmitGeometryInternal(slots, primitiveMode, _store);
 }
 
 void ObjectRenderer::submitInstancedGeometry(const std::vector<IGeometryStore::Slot>& slots, int numInstances, GLenum primitiveMode)
 {
+    if (slots.empty()) return;
+
+    // There's no instanced variant of glMultiDrawElementsBaseVertex, the command list has to go through
+    // the indirect draw path. The commands are read from a buffer object, which core profiles require.
+    if (!GLEW_ARB_multi_draw_indirect)
+    {
+        for (const auto slot : slots)
+        {
+            submitInstancedGeometry(slot, numInstances, primitiveMode);
+        }
+
+        return;
+    }
+
+    std::vector<DrawElementsIndirectCommand> commands;
+    commands.reserve(slots.size());
+
     for (const auto slot : slots)
     {
-        submitInstancedGeometry(slot, numInstances, primitiveMode);
+        auto renderParams = _store.getRenderParameters(slot);
+
+        // The index offset is specified in units of indices instead of bytes
+        commands.push_back(DrawElementsIndirectCommand
+        {
+            static_cast<GLuint>(renderParams.indexCount),
+            static_cast<GLuint>(numInstances),
+            static_cast<GLuint>(reinterpret_cast<std::uintptr_t>(renderParams.firstIndex) / sizeof(GLuint)),
+            static_cast<GLint>(renderParams.firstVertex),
+            0
+        });
     }
+
+    multiDrawElementsIndirect(*_drawCommandBuffer, primitiveMode, commands);
+    ++_drawCalls;
 }
 
 }
@@ -17,8 +17,17 @@ class ObjectRenderer :
 private:
     IGeometryStore& _store;
 
+    // Holds the per-object transforms of the oriented objects batch currently being drawn
+    IBufferObject::Ptr _objectTransformBuffer;
+    std::vector<float> _objectTransformData;
+
+    // Holds the commands of the glMultiDrawElementsIndirect calls
+    IBufferObject::Ptr _drawCommandBuffer;
+
+    std::size_t _drawCalls;
+
 public:
-    ObjectRenderer(IGeometryStore& store);
+    ObjectRenderer(IGeometryStore& store, IBufferObjectProvider& bufferObjectProvider);
 
     // Initialise the vertex attribute pointers using the given start address (can be nullptr)
     void initAttributePointers() override;
@@ -41,8 +50,22 @@ public:
     // Draws all geometry as defined by their store IDs in the given mode, no transforms (std::vector variant)
     void submitGeometry(const std::vector<IGeometryStore::Slot>& slots, GLenum primitiveMode) override;
 
-    // Draws all geometry as defined by their store IDs in the given mode, no transforms (std::vector variant)
+    // Draws the specified number of instances of all given slots in the given mode, no transforms.
+    // Uses a single glMultiDrawElementsIndirect call if the driver supports it.
     void submitInstancedGeometry(const std::vector<IGeometryStore::Slot>& slots, int numInstances, GLenum primitiveMode) override;
+
+    // Draws all given slots with the given object transform in a single draw call
+    void submitObjects(const std::vector<IGeometryStore::Slot>& slots, const Matrix4& objectTransform) override;
+
+    // Draws the given slots with their own object transforms. The transforms are uploaded to a buffer
+    // sourcing the instanced ObjectTransform attribute, picked per slot through the base instance of a
+    // single glMultiDrawElementsIndirect call. Without driver support one draw call is issued for each
+    // run of slots sharing the same transform.
+    void submitOrientedObjects(const std::vector<IGeometryStore::Slot>& slots,
+        const std::vector<Matrix4>& objectTransforms, int numInstances) override;
+
+    std::size_t getDrawCallCount() const override;
+    void resetDrawCallCount() override;
 };
 
 }
@@ -2,10 +2,12 @@
 
 #include <map>
 #include <stdexcept>
+#include <vector>
 #include "irender.h"
 #include "isurfacerenderer.h"
 #include "igeometrystore.h"
 #include "iobjectrenderer.h"
+#include "math/Matrix4.h"
 
 namespace render
 {
@@ -23,19 +25,34 @@ private:
         bool surfaceDataChanged;
         IGeometryStore::Slot storageHandle;
 
-        SurfaceInfo(IRenderableSurface& surface_, IGeometryStore::Slot slot) :
+        // The key of the shared geometry the storage handle belongs to, 0 if not shared
+        std::uint64_t geometryKey;
+
+        SurfaceInfo(IRenderableSurface& surface_, IGeometryStore::Slot slot, std::uint64_t geometryKey_) :
             surface(surface_),
             surfaceDataChanged(false),
-            storageHandle(slot)
+            storageHandle(slot),
+            geometryKey(geometryKey_)
         {}
     };
     std::map<Slot, SurfaceInfo> _surfaces;
 
+    // The storage of the geometry shared by surfaces with the same key
+    struct SharedGeometry
+    {
+        IGeometryStore::Slot storageHandle;
+        std::size_t refCount;
+    };
+    std::map<std::uint64_t, SharedGeometry> _sharedGeometry;
+
     Slot _freeSlotMappingHint;
 
     std::vector<Slot> _surfacesNeedingUpdate;
     bool _surfacesNeedUpdate;
 
+    // Storage slots of the visible surfaces sharing the same transform, re-used between frames
+    std::vector<IGeometryStore::Slot> _batchedSlots;
+
 public:
     SurfaceRenderer(IGeometryStore& store, IObjectRenderer& renderer) :
         _store(store),
@@ -54,15 +71,10 @@ public:
         // Find a free slot
         auto newSlotIndex = getNextFreeSlotIndex();
 
-        const auto& vertices = surface.getVertices();
-        const auto& indices = surface.getIndices();
-
-        auto slot = _store.allocateSlot(vertices.size(), indices.size());
+        auto geometryKey = surface.getGeometryKey();
+        auto slot = acquireStorage(surface, geometryKey);
 
-        // Transform the vertices to single precision
-        _store.updateData(slot, ConvertToRenderVertices(vertices), indices);
-
-        _surfaces.emplace(newSlotIndex, SurfaceInfo(surface, slot));
+        _surfaces.emplace(newSlotIndex, SurfaceInfo(surface, slot, geometryKey));
 
         return newSlotIndex;
     }
@@ -73,7 +85,7 @@ public:
         assert(surface != _surfaces.end());
 
         // Deallocate the storage
-        _store.deallocateSlot(surface->second.storageHandle);
+        releaseStorage(surface->second.storageHandle, surface->second.geometryKey);
         _surfaces.erase(surface);
 
         if (slot < _freeSlotMappingHint)
@@ -91,9 +103,43 @@ public:
 
     void render(const VolumeTest& view)
     {
-        for (auto& surface : _surfaces)
+        // Consecutive surfaces sharing the same transform (like the surfaces
+        // of a single model) are submitted in a single draw call. This is only used
+        // by the fixed-function fullbright renderer which needs to load each transform
+        // into the modelview matrix, the lighting mode renderer batches surfaces of
+        // different objects through IObjectRenderer::submitOrientedObjects instead.
+        const Matrix4* batchTransform = nullptr;
+
+        for (auto& [_, slot] : _surfaces)
+        {
+            auto& surface = slot.surface.get();
+
+            if (view.TestAABB(surface.getObjectBounds(), surface.getObjectTransform()) == VOLUME_OUTSIDE)
+            {
+                continue;
+            }
+
+            if (slot.surfaceDataChanged)
+            {
+                throw std::logic_error("Cannot render unprepared slot, ensure calling SurfaceRenderer::prepareForRendering first");
+            }
+
+            const auto& transform = surface.getObjectTransform();
+
+            if (!_batchedSlots.empty() && !(transform == *batchTransform))
+            {
+                _renderer.submitObjects(_batchedSlots, *batchTransform);
+                _batchedSlots.clear();
+            }
+
+            batchTransform = &transform;
+            _batchedSlots.push_back(slot.storageHandle);
+        }
+
+        if (!_batchedSlots.empty())
         {
-            renderSlot(surface.second, &view);
+            _renderer.submitObjects(_batchedSlots, *batchTransform);
+            _batchedSlots.clear();
         }
     }
 
@@ -123,12 +169,72 @@ public:
                 surfaceInfo.surfaceDataChanged = false;
 
                 auto& surface = surfaceInfo.surface.get();
-                _store.updateData(surfaceInfo.storageHandle, ConvertToRenderVertices(surface.getVertices()), surface.getIndices());
+                auto geometryKey = surface.getGeometryKey();
+
+                if (geometryKey != surfaceInfo.geometryKey)
+                {
+                    // The surface starts or stops sharing its geometry, move it to a different slot
+                    releaseStorage(surfaceInfo.storageHandle, surfaceInfo.geometryKey);
+
+                    surfaceInfo.storageHandle = acquireStorage(surface, geometryKey);
+                    surfaceInfo.geometryKey = geometryKey;
+                }
+                else if (geometryKey == 0 || _sharedGeometry.at(geometryKey).refCount == 1)
+                {
+                    // The slot is not used by anyone else, the data can be updated in place.
+                    // Slots used by several surfaces are left alone, their data is unchanged.
+                    _store.updateData(surfaceInfo.storageHandle, ConvertToRenderVertices(surface.getVertices()), surface.getIndices());
+                }
             }
         }
     }
 
 private:
+    // Returns the storage slot holding the surface data, surfaces with a non-zero key share it
+    IGeometryStore::Slot acquireStorage(IRenderableSurface& surface, std::uint64_t geometryKey)
+    {
+        if (geometryKey != 0)
+        {
+            auto existing = _sharedGeometry.find(geometryKey);
+
+            if (existing != _sharedGeometry.end())
+            {
+                ++existing->second.refCount;
+                return existing->second.storageHandle;
+            }
+        }
+
+        const auto& vertices = surface.getVertices();
+        const auto& indices = surface.getIndices();
+
+        auto slot = _store.allocateSlot(vertices.size(), indices.size());
+
+        // Transform the vertices to single precision
+        _store.updateData(slot, ConvertToRenderVertices(vertices), indices);
+
+        if (geometryKey != 0)
+        {
+            _sharedGeometry.emplace(geometryKey, SharedGeometry{ slot, 1 });
+        }
+
+        return slot;
+    }
+
+    void releaseStorage(IGeometryStore::Slot slot, std::uint64_t geometryKey)
+    {
+        if (geometryKey != 0)
+        {
+            auto shared = _sharedGeometry.find(geometryKey);
+            assert(shared != _sharedGeometry.end());
+
+            if (--shared->second.refCount > 0) return;
+
+            _sharedGeometry.erase(shared);
+        }
+
+        _store.deallocateSlot(slot);
+    }
+
     static std::vector<RenderVertex> ConvertToRenderVertices(const std::vector<MeshVertex>& vertices)
     {
         std::vector<RenderVertex> transformedVertices;
@@ -26,13 +26,13 @@ void DepthFillAlphaProgram::create()
 
     glBindAttribLocation(_programObj, GLProgramAttribute::Position, "attr_Position");
     glBindAttribLocation(_programObj, GLProgramAttribute::TexCoord, "attr_TexCoord");
+    glBindAttribLocation(_programObj, GLProgramAttribute::ObjectTransform, "attr_ObjectTransform");
 
     glLinkProgram(_programObj);
 
     debug::assertNoGlErrors();
 
     _locAlphaTest = glGetUniformLocation(_programObj, "u_AlphaTest");
-    _locObjectTransform = glGetUniformLocation(_programObj, "u_ObjectTransform");
     _locModelViewProjection = glGetUniformLocation(_programObj, "u_ModelViewProjection");
     _locDiffuseTextureMatrix = glGetUniformLocation(_programObj, "u_DiffuseTextureMatrix");
 
@@ -73,7 +73,7 @@ void DepthFillAlphaProgram::setModelViewProjection(const Matrix4& modelViewProje
 
 void DepthFillAlphaProgram::setObjectTransform(const Matrix4& transform)
 {
-    loadMatrixUniform(_locObjectTransform, transform);
+    SetObjectTransformAttribute(transform);
 }
 
 void DepthFillAlphaProgram::setDiffuseTextureTransform(const Matrix4& transform)
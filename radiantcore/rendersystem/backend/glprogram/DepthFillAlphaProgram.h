@@ -11,7 +11,6 @@ class DepthFillAlphaProgram :
 {
 private:
     GLint _locAlphaTest;
-    GLint _locObjectTransform;
     GLint _locModelViewProjection;
     GLint _locDiffuseTextureMatrix;
     
@@ -1,6 +1,8 @@
 #include "GLSLProgramBase.h"
 
+#include "GLProgramAttributes.h"
 #include "debugging/gl.h"
+#include "math/Matrix4.h"
 
 namespace render
 {
@@ -30,6 +32,33 @@ void GLSLProgramBase::disable()
     debug::assertNoGlErrors();
 }
 
+void GLSLProgramBase::SetObjectTransformAttribute(const Matrix4& transform)
+{
+    // A mat4 attribute occupies four consecutive locations, one per column
+    for (auto column = 0; column < 4; ++column)
+    {
+        glVertexAttrib4f(GLProgramAttribute::ObjectTransform + column,
+            static_cast<float>(transform[column * 4 + 0]),
+            static_cast<float>(transform[column * 4 + 1]),
+            static_cast<float>(transform[column * 4 + 2]),
+            static_cast<float>(transform[column * 4 + 3]));
+    }
+
+    // Object transforms are affine, the last row of the inverse is always 0,0,0,1
+    auto inverse = transform.getInverse();
+
+    for (auto row = 0; row < 3; ++row)
+    {
+        glVertexAttrib4f(GLProgramAttribute::WorldToObject + row,
+            static_cast<float>(inverse[row]),
+            static_cast<float>(inverse[4 + row]),
+            static_cast<float>(inverse[8 + row]),
+            static_cast<float>(inverse[12 + row]));
+    }
+
+    debug::assertNoGlErrors();
+}
+
 void GLSLProgramBase::loadMatrixUniform(GLuint location, const Matrix4& matrix)
 {
     float values[16];
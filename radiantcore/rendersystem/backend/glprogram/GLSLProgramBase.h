@@ -23,6 +23,11 @@ public:
     virtual void enable() override;
     virtual void disable() override;
 
+    // Sets the value of the ObjectTransform vertex attribute and its inverse (WorldToObject).
+    // They are used for all vertices as long as the attribute arrays are disabled,
+    // i.e. when not drawing batches of objects.
+    static void SetObjectTransformAttribute(const Matrix4& transform);
+
 protected:
     void loadMatrixUniform(GLuint location, const Matrix4& matrix);
     void loadTextureMatrixUniform(GLuint location, const Matrix4& matrix);
@@ -16,9 +16,7 @@ private:
 	float _lightScale;
 
     // Uniform/program-local parameter IDs.
-    int _locLocalLightOrigin;
     int _locWorldLightOrigin;
-    int _locWorldUpLocal;
     int _locLightColour;
     int _locViewOrigin;
     int _locLightScale;
@@ -26,7 +24,6 @@ private:
     int _locColourModulation;
     int _locColourAddition;
     int _locModelViewProjection;
-    int _locObjectTransform;
 
     int _locDiffuseTextureMatrix;
     int _locBumpTextureMatrix;
@@ -55,9 +52,8 @@ public:
 
     void setupLightParameters(OpenGLState& state, const RendererLight& light, std::size_t renderTime);
 
-    void setUpObjectLighting(const Vector3& worldLightOrigin,
-        const Vector3& viewer,
-        const Matrix4& inverseObjectTransform);
+    // The object space light and view origins are calculated in the vertex program
+    void setLightAndViewOrigin(const Vector3& worldLightOrigin, const Vector3& viewer);
 
     void setShadowMapRectangle(const Rectangle& rectangle);
     void enableShadowMapping(bool enable);
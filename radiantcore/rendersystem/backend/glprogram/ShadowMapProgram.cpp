@@ -26,6 +26,7 @@ void ShadowMapProgram::create()
 
     glBindAttribLocation(_programObj, GLProgramAttribute::Position, "attr_Position");
     glBindAttribLocation(_programObj, GLProgramAttribute::TexCoord, "attr_TexCoord");
+    glBindAttribLocation(_programObj, GLProgramAttribute::ObjectTransform, "attr_ObjectTransform");
 
     glLinkProgram(_programObj);
 
@@ -33,7 +34,6 @@ void ShadowMapProgram::create()
 
     _locAlphaTest = glGetUniformLocation(_programObj, "u_AlphaTest");
     _locLightOrigin = glGetUniformLocation(_programObj, "u_LightOrigin");
-    _locObjectTransform = glGetUniformLocation(_programObj, "u_ObjectTransform");
     _locDiffuseTextureMatrix = glGetUniformLocation(_programObj, "u_DiffuseTextureMatrix");
 
     glUseProgram(_programObj);
@@ -80,7 +80,7 @@ void ShadowMapProgram::setLightOrigin(const Vector3& lightOrigin)
 
 void ShadowMapProgram::setObjectTransform(const Matrix4& transform)
 {
-    loadMatrixUniform(_locObjectTransform, transform);
+    SetObjectTransformAttribute(transform);
 }
 
 void ShadowMapProgram::setDiffuseTextureTransform(const Matrix4& transform)
@@ -12,7 +12,6 @@ class ShadowMapProgram :
 private:
     GLint _locAlphaTest;
     GLint _locLightOrigin;
-    GLint _locObjectTransform;
     GLint _locDiffuseTextureMatrix;
 
 public:
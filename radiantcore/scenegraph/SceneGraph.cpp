@@ -19,6 +19,7 @@ SceneGraph::SceneGraph() :
 	_spacePartition(new Octree),
 	_visitedSPNodes(0),
 	_skippedSPNodes(0),
+	_spacePartitionChangeCount(0),
     _traversalOngoing(false)
 {}
 
@@ -89,6 +90,7 @@ void SceneGraph::setRoot(const IMapRootNodePtr& newRoot)
 
 	// Refresh the space partition class
 	_spacePartition = std::make_shared<Octree>();
+	++_spacePartitionChangeCount;
 
 	if (_root)
 	{
@@ -152,6 +154,7 @@ void SceneGraph::insert(const INodePtr& node)
 
 	// Insert this node into our SP tree
 	_spacePartition->link(node);
+	++_spacePartitionChangeCount;
 
 	// Call the onInsert event on the node
     assert(_root);
@@ -172,6 +175,7 @@ void SceneGraph::erase(const INodePtr& node)
     }
 
 	_spacePartition->unlink(node);
+	++_spacePartitionChangeCount;
 
 	// Fire the onRemove event on the Node
     assert(_root);
@@ -198,6 +202,7 @@ void SceneGraph::nodeBoundsChanged(const INodePtr& node)
 	{
 		// unlink returned true, so the given node was linked before => re-link it
 		_spacePartition->link(node);
+		++_spacePartitionChangeCount;
 	}
 }
 
@@ -335,6 +340,14 @@ ISpacePartitionSystemPtr SceneGraph::getSpacePartition()
 	return _spacePartition;
 }
 
+std::size_t SceneGraph::getSpacePartitionChangeCount()
+{
+    // Evaluating the root bounds triggers the re-link of any changed nodes
+    if (_root != nullptr) _root->worldAABB();
+
+    return _spacePartitionChangeCount;
+}
+
 void SceneGraph::flushActionBuffer()
 {
     // Do any actions now, in the same order they came in
@@ -39,6 +39,9 @@ private:
 	std::size_t _visitedSPNodes;
 	std::size_t _skippedSPNodes;
 
+	// Incremented on every link/unlink operation of the space partition
+	std::size_t _spacePartitionChangeCount;
+
     // During partition traversal all link/unlink calls are buffered and
     // performed later on.
     enum ActionType
@@ -96,6 +99,8 @@ public:
     void foreachVisibleNodeInVolume(const VolumeTest& volume, const INode::VisitorFunc& functor) override;
 
     ISpacePartitionSystemPtr getSpacePartition() override;
+    std::size_t getSpacePartitionChangeCount() override;
+
 private:
 	void foreachNodeInVolume(const VolumeTest& volume, const INode::VisitorFunc& functor, bool visitHidden);
 
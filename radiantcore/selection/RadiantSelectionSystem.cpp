@@ -8,6 +8,7 @@
 #include "ipreferencesystem.h"
 #include "selection/SelectionPool.h"
 #include "module/StaticModule.h"
+#include "brush/Brush.h"
 #include "brush/csg/CSG.h"
 #include "selection/algorithm/General.h"
 #include "selection/algorithm/Primitives.h"
@@ -19,6 +20,7 @@
 #include "messages/UnselectSelectionRequest.h"
 #include "messages/ManipulatorModeToggleRequest.h"
 #include "messages/ComponentSelectionModeToggleRequest.h"
+#include "debugging/ScopedTraceZone.h"
 
 #include "manipulators/DragManipulator.h"
 #include "manipulators/ClipManipulator.h"
@@ -69,12 +71,13 @@ void RadiantSelectionSystem::notifyObservers(const scene::INodePtr& node, bool i
     }
 }
 
-void RadiantSelectionSystem::testSelectScene(SelectablesList& targetList, SelectionTest& test,
+std::size_t RadiantSelectionSystem::testSelectScene(SelectablesList& targetList, SelectionTest& test,
     const VolumeTest& view, SelectionSystem::EMode mode, ComponentSelectionMode componentMode)
 {
     // The (temporary) storage pool
     SelectionPool selector;
     SelectionPool sel2;
+    std::size_t numTestedNodes = 0;
 
     switch(mode)
     {
@@ -83,6 +86,7 @@ void RadiantSelectionSystem::testSelectScene(SelectablesList& targetList, Select
             // Instantiate a walker class which is specialised for selecting entities
             EntitySelector entityTester(selector, test);
             GlobalSceneGraph().foreachVisibleNodeInVolume(view, entityTester);
+            numTestedNodes = entityTester.getNumTestedNodes();
 
             std::for_each(selector.begin(), selector.end(), [&](const auto& p) { targetList.push_back(p.second); });
         }
@@ -96,6 +100,7 @@ void RadiantSelectionSystem::testSelectScene(SelectablesList& targetList, Select
                 // Test for any visible elements (primitives, entities), but don't select child primitives
                 AnySelector anyTester(selector, test);
                 GlobalSceneGraph().foreachVisibleNodeInVolume(view, anyTester);
+                numTestedNodes = anyTester.getNumTestedNodes();
             }
             else
             {
@@ -108,6 +113,8 @@ void RadiantSelectionSystem::testSelectScene(SelectablesList& targetList, Select
                 // Now retrieve all the selectable primitives
                 PrimitiveSelector primitiveTester(sel2, test);
                 GlobalSceneGraph().foreachVisibleNodeInVolume(view, primitiveTester);
+
+                numTestedNodes = entityTester.getNumTestedNodes() + primitiveTester.getNumTestedNodes();
             }
 
             // Add the first selection crop to the target vector
@@ -133,6 +140,7 @@ void RadiantSelectionSystem::testSelectScene(SelectablesList& targetList, Select
             // Retrieve all the selectable primitives of group nodes
             GroupChildPrimitiveSelector primitiveTester(selector, test);
             GlobalSceneGraph().foreachVisibleNodeInVolume(view, primitiveTester);
+            numTestedNodes = primitiveTester.getNumTestedNodes();
 
             // Add the selection crop to the target vector
             std::for_each(selector.begin(), selector.end(), [&](const auto& p) { targetList.push_back(p.second); });
@@ -143,6 +151,7 @@ void RadiantSelectionSystem::testSelectScene(SelectablesList& targetList, Select
         {
             ComponentSelector selectionTester(selector, test, componentMode);
             SelectionSystem::foreachSelected(selectionTester);
+            numTestedNodes = selectionTester.getNumTestedNodes();
 
             std::for_each(selector.begin(), selector.end(), [&](const auto& p) { targetList.push_back(p.second); });
         }
@@ -152,12 +161,15 @@ void RadiantSelectionSystem::testSelectScene(SelectablesList& targetList, Select
         {
             MergeActionSelector tester(selector, test);
             GlobalSceneGraph().foreachVisibleNodeInVolume(view, tester);
+            numTestedNodes = tester.getNumTestedNodes();
 
             // Add the selection crop to the target vector
             std::for_each(selector.begin(), selector.end(), [&](const auto& p) { targetList.push_back(p.second); });
         }
         break;
     } // switch
+
+    return numTestedNodes;
 }
 
 /* greebo: This is true if nothing is selected (either in component mode or in primitive mode)
@@ -575,6 +587,8 @@ void RadiantSelectionSystem::deselectAll() {
 
 void RadiantSelectionSystem::selectPoint(SelectionTest& test, EModifier modifier, bool face)
 {
+    profiling::ScopedTraceZone traceZone("selection", "selectPoint");
+
     // If the user is holding the replace modifiers (default: Alt-Shift), deselect the current selection
     if (modifier == SelectionSystem::eReplace) {
         if (face) {
@@ -587,6 +601,7 @@ void RadiantSelectionSystem::selectPoint(SelectionTest& test, EModifier modifier
 
     // The possible candidates are stored in the SelectablesSet
     SelectablesList candidates;
+    std::size_t numTestedNodes = 0;
 
     if (face)
     {
@@ -594,6 +609,7 @@ void RadiantSelectionSystem::selectPoint(SelectionTest& test, EModifier modifier
 
         ComponentSelector selectionTester(selector, test, ComponentSelectionMode::Face);
         GlobalSceneGraph().foreachVisibleNodeInVolume(test.getVolume(), selectionTester);
+        numTestedNodes = selectionTester.getNumTestedNodes();
 
         // Load them all into the vector
         for (SelectionPool::const_iterator i = selector.begin(); i != selector.end(); ++i)
@@ -602,9 +618,11 @@ void RadiantSelectionSystem::selectPoint(SelectionTest& test, EModifier modifier
         }
     }
     else {
-        testSelectScene(candidates, test, test.getVolume(), Mode(), ComponentMode());
+        numTestedNodes = testSelectScene(candidates, test, test.getVolume(), Mode(), ComponentMode());
     }
 
+    profiling::recordTraceCounter("selection.testedNodes", static_cast<double>(numTestedNodes));
+
     // Was the selection test successful (have we found anything to select)?
     performPointSelection(candidates, modifier);
 
@@ -704,6 +722,8 @@ void RadiantSelectionSystem::performPointSelection(const SelectablesList& candid
 
 void RadiantSelectionSystem::selectArea(SelectionTest& test, SelectionSystem::EModifier modifier, bool face)
 {
+    profiling::ScopedTraceZone traceZone("selection", "selectArea");
+
     // If we are in replace mode, deselect all the components or previous selections
     if (modifier == SelectionSystem::eReplace)
     {
@@ -721,11 +741,13 @@ void RadiantSelectionSystem::selectArea(SelectionTest& test, SelectionSystem::EM
     SelectionPool pool;
 
     SelectablesList candidates;
+    std::size_t numTestedNodes = 0;
 
     if (face)
     {
         ComponentSelector selectionTester(pool, test, ComponentSelectionMode::Face);
         GlobalSceneGraph().foreachVisibleNodeInVolume(test.getVolume(), selectionTester);
+        numTestedNodes = selectionTester.getNumTestedNodes();
 
         // Load them all into the vector
         for (SelectionPool::const_iterator i = pool.begin(); i != pool.end(); ++i)
@@ -735,9 +757,11 @@ void RadiantSelectionSystem::selectArea(SelectionTest& test, SelectionSystem::EM
     }
     else
     {
-        testSelectScene(candidates, test, test.getVolume(), Mode(), ComponentMode());
+        numTestedNodes = testSelectScene(candidates, test, test.getVolume(), Mode(), ComponentMode());
     }
 
+    profiling::recordTraceCounter("selection.testedNodes", static_cast<double>(numTestedNodes));
+
     // Since toggling a selectable might trigger a group-selection
     // we need to keep track of the desired state of each selectable
     typedef std::map<ISelectable*, bool> SelectablesMap;
@@ -782,6 +806,9 @@ void RadiantSelectionSystem::onManipulationEnd()
 {
     GlobalSceneGraph().foreachNode(scene::freezeTransformableNode);
 
+    // Rebuild the transformed brushes in one batch
+    Brush::evaluateChangedBReps();
+
     _pivot.endOperation();
 
 	// The selection bounds have possibly changed
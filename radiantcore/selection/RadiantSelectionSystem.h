@@ -174,7 +174,8 @@ public:
 
 protected:
 	// Traverses the scene and adds any selectable nodes matching the given SelectionTest to the "targetList".
-	void testSelectScene(SelectablesList& targetList, SelectionTest& test,
+	// Returns the number of nodes that have been tested.
+	std::size_t testSelectScene(SelectablesList& targetList, SelectionTest& test,
         const VolumeTest& view, SelectionSystem::EMode mode,
         ComponentSelectionMode componentMode);
 
@@ -59,6 +59,7 @@ void SelectionTestWalker::performSelectionTest(const scene::INodePtr& selectable
 
 	if (selectionTestable)
 	{
+		++_numTestedNodes;
 		selectionTestable->testSelect(_selector, _test);
 	}
 
@@ -186,6 +187,7 @@ void ComponentSelector::performComponentselectionTest(const scene::INodePtr& nod
 
 	if (testable != NULL)
 	{
+		++_numTestedNodes;
 		testable->testSelectComponents(_selector, _test, _mode);
 	}
 }
@@ -15,12 +15,24 @@ protected:
 	Selector& _selector;
 	SelectionTest& _test;
 
+	// The number of nodes that have been tested against the SelectionTest
+	mutable std::size_t _numTestedNodes;
+
 protected:
 	SelectionTestWalker(Selector& selector, SelectionTest& test) :
 		_selector(selector),
-		_test(test)
+		_test(test),
+		_numTestedNodes(0)
 	{}
 
+public:
+	std::size_t getNumTestedNodes() const
+	{
+		return _numTestedNodes;
+	}
+
+protected:
+
 	void printNodeName(const scene::INodePtr& node);
 
 	// Returns non-NULL if the given node is an Entity
@@ -27,6 +27,7 @@
 #include "selection/algorithm/Entity.h"
 #include "selection/algorithm/GroupCycle.h"
 #include "selection/algorithm/Shader.h"
+#include "brush/Brush.h"
 #include "brush/BrushVisit.h"
 #include "patch/Patch.h"
 #include "patch/PatchNode.h"
@@ -754,6 +755,9 @@ void snapSelectionToGrid(const cmd::ArgumentList& args)
 			}
 		});
 	}
+
+	// Rebuild the snapped brushes in one batch
+	Brush::evaluateChangedBReps();
 }
 
 class IntersectionFinder :
@@ -23,6 +23,7 @@
 #include "debugging/debugging.h"
 #include "selection/TransformationVisitors.h"
 #include "selection/SceneWalkers.h"
+#include "brush/Brush.h"
 #include "command/ExecutionFailure.h"
 
 #include "string/case_conv.h"
@@ -57,6 +58,7 @@ void rotateSelected(const Quaternion& rotation)
 	SceneChangeNotify();
 
 	GlobalSceneGraph().foreachNode(scene::freezeTransformableNode);
+	Brush::evaluateChangedBReps();
 }
 
 // greebo: see header for documentation
@@ -107,6 +109,7 @@ void scaleSelected(const Vector3& scaleXYZ)
 		SceneChangeNotify();
 
 		GlobalSceneGraph().foreachNode(scene::freezeTransformableNode);
+		Brush::evaluateChangedBReps();
 	}
 	else
 	{
@@ -373,6 +376,7 @@ void translateSelected(const Vector3& translation)
 	SceneChangeNotify();
 
 	GlobalSceneGraph().foreachNode(scene::freezeTransformableNode);
+	Brush::evaluateChangedBReps();
 }
 
 // Specialised overload, called by the general nudgeSelected() routine
@@ -76,33 +76,48 @@ void CShader::setPolygonOffset(float offset)
     _template->setPolygonOffset(offset);
 }
 
-TexturePtr CShader::getEditorImage()
+MapExpressionPtr CShader::getEditorImageSource()
 {
-    if (!_editorTexture)
-    {
-        auto editorTex = _template->getEditorTexture();
+    auto editorTex = _template->getEditorTexture();
 
-        if (!editorTex)
+    if (!editorTex)
+    {
+        // If there is no editor expression defined, use the an image from a layer, but no Bump or speculars
+        for (const auto& layer : _layers)
         {
-            // If there is no editor expression defined, use the an image from a layer, but no Bump or speculars
-            for (const auto& layer : _layers)
+            if (layer->getType() != IShaderLayer::BUMP && layer->getType() != IShaderLayer::SPECULAR &&
+                std::dynamic_pointer_cast<MapExpression>(layer->getMapExpression()))
             {
-                if (layer->getType() != IShaderLayer::BUMP && layer->getType() != IShaderLayer::SPECULAR &&
-                    std::dynamic_pointer_cast<MapExpression>(layer->getMapExpression()))
-                {
-                    editorTex = std::static_pointer_cast<MapExpression>(layer->getMapExpression());
-                    break;
-                }
+                editorTex = std::static_pointer_cast<MapExpression>(layer->getMapExpression());
+                break;
             }
         }
+    }
 
+    return editorTex;
+}
+
+TexturePtr CShader::getEditorImage()
+{
+    if (!_editorTexture)
+    {
         // Pass the call to the GLTextureManager to realise this image
-        _editorTexture = GetTextureManager().getBinding(editorTex);
+        _editorTexture = GetTextureManager().getBinding(getEditorImageSource());
     }
 
     return _editorTexture;
 }
 
+TexturePtr CShader::getEditorImagePreview()
+{
+    if (!_editorPreviewTexture)
+    {
+        _editorPreviewTexture = GetTextureManager().getPreviewBinding(getEditorImageSource(), EDITOR_IMAGE_PREVIEW_SIZE);
+    }
+
+    return _editorPreviewTexture;
+}
+
 IMapExpression::Ptr CShader::getEditorImageExpression()
 {
     return _template->getEditorTexture();
@@ -113,6 +128,7 @@ void CShader::setEditorImageExpressionFromString(const std::string& editorImageP
     ensureTemplateCopy();
 
     _editorTexture.reset();
+    _editorPreviewTexture.reset();
     _template->setEditorImageExpressionFromString(editorImagePath);
 }
 
@@ -390,6 +406,29 @@ void CShader::revertModifications()
     _sigMaterialModified.emit();
 }
 
+void CShader::setDefinition(const ShaderDefinition& definition)
+{
+    if (!isModified())
+    {
+        _template = definition.shaderTemplate;
+        _fileInfo = definition.file;
+    }
+
+    _originalTemplate = definition.shaderTemplate;
+
+    // The images might have changed too, let them be requested again
+    _editorTexture.reset();
+    _editorPreviewTexture.reset();
+    _texLightFalloff.reset();
+
+    subscribeToTemplateChanges();
+
+    unrealise();
+    realise();
+
+    _sigMaterialModified.emit();
+}
+
 sigc::signal<void>& CShader::sig_materialChanged()
 {
     return _sigMaterialModified;
@@ -646,6 +685,12 @@ void CShader::updateEditorImage()
 {
     // In case the editor tex is pointing to the fallback "shader not found"
     // check if we have some possible replacements
+    if (_editorPreviewTexture && (_editorPreviewTexture == GetTextureManager().getShaderNotFound() ||
+        !_template->getEditorTexture()))
+    {
+        _editorPreviewTexture.reset();
+    }
+
     if (!_editorTexture) return;
 
     if (isEditorImageNoTex() || !_template->getEditorTexture())
@@ -675,6 +720,7 @@ void CShader::refreshImageMaps()
     }
 
     _editorTexture.reset();
+    _editorPreviewTexture.reset();
     _texLightFalloff.reset();
 
     _sigMaterialModified.emit();
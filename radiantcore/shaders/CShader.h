@@ -34,6 +34,9 @@ private:
 	// The 2D editor texture
 	TexturePtr _editorTexture;
 
+	// Low-resolution version of the editor texture, used for previews
+	TexturePtr _editorPreviewTexture;
+
 	TexturePtr _texLightFalloff;
 
 	bool m_bInUse;
@@ -65,6 +68,7 @@ public:
     float getPolygonOffset() const override;
     void setPolygonOffset(float offset) override;
 	TexturePtr getEditorImage() override;
+    TexturePtr getEditorImagePreview() override;
     IMapExpression::Ptr getEditorImageExpression() override;
     void setEditorImageExpressionFromString(const std::string& editorImagePath) override;
 	bool isEditorImageNoTex() override;
@@ -152,6 +156,10 @@ public:
 
     void commitModifications();
     void revertModifications() override;
+
+    // Replaces the definition this material has been created from, e.g. after its file
+    // has been re-parsed. Uncommitted modifications are kept, they now revert to the new one.
+    void setDefinition(const ShaderDefinition& definition);
     sigc::signal<void>& sig_materialChanged() override;
 
     void refreshImageMaps() override;
@@ -163,6 +171,9 @@ private:
     void ensureTemplateCopy();
     void subscribeToTemplateChanges();
     void updateEditorImage();
+
+    // Returns the expression the editor image is generated from
+    MapExpressionPtr getEditorImageSource();
 };
 typedef std::shared_ptr<CShader> CShaderPtr;
 
@@ -30,6 +30,7 @@
 #include "materials/ParseLib.h"
 #include "parser/DefBlockTokeniser.h"
 #include <functional>
+#include <set>
 
 namespace
 {
@@ -132,6 +133,55 @@ void Doom3ShaderSystem::refresh() {
     realise();
 }
 
+bool Doom3ShaderSystem::refreshChangedFiles()
+{
+    if (!_realised) return false;
+
+    ensureDefsLoaded();
+
+    auto changes = _defLoader->parseChangedFiles(_library);
+
+    if (changes.empty()) return false;
+
+    std::set<std::string, string::ILess> removedNames(changes.removedNames.begin(), changes.removedNames.end());
+
+    std::vector<std::string> namesGone;
+
+    for (const auto& name : changes.removedNames)
+    {
+        if (!_library->definitionExists(name))
+        {
+            namesGone.push_back(name);
+        }
+    }
+
+    // Let the affected materials pick up their new definition before anybody gets to know
+    // about the changes. Materials still in use receive a fallback definition if theirs is gone.
+    _library->updateShaders(changes.removedNames);
+
+    for (const auto& name : namesGone)
+    {
+        if (!_library->definitionExists(name))
+        {
+            _sigMaterialRemoved.emit(name);
+        }
+    }
+
+    for (const auto& name : changes.addedNames)
+    {
+        if (removedNames.count(name) == 0)
+        {
+            _sigMaterialCreated.emit(name);
+        }
+    }
+
+    // Release the textures that are no longer in use
+    _textureManager->checkBindings();
+    activeShadersChangedNotify();
+
+    return true;
+}
+
 // Is the shader system realised
 bool Doom3ShaderSystem::isRealised()
 {
@@ -71,6 +71,8 @@ public:
 	// Flushes the shaders from memory and reloads the material files
     void refresh() override;
 
+    bool refreshChangedFiles() override;
+
 	// Is the shader system realised
     bool isRealised() override;
 
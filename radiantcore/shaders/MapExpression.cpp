@@ -13,6 +13,7 @@
 #include "fmt/format.h"
 
 #include "RGBAImage.h"
+#include "BCnDecoder.h"
 #include "textures/HeightmapCreator.h"
 #include "textures/TextureManipulator.h"
 #include "string/predicate.h"
@@ -110,6 +111,20 @@ MapExpressionPtr MapExpression::createForString(const std::string& str)
     }
 }
 
+ImagePtr MapExpression::getDecompressed(const ImagePtr& input)
+{
+	if (!input->isPrecompressed()) return input;
+
+	auto decompressed = image::decompressImage(*input);
+
+	if (!decompressed) {
+		rWarning() << "Cannot decompress texture with GL format " << input->getGLFormat() << std::endl;
+		return input;
+	}
+
+	return decompressed;
+}
+
 ImagePtr MapExpression::getResampled(const ImagePtr& input, std::size_t width, std::size_t height)
 {
 	// Don't process precompressed images
@@ -152,7 +167,9 @@ ImagePtr HeightMapExpression::getImage() const {
 
 	if (heightMap == NULL) return ImagePtr();
 
-	// Don't process precompressed images
+	// Decode block-compressed images, other precompressed formats can't be processed
+	heightMap = getDecompressed(heightMap);
+
 	if (heightMap->isPrecompressed()) {
 		rWarning() << "Cannot evaluate map expression with precompressed texture." << std::endl;
 		return heightMap;
@@ -194,7 +211,10 @@ ImagePtr AddNormalsExpression::getImage() const {
 
     if (imgTwo == NULL) return ImagePtr();
 
-	// Don't process precompressed images
+	// Decode block-compressed images, other precompressed formats can't be processed
+	imgOne = getDecompressed(imgOne);
+	imgTwo = getDecompressed(imgTwo);
+
 	if (imgOne->isPrecompressed() || imgTwo->isPrecompressed()) {
 		rWarning() << "Cannot evaluate map expression with precompressed texture." << std::endl;
 		return imgOne;
@@ -265,7 +285,9 @@ ImagePtr SmoothNormalsExpression::getImage() const {
 
 	if (normalMap == NULL) return ImagePtr();
 
-	// Don't process precompressed images
+	// Decode block-compressed images, other precompressed formats can't be processed
+	normalMap = getDecompressed(normalMap);
+
 	if (normalMap->isPrecompressed()) {
 		rWarning() << "Cannot evaluate map expression with precompressed texture." << std::endl;
 		return normalMap;
@@ -360,7 +382,10 @@ ImagePtr AddExpression::getImage() const {
 
 	if (imgTwo == NULL) return ImagePtr();
 
-	// Don't process precompressed images
+	// Decode block-compressed images, other precompressed formats can't be processed
+	imgOne = getDecompressed(imgOne);
+	imgTwo = getDecompressed(imgTwo);
+
 	if (imgOne->isPrecompressed() || imgTwo->isPrecompressed()) {
 		rWarning() << "Cannot evaluate map expression with precompressed texture." << std::endl;
 		return imgOne;
@@ -437,7 +462,9 @@ ImagePtr ScaleExpression::getImage() const
 
     if (img == NULL) return ImagePtr();
 
-	// Don't process precompressed images
+	// Decode block-compressed images, other precompressed formats can't be processed
+	img = getDecompressed(img);
+
 	if (img->isPrecompressed()) {
 		rWarning() << "Cannot evaluate map expression with precompressed texture." << std::endl;
 		return img;
@@ -508,7 +535,9 @@ ImagePtr InvertAlphaExpression::getImage() const {
 
 	if (img == NULL) return ImagePtr();
 
-	// Don't process precompressed images
+	// Decode block-compressed images, other precompressed formats can't be processed
+	img = getDecompressed(img);
+
 	if (img->isPrecompressed()) {
 		rWarning() << "Cannot evaluate map expression with precompressed texture." << std::endl;
 		return img;
@@ -563,7 +592,9 @@ ImagePtr InvertColorExpression::getImage() const {
 
 	if (img == NULL) return ImagePtr();
 
-	// Don't process precompressed images
+	// Decode block-compressed images, other precompressed formats can't be processed
+	img = getDecompressed(img);
+
 	if (img->isPrecompressed()) {
 		rWarning() << "Cannot evaluate map expression with precompressed texture." << std::endl;
 		return img;
@@ -616,7 +647,9 @@ ImagePtr MakeIntensityExpression::getImage() const {
 
 	if (img == NULL) return ImagePtr();
 
-	// Don't process precompressed images
+	// Decode block-compressed images, other precompressed formats can't be processed
+	img = getDecompressed(img);
+
 	if (img->isPrecompressed()) {
 		rWarning() << "Cannot evaluate map expression with precompressed texture." << std::endl;
 		return img;
@@ -674,7 +707,9 @@ ImagePtr MakeAlphaExpression::getImage() const
 
 	if (img == NULL) return ImagePtr();
 
-	// Don't process precompressed images
+	// Decode block-compressed images, other precompressed formats can't be processed
+	img = getDecompressed(img);
+
 	if (img->isPrecompressed()) {
 		rWarning() << "Cannot evaluate map expression with precompressed texture." << std::endl;
 		return img;
@@ -808,6 +843,17 @@ ImagePtr ImageExpression::getImage() const
 	}
 }
 
+ImagePtr ImageExpression::getPreviewImage(std::size_t maxSize) const
+{
+    // The built-in keyword images are small, load them like everything else
+    if (string::starts_with(_imgName, "_"))
+    {
+        return getImage();
+    }
+
+    return GlobalImageLoader().previewImageFromVFS(_imgName, maxSize);
+}
+
 std::string ImageExpression::getIdentifier() const
 {
 	return _imgName;
@@ -49,6 +49,13 @@ public:
     // Abstract method to be implemented
     virtual ImagePtr getImage() const = 0;
 
+    // Returns a low-resolution image fitting into maxSize x maxSize, used for previews.
+    // Expressions modifying their source images return the full image by default.
+    virtual ImagePtr getPreviewImage(std::size_t maxSize) const
+    {
+        return getImage();
+    }
+
 public: /* STATIC CONSTRUCTION METHODS */
 
 	/** Creates the a MapExpression out of the given token. Nested mapexpressions
@@ -59,6 +66,13 @@ public: /* STATIC CONSTRUCTION METHODS */
 
 protected:
 
+	/**
+	 * Returns an RGBA copy of the given block-compressed image, which can be
+	 * processed by the image manipulation routines. Uncompressed images and
+	 * compressed images in unsupported formats are returned unchanged.
+	 */
+	static ImagePtr getDecompressed(const ImagePtr& input);
+
 	/** greebo: Assures that the image is matching the desired dimensions.
 	 *
 	 * @input: The image to be rescaled. If it doesn't match <width x height>
@@ -193,6 +207,7 @@ public:
 	ImageExpression(const std::string& imgName);
 
 	ImagePtr getImage() const override;
+    ImagePtr getPreviewImage(std::size_t maxSize) const override;
 	std::string getIdentifier() const override;
     std::string getExpressionString() override;
 };
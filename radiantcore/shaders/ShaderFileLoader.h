@@ -1,6 +1,10 @@
 #pragma once
 
+#include <algorithm>
+#include <map>
 #include <regex>
+#include <set>
+#include <vector>
 
 #include "iarchive.h"
 #include "ifilesystem.h"
@@ -15,6 +19,7 @@
 #include "materials/ParseLib.h"
 #include "string/replace.h"
 #include "string/predicate.h"
+#include "string/string.h"
 #include "debugging/ScopedDebugTimer.h"
 
 namespace shaders
@@ -27,71 +32,204 @@ class ShaderFileLoader :
 private:
     ShaderLibraryPtr _library;
 
+    // Names of the tables parsed from each file, by full VFS path
+    std::map<std::string, std::vector<std::string>> _tablesByFile;
+
+    // Names of the definitions each file declared after another file already did,
+    // by full VFS path. These take effect if the other declaration is removed.
+    std::map<std::string, std::set<std::string, string::ILess>> _duplicatesByFile;
+
+    // Names of the definitions added to the library by this run
+    std::vector<std::string> _addedNames;
+
 public:
+    // The outcome of parseChangedFiles()
+    struct ChangedDefinitions
+    {
+        // Definitions that have been dropped from the library before re-parsing.
+        // Some of them might have been added again.
+        std::vector<std::string> removedNames;
+
+        // Definitions that have been (re-)added to the library
+        std::vector<std::string> addedNames;
+
+        bool empty() const
+        {
+            return removedNames.empty() && addedNames.empty();
+        }
+    };
+
     /// Construct and initialise the ShaderFileLoader
     ShaderFileLoader() :
         parser::ThreadedDeclParser<ShaderLibraryPtr>(decl::Type::Material, 
             getMaterialsFolderName(), getMaterialFileExtension(), 1)
-    {}
-
-protected:
-    void onBeginParsing() override
     {
-        // Load the shader files from the VFS into a fresh library
-        _library = std::make_shared<ShaderLibrary>();
+        useBlockCache();
     }
 
-    void parse(std::istream& stream, const vfs::FileInfo& fileInfo, const std::string& modDir) override
+    // Re-parses the files that have been added or modified since the last run, the
+    // definitions are updated in the given library (which should be the result of that run).
+    // Unchanged files declaring a duplicate of a removed definition are parsed again as well,
+    // such that their declaration takes over.
+    // The existing shaders are not touched, the caller needs to update them.
+    ChangedDefinitions parseChangedFiles(const ShaderLibraryPtr& library)
     {
-        // Parse the file with a blocktokeniser, the actual block contents
-        // will be parsed separately.
-        parser::BasicDefBlockTokeniser<std::istream> tokeniser(stream);
+        ChangedDefinitions result;
+
+        auto changes = findChangedFiles();
 
-        while (tokeniser.hasMoreBlocks())
+        if (changes.empty()) return result;
+
+        auto affectedFiles = changes.removedFiles;
+
+        for (const auto& fileInfo : changes.changedFiles)
         {
-            // Get the next block
-            parser::BlockTokeniser::Block block = tokeniser.nextBlock();
+            affectedFiles.insert(fileInfo.fullPath());
+        }
 
-            // Try to parse tables
-            if (parseTable(block, fileInfo))
-            {
-                continue; // table successfully parsed
-            }
+        // Drop everything the affected files declared before
+        result.removedNames = library->removeDefinitionsFromFiles(affectedFiles);
 
-            if (block.name.substr(0, 5) == "skin ")
-            {
-                continue; // skip skin definition
-            }
+        // Re-parsing a file shadowing one of the removed names drops its definitions too,
+        // which might uncover duplicates in yet another file
+        while (true)
+        {
+            auto shadowingFiles = findFilesDeclaringDuplicates(result.removedNames, affectedFiles);
+
+            if (shadowingFiles.empty()) break;
 
-            if (block.name.substr(0, 9) == "particle ")
+            for (const auto& fullPath : shadowingFiles)
             {
-                continue; // skip particle definition
+                affectedFiles.insert(fullPath);
+
+                if (auto fileInfo = GlobalFileSystem().getFileInfo(fullPath); !fileInfo.isEmpty())
+                {
+                    changes.changedFiles.push_back(fileInfo);
+                }
             }
 
-            string::replace_all(block.name, "\\", "/"); // use forward slashes
+            auto removedNames = library->removeDefinitionsFromFiles(shadowingFiles);
+            result.removedNames.insert(result.removedNames.end(), removedNames.begin(), removedNames.end());
+        }
+
+        // Keep the precedence of the full parse, the first declaration wins
+        std::sort(changes.changedFiles.begin(), changes.changedFiles.end(), [](const vfs::FileInfo& a, const vfs::FileInfo& b)
+        {
+            return a.name < b.name;
+        });
+
+        for (const auto& fullPath : affectedFiles)
+        {
+            _duplicatesByFile.erase(fullPath);
 
-            auto shaderTemplate = std::make_shared<ShaderTemplate>(block.name, block.contents);
+            auto tables = _tablesByFile.find(fullPath);
 
-            // Construct the ShaderDefinition wrapper class
-            ShaderDefinition def(shaderTemplate, fileInfo);
+            if (tables == _tablesByFile.end()) continue;
 
-            // Insert into the definitions map, if not already present
-            if (!_library->addDefinition(block.name, def))
+            for (const auto& tableName : tables->second)
             {
-                rError() << "[shaders] " << fileInfo.name << ": shader " << block.name << " already defined." << std::endl;
+                library->removeTableDefinition(tableName);
             }
+
+            _tablesByFile.erase(tables);
         }
+
+        _library = library;
+        _addedNames.clear();
+
+        processChangedFiles(changes);
+
+        result.addedNames = std::move(_addedNames);
+        _addedNames.clear();
+        _library.reset();
+
+        rMessage() << "[shaders] Re-parsed " << changes.changedFiles.size() << " material files, " <<
+            changes.removedFiles.size() << " removed." << std::endl;
+
+        return result;
+    }
+
+protected:
+    void onBeginParsing() override
+    {
+        // Load the shader files from the VFS into a fresh library
+        _library = std::make_shared<ShaderLibrary>();
+        _tablesByFile.clear();
+        _duplicatesByFile.clear();
+        _addedNames.clear();
+    }
+
+    void parseBlock(const parser::BlockTokeniser::Block& block, const vfs::FileInfo& fileInfo, const std::string& modDir) override
+    {
+        // Try to parse tables
+        if (parseTable(block, fileInfo))
+        {
+            return; // table successfully parsed
+        }
+
+        if (block.name.substr(0, 5) == "skin ")
+        {
+            return; // skip skin definition
+        }
+
+        if (block.name.substr(0, 9) == "particle ")
+        {
+            return; // skip particle definition
+        }
+
+        auto name = string::replace_all_copy(block.name, "\\", "/"); // use forward slashes
+
+        auto shaderTemplate = std::make_shared<ShaderTemplate>(name, block.contents);
+
+        // Construct the ShaderDefinition wrapper class
+        ShaderDefinition def(shaderTemplate, fileInfo);
+
+        // Insert into the definitions map, if not already present
+        if (!_library->addDefinition(name, def))
+        {
+            rError() << "[shaders] " << fileInfo.name << ": shader " << name << " already defined." << std::endl;
+            _duplicatesByFile[fileInfo.fullPath()].insert(name);
+            return;
+        }
+
+        _addedNames.push_back(name);
     }
 
     ShaderLibraryPtr onFinishParsing() override
     {
         rMessage() << _library->getNumDefinitions() << " shader definitions found." << std::endl;
 
+        // Only needed when parsing changed files
+        _addedNames = std::vector<std::string>();
+
         // Move the resource contained in the local shared_ptr
         return std::move(_library);
     }
 
 private:
+    // Returns the files not in the given set that declared a duplicate of any of the given names
+    std::set<std::string> findFilesDeclaringDuplicates(const std::vector<std::string>& names,
+        const std::set<std::string>& excludedFiles) const
+    {
+        std::set<std::string> result;
+
+        for (const auto& [fullPath, duplicates] : _duplicatesByFile)
+        {
+            if (excludedFiles.count(fullPath) > 0) continue;
+
+            for (const auto& name : names)
+            {
+                if (duplicates.count(name) > 0)
+                {
+                    result.insert(fullPath);
+                    break;
+                }
+            }
+        }
+
+        return result;
+    }
+
     bool parseTable(const parser::BlockTokeniser::Block& block, const vfs::FileInfo& fileInfo)
     {
         if (block.name.length() <= 5 || !string::starts_with(block.name, "table"))
@@ -113,8 +251,11 @@ private:
             if (!_library->addTableDefinition(table))
             {
                 rError() << "[shaders] " << fileInfo.name << ": table " << tableName << " already defined." << std::endl;
+                return true;
             }
 
+            _tablesByFile[fileInfo.fullPath()].push_back(tableName);
+
             return true;
         }
 
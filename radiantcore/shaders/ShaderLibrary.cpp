@@ -9,6 +9,12 @@
 namespace shaders 
 {
 
+namespace
+{
+    // The file the definitions generated for missing materials are associated to
+    constexpr const char* const AUTOGENERATED_FILE_PATH = "materials/_autogenerated_by_darkradiant_.mtr";
+}
+
 // Insert into the definitions map, if not already present
 bool ShaderLibrary::addDefinition(const std::string& name,
 								  const ShaderDefinition& def)
@@ -139,6 +145,41 @@ void ShaderLibrary::removeDefinition(const std::string& name)
     _shaders.erase(name);
 }
 
+std::vector<std::string> ShaderLibrary::removeDefinitionsFromFiles(const std::set<std::string>& fullPaths)
+{
+    std::vector<std::string> removedNames;
+
+    for (auto i = _definitions.begin(); i != _definitions.end();)
+    {
+        auto fullPath = i->second.file.fullPath();
+
+        if (fullPaths.count(fullPath) > 0 || fullPath == AUTOGENERATED_FILE_PATH)
+        {
+            removedNames.push_back(i->first);
+            i = _definitions.erase(i);
+            continue;
+        }
+
+        ++i;
+    }
+
+    return removedNames;
+}
+
+void ShaderLibrary::updateShaders(const std::vector<std::string>& names)
+{
+    for (const auto& name : names)
+    {
+        auto shader = _shaders.find(name);
+
+        if (shader != _shaders.end())
+        {
+            // This will create a fallback definition if the name is gone
+            shader->second->setDefinition(getDefinition(name));
+        }
+    }
+}
+
 ShaderDefinition& ShaderLibrary::getEmptyDefinition()
 {
     if (!_emptyDefinition)
@@ -222,4 +263,9 @@ bool ShaderLibrary::addTableDefinition(const TableDefinitionPtr& def)
     return result.second;
 }
 
+void ShaderLibrary::removeTableDefinition(const std::string& name)
+{
+    _tables.erase(name);
+}
+
 } // namespace shaders
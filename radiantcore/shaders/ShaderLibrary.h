@@ -3,6 +3,8 @@
 #include <string>
 #include <map>
 #include <memory>
+#include <set>
+#include <vector>
 #include "CShader.h"
 #include "TableDefinition.h"
 
@@ -53,6 +55,13 @@ public:
     // Removes the named definition. The name must be present in the library.
     void removeDefinition(const std::string& name);
 
+    // Removes the definitions parsed from the given files (full VFS paths) along with all
+    // autogenerated ones, the shaders created from them are kept. Returns the removed names.
+    std::vector<std::string> removeDefinitionsFromFiles(const std::set<std::string>& fullPaths);
+
+    // Lets the existing shaders of the given names pick up their current definition
+    void updateShaders(const std::vector<std::string>& names);
+
     // Returns an empty definition, just enough to construct a shader from it
     ShaderDefinition& getEmptyDefinition();
 
@@ -80,6 +89,9 @@ public:
 
     // Method for adding tables, returns FALSE if a def with the same name already exists
     bool addTableDefinition(const TableDefinitionPtr& def);
+
+    // Removes the named table, materials that already looked it up keep using it
+    void removeTableDefinition(const std::string& name);
 };
 typedef std::shared_ptr<ShaderLibrary> ShaderLibraryPtr;
 
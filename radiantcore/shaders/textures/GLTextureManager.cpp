@@ -16,28 +16,36 @@ namespace
 
 namespace shaders {
 
-void GLTextureManager::checkBindings()
+namespace
 {
-    // Check the TextureMap for unique pointers and release them
-    // as they aren't used by anyone else than this class.
-    for (TextureMap::iterator i = _textures.begin();
-         i != _textures.end();
-         /* in-loop increment */)
+    // Removes the textures which aren't referenced by anyone else than the given map
+    void releaseUnusedTextures(std::map<std::string, TexturePtr>& textures)
     {
-        // If the std::shared_ptr is unique (i.e. refcount==1), remove it
-        if (i->second.use_count() == 1)
-        {
-            // Be sure to increment the iterator with a postfix ++,
-            // so that the iterator is incremented right before deletion
-            _textures.erase(i++);
-        }
-        else
+        for (auto i = textures.begin(); i != textures.end(); /* in-loop increment */)
         {
-            ++i;
+            // If the std::shared_ptr is unique (i.e. refcount==1), remove it
+            if (i->second.use_count() == 1)
+            {
+                // Be sure to increment the iterator with a postfix ++,
+                // so that the iterator is incremented right before deletion
+                textures.erase(i++);
+            }
+            else
+            {
+                ++i;
+            }
         }
     }
 }
 
+void GLTextureManager::checkBindings()
+{
+    // Check the TextureMaps for unique pointers and release them
+    // as they aren't used by anyone else than this class.
+    releaseUnusedTextures(_textures);
+    releaseUnusedTextures(_previewTextures);
+}
+
 TexturePtr GLTextureManager::getBinding(const NamedBindablePtr& bindable,
                                         BindableTexture::Role role)
 {
@@ -98,11 +106,40 @@ TexturePtr GLTextureManager::getBinding(const std::string& fullPath)
     return _textures[fullPath];
 }
 
+TexturePtr GLTextureManager::getPreviewBinding(const MapExpressionPtr& expression, std::size_t maxSize)
+{
+    if (!expression)
+    {
+        return getShaderNotFound();
+    }
+
+    auto identifier = expression->getIdentifier();
+    auto existing = _previewTextures.find(identifier);
+
+    if (existing != _previewTextures.end())
+    {
+        return existing->second;
+    }
+
+    auto image = expression->getPreviewImage(maxSize);
+    auto texture = image ? image->bindTexture(identifier) : TexturePtr();
+
+    if (texture)
+    {
+        _previewTextures.emplace(identifier, texture);
+        return texture;
+    }
+
+    rError() << "[shaders] Unable to load preview texture: " << identifier << std::endl;
+    return getShaderNotFound();
+}
+
 void GLTextureManager::clearCacheForBindable(const NamedBindablePtr& bindable)
 {
     if (!bindable) return;
 
     _textures.erase(bindable->getIdentifier());
+    _previewTextures.erase(bindable->getIdentifier());
 }
 
 // Return the shader-not-found texture, loading if necessary
@@ -15,6 +15,9 @@ class GLTextureManager
 	typedef std::map<std::string, TexturePtr> TextureMap;
 	TextureMap _textures;
 
+	// Low-resolution textures used for previews, keyed like _textures
+	TextureMap _previewTextures;
+
 	// The fallback textures in case a texture is empty or broken
 	TexturePtr _shaderNotFound;
 
@@ -37,6 +40,13 @@ public:
 	 */
 	TexturePtr getBinding(const std::string& fullPath);
 
+    /**
+     * Construct a low-resolution texture for previews from the given map expression,
+     * fitting into maxSize x maxSize. The texture reports the dimensions of the
+     * full-resolution image. Returns the "shader not found" texture on failure.
+     */
+    TexturePtr getPreviewBinding(const MapExpressionPtr& expression, std::size_t maxSize);
+
     // Removes any Texture references held in the cache referring to this bindable's ID.
     // The next call to getBinding() will produce a new TexturePtr object.
     void clearCacheForBindable(const NamedBindablePtr& bindable);
@@ -139,7 +139,7 @@ void Doom3FileSystem::initialise(const SearchPaths& vfsSearchPaths, const Extens
         initDirectory(path);
     }
 
-    for (Observer* observer : _observers)
+    for (Observer* observer : getObservers())
     {
         observer->onFileSystemInitialise();
     }
@@ -152,7 +152,7 @@ bool Doom3FileSystem::isInitialised() const
 
 void Doom3FileSystem::shutdown()
 {
-    for (Observer* observer : _observers)
+    for (Observer* observer : getObservers())
     {
         observer->onFileSystemShutdown();
     }
@@ -173,14 +173,22 @@ const VirtualFileSystem::ExtensionSet& Doom3FileSystem::getArchiveExtensions() c
 
 void Doom3FileSystem::addObserver(Observer& observer)
 {
+    std::lock_guard<std::mutex> lock(_observersLock);
     _observers.insert(&observer);
 }
 
 void Doom3FileSystem::removeObserver(Observer& observer)
 {
+    std::lock_guard<std::mutex> lock(_observersLock);
     _observers.erase(&observer);
 }
 
+Doom3FileSystem::ObserverList Doom3FileSystem::getObservers()
+{
+    std::lock_guard<std::mutex> lock(_observersLock);
+    return _observers;
+}
+
 int Doom3FileSystem::getFileCount(const std::string& filename)
 {
     int count = 0;
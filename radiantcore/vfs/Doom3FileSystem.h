@@ -2,6 +2,7 @@
 
 #include "iarchive.h"
 #include "ifilesystem.h"
+#include <mutex>
 
 namespace vfs
 {
@@ -32,6 +33,12 @@ private:
 	typedef std::set<Observer*> ObserverList;
 	ObserverList _observers;
 
+	// Observers may subscribe from modules initialised on worker threads
+	std::mutex _observersLock;
+
+	// Returns a copy of the current observers, safe to iterate without the lock
+	ObserverList getObservers();
+
 public:
 	void initialise(const SearchPaths& vfsSearchPaths, const ExtensionSet& allowedExtensions) override;
     bool isInitialised() const override;
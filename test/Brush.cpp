@@ -10,7 +10,9 @@
 #include "algorithm/Primitives.h"
 #include "math/Vector3.h"
 #include "os/path.h"
+#include "string/convert.h"
 #include "testutil/FileSelectionHelper.h"
+#include "render/NopVolumeTest.h"
 
 namespace test
 {
@@ -446,4 +448,199 @@ TEST_F(BrushTest, LoadBrushWithDuplicatePlanes)
     }
 }
 
+TEST_F(BrushTest, TransformedFaceStateIsReleasedOnFreeze)
+{
+    auto worldspawn = GlobalMapModule().findOrInsertWorldspawn();
+    auto brush = algorithm::createCubicBrush(worldspawn, Vector3(0, 0, 0), "textures/numbers/1");
+    Node_getIBrush(brush)->evaluateBRep();
+
+    auto untransformedUsage = brush->getMemoryUsage();
+
+    // Translating the brush allocates the transformed state of each face
+    scene::node_cast<ITransformable>(brush)->setTranslation(Vector3(16, 0, 0));
+    Node_getIBrush(brush)->evaluateBRep();
+
+    auto transformedUsage = brush->getMemoryUsage();
+    EXPECT_GT(transformedUsage, untransformedUsage);
+
+    scene::node_cast<ITransformable>(brush)->freezeTransform();
+    Node_getIBrush(brush)->evaluateBRep();
+
+    EXPECT_LT(brush->getMemoryUsage(), transformedUsage);
+    EXPECT_TRUE(math::isNear(brush->worldAABB().getOrigin(), Vector3(16, 0, 0), 0.01));
+}
+
+// Moving and undoing many brushes rebuilds their windings in one batch
+TEST_F(BrushTest, UndoMoveOfManyBrushesRebuildsWindings)
+{
+    auto worldspawn = GlobalMapModule().findOrInsertWorldspawn();
+    std::vector<scene::INodePtr> brushes;
+
+    for (int i = 0; i < 200; ++i)
+    {
+        brushes.push_back(algorithm::createCubicBrush(worldspawn, Vector3(i * 256.0, 0, 0)));
+    }
+
+    // Returns the bounds of the face windings, which are not evaluated on access
+    auto getWindingBounds = [](const scene::INodePtr& node)
+    {
+        AABB bounds;
+        auto* brush = Node_getIBrush(node);
+
+        for (std::size_t i = 0; i < brush->getNumFaces(); ++i)
+        {
+            for (const auto& vertex : brush->getFace(i).getWinding())
+            {
+                bounds.includePoint(vertex.vertex);
+            }
+        }
+
+        return bounds;
+    };
+
+    GlobalSelectionSystem().setSelectedAll(false);
+
+    for (const auto& brush : brushes)
+    {
+        Node_setSelected(brush, true);
+    }
+
+    GlobalCommandSystem().executeCommand("MoveSelection", cmd::Argument(Vector3(32, 0, 0)));
+
+    for (int i = 0; i < 200; ++i)
+    {
+        EXPECT_TRUE(math::isNear(getWindingBounds(brushes[i]).getOrigin(), Vector3(i * 256.0 + 32, 0, 0), 0.01))
+            << "Brush " << i << " has not been moved";
+    }
+
+    GlobalCommandSystem().executeCommand("Undo");
+
+    for (int i = 0; i < 200; ++i)
+    {
+        const auto bounds = getWindingBounds(brushes[i]);
+
+        EXPECT_TRUE(math::isNear(bounds.getOrigin(), Vector3(i * 256.0, 0, 0), 0.01)) << "Brush " << i << " has not been restored";
+        EXPECT_TRUE(math::isNear(bounds.getExtents(), Vector3(64, 64, 64), 0.01));
+    }
+}
+
+TEST_F(BrushTest, RenderStateIsRetainedUntilChanged)
+{
+    auto worldspawn = GlobalMapModule().findOrInsertWorldspawn();
+    auto brush = algorithm::createCubicBrush(worldspawn, Vector3(0, 0, 0), "textures/numbers/1");
+
+    render::NopVolumeTest volume;
+
+    auto prepareBrush = [&]()
+    {
+        brush->clearRenderStateDirty();
+        brush->onPreRender(volume);
+    };
+
+    EXPECT_TRUE(brush->isRenderStateDirty()) << "New brush needs to be prepared for rendering";
+
+    prepareBrush();
+    EXPECT_FALSE(brush->isRenderStateDirty()) << "Brush should be up to date after onPreRender";
+
+    // Changing the geometry flags the brush
+    scene::node_cast<ITransformable>(brush)->setTranslation(Vector3(16, 0, 0));
+    scene::node_cast<ITransformable>(brush)->freezeTransform();
+    EXPECT_TRUE(brush->isRenderStateDirty()) << "Translation should flag the brush";
+
+    prepareBrush();
+    EXPECT_FALSE(brush->isRenderStateDirty());
+
+    // Changing a material flags the brush
+    Node_getIBrush(brush)->setShader("textures/numbers/2");
+    EXPECT_TRUE(brush->isRenderStateDirty()) << "Shader change should flag the brush";
+
+    prepareBrush();
+    EXPECT_FALSE(brush->isRenderStateDirty());
+
+    // Selected brushes are prepared in every frame
+    Node_setSelected(brush, true);
+    prepareBrush();
+    EXPECT_TRUE(brush->isRenderStateDirty()) << "Selected brush should stay dirty";
+
+    Node_setSelected(brush, false);
+    prepareBrush();
+    EXPECT_FALSE(brush->isRenderStateDirty()) << "Deselected brush should be up to date";
+}
+
+// Replacing the face planes keeps the face objects along with their materials
+TEST_F(BrushTest, SetFacePlanesKeepsFaces)
+{
+    auto worldspawn = GlobalMapModule().findOrInsertWorldspawn();
+    auto brushNode = algorithm::createCubicBrush(worldspawn, Vector3(0, 0, 0), "textures/numbers/1");
+    auto& brush = *Node_getIBrush(brushNode);
+
+    brush.setDetailFlag(IBrush::Detail);
+
+    // Assign a distinct material and texture projection to every face
+    std::vector<IFace*> faces;
+    std::vector<Matrix3> projections;
+
+    for (std::size_t i = 0; i < brush.getNumFaces(); ++i)
+    {
+        auto& face = brush.getFace(i);
+
+        face.setShader("textures/numbers/" + string::to_string(i + 1));
+        face.shiftTexdef(static_cast<float>(i), 0);
+
+        faces.push_back(&face);
+        projections.push_back(face.getProjectionMatrix());
+    }
+
+    // Push every face outwards by 16 units
+    for (std::size_t i = 0; i < brush.getNumFaces(); ++i)
+    {
+        const auto& plane = brush.getFace(i).getPlane3();
+        brush.getFace(i).setPlane(Plane3(plane.normal(), plane.dist() + 16));
+    }
+
+    brush.evaluateBRep();
+
+    ASSERT_EQ(brush.getNumFaces(), faces.size());
+
+    for (std::size_t i = 0; i < brush.getNumFaces(); ++i)
+    {
+        // The face held from before is still the one owned by the brush
+        auto& face = brush.getFace(i);
+        EXPECT_EQ(&face, faces[i]) << "Face " << i << " has been replaced";
+
+        EXPECT_EQ(faces[i]->getShader(), "textures/numbers/" + string::to_string(i + 1));
+        EXPECT_TRUE(faces[i]->getProjectionMatrix() == projections[i]) << "Face " << i << " lost its texture projection";
+        EXPECT_NEAR(faces[i]->getPlane3().dist(), 80, 0.001);
+        EXPECT_EQ(faces[i]->getWinding().size(), 4);
+    }
+
+    EXPECT_EQ(brush.getDetailFlag(), IBrush::Detail);
+    EXPECT_TRUE(math::isNear(brushNode->worldAABB().getExtents(), Vector3(80, 80, 80), 0.01));
+}
+
+// Undoing a plane change restores the previous plane of the face
+TEST_F(BrushTest, SetFacePlaneIsUndoable)
+{
+    auto worldspawn = GlobalMapModule().findOrInsertWorldspawn();
+    auto brushNode = algorithm::createCubicBrush(worldspawn, Vector3(0, 0, 0), "textures/numbers/1");
+    auto& brush = *Node_getIBrush(brushNode);
+
+    auto& face = brush.getFace(0);
+    auto originalPlane = face.getPlane3();
+
+    {
+        UndoableCommand cmd("setFacePlane");
+        face.setPlane(Plane3(originalPlane.normal(), originalPlane.dist() + 16));
+    }
+
+    brush.evaluateBRep();
+    EXPECT_NEAR(face.getPlane3().dist(), originalPlane.dist() + 16, 0.001);
+
+    GlobalUndoSystem().undo();
+    brush.evaluateBRep();
+
+    expectNear(brush.getFace(0).getPlane3(), originalPlane, 0.001);
+    EXPECT_EQ(brush.getFace(0).getShader(), "textures/numbers/1");
+}
+
 }
@@ -21,6 +21,10 @@
 #include "scenelib.h"
 #include "algorithm/Entity.h"
 #include "algorithm/Scene.h"
+#include "os/fs.h"
+#include "os/dir.h"
+#include <fstream>
+#include <future>
 
 namespace test
 {
@@ -136,6 +140,32 @@ TEST_F(EntityTest, EntityClassInheritsAttributes)
     EXPECT_EQ(cls->getAttributeValue("spawnclass", false), "");
 }
 
+TEST_F(EntityTest, EntityClassResolvedConcurrently)
+{
+    // Reloading leaves all classes unresolved until they're accessed
+    GlobalEntityClassManager().reloadDefs();
+
+    auto cls = GlobalEntityClassManager().findClass("light_extinguishable");
+    ASSERT_TRUE(cls);
+
+    std::vector<std::future<bool>> results;
+
+    for (int i = 0; i < 8; ++i)
+    {
+        results.emplace_back(std::async(std::launch::async, [&]()
+        {
+            return cls->isLight() && cls->getParent() && cls->getParent()->getName() == "atdm:light_base" &&
+                cls->getAttributeValue("AIUse") == "AIUSE_LIGHTSOURCE" &&
+                cls->getAttributeValue("editor_color") == "0 1 0";
+        }));
+    }
+
+    for (auto& result : results)
+    {
+        EXPECT_TRUE(result.get());
+    }
+}
+
 TEST_F(EntityTest, VisitInheritedClassAttributes)
 {
     auto cls = GlobalEntityClassManager().findClass("light_extinguishable");
@@ -223,6 +253,88 @@ TEST_F(EntityTest, ReloadDefsOnUnchangedFiles)
     checkBucketEntityDef(eclass);
 }
 
+// Mounts a temporary mod folder into the VFS, such that the test can
+// write .def files without touching the shared test resources
+class EntityDefReloadTest :
+    public RadiantTest
+{
+protected:
+    std::string _modPath;
+
+    void setupGameFolder() override
+    {
+        _modPath = _context.getTemporaryDataPath() + "reloadtest/";
+        os::makeDirectory(_modPath + "def/");
+    }
+
+    void handleGameConfigMessage(game::ConfigurationNeeded& message) override
+    {
+        RadiantTest::handleGameConfigMessage(message);
+
+        auto config = message.getConfig();
+        config.modPath = _modPath;
+        message.setConfig(config);
+    }
+};
+
+TEST_F(EntityDefReloadTest, ReloadChangedDefs)
+{
+    // The temporary folder is removed along with the test context
+    fs::path parentFile = _modPath + "def/_reloadtest_parent.def";
+    fs::path childFile = _modPath + "def/_reloadtest_child.def";
+
+    auto writeParentFile = [&](const std::string& model)
+    {
+        std::ofstream stream(parentFile);
+        stream << "entityDef reloadtest_parent\n{\n    \"model\" \"" << model << "\"\n}\n";
+    };
+
+    EXPECT_FALSE(GlobalEntityClassManager().reloadChangedDefs());
+
+    writeParentFile("models/first.lwo");
+    std::ofstream(childFile) << "entityDef reloadtest_child\n{\n    \"inherit\" \"reloadtest_parent\"\n}\n";
+
+    EXPECT_TRUE(GlobalEntityClassManager().reloadChangedDefs());
+
+    auto child = GlobalEntityClassManager().findClass("reloadtest_child");
+    ASSERT_TRUE(child);
+    EXPECT_EQ(child->getModelPath(), "models/first.lwo");
+
+    // Changing the parent needs to update the child in the unchanged file too
+    writeParentFile("models/second_model.lwo");
+    EXPECT_TRUE(GlobalEntityClassManager().reloadChangedDefs());
+    EXPECT_EQ(child->getModelPath(), "models/second_model.lwo");
+    EXPECT_EQ(GlobalEntityClassManager().findClass("reloadtest_child"), child);
+}
+
+TEST_F(EntityDefReloadTest, InheritanceLoopIsIgnored)
+{
+    std::ofstream(_modPath + "def/_inheritance_loop.def") <<
+        "entityDef loop_first\n{\n    \"inherit\" \"loop_second\"\n    \"first_key\" \"1\"\n}\n"
+        "entityDef loop_second\n{\n    \"inherit\" \"loop_first\"\n    \"second_key\" \"2\"\n}\n";
+
+    EXPECT_TRUE(GlobalEntityClassManager().reloadChangedDefs());
+
+    auto first = GlobalEntityClassManager().findClass("loop_first");
+    auto second = GlobalEntityClassManager().findClass("loop_second");
+    ASSERT_TRUE(first);
+    ASSERT_TRUE(second);
+
+    // The class resolved first inherits from the other one, the loop is cut at the second class
+    auto firstParent = first->getParent();
+    auto secondParent = second->getParent();
+
+    EXPECT_TRUE((firstParent == second.get()) != (secondParent == first.get()))
+        << "Exactly one of the classes should keep its parent";
+    EXPECT_TRUE(firstParent == nullptr || secondParent == nullptr);
+
+    // Attribute lookups walking the parent chain need to return
+    EXPECT_EQ(first->getAttributeValue("first_key"), "1");
+    EXPECT_EQ(second->getAttributeValue("second_key"), "2");
+    EXPECT_EQ(first->getAttributeValue("nonexistent_key"), "");
+    EXPECT_EQ(second->getAttributeValue("nonexistent_key"), "");
+}
+
 TEST_F(EntityTest, CannotCreateEntityWithoutClass)
 {
     // Creating with a null entity class should throw an exception
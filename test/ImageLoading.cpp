@@ -1,7 +1,12 @@
 #include "RadiantTest.h"
 
+#include <fstream>
+#include "os/fs.h"
 #include "iimage.h"
+#include "ifilesystem.h"
+#include "ishaders.h"
 #include "RGBAImage.h"
+#include "BCnDecoder.h"
 
 // Helpers for examining pixel data
 using RGB8 = BasicVector3<uint8_t>;
@@ -14,6 +19,14 @@ std::ostream& operator<< (std::ostream& os, const RGB8& rgb)
               << int(rgb.z()) << "]";
 }
 
+using RGBA8 = BasicVector4<uint8_t>;
+
+std::ostream& operator<< (std::ostream& os, const RGBA8& rgba)
+{
+    return os << "[" << int(rgba.x()) << ", " << int(rgba.y()) << ", "
+              << int(rgba.z()) << ", " << int(rgba.w()) << "]";
+}
+
 // Helper class for retrieving pixels by X and Y coordinates and casting them to
 // the appropriate pixel type.
 template<typename Pixel_T> class Pixelator
@@ -49,6 +62,16 @@ protected:
         auto filePath = _context.getTestProjectPath() + path;
         return GlobalImageLoader().imageFromFile(filePath);
     }
+
+    // Shuts down and initialises the VFS again, using the same search paths
+    void reinitialiseFileSystem()
+    {
+        auto searchPaths = GlobalFileSystem().getVfsSearchPaths();
+        auto extensions = GlobalFileSystem().getArchiveExtensions();
+
+        GlobalFileSystem().shutdown();
+        GlobalFileSystem().initialise(searchPaths, extensions);
+    }
 };
 
 TEST_F(ImageLoadingTest, LoadPng8Bit)
@@ -239,4 +262,222 @@ TEST_F(ImageLoadingTest, LoadDDSCompressedBC5MipMaps)
     EXPECT_EQ(img->getGLFormat(), GL_COMPRESSED_RG_RGTC2);
 }
 
-}
\ No newline at end of file
+TEST_F(ImageLoadingTest, DecompressDDSDXT1)
+{
+    auto img = loadImage("textures/dds/test_128x128_dxt1.dds");
+    ASSERT_TRUE(img);
+
+    auto decompressed = image::decompressImage(*img);
+    ASSERT_TRUE(decompressed);
+
+    EXPECT_EQ(decompressed->getWidth(), 128);
+    EXPECT_EQ(decompressed->getHeight(), 128);
+    EXPECT_FALSE(decompressed->isPrecompressed());
+
+    // Same layout as the uncompressed test image, in RGBA order
+    Pixelator<RGBA8> pixels(*decompressed);
+    EXPECT_EQ(pixels(0, 0), RGBA8(0, 0, 0, 255));         // border
+    EXPECT_EQ(pixels(16, 16), RGBA8(255, 0, 0, 255));     // red diag
+    EXPECT_EQ(pixels(96, 16), RGBA8(255, 255, 255, 255)); // background
+    EXPECT_EQ(pixels(64, 16), RGBA8(255, 0, 255, 255));   // magenta pillar
+    EXPECT_EQ(pixels(16, 64), RGBA8(0, 255, 0, 255));     // green band
+    EXPECT_EQ(pixels(64, 80), RGBA8(0, 255, 255, 255));   // cyan pillar
+    EXPECT_EQ(pixels(127, 127), RGBA8(0, 0, 0, 255));     // border
+}
+
+TEST_F(ImageLoadingTest, DecompressDDSDXT5NPOT)
+{
+    auto img = loadImage("textures/dds/test_60x128_dxt5.dds");
+    ASSERT_TRUE(img);
+
+    auto decompressed = image::decompressImage(*img);
+    ASSERT_TRUE(decompressed);
+
+    EXPECT_EQ(decompressed->getWidth(), 60);
+    EXPECT_EQ(decompressed->getHeight(), 128);
+
+    Pixelator<RGBA8> pixels(*decompressed);
+    EXPECT_EQ(pixels(0, 0), RGBA8(0, 0, 0, 255));         // border
+    EXPECT_EQ(pixels(20, 16), RGBA8(255, 0, 0, 255));     // red diag
+    EXPECT_EQ(pixels(56, 16), RGBA8(255, 0, 255, 255));   // magenta pillar
+    EXPECT_EQ(pixels(40, 64), RGBA8(0, 255, 0, 255));     // green band
+    EXPECT_EQ(pixels(58, 100), RGBA8(0, 255, 255, 255));  // cyan pillar
+    EXPECT_EQ(pixels(59, 127), RGBA8(0, 0, 0, 255));      // border
+}
+
+TEST_F(ImageLoadingTest, DecompressDDSBC5MipMaps)
+{
+    auto img = loadImage("textures/dds/test_16x16_bc5.dds");
+    ASSERT_TRUE(img);
+
+    auto decompressed = image::decompressImage(*img);
+    ASSERT_TRUE(decompressed);
+
+    // Red and green are taken from the file, blue is the reconstructed Z component
+    Pixelator<RGBA8> pixels(*decompressed);
+    EXPECT_EQ(pixels(1, 1), RGBA8(0, 255, 128, 255));
+    EXPECT_EQ(pixels(2, 1), RGBA8(255, 255, 128, 255));
+    EXPECT_EQ(pixels(4, 8), RGBA8(255, 0, 128, 255));
+
+    // Every mipmap level can be decompressed
+    for (std::size_t level = 1; level < img->getLevels(); ++level)
+    {
+        auto mipMap = image::decompressImage(*img, level);
+        ASSERT_TRUE(mipMap);
+        EXPECT_EQ(mipMap->getWidth(), img->getWidth(level));
+        EXPECT_EQ(mipMap->getHeight(), img->getHeight(level));
+    }
+}
+
+TEST_F(ImageLoadingTest, DecompressBC7Blocks)
+{
+    // Mode 6 block, single subset with RGBA endpoints and 4 bit indices running from 0 to 15
+    const uint8_t mode6[16] =
+    {
+        0x40, 0x32, 0x45, 0xa6, 0x55, 0xfc, 0xff, 0x80, 0x10, 0x32, 0x54, 0x76, 0x98, 0xba, 0xdc, 0xfe
+    };
+
+    RGBAImage img(4, 4);
+    image::decodeBlocks(image::BlockFormat::BC7, mode6, 4, 4, img.getPixels());
+
+    Pixelator<RGBA8> pixels(img);
+    EXPECT_EQ(pixels(0, 0), RGBA8(201, 101, 21, 255));
+    EXPECT_EQ(pixels(1, 0), RGBA8(191, 106, 36, 239));
+    EXPECT_EQ(pixels(0, 2), RGBA8(115, 143, 145, 120));
+    EXPECT_EQ(pixels(3, 3), RGBA8(40, 180, 254, 0));
+
+    // Mode 1 block using partition 13 (upper and lower half) with shared p-bits
+    const uint8_t mode1[16] =
+    {
+        0x36, 0xff, 0x0f, 0x00, 0x00, 0xf0, 0xff, 0x8a, 0x42, 0x51, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00
+    };
+
+    image::decodeBlocks(image::BlockFormat::BC7, mode1, 4, 4, img.getPixels());
+
+    for (int y = 0; y < 4; ++y)
+    {
+        for (int x = 0; x < 4; ++x)
+        {
+            EXPECT_EQ(pixels(x, y), y < 2 ? RGBA8(255, 2, 42, 255) : RGBA8(0, 253, 80, 255));
+        }
+    }
+}
+
+TEST_F(ImageLoadingTest, DecompressLargeImageInParallel)
+{
+    // Large enough to be split into several tasks, with partial blocks at the borders
+    constexpr std::size_t Width = 1021;
+    constexpr std::size_t Height = 1022;
+
+    std::vector<uint8_t> blocks(image::getCompressedSize(image::BlockFormat::BC3, Width, Height));
+
+    for (std::size_t i = 0; i < blocks.size(); ++i)
+    {
+        blocks[i] = static_cast<uint8_t>((i * 7919) >> 3);
+    }
+
+    std::vector<uint8_t> parallel(Width * Height * 4);
+    std::vector<uint8_t> sequential(Width * Height * 4);
+
+    image::decodeBlocks(image::BlockFormat::BC3, blocks.data(), Width, Height, parallel.data());
+    image::bcn::decodeBlockRows(image::bcn::decodeBC3, 16, blocks.data(), Width, Height,
+        sequential.data(), 0, (Height + 3) / 4);
+
+    EXPECT_EQ(parallel, sequential);
+}
+
+TEST_F(ImageLoadingTest, LoadPreviewFromVFS)
+{
+    auto preview = GlobalImageLoader().previewImageFromVFS("textures/a_1024x512", 128);
+    ASSERT_TRUE(preview);
+
+    // Downscaled to fit into 128x128, keeping the aspect ratio
+    EXPECT_EQ(preview->getWidth(), 128);
+    EXPECT_EQ(preview->getHeight(), 64);
+    EXPECT_FALSE(preview->isPrecompressed());
+
+    // The second request is served by the thumbnail cache without decoding again
+    auto cached = GlobalImageLoader().previewImageFromVFS("textures/a_1024x512", 128);
+    EXPECT_EQ(cached, preview);
+
+    // After the in-memory thumbnails are dropped, the entry is read back from disk
+    reinitialiseFileSystem();
+
+    auto fromDisk = GlobalImageLoader().previewImageFromVFS("textures/a_1024x512", 128);
+    ASSERT_TRUE(fromDisk);
+    EXPECT_NE(fromDisk, preview);
+    EXPECT_EQ(fromDisk->getWidth(), 128);
+    EXPECT_EQ(fromDisk->getHeight(), 64);
+    EXPECT_TRUE(std::equal(preview->getPixels(), preview->getPixels() + 128 * 64 * 4, fromDisk->getPixels()));
+
+    // Images smaller than the preview size are not scaled up
+    auto unscaled = GlobalImageLoader().previewImageFromVFS("textures/a_1024x512", 2048);
+    ASSERT_TRUE(unscaled);
+    EXPECT_EQ(unscaled->getWidth(), 1024);
+    EXPECT_EQ(unscaled->getHeight(), 512);
+}
+
+TEST_F(ImageLoadingTest, CorruptThumbnailIsIgnored)
+{
+    auto preview = GlobalImageLoader().previewImageFromVFS("textures/a_1024x512", 128);
+    ASSERT_TRUE(preview);
+
+    // Overwrite the stored thumbnail dimensions with huge values
+    auto thumbnailPath = _context.getCacheDataPath() + "thumbnails/";
+    std::size_t numCorruptedFiles = 0;
+
+    for (const auto& entry : fs::directory_iterator(thumbnailPath))
+    {
+        std::fstream file(entry.path().string(), std::ios::binary | std::ios::in | std::ios::out);
+
+        // Header: magic, version, key length, key, original width and height, width, height
+        uint32_t keyLength = 0;
+        file.seekg(8);
+        file.read(reinterpret_cast<char*>(&keyLength), sizeof(keyLength));
+
+        uint32_t hugeSize = 0xFFFFFFFF;
+        file.seekp(12 + keyLength + 8);
+        file.write(reinterpret_cast<const char*>(&hugeSize), sizeof(hugeSize));
+        file.write(reinterpret_cast<const char*>(&hugeSize), sizeof(hugeSize));
+
+        ++numCorruptedFiles;
+    }
+
+    EXPECT_GT(numCorruptedFiles, 0) << "No thumbnails found in " << thumbnailPath;
+
+    // Drop the thumbnails held in memory, such that the file is read again
+    reinitialiseFileSystem();
+
+    // The corrupt entry is rejected and the preview is generated again
+    auto regenerated = GlobalImageLoader().previewImageFromVFS("textures/a_1024x512", 128);
+    ASSERT_TRUE(regenerated);
+    EXPECT_EQ(regenerated->getWidth(), 128);
+    EXPECT_EQ(regenerated->getHeight(), 64);
+}
+
+TEST_F(ImageLoadingTest, LoadDDSPreviewFromMipMap)
+{
+    // The DDS is located in the dds/ folder, the preview is taken from the 15x32 mipmap
+    auto preview = GlobalImageLoader().previewImageFromVFS("textures/dds/test_60x128_dxt5_mips", 32);
+    ASSERT_TRUE(preview);
+
+    EXPECT_EQ(preview->getWidth(), 15);
+    EXPECT_EQ(preview->getHeight(), 32);
+    EXPECT_FALSE(preview->isPrecompressed());
+    EXPECT_EQ(preview->getGLFormat(), GL_RGBA);
+}
+
+TEST_F(ImageLoadingTest, EditorImagePreviewReportsOriginalSize)
+{
+    auto material = GlobalMaterialManager().getMaterial("textures/a_1024x512");
+
+    auto preview = material->getEditorImagePreview();
+    ASSERT_TRUE(preview);
+
+    // Thumbnails are laid out using the dimensions of the full image
+    EXPECT_NE(preview, material->getEditorImage());
+    EXPECT_EQ(preview->getWidth(), 1024);
+    EXPECT_EQ(preview->getHeight(), 512);
+}
+
+}
@@ -2,7 +2,10 @@
 
 #include "imap.h"
 #include "ilayer.h"
+#include "ibrush.h"
+#include "iselection.h"
 #include "algorithm/Scene.h"
+#include "algorithm/Primitives.h"
 #include "scenelib.h"
 
 namespace test
@@ -110,4 +113,124 @@ TEST_F(LayerTest, RemovingFromLayerMarksMapAsModified)
     performMoveOrAddToLayerTest(LayerAction::RemoveFromLayer);
 }
 
+TEST_F(LayerTest, LayerListBehavesLikeOrderedSet)
+{
+    // Mix IDs of the inline range with negative and large ones
+    scene::LayerList layers{ 70, 3, -1, 0, 3 };
+
+    EXPECT_EQ(layers.size(), 4);
+    EXPECT_EQ(std::vector<int>(layers.begin(), layers.end()), std::vector<int>({ -1, 0, 3, 70 }));
+
+    EXPECT_EQ(layers.count(70), 1);
+    EXPECT_EQ(layers.count(64), 0);
+    EXPECT_NE(layers.find(3), layers.end());
+    EXPECT_EQ(*layers.find(70), 70);
+
+    EXPECT_EQ(layers.erase(3), 1);
+    EXPECT_EQ(layers.erase(3), 0);
+    EXPECT_EQ(layers.erase(-1), 1);
+
+    EXPECT_EQ(layers, scene::LayerList({ 0, 70 }));
+    EXPECT_NE(layers, scene::LayerList({ 0 }));
+
+    layers.clear();
+    EXPECT_TRUE(layers.empty());
+    EXPECT_EQ(layers.begin(), layers.end());
+}
+
+TEST_F(LayerTest, LayerVisibilityAffectsMembersAndTheirParents)
+{
+    auto& layerManager = GlobalMapModule().getRoot()->getLayerManager();
+    auto layerId = layerManager.createLayer("TestLayer");
+
+    auto worldspawn = GlobalMapModule().findOrInsertWorldspawn();
+    auto brush1 = GlobalBrushCreator().createBrush();
+    auto brush2 = GlobalBrushCreator().createBrush();
+    scene::addNodeToContainer(brush1, worldspawn);
+    scene::addNodeToContainer(brush2, worldspawn);
+
+    layerManager.assignNodesToLayers({ brush1 }, scene::LayerList{ layerId });
+    EXPECT_EQ(brush1->getLayers(), scene::LayerList({ layerId }));
+
+    layerManager.setLayerVisibility(layerId, false);
+
+    EXPECT_TRUE(brush1->checkStateFlag(scene::Node::eLayered));
+    EXPECT_FALSE(brush2->checkStateFlag(scene::Node::eLayered));
+    EXPECT_FALSE(worldspawn->checkStateFlag(scene::Node::eLayered));
+
+    // Hiding the default layer too hides the worldspawn, all its children are hidden
+    layerManager.setLayerVisibility(0, false);
+
+    EXPECT_TRUE(brush2->checkStateFlag(scene::Node::eLayered));
+    EXPECT_TRUE(worldspawn->checkStateFlag(scene::Node::eLayered));
+
+    // Showing the test layer brings the worldspawn back, as one of its children is visible
+    layerManager.setLayerVisibility(layerId, true);
+
+    EXPECT_FALSE(brush1->checkStateFlag(scene::Node::eLayered));
+    EXPECT_TRUE(brush2->checkStateFlag(scene::Node::eLayered));
+    EXPECT_FALSE(worldspawn->checkStateFlag(scene::Node::eLayered));
+
+    layerManager.setLayerVisibility(0, true);
+
+    // Deleting the layer moves its members back to the default layer
+    layerManager.deleteLayer("TestLayer");
+    EXPECT_EQ(brush1->getLayers(), scene::LayerList({ 0 }));
+
+    // Removed nodes are no longer affected by the layer
+    scene::removeNodeFromParent(brush2);
+    layerManager.setLayerVisibility(0, false);
+    EXPECT_FALSE(brush2->checkStateFlag(scene::Node::eLayered));
+    EXPECT_TRUE(brush1->checkStateFlag(scene::Node::eLayered));
+}
+
+TEST_F(LayerTest, SelectingLayerFollowsMemberOrder)
+{
+    auto& layerManager = GlobalMapModule().getRoot()->getLayerManager();
+    auto layerId = layerManager.createLayer("TestLayer");
+
+    auto worldspawn = GlobalMapModule().findOrInsertWorldspawn();
+
+    std::vector<scene::INodePtr> brushes;
+
+    for (int i = 0; i < 16; ++i)
+    {
+        brushes.push_back(algorithm::createCubicBrush(worldspawn, Vector3(i * 128, 0, 0)));
+    }
+
+    layerManager.assignNodesToLayers(brushes, scene::LayerList{ layerId });
+
+    // Selecting the layer twice yields the members in the order they joined the layer
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        GlobalSelectionSystem().setSelectedAll(false);
+        layerManager.setSelected(layerId, true);
+
+        std::vector<scene::INodePtr> selected;
+        GlobalSelectionSystem().foreachSelected([&](const scene::INodePtr& node)
+        {
+            selected.push_back(node);
+        });
+
+        EXPECT_EQ(selected, brushes) << "Layer members should be selected in insertion order";
+    }
+
+    // A node leaving and re-joining the layer moves to the end
+    scene::removeNodeFromParent(brushes.front());
+    scene::addNodeToContainer(brushes.front(), worldspawn);
+
+    GlobalSelectionSystem().setSelectedAll(false);
+    layerManager.setSelected(layerId, true);
+
+    std::vector<scene::INodePtr> selected;
+    GlobalSelectionSystem().foreachSelected([&](const scene::INodePtr& node)
+    {
+        selected.push_back(node);
+    });
+
+    ASSERT_EQ(selected.size(), brushes.size());
+    EXPECT_EQ(selected.back(), brushes.front());
+    EXPECT_EQ(selected.front(), brushes[1]);
+}
+
 }
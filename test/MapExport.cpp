@@ -7,6 +7,7 @@
 #include "math/Matrix3.h"
 #include "iselection.h"
 #include "scenelib.h"
+#include "scene/Traverse.h"
 #include "os/path.h"
 #include "string/predicate.h"
 #include "xmlutil/Document.h"
@@ -292,6 +293,67 @@ brushDef3
 namespace
 {
 
+// Forwards all calls to the wrapped writer, without supporting per-entity writers
+class SequentialMapWriter :
+    public map::IMapWriter
+{
+private:
+    map::IMapWriterPtr _writer;
+
+public:
+    SequentialMapWriter(const map::IMapWriterPtr& writer) :
+        _writer(writer)
+    {}
+
+    void beginWriteMap(const scene::IMapRootNodePtr& root, std::ostream& stream) override { _writer->beginWriteMap(root, stream); }
+    void endWriteMap(const scene::IMapRootNodePtr& root, std::ostream& stream) override { _writer->endWriteMap(root, stream); }
+    void beginWriteEntity(const IEntityNodePtr& entity, std::ostream& stream) override { _writer->beginWriteEntity(entity, stream); }
+    void endWriteEntity(const IEntityNodePtr& entity, std::ostream& stream) override { _writer->endWriteEntity(entity, stream); }
+    void beginWriteBrush(const IBrushNodePtr& brush, std::ostream& stream) override { _writer->beginWriteBrush(brush, stream); }
+    void endWriteBrush(const IBrushNodePtr& brush, std::ostream& stream) override { _writer->endWriteBrush(brush, stream); }
+    void beginWritePatch(const IPatchNodePtr& patch, std::ostream& stream) override { _writer->beginWritePatch(patch, stream); }
+    void endWritePatch(const IPatchNodePtr& patch, std::ostream& stream) override { _writer->endWritePatch(patch, stream); }
+};
+
+std::string exportMapUsingWriter(map::IMapWriter& writer)
+{
+    std::ostringstream output;
+
+    // The exporter prepares the scene and restores it on destruction
+    auto exporter = GlobalMapModule().createMapExporter(writer, GlobalMapModule().getRoot(), output);
+    exporter->exportMap(GlobalMapModule().getRoot(), scene::traverse);
+
+    return output.str();
+}
+
+}
+
+// Entities written in parallel into separate buffers need to produce the same text as the sequential export
+TEST_F(MapExportTest, ParallelEntityExportMatchesSequentialExport)
+{
+    loadMap("altar.map");
+
+    for (const auto& gameType : { "doom3", "quake4", "quake3", "quake3alternate" })
+    {
+        auto format = GlobalMapFormatManager().getMapFormatForGameType(gameType, "map");
+        ASSERT_TRUE(format) << "Could not find a map format for game type " << gameType;
+
+        auto writer = format->getMapWriter();
+        EXPECT_TRUE(writer->createEntityWriter(0)) << gameType << " writer doesn't support per-entity writers";
+
+        SequentialMapWriter sequentialWriter(format->getMapWriter());
+
+        auto parallelText = exportMapUsingWriter(*writer);
+        auto sequentialText = exportMapUsingWriter(sequentialWriter);
+
+        EXPECT_NE(parallelText.find("// entity 1"), std::string::npos) << "Export of " << gameType << " contains too few entities";
+        EXPECT_EQ(parallelText, sequentialText) << "Parallel export of " << gameType << " differs from the sequential one";
+    }
+}
+
+namespace
+{
+
 void runExportWithEmptyFileExtension(const std::string& temporaryDataPath,const std::string& command)
 {
     auto brush = algorithm::createCuboidBrush(GlobalMapModule().findOrInsertWorldspawn(),
@@ -2,6 +2,9 @@
 
 #include "ishaders.h"
 #include <algorithm>
+#include <fstream>
+#include "os/fs.h"
+#include "os/dir.h"
 #include "string/split.h"
 #include "string/case_conv.h"
 #include "string/trim.h"
@@ -1527,4 +1530,105 @@ TEST_F(MaterialsTest, CoverageOfMaterialWithBlendStage)
     EXPECT_EQ(material->getCoverage(), Material::MC_OPAQUE) << "Material should be opaque";
 }
 
+// Mounts a temporary mod folder into the VFS, such that the test can
+// write .mtr files without touching the shared test resources
+class MaterialRefreshTest :
+    public RadiantTest
+{
+protected:
+    std::string _modPath;
+
+    void setupGameFolder() override
+    {
+        _modPath = _context.getTemporaryDataPath() + "refreshtest/";
+        os::makeDirectory(_modPath + "materials/");
+    }
+
+    void handleGameConfigMessage(game::ConfigurationNeeded& message) override
+    {
+        RadiantTest::handleGameConfigMessage(message);
+
+        auto config = message.getConfig();
+        config.modPath = _modPath;
+        message.setConfig(config);
+    }
+
+    void writeMaterialFile(const std::string& filename, const std::string& name, const std::string& description)
+    {
+        std::ofstream stream(_modPath + "materials/" + filename);
+        stream << name << "\n{\n    description \"" << description << "\"\n}\n";
+    }
+};
+
+TEST_F(MaterialRefreshTest, RefreshChangedFiles)
+{
+    // The temporary folder is removed along with the test context
+    fs::path materialFile = _modPath + "materials/_refreshtest.mtr";
+
+    auto writeChangedMaterial = [&](const std::string& description)
+    {
+        writeMaterialFile(materialFile.filename().string(), "textures/refreshtest/changed", description);
+    };
+
+    auto& materialManager = GlobalMaterialManager();
+
+    // Nothing changed since the materials have been loaded
+    EXPECT_FALSE(materialManager.refreshChangedFiles());
+
+    auto unchangedMaterial = materialManager.getMaterial("textures/orbweaver/drain_grille");
+    auto unchangedDefinition = unchangedMaterial->getDefinition();
+
+    // Adding a new file
+    writeChangedMaterial("First");
+    EXPECT_TRUE(materialManager.refreshChangedFiles());
+    EXPECT_TRUE(materialManager.materialExists("textures/refreshtest/changed"));
+
+    auto material = materialManager.getMaterial("textures/refreshtest/changed");
+    EXPECT_EQ(material->getDescription(), "First");
+
+    // Modifying it (the file size differs, so this is detected regardless of the timestamp resolution)
+    writeChangedMaterial("Second version");
+    EXPECT_TRUE(materialManager.refreshChangedFiles());
+    EXPECT_FALSE(materialManager.refreshChangedFiles()) << "Nothing should have changed a second time";
+
+    // The existing material instance has been updated
+    EXPECT_EQ(material->getDescription(), "Second version");
+    EXPECT_EQ(materialManager.getMaterial("textures/refreshtest/changed"), material);
+
+    // Materials in the other files are untouched
+    EXPECT_EQ(materialManager.getMaterial("textures/orbweaver/drain_grille"), unchangedMaterial);
+    EXPECT_EQ(unchangedMaterial->getDefinition(), unchangedDefinition);
+
+    // Removing the file drops the declaration, the material still in use falls back to a generated one
+    fs::remove(materialFile);
+    EXPECT_TRUE(materialManager.refreshChangedFiles());
+    EXPECT_EQ(material->getShaderFileInfo().name, "_autogenerated_by_darkradiant_.mtr");
+}
+
+TEST_F(MaterialRefreshTest, RemovingFileRestoresDuplicateDeclaration)
+{
+    auto& materialManager = GlobalMaterialManager();
+
+    // Both files declare the same material, the first one in lexicographical order wins
+    writeMaterialFile("_refreshdup_a.mtr", "textures/refreshtest/duplicate", "Defined in a");
+    writeMaterialFile("_refreshdup_b.mtr", "textures/refreshtest/duplicate", "Defined in b");
+    EXPECT_TRUE(materialManager.refreshChangedFiles());
+
+    auto material = materialManager.getMaterial("textures/refreshtest/duplicate");
+    EXPECT_EQ(material->getDescription(), "Defined in a");
+    EXPECT_EQ(material->getShaderFileInfo().name, "_refreshdup_a.mtr");
+
+    // Removing the winning file brings back the declaration in the other file
+    fs::remove(_modPath + "materials/_refreshdup_a.mtr");
+    EXPECT_TRUE(materialManager.refreshChangedFiles());
+
+    EXPECT_TRUE(materialManager.materialExists("textures/refreshtest/duplicate"));
+    EXPECT_EQ(materialManager.getMaterial("textures/refreshtest/duplicate"), material);
+    EXPECT_EQ(material->getDescription(), "Defined in b");
+    EXPECT_EQ(material->getShaderFileInfo().name, "_refreshdup_b.mtr");
+
+    // Nothing is left to re-parse
+    EXPECT_FALSE(materialManager.refreshChangedFiles());
+}
+
 }
@@ -3,6 +3,7 @@
 #include "algorithm/Scene.h"
 #include "iscenegraph.h"
 #include "imodel.h"
+#include "imodelsurface.h"
 #include "itransformable.h"
 #include "icommandsystem.h"
 #include "iselectable.h"
@@ -60,4 +61,63 @@ TEST_F(RadiantTest, DuplicateScaledModel)
     ASSERT_TRUE(duplicatedModel->getModelScale() == scale);
 }
 
+namespace
+{
+
+inline std::uint64_t getFirstSurfaceGeometryKey(const model::ModelNodePtr& model)
+{
+    const auto& surface = model->getIModel().getSurface(0);
+    return dynamic_cast<const model::IIndexedModelSurface&>(surface).getGeometryKey();
+}
+
+inline void setModelScale(const scene::INodePtr& entity, const Vector3& scale)
+{
+    entity->foreachNode([&](const scene::INodePtr& node)
+    {
+        if (auto transformable = scene::node_cast<ITransformable>(node); transformable)
+        {
+            transformable->setType(TRANSFORM_PRIMITIVE);
+            transformable->setScale(scale);
+        }
+
+        return true;
+    });
+}
+
+}
+
+TEST_F(RadiantTest, ScaledModelKeepsItsGeometryKey)
+{
+    loadMap("duplicate_scaled_model.map");
+
+    auto func_static = algorithm::getEntityByName(GlobalSceneGraph().root(), "moss01");
+    auto model = algorithm::findChildModel(func_static);
+
+    auto sharedKey = getFirstSurfaceGeometryKey(model);
+    EXPECT_NE(sharedKey, 0) << "Unscaled model surfaces should share their geometry";
+
+    // Scaling the model assigns a private key to its surfaces
+    setModelScale(func_static, Vector3(2, 2, 2));
+    auto privateKey = getFirstSurfaceGeometryKey(model);
+    EXPECT_NE(privateKey, 0);
+    EXPECT_NE(privateKey, sharedKey);
+
+    // Scaling it again keeps the private key, the renderer can update the geometry in place
+    setModelScale(func_static, Vector3(3, 4, 2));
+    EXPECT_EQ(getFirstSurfaceGeometryKey(model), privateKey);
+
+    // Reverting the scale restores the shared key
+    func_static->foreachNode([&](const scene::INodePtr& node)
+    {
+        if (auto transformable = scene::node_cast<ITransformable>(node); transformable)
+        {
+            transformable->revertTransform();
+        }
+
+        return true;
+    });
+
+    EXPECT_EQ(getFirstSurfaceGeometryKey(model), sharedKey) << "Reverted model should share its geometry again";
+}
+
 }
@@ -3,6 +3,15 @@
 #include <unordered_set>
 #include "imodelsurface.h"
 #include "imodelcache.h"
+#include "ieclass.h"
+#include "ientity.h"
+#include "imap.h"
+#include "itraceable.h"
+#include "itransformable.h"
+#include "math/Ray.h"
+#include "os/path.h"
+#include "registry/registry.h"
+#include "scenelib.h"
 
 #include "render/VertexHashing.h"
 
@@ -453,4 +462,216 @@ TEST_F(ModelTest, LoadFbxModel)
     EXPECT_EQ(model->getPolyCount(), 12);
 }
 
+TEST_F(ModelTest, PreloadedModelsMatchRegularLoad)
+{
+    std::set<std::string> modelPaths
+    {
+        "models/torch.lwo",
+        "models/twosided_ivy.lwo",
+        "models/moss_patch.ase",
+        "models/ase/tiles.ase",
+        "models/doesnt_exist.lwo", // missing file
+        "func_static_1",           // brush-based entity, no model file
+    };
+
+    GlobalModelCache().preloadModels(modelPaths);
+
+    for (const auto& path : modelPaths)
+    {
+        auto node = GlobalModelCache().getModelNode(path);
+        EXPECT_TRUE(node) << "No model node for " << path;
+
+        auto modelNode = Node_getModel(node);
+
+        if (path == "models/doesnt_exist.lwo" || path == "func_static_1")
+        {
+            continue;
+        }
+
+        EXPECT_TRUE(modelNode) << "Not a model node: " << path;
+
+        // The node should reference the cached model instance
+        auto cachedModel = GlobalModelCache().getModel(path);
+        EXPECT_EQ(&modelNode->getIModel(), cachedModel.get()) << "Node doesn't reference the cached model " << path;
+
+        // Compare the preloaded model to one loaded the regular way
+        auto importer = GlobalModelFormatManager().getImporter(os::getExtension(path));
+        auto regularModel = importer->loadModelFromPath(path);
+
+        EXPECT_EQ(cachedModel->getSurfaceCount(), regularModel->getSurfaceCount());
+        EXPECT_EQ(cachedModel->getVertexCount(), regularModel->getVertexCount());
+        EXPECT_EQ(cachedModel->getPolyCount(), regularModel->getPolyCount());
+
+        for (int i = 0; i < cachedModel->getSurfaceCount(); ++i)
+        {
+            EXPECT_EQ(cachedModel->getSurface(i).getDefaultMaterial(), regularModel->getSurface(i).getDefaultMaterial());
+        }
+    }
+}
+
+TEST_F(ModelTest, ModelCacheEvictsUnusedModels)
+{
+    GlobalModelCache().clear();
+
+    // Any model exceeds a budget of a few bytes
+    registry::setValue("user/ui/modelCache/memoryBudget", "0.00001");
+
+    auto statistics = GlobalModelCache().getStatistics();
+    EXPECT_EQ(statistics.numModels, 0);
+
+    auto evictionsBefore = statistics.numEvictions;
+
+    // Keep a node referencing the first model, the second one is unused
+    auto node = GlobalModelCache().getModelNode("models/ase/testcube.ase");
+    auto unusedModel = GlobalModelCache().getModel("models/ase/tiles.ase");
+    unusedModel.reset();
+
+    // Loading another model evicts the unused one
+    auto model = GlobalModelCache().getModel("models/torch.lwo");
+
+    statistics = GlobalModelCache().getStatistics();
+    EXPECT_EQ(statistics.numEvictions, evictionsBefore + 1);
+    EXPECT_EQ(statistics.numModels, 2);
+    EXPECT_GT(statistics.totalSize, statistics.memoryBudget);
+
+    // The referenced model is still cached
+    auto hitsBefore = statistics.numHits;
+    GlobalModelCache().getModel("models/ase/testcube.ase");
+    EXPECT_EQ(GlobalModelCache().getStatistics().numHits, hitsBefore + 1);
+
+    // Removing the budget doesn't evict anything
+    registry::setValue("user/ui/modelCache/memoryBudget", "0");
+    model.reset();
+    node.reset();
+    GlobalModelCache().getModel("models/ase/tiles.ase");
+
+    statistics = GlobalModelCache().getStatistics();
+    EXPECT_EQ(statistics.numEvictions, evictionsBefore + 1);
+    EXPECT_EQ(statistics.numModels, 3);
+}
+
+TEST_F(ModelTest, ModelInstancesShareGeometryKey)
+{
+    std::vector<scene::INodePtr> modelNodes;
+
+    for (int i = 0; i < 2; ++i)
+    {
+        auto entity = GlobalEntityModule().createEntity(GlobalEntityClassManager().findClass("func_static"));
+        scene::addNodeToContainer(entity, GlobalMapModule().getRoot());
+        entity->getEntity().setKeyValue("model", "models/torch.lwo");
+
+        entity->foreachNode([&](const scene::INodePtr& child)
+        {
+            if (Node_getModel(child)) modelNodes.push_back(child);
+            return true;
+        });
+    }
+
+    ASSERT_EQ(modelNodes.size(), 2) << "Model nodes not attached";
+
+    auto getGeometryKey = [](const scene::INodePtr& node)
+    {
+        const auto& surface = Node_getModel(node)->getIModel().getSurface(0);
+        return dynamic_cast<const model::IIndexedModelSurface&>(surface).getGeometryKey();
+    };
+
+    // Both instances can be stored once in the renderer
+    EXPECT_NE(getGeometryKey(modelNodes[0]), 0);
+    EXPECT_EQ(getGeometryKey(modelNodes[0]), getGeometryKey(modelNodes[1]));
+
+    // Scaling one instance changes its geometry, it can't be shared any longer
+    auto transformable = scene::node_cast<ITransformable>(modelNodes[1]);
+    ASSERT_TRUE(transformable);
+
+    transformable->setType(TRANSFORM_PRIMITIVE);
+    transformable->setScale(Vector3(2, 2, 2));
+    transformable->freezeTransform();
+
+    EXPECT_NE(getGeometryKey(modelNodes[1]), 0);
+    EXPECT_NE(getGeometryKey(modelNodes[0]), getGeometryKey(modelNodes[1]));
+}
+
+TEST_F(ModelTest, RayIntersectionMatchesTransformedTriangles)
+{
+    auto entity = GlobalEntityModule().createEntity(GlobalEntityClassManager().findClass("func_static"));
+    scene::addNodeToContainer(entity, GlobalMapModule().getRoot());
+
+    entity->getEntity().setKeyValue("origin", "128 -56 32");
+    entity->getEntity().setKeyValue("rotation", "0.707107 0.707107 0 -0.707107 0.707107 0 0 0 1");
+    entity->getEntity().setKeyValue("model", "models/torch.lwo");
+
+    scene::INodePtr modelNode;
+    entity->foreachNode([&](const scene::INodePtr& child)
+    {
+        if (Node_getModel(child)) modelNode = child;
+        return true;
+    });
+
+    ASSERT_TRUE(modelNode) << "No model node attached";
+
+    auto traceable = std::dynamic_pointer_cast<ITraceable>(modelNode);
+    ASSERT_TRUE(traceable);
+
+    const auto& model = Node_getModel(modelNode)->getIModel();
+    const auto& localToWorld = modelNode->localToWorld();
+    const auto& bounds = modelNode->worldAABB();
+
+    // Aim rays from various directions at points within the model bounds
+    std::size_t numHits = 0;
+
+    for (int i = 0; i < 200; ++i)
+    {
+        auto theta = i * 0.61;
+        auto phi = i * 0.37;
+        Vector3 origin = bounds.getOrigin() + Vector3(cos(theta) * sin(phi), sin(theta) * sin(phi), cos(phi)) * 256;
+        Vector3 target = bounds.getOrigin() + Vector3(
+            bounds.getExtents().x() * sin(i * 1.3), bounds.getExtents().y() * cos(i * 0.7), bounds.getExtents().z() * sin(i * 2.1));
+
+        auto ray = Ray::createForPoints(origin, target);
+
+        // Find the expected intersection by testing every triangle in world space
+        auto bestDistSquared = std::numeric_limits<double>::max();
+        Vector3 expected;
+
+        for (int s = 0; s < model.getSurfaceCount(); ++s)
+        {
+            const auto& surface = model.getSurface(s);
+
+            for (int p = 0; p < surface.getNumTriangles(); ++p)
+            {
+                auto poly = surface.getPolygon(p);
+                Vector3 triIntersection;
+
+                if (ray.intersectTriangle(localToWorld.transformPoint(poly.a.vertex), localToWorld.transformPoint(poly.b.vertex),
+                    localToWorld.transformPoint(poly.c.vertex), triIntersection) != Ray::POINT)
+                {
+                    continue;
+                }
+
+                auto distSquared = (triIntersection - ray.origin).getLengthSquared();
+
+                if (distSquared > 0 && distSquared < bestDistSquared)
+                {
+                    bestDistSquared = distSquared;
+                    expected = triIntersection;
+                }
+            }
+        }
+
+        Vector3 intersection;
+        auto hit = traceable->getIntersection(ray, intersection);
+
+        EXPECT_EQ(hit, bestDistSquared < std::numeric_limits<double>::max()) << "Hit mismatch for ray " << i;
+
+        if (hit)
+        {
+            ++numHits;
+            EXPECT_TRUE(math::isNear(intersection, expected, 0.01)) << "Intersection mismatch for ray " << i
+                << ": " << intersection << " vs. " << expected;
+        }
+    }
+
+    EXPECT_GT(numHits, 0) << "None of the rays hit the model";
+}
+
 }
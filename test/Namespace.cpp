@@ -0,0 +1,61 @@
+#include "RadiantTest.h"
+
+#include "inamespace.h"
+
+namespace test
+{
+
+using NamespaceTest = RadiantTest;
+
+TEST_F(NamespaceTest, AddUniqueNameUsesLowestFreeNumber)
+{
+    auto nspace = GlobalNamespaceFactory().createNamespace();
+
+    EXPECT_EQ(nspace->addUniqueName("light_1"), "light_1");
+    EXPECT_EQ(nspace->addUniqueName("light_2"), "light_2");
+    EXPECT_EQ(nspace->addUniqueName("light_4"), "light_4");
+
+    // The gap at 3 is filled first, then numbering continues after 4
+    EXPECT_EQ(nspace->addUniqueName("light_1"), "light_3");
+    EXPECT_EQ(nspace->addUniqueName("light_1"), "light_5");
+
+    // A name without postfix is kept as it is the first time
+    EXPECT_EQ(nspace->addUniqueName("light_"), "light_");
+    EXPECT_EQ(nspace->addUniqueName("light_"), "light_6");
+}
+
+TEST_F(NamespaceTest, AddUniqueNameReusesErasedNumbers)
+{
+    auto nspace = GlobalNamespaceFactory().createNamespace();
+
+    for (int i = 1; i <= 100; ++i)
+    {
+        EXPECT_EQ(nspace->addUniqueName("func_static_1"), "func_static_" + std::to_string(i));
+    }
+
+    EXPECT_TRUE(nspace->erase("func_static_50"));
+    EXPECT_TRUE(nspace->erase("func_static_7"));
+    EXPECT_FALSE(nspace->nameExists("func_static_7"));
+
+    EXPECT_EQ(nspace->addUniqueName("func_static_1"), "func_static_7");
+    EXPECT_EQ(nspace->addUniqueName("func_static_1"), "func_static_50");
+    EXPECT_EQ(nspace->addUniqueName("func_static_1"), "func_static_101");
+}
+
+TEST_F(NamespaceTest, LeadingZeroPostfixesAreDistinct)
+{
+    auto nspace = GlobalNamespaceFactory().createNamespace();
+
+    // "04" and "4" are different names, "04" doesn't block the number 4
+    EXPECT_TRUE(nspace->insert("speaker_04"));
+    EXPECT_TRUE(nspace->insert("speaker_1"));
+
+    EXPECT_TRUE(nspace->nameExists("speaker_04"));
+    EXPECT_FALSE(nspace->nameExists("speaker_4"));
+
+    EXPECT_EQ(nspace->addUniqueName("speaker_04"), "speaker_2");
+    EXPECT_EQ(nspace->addUniqueName("speaker_1"), "speaker_3");
+    EXPECT_EQ(nspace->addUniqueName("speaker_1"), "speaker_4");
+}
+
+}
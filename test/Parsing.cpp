@@ -1,7 +1,11 @@
 #include "RadiantTest.h"
 
+#include <sstream>
+#include "iaasfile.h"
 #include "isound.h"
 #include "parser/DefBlockTokeniser.h"
+#include "parser/BufferTokeniser.h"
+#include "parser/DeclBlockCache.h"
 
 namespace test
 {
@@ -113,6 +117,126 @@ TEST(DefBlockTokeniser, BlockSeparation)
     });
 }
 
+TEST(BufferTokeniser, TokensAndDelimiters)
+{
+    std::string testString = R"(settings {
+    bboxes
+    {
+        (-16 -16 0)-(16 16 72)
+    }
+    fileExtension = "aas48" // comment
+    /* delimited
+       comment */ usePatches = 0
+})";
+
+    parser::BufferTokeniser tok(testString);
+
+    std::vector<std::string> expectedTokens = {
+        "settings", "{", "bboxes", "{", "(", "-16", "-16", "0", ")", "-", "(", "16", "16", "72", ")", "}",
+        "fileExtension", "=", "aas48", "usePatches", "=", "0", "}"
+    };
+
+    for (const auto& expected : expectedTokens)
+    {
+        EXPECT_TRUE(tok.hasMoreTokens());
+        EXPECT_EQ(tok.nextToken(), expected);
+    }
+
+    EXPECT_FALSE(tok.hasMoreTokens());
+}
+
+TEST(BufferTokeniser, NumericFastPath)
+{
+    std::string testString = "planes 1 { 0 ( 1 -0.5 +3e2 -12.25 ) } 7abc";
+
+    parser::BufferTokeniser tok(testString);
+
+    tok.assertNextToken("planes");
+    EXPECT_EQ(tok.nextNumber<std::size_t>(), 1);
+    tok.assertNextToken("{");
+    EXPECT_EQ(tok.nextNumber<int>(), 0);
+    tok.assertNextToken("(");
+    EXPECT_EQ(tok.nextNumber<double>(), 1.0);
+    EXPECT_EQ(tok.nextNumber<double>(), -0.5);
+    EXPECT_EQ(tok.nextNumber<double>(), 300.0);
+    EXPECT_EQ(tok.nextNumber<float>(), -12.25f);
+    tok.assertNextToken(")");
+    tok.assertNextToken("}");
+
+    // Trailing garbage is not accepted
+    EXPECT_THROW(tok.nextNumber<int>(), parser::ParseException);
+}
+
+TEST(BufferTokeniser, SkipBlock)
+{
+    std::string testString = "areas { 3 { walk ( 1 2 3 ) } 4 { } } next";
+
+    parser::BufferTokeniser tok(testString);
+
+    tok.assertNextToken("areas");
+    tok.assertNextToken("{");
+    tok.skipBlock();
+
+    EXPECT_EQ(tok.nextToken(), "next");
+    EXPECT_FALSE(tok.hasMoreTokens());
+}
+
+using AasParsingTest = RadiantTest;
+
+TEST_F(AasParsingTest, ChecksumAboveInt32Range)
+{
+    // The checksum is written as unsigned value, this one exceeds a 32 bit long
+    std::stringstream stream("DewmAAS 1.07\n\n4294967295\n\nplanes 2 {\n"
+        "    0 ( 0 0 1 64 )\n    1 ( 0 0 -1 -64 )\n}\n");
+
+    auto loader = GlobalAasFileManager().getLoaderForStream(stream);
+    ASSERT_TRUE(loader) << "No loader accepting the file";
+
+    auto aasFile = loader->loadFromStream(stream);
+    ASSERT_TRUE(aasFile) << "File has been rejected";
+
+    EXPECT_EQ(aasFile->getNumPlanes(), 2);
+    EXPECT_EQ(aasFile->getPlane(1).dist(), -64);
+}
+
+TEST(DeclBlockCache, RecordsSurviveSaving)
+{
+    auto filename = (fs::temp_directory_path() / "declblockcache_test.bin").string();
+    fs::remove(filename);
+
+    {
+        parser::DeclBlockCache cache(filename);
+
+        EXPECT_EQ(cache.find("materials/a.mtr", "stamp1"), nullptr);
+
+        cache.insert("materials/a.mtr", "stamp1", "base", { { "textures/a", "\n  diffusemap _white\n" }, { "table t", "{ 0, 1 }" } });
+        cache.insert("materials/b.mtr", "stamp2", "mod", {});
+        cache.save();
+    }
+
+    parser::DeclBlockCache cache(filename);
+
+    // A different stamp means the file has changed
+    EXPECT_EQ(cache.find("materials/a.mtr", "stamp2"), nullptr);
+
+    auto record = cache.find("materials/a.mtr", "stamp1");
+    ASSERT_NE(record, nullptr);
+    EXPECT_EQ(record->modName, "base");
+    ASSERT_EQ(record->blocks.size(), 2);
+    EXPECT_EQ(record->blocks[0].name, "textures/a");
+    EXPECT_EQ(record->blocks[0].contents, "\n  diffusemap _white\n");
+    EXPECT_EQ(record->blocks[1].name, "table t");
+    EXPECT_EQ(record->blocks[1].contents, "{ 0, 1 }");
+
+    // b.mtr hasn't been looked up, saving drops it
+    cache.save();
+
+    EXPECT_EQ(parser::DeclBlockCache(filename).find("materials/b.mtr", "stamp2"), nullptr);
+    EXPECT_NE(parser::DeclBlockCache(filename).find("materials/a.mtr", "stamp1"), nullptr);
+
+    fs::remove(filename);
+}
+
 using SoundShaderParsingTests = RadiantTest;
 
 TEST_F(SoundShaderParsingTests, ShaderParsing)
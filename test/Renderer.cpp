@@ -6,6 +6,11 @@
 #include "ilightnode.h"
 #include "math/Matrix4.h"
 #include "scenelib.h"
+#include "render/View.h"
+#include "render/CameraView.h"
+#include "render/CamRenderer.h"
+#include "render/RenderableCollectionWalker.h"
+#include <GL/glew.h>
 
 namespace test
 {
@@ -415,4 +420,82 @@ TEST_F(RenderSystemTest, AttachmentIsRegisteredAsLight)
     EXPECT_EQ(getLightCount(renderSystem), 1) << "Rendersystem should know of 1 light after removing the torch";
 }
 
+namespace
+{
+
+// Extracts the number following the given label from the render result string
+std::size_t getResultValue(const std::string& result, const std::string& label)
+{
+    auto pos = result.find(label);
+
+    EXPECT_NE(pos, std::string::npos) << "Label " << label << " not found in " << result;
+
+    return pos != std::string::npos ? std::stoul(result.substr(pos + label.length())) : 0;
+}
+
+// Renders a single frame in lighting mode, returning the result summary
+std::string renderLitFrame()
+{
+    render::View view(true);
+    view.construct(camera::calculateProjectionMatrix(1, 8192, 90, 640, 480),
+        camera::calculateModelViewMatrix(Vector3(0, -512, 32), Vector3(0, 90, 0)), 640, 480);
+
+    render::CamRenderer::HighlightShaders shaders;
+    render::CamRenderer renderer(view, shaders);
+
+    GlobalRenderSystem().startFrame();
+    renderer.prepare();
+
+    render::RenderableCollectionWalker::CollectRenderablesInScene(renderer, view);
+
+    auto result = GlobalRenderSystem().renderLitScene(RENDER_DEPTHTEST | RENDER_MASKCOLOUR | RENDER_DEPTHWRITE |
+        RENDER_ALPHATEST | RENDER_BLEND | RENDER_CULLFACE | RENDER_FILL | RENDER_LIGHTING | RENDER_TEXTURE_2D |
+        RENDER_VERTEX_COLOUR | RENDER_SMOOTH | RENDER_SCALED | RENDER_BUMP | RENDER_PROGRAM, view);
+
+    renderer.cleanup();
+    GlobalRenderSystem().endFrame();
+
+    return result->toString();
+}
+
+}
+
+TEST_F(RenderSystemTest, ModelInstancesShareInteractionDrawCalls)
+{
+    if (!GLEW_ARB_multi_draw_indirect || !GLEW_ARB_base_instance)
+    {
+        GTEST_SKIP() << "Per-object transform batching is not supported by this driver";
+    }
+
+    auto light = Light::withRadius(V3(512, 512, 512));
+    scene::addNodeToContainer(light.node, GlobalMapModule().getRoot());
+
+    // Place a number of instances of the same model next to each other
+    auto addModel = [](int index)
+    {
+        auto entity = createByClassName("func_static");
+        scene::addNodeToContainer(entity, GlobalMapModule().getRoot());
+
+        Node_getEntity(entity)->setKeyValue("model", "models/twosided_ivy.lwo");
+        Node_getEntity(entity)->setKeyValue("origin", string::to_string(V3(index * 32 - 112, 0, 0)));
+    };
+
+    addModel(0);
+    auto singleModel = renderLitFrame();
+
+    for (int i = 1; i < 8; ++i)
+    {
+        addModel(i);
+    }
+    auto eightModels = renderLitFrame();
+
+    EXPECT_EQ(getResultValue(eightModels, "Objs: "), 8 * getResultValue(singleModel, "Objs: "))
+        << "Every model instance should interact with the light";
+
+    // The instances share their material and are drawn in the same batches
+    EXPECT_GT(getResultValue(singleModel, "Int="), 0);
+    EXPECT_EQ(getResultValue(eightModels, "Int="), getResultValue(singleModel, "Int="));
+    EXPECT_EQ(getResultValue(eightModels, "D="), getResultValue(singleModel, "D="));
+}
+
 }
@@ -1,8 +1,12 @@
 #include "RadiantTest.h"
 
+#include <set>
+
 #include "scene/BasicRootNode.h"
 #include "scene/Node.h"
 #include "scenelib.h"
+#include "render/NopVolumeTest.h"
+#include "render/RenderableCollectionWalker.h"
 
 namespace test
 {
@@ -40,6 +44,8 @@ public:
         return 0;
     }
 
+    using Node::renderStateUpdateQueued;
+
     // Wrapper to invoke the protected method
     void setProtectedForcedVisibility(bool isForced)
     {
@@ -257,4 +263,66 @@ TEST_F(SceneNodeTest, SetFilterStatus)
     EXPECT_FALSE(node->isFiltered()) << "Node should report as unfiltered";
 }
 
+TEST_F(SceneNodeTest, CulledNodeCacheFollowsSceneChanges)
+{
+    render::NopVolumeTest volume;
+    render::CulledNodeCache cache;
+
+    auto collectNodes = [&]()
+    {
+        std::set<scene::INodePtr> nodes;
+        cache.foreachVisibleNode(volume, [&](const scene::INodePtr& node) { nodes.insert(node); });
+        return nodes;
+    };
+
+    auto first = std::make_shared<VisibilityTestNode>();
+    scene::addNodeToContainer(first, GlobalMapModule().getRoot());
+
+    EXPECT_EQ(collectNodes().count(first), 1) << "Node should have been collected";
+
+    // Inserting a node invalidates the cached list
+    auto second = std::make_shared<VisibilityTestNode>();
+    scene::addNodeToContainer(second, GlobalMapModule().getRoot());
+
+    auto nodes = collectNodes();
+    EXPECT_EQ(nodes.count(first), 1) << "Node should still be collected";
+    EXPECT_EQ(nodes.count(second), 1) << "Inserted node should have been collected";
+
+    // Hidden nodes are skipped without re-traversing the scene
+    first->enable(scene::Node::eHidden);
+    EXPECT_EQ(collectNodes().count(first), 0) << "Hidden node shouldn't be visited";
+
+    first->disable(scene::Node::eHidden);
+    EXPECT_EQ(collectNodes().count(first), 1) << "Node should be visited again";
+
+    // Removed nodes must not be visited anymore
+    scene::removeNodeFromParent(second);
+    EXPECT_EQ(collectNodes().count(second), 0) << "Removed node shouldn't be visited";
+}
+
+TEST_F(SceneNodeTest, RenderStateIsDirtyAfterChanges)
+{
+    auto node = std::make_shared<VisibilityTestNode>();
+    scene::addNodeToContainer(node, GlobalMapModule().getRoot());
+
+    EXPECT_TRUE(node->renderStateUpdateQueued()) << "Inserted node should be dirty";
+
+    node->clearRenderStateDirty();
+    EXPECT_FALSE(node->renderStateUpdateQueued());
+
+    node->boundsChanged();
+    EXPECT_TRUE(node->renderStateUpdateQueued()) << "Bounds change should flag the node";
+
+    node->clearRenderStateDirty();
+    node->transformChanged();
+    EXPECT_TRUE(node->renderStateUpdateQueued()) << "Transform change should flag the node";
+
+    node->clearRenderStateDirty();
+    node->setFiltered(true);
+    EXPECT_TRUE(node->renderStateUpdateQueued()) << "Visibility change should flag the node";
+
+    // Nodes not tracking their render state are prepared in every frame
+    EXPECT_TRUE(node->isRenderStateDirty());
+}
+
 }
@@ -0,0 +1,153 @@
+#include "RadiantTest.h"
+
+#include <fstream>
+#include "isound.h"
+#include "ifilesystem.h"
+#include "os/dir.h"
+#include "os/fs.h"
+#include "../plugins/sound/OggMetadataReader.h"
+#include "../plugins/sound/OggFileLoader.h"
+
+namespace test
+{
+
+using SoundManagerTest = RadiantTest;
+
+TEST_F(SoundManagerTest, WavFileMetadata)
+{
+    auto mono = GlobalSoundManager().getSoundFileMetadata("sound/test/tone_22khz_mono.wav");
+
+    EXPECT_NEAR(mono.duration, 0.5f, 0.001f);
+    EXPECT_EQ(mono.channels, 1);
+    EXPECT_EQ(mono.sampleRate, 22050);
+
+    auto stereo = GlobalSoundManager().getSoundFileMetadata("sound/test/tone_44khz_stereo.wav");
+
+    EXPECT_NEAR(stereo.duration, 0.25f, 0.001f);
+    EXPECT_EQ(stereo.channels, 2);
+    EXPECT_EQ(stereo.sampleRate, 44100);
+}
+
+TEST_F(SoundManagerTest, MetadataLookupIsRepeatable)
+{
+    // The second query is answered by the metadata index
+    auto first = GlobalSoundManager().getSoundFileMetadata("sound/test/tone_22khz_mono.wav");
+    auto second = GlobalSoundManager().getSoundFileMetadata("sound/test/tone_22khz_mono.wav");
+
+    EXPECT_EQ(first.duration, second.duration);
+    EXPECT_EQ(first.channels, second.channels);
+    EXPECT_EQ(first.sampleRate, second.sampleRate);
+
+    EXPECT_EQ(GlobalSoundManager().getSoundFileDuration("sound/test/tone_22khz_mono.wav"), first.duration);
+}
+
+TEST_F(SoundManagerTest, MetadataLookupTriesOtherExtensions)
+{
+    // The .ogg file doesn't exist, the .wav variant is used instead
+    auto metadata = GlobalSoundManager().getSoundFileMetadata("sound/test/tone_22khz_mono.ogg");
+
+    EXPECT_EQ(metadata.sampleRate, 22050);
+
+    EXPECT_THROW(GlobalSoundManager().getSoundFileMetadata("sound/test/nonexistent.wav"), std::out_of_range);
+}
+
+namespace
+{
+
+// Compares the header-based metadata reader against the libvorbis result
+void expectOggMetadataMatchesVorbis(const std::string& vfsPath, bool expectSeekableStream)
+{
+    auto file = GlobalFileSystem().openFile(vfsPath);
+    ASSERT_TRUE(file) << "Could not open " << vfsPath;
+
+    auto& stream = file->getInputStream();
+    EXPECT_EQ(dynamic_cast<SeekableInputStream*>(&stream) != nullptr, expectSeekableStream);
+
+    auto metadata = sound::OggMetadataReader::Read(stream, file->size());
+
+    auto vorbisFile = GlobalFileSystem().openFile(vfsPath);
+    auto expected = sound::OggFileLoader::GetMetadata(*vorbisFile);
+
+    EXPECT_NEAR(metadata.duration, expected.duration, 0.0001f);
+    EXPECT_EQ(metadata.channels, expected.channels);
+    EXPECT_EQ(metadata.sampleRate, expected.sampleRate);
+}
+
+}
+
+TEST_F(SoundManagerTest, OggFileMetadata)
+{
+    expectOggMetadataMatchesVorbis("sound/test/tone_32khz_stereo.ogg", true);
+
+    auto metadata = GlobalSoundManager().getSoundFileMetadata("sound/test/tone_32khz_stereo.ogg");
+
+    EXPECT_NEAR(metadata.duration, 0.5f, 0.001f);
+    EXPECT_EQ(metadata.channels, 2);
+    EXPECT_EQ(metadata.sampleRate, 32000);
+}
+
+TEST_F(SoundManagerTest, OggFileMetadataInPk4)
+{
+    // Stored (uncompressed) PK4 entries are read through a seekable sub-file stream
+    expectOggMetadataMatchesVorbis("sound/test/packed_tone_22khz_mono.ogg", true);
+
+    auto metadata = GlobalSoundManager().getSoundFileMetadata("sound/test/packed_tone_22khz_mono.ogg");
+
+    EXPECT_NEAR(metadata.duration, 0.75f, 0.001f);
+    EXPECT_EQ(metadata.channels, 1);
+    EXPECT_EQ(metadata.sampleRate, 22050);
+}
+
+// Mounts a temporary mod folder containing a sound file that can't be parsed
+class UnreadableSoundFileTest :
+    public RadiantTest
+{
+protected:
+    std::string _modPath;
+    fs::path _soundFile;
+    fs::path _validSoundFile;
+
+    void setupGameFolder() override
+    {
+        _modPath = _context.getTemporaryDataPath() + "soundtest/";
+        os::makeDirectory(_modPath + "sound/");
+
+        _soundFile = _modPath + "sound/_unreadable.wav";
+        _validSoundFile = _context.getTestProjectPath() + "sound/test/tone_22khz_mono.wav";
+
+        // Garbage of the same size as the valid file
+        std::ofstream(_soundFile.string(), std::ios::binary) << std::string(fs::file_size(_validSoundFile), 'x');
+    }
+
+    void handleGameConfigMessage(game::ConfigurationNeeded& message) override
+    {
+        RadiantTest::handleGameConfigMessage(message);
+
+        auto config = message.getConfig();
+        config.modPath = _modPath;
+        message.setConfig(config);
+    }
+};
+
+TEST_F(UnreadableSoundFileTest, FailedReadsAreNotIndexed)
+{
+    auto metadata = GlobalSoundManager().getSoundFileMetadata("sound/_unreadable.wav");
+
+    EXPECT_EQ(metadata.duration, 0);
+    EXPECT_EQ(metadata.channels, 0);
+    EXPECT_EQ(metadata.sampleRate, 0);
+
+    // Replace the contents, keeping size and modification time, such that an
+    // index entry created by the failed read would still be considered valid
+    auto modificationTime = fs::last_write_time(_soundFile);
+    fs::copy_file(_validSoundFile, _soundFile, fs::copy_options::overwrite_existing);
+    fs::last_write_time(_soundFile, modificationTime);
+
+    metadata = GlobalSoundManager().getSoundFileMetadata("sound/_unreadable.wav");
+
+    EXPECT_NEAR(metadata.duration, 0.5f, 0.001f);
+    EXPECT_EQ(metadata.channels, 1);
+    EXPECT_EQ(metadata.sampleRate, 22050);
+}
+
+}
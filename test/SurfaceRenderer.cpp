@@ -0,0 +1,268 @@
+#include "gtest/gtest.h"
+
+#include <set>
+#include "render/GeometryStore.h"
+#include "render/MeshVertex.h"
+#include "math/AABB.h"
+#include "../radiantcore/rendersystem/backend/SurfaceRenderer.h"
+#include "testutil/TestBufferObjectProvider.h"
+
+namespace test
+{
+
+namespace
+{
+
+class NullSyncObjectProvider final :
+    public render::ISyncObjectProvider
+{
+public:
+    render::ISyncObject::Ptr createSyncObject() override
+    {
+        return {};
+    }
+};
+
+// Geometry store keeping track of the slots currently in use
+class TrackingGeometryStore final :
+    public render::IGeometryStore
+{
+private:
+    NullSyncObjectProvider _syncObjectProvider;
+    TestBufferObjectProvider _bufferObjectProvider;
+    render::GeometryStore _store;
+
+public:
+    std::set<Slot> allocatedSlots;
+    std::size_t numUpdates = 0;
+
+    TrackingGeometryStore() :
+        _store(_syncObjectProvider, _bufferObjectProvider)
+    {}
+
+    Slot allocateSlot(std::size_t numVertices, std::size_t numIndices) override
+    {
+        auto slot = _store.allocateSlot(numVertices, numIndices);
+        allocatedSlots.insert(slot);
+        return slot;
+    }
+
+    Slot allocateIndexSlot(Slot slotContainingVertexData, std::size_t numIndices) override
+    {
+        auto slot = _store.allocateIndexSlot(slotContainingVertexData, numIndices);
+        allocatedSlots.insert(slot);
+        return slot;
+    }
+
+    void updateData(Slot slot, const std::vector<render::RenderVertex>& vertices,
+        const std::vector<unsigned int>& indices) override
+    {
+        EXPECT_EQ(allocatedSlots.count(slot), 1) << "Updating a slot that is not allocated";
+        ++numUpdates;
+        _store.updateData(slot, vertices, indices);
+    }
+
+    void updateSubData(Slot slot, std::size_t vertexOffset, const std::vector<render::RenderVertex>& vertices,
+        std::size_t indexOffset, const std::vector<unsigned int>& indices) override
+    {
+        _store.updateSubData(slot, vertexOffset, vertices, indexOffset, indices);
+    }
+
+    void resizeData(Slot slot, std::size_t vertexSize, std::size_t indexSize) override
+    {
+        _store.resizeData(slot, vertexSize, indexSize);
+    }
+
+    void deallocateSlot(Slot slot) override
+    {
+        EXPECT_EQ(allocatedSlots.erase(slot), 1) << "Slot has been deallocated twice";
+        _store.deallocateSlot(slot);
+    }
+
+    RenderParameters getRenderParameters(Slot slot) override
+    {
+        return _store.getRenderParameters(slot);
+    }
+
+    AABB getBounds(Slot slot) override
+    {
+        return _store.getBounds(slot);
+    }
+
+    std::pair<render::IBufferObject::Ptr, render::IBufferObject::Ptr> getBufferObjects() override
+    {
+        return _store.getBufferObjects();
+    }
+
+    void syncToBufferObjects() override
+    {
+        _store.syncToBufferObjects();
+    }
+};
+
+// Object renderer not issuing any draw calls
+class NullObjectRenderer final :
+    public render::IObjectRenderer
+{
+public:
+    void initAttributePointers() override {}
+    void submitObject(render::IRenderableObject& object) override {}
+    void submitGeometry(render::IGeometryStore::Slot slot, GLenum primitiveMode) override {}
+    void submitInstancedGeometry(render::IGeometryStore::Slot slot, int numInstances, GLenum primitiveMode) override {}
+    void submitGeometry(const std::set<render::IGeometryStore::Slot>& slots, GLenum primitiveMode) override {}
+    void submitGeometry(const std::vector<render::IGeometryStore::Slot>& slots, GLenum primitiveMode) override {}
+    void submitInstancedGeometry(const std::vector<render::IGeometryStore::Slot>& slots, int numInstances, GLenum primitiveMode) override {}
+    void submitGeometryWithCustomIndices(render::IGeometryStore::Slot slot, GLenum primitiveMode,
+        const std::vector<unsigned int>& indices) override {}
+    void submitObjects(const std::vector<render::IGeometryStore::Slot>& slots, const Matrix4& objectTransform) override {}
+    void submitOrientedObjects(const std::vector<render::IGeometryStore::Slot>& slots,
+        const std::vector<Matrix4>& objectTransforms, int numInstances) override {}
+    std::size_t getDrawCallCount() const override { return 0; }
+    void resetDrawCallCount() override {}
+};
+
+class TestSurface final :
+    public render::IRenderableSurface
+{
+private:
+    std::vector<MeshVertex> _vertices;
+    std::vector<unsigned int> _indices;
+    Matrix4 _transform;
+    AABB _bounds;
+    sigc::signal<void> _sigBoundsChanged;
+
+public:
+    std::uint64_t geometryKey;
+
+    TestSurface(std::uint64_t geometryKey_) :
+        _vertices({
+            MeshVertex({ 0, 0, 0 }, { 0, 0, 1 }, { 0, 0 }),
+            MeshVertex({ 64, 0, 0 }, { 0, 0, 1 }, { 1, 0 }),
+            MeshVertex({ 0, 64, 0 }, { 0, 0, 1 }, { 0, 1 }),
+        }),
+        _indices({ 0, 1, 2 }),
+        _transform(Matrix4::getIdentity()),
+        _bounds({ 32, 32, 0 }, { 32, 32, 0 }),
+        geometryKey(geometryKey_)
+    {}
+
+    const std::vector<MeshVertex>& getVertices() override { return _vertices; }
+    const std::vector<unsigned int>& getIndices() override { return _indices; }
+    std::uint64_t getGeometryKey() override { return geometryKey; }
+
+    bool isVisible() override { return true; }
+    bool isOriented() override { return true; }
+    const Matrix4& getObjectTransform() override { return _transform; }
+    const AABB& getObjectBounds() override { return _bounds; }
+    sigc::signal<void>& signal_boundsChanged() override { return _sigBoundsChanged; }
+    render::IGeometryStore::Slot getStorageLocation() override { return 0; }
+    bool isShadowCasting() override { return false; }
+};
+
+}
+
+TEST(SurfaceRenderer, SurfacesWithTheSameKeyShareTheirSlot)
+{
+    TrackingGeometryStore store;
+    NullObjectRenderer objectRenderer;
+    render::SurfaceRenderer renderer(store, objectRenderer);
+
+    TestSurface first(1);
+    TestSurface second(1);
+
+    auto firstSlot = renderer.addSurface(first);
+    auto secondSlot = renderer.addSurface(second);
+
+    EXPECT_NE(firstSlot, secondSlot) << "Each surface should get its own renderer slot";
+    EXPECT_EQ(renderer.getSurfaceStorageLocation(firstSlot), renderer.getSurfaceStorageLocation(secondSlot))
+        << "Surfaces with the same key should share their storage";
+    EXPECT_EQ(store.allocatedSlots.size(), 1);
+
+    // Removing one surface keeps the storage of the other one
+    auto storageLocation = renderer.getSurfaceStorageLocation(secondSlot);
+    renderer.removeSurface(firstSlot);
+
+    EXPECT_EQ(renderer.getSurfaceStorageLocation(secondSlot), storageLocation);
+    EXPECT_EQ(store.allocatedSlots.count(storageLocation), 1) << "Shared storage has been freed too early";
+
+    // Removing the last one frees it
+    renderer.removeSurface(secondSlot);
+    EXPECT_TRUE(store.allocatedSlots.empty()) << "Shared storage should be freed with its last surface";
+}
+
+TEST(SurfaceRenderer, SurfacesWithoutKeyDontShareTheirSlot)
+{
+    TrackingGeometryStore store;
+    NullObjectRenderer objectRenderer;
+    render::SurfaceRenderer renderer(store, objectRenderer);
+
+    TestSurface first(0);
+    TestSurface second(0);
+
+    auto firstSlot = renderer.addSurface(first);
+    auto secondSlot = renderer.addSurface(second);
+
+    EXPECT_NE(renderer.getSurfaceStorageLocation(firstSlot), renderer.getSurfaceStorageLocation(secondSlot));
+    EXPECT_EQ(store.allocatedSlots.size(), 2);
+
+    renderer.removeSurface(firstSlot);
+    renderer.removeSurface(secondSlot);
+    EXPECT_TRUE(store.allocatedSlots.empty());
+}
+
+TEST(SurfaceRenderer, KeyChangeMovesSurfaceToNewSlot)
+{
+    TrackingGeometryStore store;
+    NullObjectRenderer objectRenderer;
+    render::SurfaceRenderer renderer(store, objectRenderer);
+
+    TestSurface first(1);
+    TestSurface second(1);
+
+    auto firstSlot = renderer.addSurface(first);
+    auto secondSlot = renderer.addSurface(second);
+    auto sharedLocation = renderer.getSurfaceStorageLocation(secondSlot);
+
+    // The second surface gets a private key, it needs a slot of its own
+    second.geometryKey = 2;
+    renderer.updateSurface(secondSlot);
+    renderer.prepareForRendering();
+
+    EXPECT_NE(renderer.getSurfaceStorageLocation(secondSlot), sharedLocation) << "Surface should have been moved";
+    EXPECT_EQ(renderer.getSurfaceStorageLocation(firstSlot), sharedLocation) << "Other surface should keep its slot";
+    EXPECT_EQ(store.allocatedSlots.size(), 2);
+
+    // Updating the surface keeping its private key updates the slot in place
+    auto privateLocation = renderer.getSurfaceStorageLocation(secondSlot);
+    auto numUpdates = store.numUpdates;
+
+    renderer.updateSurface(secondSlot);
+    renderer.prepareForRendering();
+
+    EXPECT_EQ(renderer.getSurfaceStorageLocation(secondSlot), privateLocation) << "Surface should stay in its slot";
+    EXPECT_EQ(store.numUpdates, numUpdates + 1) << "Surface data should have been updated in place";
+    EXPECT_EQ(store.allocatedSlots.size(), 2);
+
+    // Switching back to the shared key releases the private slot
+    second.geometryKey = 1;
+    renderer.updateSurface(secondSlot);
+    renderer.prepareForRendering();
+
+    EXPECT_EQ(renderer.getSurfaceStorageLocation(secondSlot), sharedLocation) << "Surface should share the slot again";
+    EXPECT_EQ(store.allocatedSlots.size(), 1);
+    EXPECT_EQ(store.allocatedSlots.count(privateLocation), 0) << "Private slot should have been freed";
+
+    // Updating a surface sharing its slot with others leaves the data alone
+    numUpdates = store.numUpdates;
+
+    renderer.updateSurface(secondSlot);
+    renderer.prepareForRendering();
+
+    EXPECT_EQ(store.numUpdates, numUpdates) << "Shared data should not have been touched";
+
+    renderer.removeSurface(firstSlot);
+    renderer.removeSurface(secondSlot);
+    EXPECT_TRUE(store.allocatedSlots.empty());
+}
+
+}
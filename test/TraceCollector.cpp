@@ -0,0 +1,272 @@
+#include "RadiantTest.h"
+
+#include <cmath>
+#include <limits>
+#include <set>
+#include <sstream>
+#include <thread>
+#include "itracecollector.h"
+#include "debugging/ScopedTraceZone.h"
+
+namespace test
+{
+
+using TraceCollectorTest = RadiantTest;
+
+namespace
+{
+
+// The exported trace contains one event per line
+std::vector<std::string> exportTraceEvents()
+{
+    std::stringstream stream;
+    GlobalTraceCollector().exportChromeTrace(stream);
+
+    std::vector<std::string> events;
+    std::string line;
+
+    while (std::getline(stream, line))
+    {
+        events.push_back(line);
+    }
+
+    return events;
+}
+
+// Returns all exported events with the given name
+std::vector<std::string> findTraceEvents(const std::vector<std::string>& events, const std::string& name)
+{
+    std::vector<std::string> result;
+    auto needle = "\"name\":\"" + name + "\"";
+
+    for (const auto& event : events)
+    {
+        if (event.find(needle) != std::string::npos)
+        {
+            result.push_back(event);
+        }
+    }
+
+    return result;
+}
+
+// Extracts the number following the given key (like "tid" or "value")
+double getNumericValue(const std::string& event, const std::string& key)
+{
+    auto needle = "\"" + key + "\":";
+    auto pos = event.find(needle);
+
+    EXPECT_NE(pos, std::string::npos) << "Key " << key << " not found in " << event;
+
+    return pos != std::string::npos ? std::stod(event.substr(pos + needle.length())) : -1;
+}
+
+}
+
+TEST_F(TraceCollectorTest, NothingIsRecordedWhileDisabled)
+{
+    auto& collector = GlobalTraceCollector();
+
+    EXPECT_FALSE(collector.isEnabled()) << "Tracing should be disabled by default";
+
+    {
+        profiling::ScopedTraceZone zone("test", "DisabledZone");
+        profiling::recordTraceCounter("test.disabledCounter", 1);
+    }
+
+    collector.setEnabled(true);
+    EXPECT_TRUE(collector.isEnabled());
+
+    {
+        profiling::ScopedTraceZone zone("test", "EnabledZone");
+        profiling::recordTraceCounter("test.counter", 2);
+    }
+
+    collector.setEnabled(false);
+
+    // Events recorded after disabling the collector are dropped
+    profiling::recordTraceCounter("test.counter", 3);
+
+    auto events = exportTraceEvents();
+
+    EXPECT_TRUE(findTraceEvents(events, "DisabledZone").empty());
+    EXPECT_TRUE(findTraceEvents(events, "test.disabledCounter").empty());
+    EXPECT_EQ(findTraceEvents(events, "EnabledZone").size(), 1);
+
+    auto counters = findTraceEvents(events, "test.counter");
+    ASSERT_EQ(counters.size(), 1) << "Only the counter recorded while enabled should be exported";
+    EXPECT_EQ(getNumericValue(counters.front(), "value"), 2);
+
+    // Clearing discards the recorded events
+    collector.clear();
+    events = exportTraceEvents();
+    EXPECT_TRUE(findTraceEvents(events, "EnabledZone").empty());
+    EXPECT_TRUE(findTraceEvents(events, "test.counter").empty());
+}
+
+TEST_F(TraceCollectorTest, ExportZonesAndCountersOfTwoThreads)
+{
+    GlobalTraceCollector().setEnabled(true);
+
+    {
+        profiling::ScopedTraceZone zone("test", "MainThreadZone", "main \"detail\"");
+        profiling::recordTraceCounter("test.mainThreadCounter", 16);
+    }
+
+    std::thread worker([]()
+    {
+        profiling::ScopedTraceZone zone("test", "WorkerThreadZone", "worker");
+        profiling::recordTraceCounter("test.workerThreadCounter", 0.5);
+    });
+    worker.join();
+
+    GlobalTraceCollector().setEnabled(false);
+
+    auto events = exportTraceEvents();
+
+    // Check the JSON frame
+    ASSERT_FALSE(events.empty());
+    EXPECT_EQ(events.front(), "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    EXPECT_EQ(events.back(), "]}");
+
+    // Every thread is named using a metadata event
+    auto threadNames = findTraceEvents(events, "thread_name");
+    EXPECT_GE(threadNames.size(), 2);
+    EXPECT_EQ(findTraceEvents(threadNames, "Main Thread").size(), 1);
+
+    auto mainZone = findTraceEvents(events, "MainThreadZone");
+    auto workerZone = findTraceEvents(events, "WorkerThreadZone");
+    auto mainCounter = findTraceEvents(events, "test.mainThreadCounter");
+    auto workerCounter = findTraceEvents(events, "test.workerThreadCounter");
+
+    ASSERT_EQ(mainZone.size(), 1);
+    ASSERT_EQ(workerZone.size(), 1);
+    ASSERT_EQ(mainCounter.size(), 1);
+    ASSERT_EQ(workerCounter.size(), 1);
+
+    // Zones are complete events, carrying their (escaped) detail string
+    EXPECT_NE(mainZone.front().find("\"ph\":\"X\""), std::string::npos);
+    EXPECT_NE(mainZone.front().find("\"cat\":\"test\""), std::string::npos);
+    EXPECT_NE(mainZone.front().find("\"args\":{\"detail\":\"main \\\"detail\\\"\"}"), std::string::npos);
+    EXPECT_GE(getNumericValue(mainZone.front(), "dur"), 0);
+
+    // Counters are counter events
+    EXPECT_NE(mainCounter.front().find("\"ph\":\"C\""), std::string::npos);
+    EXPECT_EQ(getNumericValue(mainCounter.front(), "value"), 16);
+    EXPECT_EQ(getNumericValue(workerCounter.front(), "value"), 0.5);
+
+    // The events of each thread share the thread ID
+    auto mainThreadId = getNumericValue(mainZone.front(), "tid");
+    auto workerThreadId = getNumericValue(workerZone.front(), "tid");
+
+    EXPECT_NE(mainThreadId, workerThreadId);
+    EXPECT_EQ(getNumericValue(mainCounter.front(), "tid"), mainThreadId);
+    EXPECT_EQ(getNumericValue(workerCounter.front(), "tid"), workerThreadId);
+}
+
+TEST_F(TraceCollectorTest, RingBufferWrapsAround)
+{
+    GlobalTraceCollector().setEnabled(true);
+
+    // Record more events than a single thread buffer can hold
+    constexpr std::size_t NumCounters = 100000;
+
+    std::thread worker([]()
+    {
+        for (std::size_t i = 0; i < NumCounters; ++i)
+        {
+            profiling::recordTraceCounter("test.wrapCounter", static_cast<double>(i));
+        }
+    });
+    worker.join();
+
+    GlobalTraceCollector().setEnabled(false);
+
+    auto counters = findTraceEvents(exportTraceEvents(), "test.wrapCounter");
+
+    ASSERT_FALSE(counters.empty());
+    EXPECT_LT(counters.size(), NumCounters) << "The oldest events should have been overwritten";
+
+    // The remaining events are exported oldest first, ending with the most recent one
+    EXPECT_EQ(getNumericValue(counters.front(), "value"), static_cast<double>(NumCounters - counters.size()));
+    EXPECT_EQ(getNumericValue(counters.back(), "value"), static_cast<double>(NumCounters - 1));
+
+    for (std::size_t i = 1; i < counters.size(); ++i)
+    {
+        EXPECT_EQ(getNumericValue(counters[i], "value"), getNumericValue(counters[i - 1], "value") + 1);
+    }
+}
+
+TEST_F(TraceCollectorTest, BuffersOfExitedThreadsAreReused)
+{
+    GlobalTraceCollector().setEnabled(true);
+
+    // Record from a number of short-lived threads, one after the other
+    for (int i = 0; i < 4; ++i)
+    {
+        std::thread worker([i]()
+        {
+            profiling::recordTraceCounter("test.shortLivedThreadCounter", i);
+        });
+        worker.join();
+    }
+
+    GlobalTraceCollector().setEnabled(false);
+
+    auto counters = findTraceEvents(exportTraceEvents(), "test.shortLivedThreadCounter");
+    ASSERT_EQ(counters.size(), 4) << "The events of exited threads should be kept";
+
+    std::set<double> threadIds;
+
+    for (const auto& counter : counters)
+    {
+        threadIds.insert(getNumericValue(counter, "tid"));
+    }
+
+    EXPECT_EQ(threadIds.size(), 1) << "Every thread should have reused the buffer of the previous one";
+}
+
+TEST_F(TraceCollectorTest, NonFiniteCounterValuesAreExportedAsNull)
+{
+    GlobalTraceCollector().setEnabled(true);
+
+    profiling::recordTraceCounter("test.nanCounter", std::nan(""));
+    profiling::recordTraceCounter("test.infCounter", std::numeric_limits<double>::infinity());
+    profiling::recordTraceCounter("test.finiteCounter", 1.5);
+
+    GlobalTraceCollector().setEnabled(false);
+
+    auto events = exportTraceEvents();
+
+    auto nanCounters = findTraceEvents(events, "test.nanCounter");
+    auto infCounters = findTraceEvents(events, "test.infCounter");
+    ASSERT_EQ(nanCounters.size(), 1);
+    ASSERT_EQ(infCounters.size(), 1);
+
+    // nan and inf are not valid JSON
+    EXPECT_NE(nanCounters.front().find("\"value\":null"), std::string::npos) << nanCounters.front();
+    EXPECT_NE(infCounters.front().find("\"value\":null"), std::string::npos) << infCounters.front();
+
+    auto finiteCounters = findTraceEvents(events, "test.finiteCounter");
+    ASSERT_EQ(finiteCounters.size(), 1);
+    EXPECT_EQ(getNumericValue(finiteCounters.front(), "value"), 1.5);
+}
+
+TEST_F(TraceCollectorTest, MapLoadingRecordsNodeCounter)
+{
+    GlobalTraceCollector().setEnabled(true);
+
+    loadMap("altar.map");
+
+    GlobalTraceCollector().setEnabled(false);
+
+    auto events = exportTraceEvents();
+
+    EXPECT_EQ(findTraceEvents(events, "Map::loadMapResource").size(), 1);
+
+    auto counters = findTraceEvents(events, "map.loadedNodes");
+    ASSERT_EQ(counters.size(), 1);
+    EXPECT_GT(getNumericValue(counters.front(), "value"), 0);
+}
+
+}
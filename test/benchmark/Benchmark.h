@@ -0,0 +1,204 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <fmt/format.h>
+
+namespace benchmark
+{
+
+/**
+ * Statistical summary of the timings (in milliseconds) collected
+ * by repeatedly running a benchmark.
+ */
+struct Statistics
+{
+    std::size_t iterations = 0;
+    double min = 0;
+    double max = 0;
+    double mean = 0;
+    double median = 0;
+    double stddev = 0;
+    double p90 = 0;
+
+    static Statistics Calculate(std::vector<double> samples)
+    {
+        Statistics stats;
+
+        if (samples.empty()) return stats;
+
+        std::sort(samples.begin(), samples.end());
+
+        stats.iterations = samples.size();
+        stats.min = samples.front();
+        stats.max = samples.back();
+        stats.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+
+        auto middle = samples.size() / 2;
+        stats.median = samples.size() % 2 == 0 ? (samples[middle - 1] + samples[middle]) * 0.5 : samples[middle];
+
+        // Nearest-rank percentile
+        auto p90Rank = static_cast<std::size_t>(std::ceil(0.9 * samples.size()));
+        stats.p90 = samples[std::max<std::size_t>(p90Rank, 1) - 1];
+
+        double squaredDeviations = 0;
+
+        for (auto sample : samples)
+        {
+            squaredDeviations += (sample - stats.mean) * (sample - stats.mean);
+        }
+
+        stats.stddev = samples.size() > 1 ? std::sqrt(squaredDeviations / (samples.size() - 1)) : 0.0;
+
+        return stats;
+    }
+};
+
+struct Result
+{
+    std::string name;
+    std::vector<double> samples;
+    Statistics statistics;
+};
+
+/**
+ * Collects the results of all benchmarks run by this executable,
+ * to be written to a JSON file after all of them have completed.
+ */
+class Results
+{
+private:
+    std::vector<Result> _results;
+
+    std::size_t _iterations = 10;
+    std::size_t _warmupIterations = 1;
+
+public:
+    static Results& Instance()
+    {
+        static Results _instance;
+        return _instance;
+    }
+
+    std::size_t getIterations() const
+    {
+        return _iterations;
+    }
+
+    void setIterations(std::size_t iterations)
+    {
+        _iterations = std::max<std::size_t>(iterations, 1);
+    }
+
+    std::size_t getWarmupIterations() const
+    {
+        return _warmupIterations;
+    }
+
+    void setWarmupIterations(std::size_t iterations)
+    {
+        _warmupIterations = iterations;
+    }
+
+    void add(const std::string& name, const std::vector<double>& samples)
+    {
+        auto stats = Statistics::Calculate(samples);
+
+        _results.push_back(Result{ name, samples, stats });
+
+        std::cout << fmt::format("[ BENCHMARK] {0}: median {1:.3f} ms, mean {2:.3f} ms, stddev {3:.3f} ms ({4} iterations)",
+            name, stats.median, stats.mean, stats.stddev, stats.iterations) << std::endl;
+    }
+
+    const std::vector<Result>& get() const
+    {
+        return _results;
+    }
+
+    void writeJson(std::ostream& stream, const std::string& timestamp) const
+    {
+        stream << "{\n";
+        stream << fmt::format("  \"timestamp\": \"{0}\",\n", timestamp);
+        stream << fmt::format("  \"iterations\": {0},\n", _iterations);
+        stream << fmt::format("  \"warmupIterations\": {0},\n", _warmupIterations);
+        stream << "  \"unit\": \"ms\",\n";
+        stream << "  \"benchmarks\": [";
+
+        for (auto r = _results.begin(); r != _results.end(); ++r)
+        {
+            const auto& stats = r->statistics;
+
+            stream << (r == _results.begin() ? "\n" : ",\n");
+            stream << "    {\n";
+            stream << fmt::format("      \"name\": \"{0}\",\n", r->name);
+            stream << fmt::format("      \"iterations\": {0},\n", stats.iterations);
+            stream << fmt::format("      \"min\": {0:.4f},\n", stats.min);
+            stream << fmt::format("      \"max\": {0:.4f},\n", stats.max);
+            stream << fmt::format("      \"mean\": {0:.4f},\n", stats.mean);
+            stream << fmt::format("      \"median\": {0:.4f},\n", stats.median);
+            stream << fmt::format("      \"stddev\": {0:.4f},\n", stats.stddev);
+            stream << fmt::format("      \"p90\": {0:.4f},\n", stats.p90);
+            stream << "      \"samples\": [";
+
+            for (auto s = r->samples.begin(); s != r->samples.end(); ++s)
+            {
+                stream << (s == r->samples.begin() ? "" : ", ") << fmt::format("{0:.4f}", *s);
+            }
+
+            stream << "]\n";
+            stream << "    }";
+        }
+
+        stream << "\n  ]\n";
+        stream << "}\n";
+    }
+};
+
+/**
+ * Runs the given functor the configured number of times (after a few untimed
+ * warm-up runs) and records the timings under the given name.
+ *
+ * The optional setup functor is invoked before every run, its execution
+ * time is not included in the measurement. The optional teardown functor
+ * is invoked after every run, untimed as well.
+ */
+inline void run(const std::string& name, const std::function<void()>& functor,
+    const std::function<void()>& setup = std::function<void()>(),
+    const std::function<void()>& teardown = std::function<void()>())
+{
+    auto& results = Results::Instance();
+
+    for (std::size_t i = 0; i < results.getWarmupIterations(); ++i)
+    {
+        if (setup) setup();
+        functor();
+        if (teardown) teardown();
+    }
+
+    std::vector<double> samples;
+    samples.reserve(results.getIterations());
+
+    for (std::size_t i = 0; i < results.getIterations(); ++i)
+    {
+        if (setup) setup();
+
+        auto start = std::chrono::steady_clock::now();
+        functor();
+        auto end = std::chrono::steady_clock::now();
+
+        samples.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+
+        if (teardown) teardown();
+    }
+
+    results.add(name, samples);
+}
+
+}
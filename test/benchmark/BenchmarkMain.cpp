@@ -0,0 +1,81 @@
+#include "gtest/gtest.h"
+
+#include <ctime>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "Benchmark.h"
+
+namespace
+{
+    const char* const OUTPUT_ARG = "--benchmark-output=";
+    const char* const ITERATIONS_ARG = "--benchmark-iterations=";
+    const char* const WARMUP_ARG = "--benchmark-warmup=";
+
+    bool startsWith(const char* arg, const char* prefix)
+    {
+        return std::strncmp(arg, prefix, std::strlen(prefix)) == 0;
+    }
+
+    std::string getTimestamp()
+    {
+        auto now = std::time(nullptr);
+        char buffer[32];
+        std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+        return buffer;
+    }
+}
+
+/**
+ * Entry point of the drbenchmark executable. Accepts the usual Google Test
+ * arguments (e.g. --gtest_filter) plus the following:
+ *
+ * --benchmark-output=<path>     JSON file the timings are written to (default: benchmark.json)
+ * --benchmark-iterations=<n>    Number of timed runs per benchmark (default: 10)
+ * --benchmark-warmup=<n>        Number of untimed runs preceding the timed ones (default: 1)
+ */
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+
+    std::string outputPath = "benchmark.json";
+    auto& results = benchmark::Results::Instance();
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (startsWith(argv[i], OUTPUT_ARG))
+        {
+            outputPath = argv[i] + std::strlen(OUTPUT_ARG);
+        }
+        else if (startsWith(argv[i], ITERATIONS_ARG))
+        {
+            results.setIterations(std::stoul(argv[i] + std::strlen(ITERATIONS_ARG)));
+        }
+        else if (startsWith(argv[i], WARMUP_ARG))
+        {
+            results.setWarmupIterations(std::stoul(argv[i] + std::strlen(WARMUP_ARG)));
+        }
+        else
+        {
+            std::cerr << "Unknown argument: " << argv[i] << std::endl;
+            return 1;
+        }
+    }
+
+    auto testResult = RUN_ALL_TESTS();
+
+    std::ofstream stream(outputPath);
+
+    if (!stream.good())
+    {
+        std::cerr << "Cannot write benchmark results to " << outputPath << std::endl;
+        return 1;
+    }
+
+    results.writeJson(stream, getTimestamp());
+
+    std::cout << "Benchmark results written to " << outputPath << std::endl;
+
+    return testResult;
+}
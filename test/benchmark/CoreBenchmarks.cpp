@@ -0,0 +1,365 @@
+#include "RadiantTest.h"
+
+#include "ibrush.h"
+#include "ipatch.h"
+#include "imap.h"
+#include "ieclass.h"
+#include "ishaders.h"
+#include "iselection.h"
+#include "icomparablenode.h"
+#include "scenelib.h"
+#include "os/path.h"
+#include "math/pi.h"
+#include "render/View.h"
+#include "algorithm/Scene.h"
+#include "algorithm/View.h"
+#include "BCnDecoder.h"
+#include "Benchmark.h"
+#include "SyntheticMap.h"
+
+namespace test
+{
+
+using CoreBenchmark = RadiantTest;
+
+namespace
+{
+
+// Generates a synthetic map in the temporary folder and returns its path
+std::string writeSyntheticMap(const radiant::TestContext& context, const benchmark::SyntheticMap& map, const std::string& filename)
+{
+    auto path = os::standardPathWithSlash(context.getTemporaryDataPath()) + filename;
+    EXPECT_TRUE(map.write(path)) << "Failed to write the synthetic map to " << path;
+    return path;
+}
+
+// Fills a buffer with deterministic pseudo-random compressed blocks
+std::vector<uint8_t> createBlockData(image::BlockFormat format, std::size_t width, std::size_t height)
+{
+    std::vector<uint8_t> blocks(image::getCompressedSize(format, width, height));
+    uint32_t state = 0x12345678;
+
+    for (auto& byte : blocks)
+    {
+        state = state * 1664525 + 1013904223;
+        byte = static_cast<uint8_t>(state >> 24);
+    }
+
+    return blocks;
+}
+
+std::size_t countBrushes(const scene::INodePtr& root)
+{
+    std::size_t count = 0;
+
+    root->foreachNode([&](const scene::INodePtr& node)
+    {
+        if (Node_isBrush(node)) ++count;
+        return true;
+    });
+
+    return count;
+}
+
+}
+
+TEST_F(CoreBenchmark, LoadResourceMap)
+{
+    benchmark::run("MapLoad.altar", [&]()
+    {
+        GlobalCommandSystem().executeCommand("OpenMap", std::string("maps/altar.map"));
+    }, std::function<void()>(), []()
+    {
+        GlobalMapModule().createNewMap();
+    });
+}
+
+TEST_F(CoreBenchmark, LoadSyntheticMap)
+{
+    benchmark::SyntheticMap map;
+    auto path = writeSyntheticMap(_context, map, "synthetic_load.map");
+
+    benchmark::run("MapLoad.synthetic", [&]()
+    {
+        GlobalCommandSystem().executeCommand("OpenMap", path);
+    }, std::function<void()>(), []()
+    {
+        GlobalMapModule().createNewMap();
+    });
+
+    // Check that the map has been loaded completely
+    GlobalCommandSystem().executeCommand("OpenMap", path);
+    EXPECT_GE(countBrushes(GlobalMapModule().getRoot()), map.getNumWorldspawnBrushes());
+}
+
+TEST_F(CoreBenchmark, BrushBRepConstruction)
+{
+    constexpr std::size_t NumBrushes = 4096;
+    std::vector<scene::INodePtr> brushes;
+
+    benchmark::run("Brush.BRepConstruction", [&]()
+    {
+        for (std::size_t i = 0; i < NumBrushes; ++i)
+        {
+            auto node = GlobalBrushCreator().createBrush();
+            auto& brush = *Node_getIBrush(node);
+
+            auto translation = Matrix4::getTranslation(Vector3(i * 128.0, 0, 0));
+
+            // A slanted face makes the clipping a bit less trivial
+            brush.addFace(Plane3(+1, 0, 0, 64).transform(translation));
+            brush.addFace(Plane3(-1, 0, 0, 64).transform(translation));
+            brush.addFace(Plane3(0, +1, 0, 64).transform(translation));
+            brush.addFace(Plane3(0, -1, 0, 64).transform(translation));
+            brush.addFace(Plane3(0, 0, +1, 64).transform(translation));
+            brush.addFace(Plane3(0, 0, -1, 64).transform(translation));
+            brush.addFace(Plane3(Vector3(1, 1, 1).getNormalised(), 64).transform(translation));
+
+            brush.evaluateBRep();
+
+            brushes.push_back(node);
+        }
+    }, std::function<void()>(), [&]()
+    {
+        brushes.clear();
+    });
+}
+
+TEST_F(CoreBenchmark, BrushWindingClipping)
+{
+    // Sphere-like brushes with many faces, each winding is clipped by all the other faces
+    constexpr std::size_t NumBrushes = 256;
+    constexpr std::size_t NumRings = 8;
+    constexpr std::size_t NumSegments = 16;
+    std::vector<scene::INodePtr> brushes;
+
+    benchmark::run("Brush.WindingClipping.synthetic", [&]()
+    {
+        for (std::size_t i = 0; i < NumBrushes; ++i)
+        {
+            auto node = GlobalBrushCreator().createBrush();
+            auto& brush = *Node_getIBrush(node);
+
+            auto translation = Matrix4::getTranslation(Vector3(i * 256.0, 0, 0));
+
+            brush.addFace(Plane3(0, 0, +1, 64).transform(translation));
+            brush.addFace(Plane3(0, 0, -1, 64).transform(translation));
+
+            for (std::size_t ring = 1; ring < NumRings; ++ring)
+            {
+                auto elevation = math::PI * ring / NumRings - math::PI / 2;
+
+                for (std::size_t segment = 0; segment < NumSegments; ++segment)
+                {
+                    auto azimuth = 2 * math::PI * segment / NumSegments;
+                    Vector3 normal(cos(elevation) * cos(azimuth), cos(elevation) * sin(azimuth), sin(elevation));
+
+                    brush.addFace(Plane3(normal, 64).transform(translation));
+                }
+            }
+
+            brush.evaluateBRep();
+
+            brushes.push_back(node);
+        }
+    }, std::function<void()>(), [&]()
+    {
+        brushes.clear();
+    });
+
+    // The brushes of a real map, their faces are marked as changed before every run
+    GlobalCommandSystem().executeCommand("OpenMap", std::string("maps/altar.map"));
+
+    std::vector<IBrush*> mapBrushes;
+
+    GlobalMapModule().getRoot()->foreachNode([&](const scene::INodePtr& node)
+    {
+        if (Node_isBrush(node))
+        {
+            mapBrushes.push_back(Node_getIBrush(node));
+        }
+
+        return true;
+    });
+
+    EXPECT_FALSE(mapBrushes.empty());
+
+    benchmark::run("Brush.WindingClipping.altar", [&]()
+    {
+        for (auto brush : mapBrushes)
+        {
+            brush->evaluateBRep();
+        }
+    }, [&]()
+    {
+        for (auto brush : mapBrushes)
+        {
+            for (std::size_t i = 0; i < brush->getNumFaces(); ++i)
+            {
+                brush->getFace(i).transform(Matrix4::getIdentity());
+            }
+        }
+    });
+}
+
+TEST_F(CoreBenchmark, PatchTesselation)
+{
+    constexpr std::size_t NumPatches = 256;
+    constexpr std::size_t PatchSize = 17;
+
+    auto world = GlobalMapModule().findOrInsertWorldspawn();
+    std::vector<IPatch*> patches;
+
+    for (std::size_t i = 0; i < NumPatches; ++i)
+    {
+        auto node = GlobalPatchModule().createPatch(patch::PatchDefType::Def2);
+        world->addChildNode(node);
+
+        auto& patch = std::dynamic_pointer_cast<IPatchNode>(node)->getPatch();
+        patch.setDims(PatchSize, PatchSize);
+
+        for (std::size_t row = 0; row < PatchSize; ++row)
+        {
+            for (std::size_t col = 0; col < PatchSize; ++col)
+            {
+                patch.ctrlAt(row, col).vertex.set(col * 32.0, row * 32.0, i * 64.0 + ((row + col) % 3) * 24.0);
+                patch.ctrlAt(row, col).texcoord[0] = col / (PatchSize - 1.0);
+                patch.ctrlAt(row, col).texcoord[1] = row / (PatchSize - 1.0);
+            }
+        }
+
+        patch.controlPointsChanged();
+        patches.push_back(&patch);
+    }
+
+    benchmark::run("Patch.Tesselation", [&]()
+    {
+        for (auto patch : patches)
+        {
+            patch->updateTesselation(true);
+        }
+    });
+}
+
+TEST_F(CoreBenchmark, NodeFingerprinting)
+{
+    benchmark::SyntheticMap map;
+    GlobalCommandSystem().executeCommand("OpenMap", writeSyntheticMap(_context, map, "synthetic_fingerprint.map"));
+
+    std::vector<scene::IComparableNode*> nodes;
+
+    GlobalMapModule().getRoot()->foreachNode([&](const scene::INodePtr& node)
+    {
+        if (auto comparable = dynamic_cast<scene::IComparableNode*>(node.get()); comparable != nullptr)
+        {
+            nodes.push_back(comparable);
+        }
+
+        return true;
+    });
+
+    EXPECT_FALSE(nodes.empty());
+
+    benchmark::run("Scene.Fingerprinting", [&]()
+    {
+        std::size_t totalLength = 0;
+
+        for (auto node : nodes)
+        {
+            totalLength += node->getFingerprint().length();
+        }
+
+        EXPECT_GT(totalLength, 0);
+    });
+}
+
+TEST_F(CoreBenchmark, PointSelection)
+{
+    benchmark::SyntheticMap map;
+    GlobalCommandSystem().executeCommand("OpenMap", writeSyntheticMap(_context, map, "synthetic_selection.map"));
+
+    // Center the view on a brush in the middle of the grid
+    auto center = static_cast<double>(map.gridSize / 2) * 128.0;
+
+    render::View orthoView(false);
+    algorithm::constructCenteredOrthoview(orthoView, Vector3(center, center, 0));
+
+    benchmark::run("Selection.Point", [&]()
+    {
+        for (int i = 0; i < 50; ++i)
+        {
+            auto test = algorithm::constructOrthoviewSelectionTest(orthoView);
+            GlobalSelectionSystem().selectPoint(test, selection::SelectionSystem::eReplace, false);
+        }
+    }, std::function<void()>(), []()
+    {
+        GlobalSelectionSystem().setSelectedAll(false);
+    });
+}
+
+TEST_F(CoreBenchmark, AreaSelection)
+{
+    benchmark::SyntheticMap map;
+    GlobalCommandSystem().executeCommand("OpenMap", writeSyntheticMap(_context, map, "synthetic_area_selection.map"));
+
+    auto center = static_cast<double>(map.gridSize / 2) * 128.0;
+
+    render::View orthoView(false);
+    algorithm::constructCenteredOrthoview(orthoView, Vector3(center, center, 0));
+
+    benchmark::run("Selection.Area", [&]()
+    {
+        // Select everything within the central half of the viewport
+        render::View scissored(orthoView);
+        ConstructSelectionTest(scissored, selection::Rectangle::ConstructFromArea(Vector2(-0.5, -0.5), Vector2(1.0, 1.0)));
+
+        SelectionVolume test(scissored);
+        GlobalSelectionSystem().selectArea(test, selection::SelectionSystem::eToggle, false);
+    }, std::function<void()>(), []()
+    {
+        GlobalSelectionSystem().setSelectedAll(false);
+    });
+}
+
+TEST_F(CoreBenchmark, EntityDefParsing)
+{
+    benchmark::run("Decls.ReloadDefs", []()
+    {
+        GlobalEntityClassManager().reloadDefs();
+    });
+}
+
+TEST_F(CoreBenchmark, MaterialParsing)
+{
+    benchmark::run("Decls.RefreshMaterials", []()
+    {
+        GlobalMaterialManager().refresh();
+    });
+}
+
+TEST_F(CoreBenchmark, BlockDecompression)
+{
+    constexpr std::size_t Size = 4096;
+    std::vector<uint8_t> rgba(Size * Size * 4);
+
+    auto bc3 = createBlockData(image::BlockFormat::BC3, Size, Size);
+    auto bc5 = createBlockData(image::BlockFormat::BC5, Size, Size);
+    auto bc7 = createBlockData(image::BlockFormat::BC7, Size, Size);
+
+    benchmark::run("Image.DecodeBC3", [&]()
+    {
+        image::decodeBlocks(image::BlockFormat::BC3, bc3.data(), Size, Size, rgba.data());
+    });
+
+    benchmark::run("Image.DecodeBC5", [&]()
+    {
+        image::decodeBlocks(image::BlockFormat::BC5, bc5.data(), Size, Size, rgba.data());
+    });
+
+    benchmark::run("Image.DecodeBC7", [&]()
+    {
+        image::decodeBlocks(image::BlockFormat::BC7, bc7.data(), Size, Size, rgba.data());
+    });
+}
+
+}
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <fstream>
+#include <string>
+#include <fmt/format.h>
+
+namespace benchmark
+{
+
+/**
+ * Generates large Doom 3 map files with a deterministic layout,
+ * used to benchmark the code paths which are scaling with the map size.
+ */
+class SyntheticMap
+{
+public:
+    // Number of brushes along each horizontal axis, the map contains gridSize^2 worldspawn brushes
+    std::size_t gridSize = 64;
+
+    // Every n-th grid cell receives a patch in addition to its brush (0 disables patches)
+    std::size_t patchInterval = 4;
+
+    // Every n-th grid cell receives a func_static with two child brushes (0 disables them)
+    std::size_t funcStaticInterval = 16;
+
+    // Every n-th grid cell receives a light entity (0 disables lights)
+    std::size_t lightInterval = 32;
+
+    std::string material = "textures/numbers/1";
+
+    std::size_t getNumWorldspawnBrushes() const
+    {
+        return gridSize * gridSize;
+    }
+
+    // Writes the map to the given path, returns false if the file could not be opened
+    bool write(const std::string& path) const
+    {
+        std::ofstream stream(path);
+
+        if (!stream.good()) return false;
+
+        std::size_t primitive = 0;
+
+        stream << "Version 2\n";
+        stream << "// entity 0\n{\n\"classname\" \"worldspawn\"\n";
+
+        forEachCell([&](std::size_t index, double x, double y)
+        {
+            writeBrush(stream, primitive++, x, y, 0, 48);
+
+            if (patchInterval > 0 && index % patchInterval == 0)
+            {
+                writePatch(stream, primitive++, x, y, 64);
+            }
+        });
+
+        stream << "}\n";
+
+        std::size_t entity = 1;
+
+        forEachCell([&](std::size_t index, double x, double y)
+        {
+            if (funcStaticInterval > 0 && index % funcStaticInterval == 0)
+            {
+                stream << fmt::format("// entity {0}\n{{\n", entity);
+                stream << "\"classname\" \"func_static\"\n";
+                stream << fmt::format("\"name\" \"func_static_{0}\"\n", entity);
+                stream << fmt::format("\"model\" \"func_static_{0}\"\n", entity);
+                writeBrush(stream, 0, x, y, 128, 16);
+                writeBrush(stream, 1, x, y, 176, 16);
+                stream << "}\n";
+                ++entity;
+            }
+
+            if (lightInterval > 0 && index % lightInterval == 0)
+            {
+                stream << fmt::format("// entity {0}\n{{\n", entity);
+                stream << "\"classname\" \"light\"\n";
+                stream << fmt::format("\"name\" \"light_{0}\"\n", entity);
+                stream << fmt::format("\"origin\" \"{0} {1} 256\"\n", x, y);
+                stream << "\"light_radius\" \"320 320 320\"\n";
+                stream << "}\n";
+                ++entity;
+            }
+        });
+
+        return true;
+    }
+
+private:
+    template<typename Func>
+    void forEachCell(const Func& func) const
+    {
+        for (std::size_t row = 0; row < gridSize; ++row)
+        {
+            for (std::size_t col = 0; col < gridSize; ++col)
+            {
+                func(row * gridSize + col, col * 128.0, row * 128.0);
+            }
+        }
+    }
+
+    // Writes an axis-aligned cube centered at the given position
+    void writeBrush(std::ostream& stream, std::size_t primitive, double x, double y, double z, double extents) const
+    {
+        stream << fmt::format("// primitive {0}\n{{\nbrushDef3\n{{\n", primitive);
+
+        auto writePlane = [&](int nx, int ny, int nz, double dist)
+        {
+            stream << fmt::format("( {0} {1} {2} {3} ) ( ( 0.0078125 0 0 ) ( 0 0.0078125 0 ) ) \"{4}\" 0 0 0\n",
+                nx, ny, nz, -dist, material);
+        };
+
+        writePlane(+1, 0, 0, x + extents);
+        writePlane(-1, 0, 0, -(x - extents));
+        writePlane(0, +1, 0, y + extents);
+        writePlane(0, -1, 0, -(y - extents));
+        writePlane(0, 0, +1, z + extents);
+        writePlane(0, 0, -1, -(z - extents));
+
+        stream << "}\n}\n";
+    }
+
+    // Writes a wavy 5x5 patchDef2 hovering above the given position
+    void writePatch(std::ostream& stream, std::size_t primitive, double x, double y, double z) const
+    {
+        constexpr std::size_t Size = 5;
+
+        stream << fmt::format("// primitive {0}\n{{\npatchDef2\n{{\n\"{1}\"\n", primitive, material);
+        stream << fmt::format("( {0} {0} 0 0 0 )\n(\n", Size);
+
+        for (std::size_t i = 0; i < Size; ++i)
+        {
+            stream << "( ";
+
+            for (std::size_t j = 0; j < Size; ++j)
+            {
+                stream << fmt::format("( {0} {1} {2} {3} {4} ) ",
+                    x - 48 + i * 24.0, y - 48 + j * 24.0, z + ((i + j) % 2) * 16.0,
+                    i / (Size - 1.0), j / (Size - 1.0));
+            }
+
+            stream << ")\n";
+        }
+
+        stream << ")\n}\n}\n";
+    }
+};
+
+}
@@ -0,0 +1,174 @@
+#include "gtest/gtest.h"
+
+#include "wxutil/dataview/LazyVFSTreePopulator.h"
+
+namespace test
+{
+
+namespace
+{
+
+struct PopulatorColumns :
+    public wxutil::TreeModel::ColumnRecord
+{
+    wxutil::TreeModel::Column name;
+
+    PopulatorColumns() :
+        name(add(wxutil::TreeModel::Column::String))
+    {}
+};
+
+class LazyVFSTreePopulatorTest :
+    public ::testing::Test
+{
+protected:
+    PopulatorColumns _columns;
+    wxutil::TreeModel::Ptr _model;
+
+    // The paths of all rows created so far, in order of creation
+    std::vector<std::string> _createdPaths;
+
+    void SetUp() override
+    {
+        _model = new wxutil::TreeModel(_columns);
+    }
+
+    void populate(const std::vector<std::string>& paths)
+    {
+        wxutil::LazyVFSTreePopulator populator(_model);
+
+        for (const auto& path : paths)
+        {
+            populator.addPath(path);
+        }
+
+        populator.populate([this](wxutil::TreeModel& model, wxutil::TreeModel::Row& row,
+            const std::string& path, const std::string& leafName, bool isFolder)
+        {
+            row[_columns.name] = wxVariant(leafName);
+            _createdPaths.push_back(path);
+        });
+
+        EXPECT_TRUE(populator.empty());
+    }
+
+    // Returns the names of the child rows, as the view would request them on expansion
+    std::vector<std::string> getChildNames(const wxDataViewItem& parent)
+    {
+        wxDataViewItemArray children;
+        _model->GetChildren(parent, children);
+
+        std::vector<std::string> names;
+
+        for (const auto& child : children)
+        {
+            names.push_back(getName(child));
+        }
+
+        return names;
+    }
+
+    wxDataViewItem findChild(const wxDataViewItem& parent, const std::string& name)
+    {
+        wxDataViewItemArray children;
+        _model->GetChildren(parent, children);
+
+        for (const auto& child : children)
+        {
+            if (getName(child) == name) return child;
+        }
+
+        return wxDataViewItem();
+    }
+
+    std::string getName(const wxDataViewItem& item)
+    {
+        return wxutil::TreeModel::Row(item, *_model)[_columns.name];
+    }
+};
+
+const std::vector<std::string> TestPaths
+{
+    "textures/stone/wall",
+    "readme",
+    "textures/wood/plank",
+    "models/barrel",
+    "textures/stone/Floor",
+};
+
+}
+
+TEST_F(LazyVFSTreePopulatorTest, OnlyTopLevelRowsAreCreated)
+{
+    populate(TestPaths);
+
+    EXPECT_EQ(_createdPaths, (std::vector<std::string>{ "models", "textures", "readme" }));
+}
+
+TEST_F(LazyVFSTreePopulatorTest, ExpandingCreatesChildRows)
+{
+    populate(TestPaths);
+
+    // Folders first, then files, case-insensitively by name
+    EXPECT_EQ(getChildNames(wxDataViewItem()), (std::vector<std::string>{ "models", "textures", "readme" }));
+
+    auto textures = findChild(wxDataViewItem(), "textures");
+    ASSERT_TRUE(textures.IsOk());
+    EXPECT_TRUE(_model->IsContainer(textures));
+
+    EXPECT_EQ(getChildNames(textures), (std::vector<std::string>{ "stone", "wood" }));
+    EXPECT_EQ(getChildNames(findChild(textures, "stone")), (std::vector<std::string>{ "Floor", "wall" }));
+
+    // The wood folder and the models folder have not been expanded yet
+    EXPECT_EQ(_createdPaths, (std::vector<std::string>{ "models", "textures", "readme",
+        "textures/stone", "textures/wood", "textures/stone/Floor", "textures/stone/wall" }));
+
+    // Expanding a folder a second time doesn't create its rows again
+    EXPECT_EQ(getChildNames(textures), (std::vector<std::string>{ "stone", "wood" }));
+    EXPECT_EQ(_createdPaths.size(), 7);
+}
+
+TEST_F(LazyVFSTreePopulatorTest, SearchingFindsRowsInUnexpandedFolders)
+{
+    populate(TestPaths);
+
+    auto plank = _model->FindString("plank", _columns.name);
+    ASSERT_TRUE(plank.IsOk());
+    EXPECT_EQ(getName(_model->GetParent(plank)), "wood");
+
+    auto barrel = _model->FindNextString("barr", { _columns.name });
+    ASSERT_TRUE(barrel.IsOk());
+    EXPECT_EQ(getName(barrel), "barrel");
+    EXPECT_EQ(getName(_model->GetParent(barrel)), "models");
+
+    // Short needles walk the tree, which populates the folders too
+    auto floor = _model->FindNextString("fl", { _columns.name });
+    ASSERT_TRUE(floor.IsOk());
+    EXPECT_EQ(getName(floor), "Floor");
+}
+
+TEST_F(LazyVFSTreePopulatorTest, RefreshReplacesPendingRows)
+{
+    populate(TestPaths);
+
+    // Expand one of the folders, the others are still pending
+    ASSERT_TRUE(findChild(findChild(wxDataViewItem(), "textures"), "stone").IsOk());
+
+    // Refresh the model with a different set of paths
+    _model->Clear();
+    _createdPaths.clear();
+
+    populate({ "textures/metal/grate", "sounds/door" });
+
+    EXPECT_EQ(_createdPaths, (std::vector<std::string>{ "sounds", "textures" }));
+
+    auto textures = findChild(wxDataViewItem(), "textures");
+    ASSERT_TRUE(textures.IsOk());
+    EXPECT_EQ(getChildNames(textures), (std::vector<std::string>{ "metal" }));
+
+    // Nothing of the previous population is left over
+    EXPECT_FALSE(_model->FindString("plank", _columns.name).IsOk());
+    EXPECT_TRUE(_model->FindString("grate", _columns.name).IsOk());
+}
+
+}
@@ -0,0 +1,146 @@
+#include "gtest/gtest.h"
+
+#include "wxutil/dataview/TreeModel.h"
+
+namespace test
+{
+
+namespace
+{
+
+struct TreeModelColumns :
+    public wxutil::TreeModel::ColumnRecord
+{
+    wxutil::TreeModel::Column name;
+
+    TreeModelColumns() :
+        name(add(wxutil::TreeModel::Column::String))
+    {}
+};
+
+/**
+ * Sets up the following model, listed in the order of a forward search:
+ *
+ * Alpha
+ *   alpha_one
+ *   beta_two
+ * Beta
+ * gamma_ALPHA
+ */
+class TreeModelSearchTest :
+    public ::testing::Test
+{
+protected:
+    TreeModelColumns _columns;
+    wxutil::TreeModel::Ptr _model;
+
+    wxDataViewItem _alpha;
+    wxDataViewItem _alphaOne;
+    wxDataViewItem _betaTwo;
+    wxDataViewItem _beta;
+    wxDataViewItem _gammaAlpha;
+
+    void SetUp() override
+    {
+        _model = new wxutil::TreeModel(_columns);
+
+        _alpha = addItem("Alpha");
+        _alphaOne = addItem("alpha_one", _alpha);
+        _betaTwo = addItem("beta_two", _alpha);
+        _beta = addItem("Beta");
+        _gammaAlpha = addItem("gamma_ALPHA");
+    }
+
+    wxDataViewItem addItem(const std::string& name, const wxDataViewItem& parent = wxDataViewItem())
+    {
+        auto row = _model->AddItem(parent);
+        row[_columns.name] = wxVariant(name);
+
+        return row.getItem();
+    }
+
+    wxDataViewItem findNext(const std::string& needle, const wxDataViewItem& previousMatch = wxDataViewItem())
+    {
+        return _model->FindNextString(needle, { _columns.name }, previousMatch);
+    }
+
+    wxDataViewItem findPrev(const std::string& needle, const wxDataViewItem& previousMatch = wxDataViewItem())
+    {
+        return _model->FindPrevString(needle, { _columns.name }, previousMatch);
+    }
+};
+
+}
+
+TEST_F(TreeModelSearchTest, FindNextStringFollowsTreeOrder)
+{
+    // Matches are case-insensitive, parents come before their children
+    EXPECT_EQ(findNext("alpha"), _alpha);
+    EXPECT_EQ(findNext("alpha", _alpha), _alphaOne);
+    EXPECT_EQ(findNext("alpha", _alphaOne), _gammaAlpha);
+
+    // Non-matching reference items are valid too
+    EXPECT_EQ(findNext("alpha", _betaTwo), _gammaAlpha);
+}
+
+TEST_F(TreeModelSearchTest, FindPrevStringFollowsReverseTreeOrder)
+{
+    // The reverse walk visits the siblings backwards, parents before their children
+    EXPECT_EQ(findPrev("alpha"), _gammaAlpha);
+    EXPECT_EQ(findPrev("alpha", _gammaAlpha), _alpha);
+    EXPECT_EQ(findPrev("alpha", _alpha), _alphaOne);
+}
+
+TEST_F(TreeModelSearchTest, FindStringMisses)
+{
+    EXPECT_FALSE(findNext("delta").IsOk());
+    EXPECT_FALSE(findPrev("delta").IsOk());
+
+    // All trigrams of the needle occur in the model, but in no single value
+    EXPECT_FALSE(findNext("alpha_alpha").IsOk());
+    EXPECT_FALSE(findPrev("alpha_alpha").IsOk());
+}
+
+TEST_F(TreeModelSearchTest, FindStringWrapsAroundWithoutReference)
+{
+    // There's nothing after the last match, the search doesn't wrap by itself
+    EXPECT_FALSE(findNext("alpha", _gammaAlpha).IsOk());
+    EXPECT_FALSE(findPrev("alpha", _alphaOne).IsOk());
+
+    // Starting over without reference item returns the first match again
+    EXPECT_EQ(findNext("alpha"), _alpha);
+    EXPECT_EQ(findPrev("alpha"), _gammaAlpha);
+}
+
+TEST_F(TreeModelSearchTest, FindStringWithShortNeedles)
+{
+    EXPECT_EQ(findNext("be"), _betaTwo);
+    EXPECT_EQ(findNext("be", _betaTwo), _beta);
+    EXPECT_FALSE(findNext("be", _beta).IsOk());
+
+    EXPECT_EQ(findPrev("o"), _betaTwo);
+    EXPECT_EQ(findNext("_"), _alphaOne);
+    EXPECT_EQ(findNext("_", _betaTwo), _gammaAlpha);
+
+    EXPECT_FALSE(findNext("x").IsOk());
+}
+
+TEST_F(TreeModelSearchTest, FindStringFollowsModelChanges)
+{
+    // The first search creates the index
+    EXPECT_EQ(findNext("alpha", _alphaOne), _gammaAlpha);
+
+    wxutil::TreeModel::Row(_gammaAlpha, *_model)[_columns.name] = wxVariant("delta");
+    wxutil::TreeModel::Row(_beta, *_model)[_columns.name] = wxVariant("Alphabet");
+
+    EXPECT_EQ(findNext("alpha", _alphaOne), _beta);
+    EXPECT_EQ(findNext("delta"), _gammaAlpha);
+
+    _model->RemoveItem(_alpha);
+    EXPECT_EQ(findNext("alpha"), _beta);
+
+    auto epsilon = addItem("epsilon_alpha", _beta);
+    EXPECT_EQ(findNext("alpha", _beta), epsilon);
+}
+
+}